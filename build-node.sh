@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Node.js Addon Build Script
+# Compiles the HTML Layout Parser core as a native N-API addon against the
+# system FreeType (same sources as the WASM build)
+#
+# Usage:
+#   ./build-node.sh          # Release build
+#   ./build-node.sh --debug  # Build with debug info
+#   ./build-node.sh --clean  # Clean build directory first
+#
+# Requirements: CMake, a C++17 compiler, FreeType development files and the
+# Node.js headers (node_api.h)
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD_DIR="${SCRIPT_DIR}/build-node"
+OUTPUT_DIR="${SCRIPT_DIR}/native-output"
+ADDON_DIR="${SCRIPT_DIR}/node-addon"
+
+BUILD_TYPE="Release"
+CLEAN_BUILD="OFF"
+
+while [[ $# -gt 0 ]]; do
+    case $1 in
+        --debug)
+            BUILD_TYPE="RelWithDebInfo"
+            shift
+            ;;
+        --clean)
+            CLEAN_BUILD="ON"
+            shift
+            ;;
+        --help)
+            echo "Usage: $0 [options]"
+            echo ""
+            echo "Options:"
+            echo "  --debug      Build with debug info"
+            echo "  --clean      Clean build directory before building"
+            echo "  --help       Show this help message"
+            exit 0
+            ;;
+        *)
+            echo "Unknown option: $1"
+            echo "Use --help for usage information"
+            exit 1
+            ;;
+    esac
+done
+
+echo "=== HTML Layout Parser Node Addon Build Script ==="
+echo ""
+echo "Build Configuration:"
+echo "  Build Type:    ${BUILD_TYPE}"
+echo ""
+
+if ! command -v cmake &> /dev/null; then
+    echo "Error: cmake not found."
+    exit 1
+fi
+
+if [ "${CLEAN_BUILD}" = "ON" ]; then
+    echo "Cleaning build directory..."
+    rm -rf "${BUILD_DIR}"
+fi
+
+echo "Running CMake configuration..."
+cmake -S "${ADDON_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE="${BUILD_TYPE}"
+
+echo ""
+echo "Compiling Node addon..."
+cmake --build "${BUILD_DIR}" -j$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)
+
+mkdir -p "${OUTPUT_DIR}"
+cp "${BUILD_DIR}/html_layout_parser.node" "${OUTPUT_DIR}/html_layout_parser.node"
+
+echo ""
+echo "=== Build Complete ==="
+echo "Addon: ${OUTPUT_DIR}/html_layout_parser.node"
+ls -lh "${OUTPUT_DIR}/html_layout_parser.node"
@@ -9,6 +9,8 @@
 #   ./build.sh --minimal     # Build minimal version with -Oz
 #   ./build.sh --performance # Build full version optimized for speed (-O3)
 #   ./build.sh --debug      # Build with -O2 and debug info
+#   ./build.sh --wasm-exceptions # Use native Wasm exception handling
+#   ./build.sh --pthreads   # Serialize large outputs on worker threads (needs SharedArrayBuffer)
 #   ./build.sh --clean      # Clean build directory first
 
 set -e
@@ -23,6 +25,8 @@ BUILD_MINIMAL="OFF"
 OPTIMIZATION_LEVEL="O3"
 ENABLE_LTO="ON"
 ENABLE_EXCEPTIONS="ON"  # Required by litehtml
+ENABLE_WASM_EXCEPTIONS="OFF"
+ENABLE_PTHREADS="OFF"
 CLEAN_BUILD="OFF"
 RUN_WASM_OPT="OFF"
 WASM_OPT_LEVEL="Oz"
@@ -57,6 +61,14 @@ while [[ $# -gt 0 ]]; do
             CLEAN_BUILD="ON"
             shift
             ;;
+        --wasm-exceptions)
+            ENABLE_WASM_EXCEPTIONS="ON"
+            shift
+            ;;
+        --pthreads)
+            ENABLE_PTHREADS="ON"
+            shift
+            ;;
         --no-wasm-opt)
             RUN_WASM_OPT="OFF"
             shift
@@ -70,6 +82,8 @@ while [[ $# -gt 0 ]]; do
             echo "  --performance Build full version optimized for speed (-O3)"
             echo "  --debug      Build debug version (-O2, no LTO)"
             echo "  --clean      Clean build directory before building"
+            echo "  --wasm-exceptions Use native Wasm exception handling (-fwasm-exceptions)"
+            echo "  --pthreads   Build with pthreads (parallel serialization, needs SharedArrayBuffer)"
             echo "  --no-wasm-opt Skip wasm-opt post-processing"
             echo "  --help       Show this help message"
             exit 0
@@ -82,6 +96,11 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
+# wasm-opt must be told about the exception handling proposal
+if [ "${ENABLE_WASM_EXCEPTIONS}" = "ON" ]; then
+    WASM_OPT_FLAGS="${WASM_OPT_FLAGS} --enable-exception-handling"
+fi
+
 echo "=== HTML Layout Parser v2.0 WASM Build Script ==="
 echo ""
 echo "Build Configuration:"
@@ -89,6 +108,8 @@ echo "  Minimal Build: ${BUILD_MINIMAL}"
 echo "  Optimization:  -${OPTIMIZATION_LEVEL}"
 echo "  LTO Enabled:   ${ENABLE_LTO}"
 echo "  Exceptions:    ${ENABLE_EXCEPTIONS}"
+echo "  Wasm EH:       ${ENABLE_WASM_EXCEPTIONS}"
+echo "  Pthreads:      ${ENABLE_PTHREADS}"
 echo "  WASM Opt:      ${RUN_WASM_OPT} (-${WASM_OPT_LEVEL})"
 echo ""
 
@@ -119,7 +140,9 @@ emcmake cmake "${SRC_DIR}" \
     -DBUILD_MINIMAL="${BUILD_MINIMAL}" \
     -DOPTIMIZATION_LEVEL="${OPTIMIZATION_LEVEL}" \
     -DENABLE_LTO="${ENABLE_LTO}" \
-    -DENABLE_EXCEPTIONS="${ENABLE_EXCEPTIONS}"
+    -DENABLE_EXCEPTIONS="${ENABLE_EXCEPTIONS}" \
+    -DENABLE_WASM_EXCEPTIONS="${ENABLE_WASM_EXCEPTIONS}" \
+    -DENABLE_PTHREADS="${ENABLE_PTHREADS}"
 
 # Compile
 echo ""
@@ -0,0 +1,830 @@
+/**
+ * @file node_addon.cpp
+ * @brief HTML Layout Parser v2.0 - Node.js N-API addon (Node.js 原生插件)
+ *
+ * Native build of the parser for Node.js servers. It links the same sources
+ * as the WASM module (html_layout_parser.cpp, WasmContainer, MultiFontManager,
+ * litehtml) against the system FreeType and exposes the C API of
+ * html_layout_parser.h to JavaScript:
+ * - Every WASM export has a synchronous binding with the same arguments;
+ *   strings are returned as JS strings instead of pointers
+ * - HTML may be passed as a string or as a Buffer/Uint8Array; Buffer bytes
+ *   are read in place, without a copy into a separate heap
+ * - parseHTMLAsync / measureHTMLAsync run on the libuv threadpool and
+ *   return Promises, keeping the event loop free during layout
+ * - parseHTMLStream hands the output to a JS callback in chunks as it is
+ *   serialized
+ *
+ * Threading: the core keeps global state (fonts, last metrics, last result,
+ * caches), so every call into it holds one mutex. Async parses therefore run
+ * off the main thread but one at a time. The state is per process, shared by
+ * worker threads that load the addon; use several processes for parallelism.
+ */
+
+#include <node_api.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "html_layout_parser.h"
+
+namespace {
+
+// Serializes all calls into the parser core (解析器核心调用互斥锁)
+std::mutex g_coreMutex;
+
+// ============================================================================
+// Argument helpers (参数辅助函数)
+// ============================================================================
+
+/**
+ * @brief UTF-8 input taken from a JS string or read in place from a Buffer (输入字节)
+ */
+struct InputBytes {
+    const char* data = nullptr;     // Start of the bytes (字节起始)
+    size_t length = 0;              // Byte length (字节长度)
+    std::string owned;              // Storage when the input was a JS string (字符串副本)
+    bool present = false;           // false for null/undefined (是否提供)
+
+    const char* c_str() const { return present ? data : nullptr; }
+};
+
+/**
+ * @brief Read a string, Buffer or Uint8Array argument (读取字符串或 Buffer 参数)
+ * @param allowNull true to map null/undefined to a missing input
+ * @return false with a pending TypeError when the type is not accepted
+ */
+bool readInput(napi_env env, napi_value value, InputBytes& out, bool allowNull, const char* name) {
+    out = InputBytes();
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+
+    if (type == napi_undefined || type == napi_null) {
+        if (allowNull) {
+            return true;
+        }
+    } else if (type == napi_string) {
+        size_t length = 0;
+        napi_get_value_string_utf8(env, value, nullptr, 0, &length);
+        out.owned.resize(length);
+        napi_get_value_string_utf8(env, value, &out.owned[0], length + 1, &length);
+        out.data = out.owned.c_str();
+        out.length = length;
+        out.present = true;
+        return true;
+    } else {
+        bool isBuffer = false;
+        napi_is_buffer(env, value, &isBuffer);
+        if (isBuffer) {
+            void* data = nullptr;
+            napi_get_buffer_info(env, value, &data, &out.length);
+            out.data = static_cast<const char*>(data);
+            out.present = true;
+            return true;
+        }
+        bool isTypedArray = false;
+        napi_is_typedarray(env, value, &isTypedArray);
+        if (isTypedArray) {
+            napi_typedarray_type arrayType;
+            void* data = nullptr;
+            napi_get_typedarray_info(env, value, &arrayType, &out.length, &data, nullptr, nullptr);
+            if (arrayType == napi_uint8_array) {
+                out.data = static_cast<const char*>(data);
+                out.present = true;
+                return true;
+            }
+        }
+    }
+
+    std::string message = std::string(name) + " must be a string or a Buffer";
+    napi_throw_type_error(env, nullptr, message.c_str());
+    return false;
+}
+
+/**
+ * @brief Copy a Buffer input into owned storage (将 Buffer 输入复制为自有存储)
+ *
+ * Used by entry points that need a NUL-terminated string; plain strings are
+ * already owned and NUL-terminated.
+ */
+void ensureTerminated(InputBytes& input) {
+    if (input.present && input.data != input.owned.c_str()) {
+        input.owned.assign(input.data, input.length);
+        input.data = input.owned.c_str();
+    }
+}
+
+int32_t readInt(napi_env env, napi_value value) {
+    int32_t result = 0;
+    napi_get_value_int32(env, value, &result);
+    return result;
+}
+
+double readDouble(napi_env env, napi_value value) {
+    double result = 0;
+    napi_get_value_double(env, value, &result);
+    return result;
+}
+
+bool readBool(napi_env env, napi_value value) {
+    bool result = false;
+    napi_get_value_bool(env, value, &result);
+    return result;
+}
+
+/**
+ * @brief Convert a parser-owned string to JS and release it (转换并释放结果字符串)
+ */
+napi_value takeString(napi_env env, const char* str) {
+    napi_value result;
+    if (str == nullptr) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    napi_create_string_utf8(env, str, NAPI_AUTO_LENGTH, &result);
+    freeString(str);
+    return result;
+}
+
+napi_value makeInt(napi_env env, int64_t value) {
+    napi_value result;
+    napi_create_int64(env, value, &result);
+    return result;
+}
+
+napi_value makeBool(napi_env env, bool value) {
+    napi_value result;
+    napi_get_boolean(env, value, &result);
+    return result;
+}
+
+napi_value makeUndefined(napi_env env) {
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+/**
+ * @brief Fetch call arguments, padding missing ones with undefined (获取调用参数)
+ */
+template <size_t N>
+void getArgs(napi_env env, napi_callback_info info, napi_value (&args)[N]) {
+    size_t argc = N;
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    for (size_t i = argc; i < N; ++i) {
+        napi_get_undefined(env, &args[i]);
+    }
+}
+
+// ============================================================================
+// Debug and font bindings (调试与字体绑定)
+// ============================================================================
+
+napi_value SetDebugMode(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    setDebugMode(readBool(env, args[0]));
+    return makeUndefined(env);
+}
+
+napi_value GetDebugMode(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return makeBool(env, getDebugMode());
+}
+
+// loadFont(data: Uint8Array, name: string): number
+napi_value LoadFont(napi_env env, napi_callback_info info) {
+    napi_value args[2];
+    getArgs(env, info, args);
+    InputBytes data;
+    InputBytes name;
+    if (!readInput(env, args[0], data, false, "fontData") || !readInput(env, args[1], name, false, "fontName")) {
+        return nullptr;
+    }
+    ensureTerminated(name);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return makeInt(env, loadFont(reinterpret_cast<const uint8_t*>(data.data),
+                                 static_cast<int>(data.length), name.c_str()));
+}
+
+napi_value UnloadFont(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    unloadFont(readInt(env, args[0]));
+    return makeUndefined(env);
+}
+
+napi_value SetDefaultFont(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    setDefaultFont(readInt(env, args[0]));
+    return makeUndefined(env);
+}
+
+napi_value GetLoadedFonts(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getLoadedFonts());
+}
+
+napi_value ClearAllFonts(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    clearAllFonts();
+    return makeUndefined(env);
+}
+
+// ============================================================================
+// Parse bindings (解析绑定)
+// ============================================================================
+
+// parseHTML(html, css, viewportWidth, mode, optionsJson): string
+napi_value ParseHTML(napi_env env, napi_callback_info info) {
+    napi_value args[5];
+    getArgs(env, info, args);
+    InputBytes html, css, mode, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], mode, true, "mode") || !readInput(env, args[4], options, true, "options")) {
+        return nullptr;
+    }
+    // css is passed with its length and may be a Buffer read in place
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, parseHTMLSized(html.data, html.length, css.c_str(), css.length, readInt(env, args[2]),
+                                          mode.c_str(), options.c_str()));
+}
+
+/**
+ * @brief State of one parseHTMLStream call (流式解析调用状态)
+ */
+struct StreamCall {
+    napi_env env;
+    napi_value onChunk;
+    bool threw = false;     // onChunk threw; the exception is pending (回调抛出异常)
+};
+
+/**
+ * @brief Pass a chunk to the JS callback as a string (将数据块以字符串交给 JS 回调)
+ */
+int deliverChunk(const char* data, size_t size, void* userData) {
+    StreamCall& call = *static_cast<StreamCall*>(userData);
+    napi_value chunk, undefined, result;
+    napi_create_string_utf8(call.env, data, size, &chunk);
+    napi_get_undefined(call.env, &undefined);
+    if (napi_call_function(call.env, undefined, call.onChunk, 1, &chunk, &result) != napi_ok) {
+        call.threw = true;
+        return 0;
+    }
+    napi_valuetype type;
+    napi_typeof(call.env, result, &type);
+    return type == napi_boolean && !readBool(call.env, result) ? 0 : 1;
+}
+
+// parseHTMLStream(html, css, viewportWidth, mode, optionsJson, chunkSize, onChunk): boolean
+// onChunk runs while the core is locked and must not call back into the addon.
+napi_value ParseHTMLStream(napi_env env, napi_callback_info info) {
+    napi_value args[7];
+    getArgs(env, info, args);
+    InputBytes html, css, mode, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], mode, true, "mode") || !readInput(env, args[4], options, true, "options")) {
+        return nullptr;
+    }
+    napi_valuetype callbackType;
+    napi_typeof(env, args[6], &callbackType);
+    if (callbackType != napi_function) {
+        napi_throw_type_error(env, nullptr, "onChunk must be a function");
+        return nullptr;
+    }
+    ensureTerminated(css);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    StreamCall call{env, args[6]};
+    int32_t chunkSize = readInt(env, args[5]);
+    int delivered;
+    {
+        std::lock_guard<std::mutex> lock(g_coreMutex);
+        delivered = parseHTMLToStream(html.data, html.length, css.c_str(), readInt(env, args[2]),
+                                      mode.c_str(), options.c_str(),
+                                      chunkSize > 0 ? static_cast<size_t>(chunkSize) : 0,
+                                      deliverChunk, &call);
+    }
+    if (call.threw) {
+        return nullptr;
+    }
+    return makeBool(env, delivered != 0);
+}
+
+// parseHTMLWithDiagnostics(html, css, viewportWidth, mode, optionsJson): string
+napi_value ParseHTMLWithDiagnostics(napi_env env, napi_callback_info info) {
+    napi_value args[5];
+    getArgs(env, info, args);
+    InputBytes html, css, mode, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], mode, true, "mode") || !readInput(env, args[4], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(html);
+    ensureTerminated(css);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, parseHTMLWithDiagnostics(html.c_str(), css.c_str(), readInt(env, args[2]),
+                                                    mode.c_str(), options.c_str()));
+}
+
+// parseHTMLMultiWidth(html, css, widths: number[], mode, optionsJson): string
+napi_value ParseHTMLMultiWidth(napi_env env, napi_callback_info info) {
+    napi_value args[5];
+    getArgs(env, info, args);
+    InputBytes html, css, mode, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], mode, true, "mode") || !readInput(env, args[4], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(html);
+    ensureTerminated(css);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+
+    std::vector<int> widths;
+    bool isArray = false;
+    napi_is_array(env, args[2], &isArray);
+    if (isArray) {
+        uint32_t count = 0;
+        napi_get_array_length(env, args[2], &count);
+        for (uint32_t i = 0; i < count; ++i) {
+            napi_value element;
+            napi_get_element(env, args[2], i, &element);
+            widths.push_back(readInt(env, element));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, parseHTMLMultiWidth(html.c_str(), css.c_str(), widths.data(),
+                                               static_cast<int>(widths.size()), mode.c_str(), options.c_str()));
+}
+
+// fitToBox(html, css, width, height, minSize, maxSize, mode, optionsJson): string
+napi_value FitToBox(napi_env env, napi_callback_info info) {
+    napi_value args[8];
+    getArgs(env, info, args);
+    InputBytes html, css, mode, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[6], mode, true, "mode") || !readInput(env, args[7], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(html);
+    ensureTerminated(css);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, fitToBox(html.c_str(), css.c_str(), readInt(env, args[2]), readInt(env, args[3]),
+                                    static_cast<float>(readDouble(env, args[4])),
+                                    static_cast<float>(readDouble(env, args[5])),
+                                    mode.c_str(), options.c_str()));
+}
+
+// measureHTML(html, css, viewportWidth, optionsJson): string
+napi_value MeasureHTML(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes html, css, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(css);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, measureHTMLBytes(html.data, html.length, css.c_str(), readInt(env, args[2]),
+                                            options.c_str()));
+}
+
+/**
+ * @brief Read an array of HTML items as NUL-terminated strings (读取批处理条目数组)
+ * @return false with a pending exception if value is not an array of strings / Buffers
+ */
+bool readItems(napi_env env, napi_value value, std::vector<InputBytes>& items, std::vector<const char*>& pointers) {
+    bool isArray = false;
+    napi_is_array(env, value, &isArray);
+    if (!isArray) {
+        napi_throw_type_error(env, nullptr, "items must be an array");
+        return false;
+    }
+    uint32_t count = 0;
+    napi_get_array_length(env, value, &count);
+    items.resize(count);
+    pointers.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        napi_value element;
+        napi_get_element(env, value, i, &element);
+        if (!readInput(env, element, items[i], true, "item")) {
+            return false;
+        }
+        ensureTerminated(items[i]);
+        pointers[i] = items[i].c_str();
+    }
+    return true;
+}
+
+// measureHTMLBatch(items: Array<string | Buffer>, css, viewportWidth, optionsJson): string
+napi_value MeasureHTMLBatch(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes css, options;
+    if (!readInput(env, args[1], css, true, "css") || !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(css);
+    ensureTerminated(options);
+
+    std::vector<InputBytes> items;
+    std::vector<const char*> pointers;
+    if (!readItems(env, args[0], items, pointers)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, measureHTMLBatch(pointers.data(), static_cast<int>(pointers.size()), css.c_str(),
+                                            readInt(env, args[2]), options.c_str()));
+}
+
+// parseHTMLBatch(items: Array<string | Buffer>, css, viewportWidth, mode, optionsJson): string
+napi_value ParseHTMLBatch(napi_env env, napi_callback_info info) {
+    napi_value args[5];
+    getArgs(env, info, args);
+    InputBytes css, mode, options;
+    if (!readInput(env, args[1], css, true, "css") || !readInput(env, args[3], mode, true, "mode") ||
+        !readInput(env, args[4], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(css);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+
+    std::vector<InputBytes> items;
+    std::vector<const char*> pointers;
+    if (!readItems(env, args[0], items, pointers)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, parseHTMLBatch(pointers.data(), static_cast<int>(pointers.size()), css.c_str(),
+                                          readInt(env, args[2]), mode.c_str(), options.c_str()));
+}
+
+// ============================================================================
+// Async parse bindings (异步解析绑定)
+// ============================================================================
+
+/**
+ * @brief State of one parse running on the libuv threadpool (线程池解析任务)
+ */
+struct AsyncParse {
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref htmlRef = nullptr;     // Keeps a Buffer input alive (保持 Buffer 存活)
+    bool measure = false;           // measureHTML instead of parseHTML (测量模式)
+    InputBytes html;
+    InputBytes css;
+    InputBytes mode;
+    InputBytes options;
+    int viewportWidth = 0;
+    std::string result;
+};
+
+void executeAsyncParse(napi_env env, void* data) {
+    AsyncParse* task = static_cast<AsyncParse*>(data);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    const char* result = task->measure
+        ? measureHTMLBytes(task->html.data, task->html.length, task->css.c_str(),
+                           task->viewportWidth, task->options.c_str())
+        : parseHTMLSized(task->html.data, task->html.length, task->css.c_str(), task->css.length,
+                         task->viewportWidth, task->mode.c_str(), task->options.c_str());
+    if (result != nullptr) {
+        task->result = result;
+        freeString(result);
+    }
+}
+
+void completeAsyncParse(napi_env env, napi_status status, void* data) {
+    AsyncParse* task = static_cast<AsyncParse*>(data);
+    napi_value value;
+    if (status == napi_ok) {
+        napi_create_string_utf8(env, task->result.data(), task->result.size(), &value);
+        napi_resolve_deferred(env, task->deferred, value);
+    } else {
+        napi_value message;
+        napi_create_string_utf8(env, "Async parse was cancelled", NAPI_AUTO_LENGTH, &message);
+        napi_create_error(env, nullptr, message, &value);
+        napi_reject_deferred(env, task->deferred, value);
+    }
+    if (task->htmlRef != nullptr) {
+        napi_delete_reference(env, task->htmlRef);
+    }
+    napi_delete_async_work(env, task->work);
+    delete task;
+}
+
+/**
+ * @brief Queue a parse or measure on the threadpool and return its Promise (排队异步解析)
+ *
+ * Argument layout: (html, css, viewportWidth, mode, optionsJson) for parse,
+ * (html, css, viewportWidth, optionsJson) for measure.
+ */
+napi_value queueAsyncParse(napi_env env, napi_callback_info info, bool measure) {
+    napi_value args[5];
+    getArgs(env, info, args);
+    AsyncParse* task = new AsyncParse();
+    task->measure = measure;
+    napi_value optionsArg = measure ? args[3] : args[4];
+    if (!readInput(env, args[0], task->html, false, "html") || !readInput(env, args[1], task->css, true, "css") ||
+        (!measure && !readInput(env, args[3], task->mode, true, "mode")) ||
+        !readInput(env, optionsArg, task->options, true, "options")) {
+        delete task;
+        return nullptr;
+    }
+    ensureTerminated(task->css);
+    ensureTerminated(task->mode);
+    ensureTerminated(task->options);
+    task->viewportWidth = readInt(env, args[2]);
+
+    // A string was copied into task->html.owned; a Buffer is referenced in place
+    if (task->html.data != task->html.owned.c_str()) {
+        napi_create_reference(env, args[0], 1, &task->htmlRef);
+    }
+
+    napi_value promise;
+    napi_value resourceName;
+    napi_create_promise(env, &task->deferred, &promise);
+    napi_create_string_utf8(env, measure ? "measureHTMLAsync" : "parseHTMLAsync", NAPI_AUTO_LENGTH, &resourceName);
+    napi_create_async_work(env, nullptr, resourceName, executeAsyncParse, completeAsyncParse, task, &task->work);
+    napi_queue_async_work(env, task->work);
+    return promise;
+}
+
+napi_value ParseHTMLAsync(napi_env env, napi_callback_info info) {
+    return queueAsyncParse(env, info, false);
+}
+
+napi_value MeasureHTMLAsync(napi_env env, napi_callback_info info) {
+    return queueAsyncParse(env, info, true);
+}
+
+// ============================================================================
+// Result bindings (结果绑定)
+// ============================================================================
+
+// getDisplayList(): Buffer | null (copy of the last display list)
+napi_value GetDisplayList(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    const uint8_t* data = getDisplayList();
+    int size = getDisplayListSize();
+    napi_value result;
+    if (data == nullptr || size <= 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    napi_create_buffer_copy(env, static_cast<size_t>(size), data, nullptr, &result);
+    return result;
+}
+
+napi_value GetLastParseResult(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getLastParseResult());
+}
+
+// ============================================================================
+// Template bindings (模板绑定)
+// ============================================================================
+
+// compileTemplate(html, css, viewportWidth, optionsJson): number
+napi_value CompileTemplate(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes html, css, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(html);
+    ensureTerminated(css);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return makeInt(env, compileTemplate(html.c_str(), css.c_str(), readInt(env, args[2]), options.c_str()));
+}
+
+// layoutTemplate(handle, slotValuesJson, mode, optionsJson): string
+napi_value LayoutTemplate(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes values, mode, options;
+    if (!readInput(env, args[1], values, true, "slotValues") || !readInput(env, args[2], mode, true, "mode") ||
+        !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(values);
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, layoutTemplate(readInt(env, args[0]), values.c_str(), mode.c_str(), options.c_str()));
+}
+
+napi_value GetTemplateSlots(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getTemplateSlots(readInt(env, args[0])));
+}
+
+napi_value DestroyTemplate(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    destroyTemplate(readInt(env, args[0]));
+    return makeUndefined(env);
+}
+
+// ============================================================================
+// Snapshot bindings (快照绑定)
+// ============================================================================
+
+// createSnapshot(html, css, viewportWidth, optionsJson): Buffer | null
+napi_value CreateSnapshot(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes html, css, options;
+    if (!readInput(env, args[0], html, false, "html") || !readInput(env, args[1], css, true, "css") ||
+        !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(html);
+    ensureTerminated(css);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    int size = createSnapshot(html.c_str(), css.c_str(), readInt(env, args[2]), options.c_str());
+    napi_value result;
+    if (size <= 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    napi_create_buffer_copy(env, static_cast<size_t>(size), getSnapshot(), nullptr, &result);
+    return result;
+}
+
+// parseSnapshot(snapshot, viewportWidth, mode, optionsJson): string
+napi_value ParseSnapshot(napi_env env, napi_callback_info info) {
+    napi_value args[4];
+    getArgs(env, info, args);
+    InputBytes snapshot, mode, options;
+    if (!readInput(env, args[0], snapshot, false, "snapshot") || !readInput(env, args[2], mode, true, "mode") ||
+        !readInput(env, args[3], options, true, "options")) {
+        return nullptr;
+    }
+    ensureTerminated(mode);
+    ensureTerminated(options);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, parseSnapshot(reinterpret_cast<const uint8_t*>(snapshot.data), snapshot.length,
+                                         readInt(env, args[1]), mode.c_str(), options.c_str()));
+}
+
+// ============================================================================
+// Memory, metrics and cache bindings (内存、指标与缓存绑定)
+// ============================================================================
+
+napi_value Destroy(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    destroy();
+    return makeUndefined(env);
+}
+
+napi_value GetTotalMemoryUsage(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return makeInt(env, static_cast<int64_t>(getTotalMemoryUsage()));
+}
+
+napi_value CheckMemoryThreshold(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return makeBool(env, checkMemoryThreshold());
+}
+
+napi_value GetMemoryMetrics(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getMemoryMetrics());
+}
+
+napi_value GetVersion(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getVersion());
+}
+
+napi_value GetMetrics(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getMetrics());
+}
+
+napi_value GetDetailedMetrics(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getDetailedMetrics());
+}
+
+napi_value GetCacheStats(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    return takeString(env, getCacheStats());
+}
+
+napi_value ResetCacheStats(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    resetCacheStats();
+    return makeUndefined(env);
+}
+
+napi_value ClearCache(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    clearCache();
+    return makeUndefined(env);
+}
+
+napi_value SetResultCacheBudget(napi_env env, napi_callback_info info) {
+    napi_value args[1];
+    getArgs(env, info, args);
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    setResultCacheBudget(readInt(env, args[0]));
+    return makeUndefined(env);
+}
+
+// ============================================================================
+// Module registration (模块注册)
+// ============================================================================
+
+// Environments (main thread and workers) that loaded the addon (加载插件的环境数)
+int g_envCount = 0;
+
+// Release templates, fonts and caches when the last environment exits, while
+// the process is still intact; static destructors at exit would otherwise
+// tear them down in any order
+void cleanupCore(void* /*arg*/) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    if (--g_envCount == 0) {
+        destroy();
+    }
+}
+
+napi_value Init(napi_env env, napi_value exports) {
+    {
+        std::lock_guard<std::mutex> lock(g_coreMutex);
+        ++g_envCount;
+    }
+    napi_add_env_cleanup_hook(env, cleanupCore, nullptr);
+
+    const napi_property_descriptor properties[] = {
+        { "setDebugMode", nullptr, SetDebugMode, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getDebugMode", nullptr, GetDebugMode, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "loadFont", nullptr, LoadFont, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "unloadFont", nullptr, UnloadFont, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setDefaultFont", nullptr, SetDefaultFont, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getLoadedFonts", nullptr, GetLoadedFonts, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "clearAllFonts", nullptr, ClearAllFonts, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTML", nullptr, ParseHTML, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTMLAsync", nullptr, ParseHTMLAsync, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTMLStream", nullptr, ParseHTMLStream, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTMLWithDiagnostics", nullptr, ParseHTMLWithDiagnostics, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTMLMultiWidth", nullptr, ParseHTMLMultiWidth, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseHTMLBatch", nullptr, ParseHTMLBatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "fitToBox", nullptr, FitToBox, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "measureHTML", nullptr, MeasureHTML, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "measureHTMLAsync", nullptr, MeasureHTMLAsync, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "measureHTMLBatch", nullptr, MeasureHTMLBatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getDisplayList", nullptr, GetDisplayList, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getLastParseResult", nullptr, GetLastParseResult, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "compileTemplate", nullptr, CompileTemplate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "layoutTemplate", nullptr, LayoutTemplate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getTemplateSlots", nullptr, GetTemplateSlots, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "destroyTemplate", nullptr, DestroyTemplate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "createSnapshot", nullptr, CreateSnapshot, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "parseSnapshot", nullptr, ParseSnapshot, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "destroy", nullptr, Destroy, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getTotalMemoryUsage", nullptr, GetTotalMemoryUsage, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "checkMemoryThreshold", nullptr, CheckMemoryThreshold, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getMemoryMetrics", nullptr, GetMemoryMetrics, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getVersion", nullptr, GetVersion, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getMetrics", nullptr, GetMetrics, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getDetailedMetrics", nullptr, GetDetailedMetrics, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getCacheStats", nullptr, GetCacheStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "resetCacheStats", nullptr, ResetCacheStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "clearCache", nullptr, ClearCache, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setResultCacheBudget", nullptr, SetResultCacheBudget, nullptr, nullptr, nullptr, napi_default, nullptr },
+    };
+    napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
+    return exports;
+}
+
+} // namespace
+
+NAPI_MODULE(html_layout_parser, Init)
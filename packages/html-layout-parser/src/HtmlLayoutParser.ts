@@ -17,9 +17,122 @@ import type {
   SimpleOutput,
   Row,
   ParseResultWithDiagnostics,
-  Environment
+  CompactLayout,
+  StreamParseOptions,
+  ParseChunkHandler,
+  Environment,
+  DisplayListOp,
+  CacheStats,
+  MultiWidthResult,
+  FitToBoxOptions,
+  MeasureOptions,
+  MeasureResult,
+  FitToBoxResult,
+  TemplateOptions,
+  TemplateLayoutOptions,
+  TemplateSlotValues,
+  SnapshotOptions,
+  SnapshotParseOptions,
+  BatchParseOptions,
+  ComplexityLimits
 } from './types';
 import { ErrorCode } from './types';
+import { decodeDisplayList } from './display-list';
+
+const COMPLEXITY_LIMITS = ['maxDepth', 'maxElements', 'maxCssRules', 'maxTableCells', 'maxGlyphs'] as const;
+
+/**
+ * Copy the set complexity limits into a native options object
+ * 将已设置的复杂度限制复制到原生选项对象
+ * @internal
+ */
+export function addComplexityLimits(native: Record<string, unknown>, options: ComplexityLimits): void {
+  for (const key of COMPLEXITY_LIMITS) {
+    const value = options[key];
+    if (value !== undefined && value > 0) {
+      native[key] = Math.min(1e9, Math.floor(value));
+    }
+  }
+}
+
+/**
+ * Build the optionsJson argument of the native parse functions
+ * 构建原生解析函数的 optionsJson 参数
+ * 
+ * Shared by the WASM parser and the Node addon parser.
+ * 
+ * @returns JSON string, or null when no native option is set
+ *          JSON 字符串，未设置原生选项时返回 null
+ * @internal
+ */
+export function buildOptionsJson(options: BatchParseOptions): string | null {
+  const native: Record<string, unknown> = {};
+  if (options.displayList) {
+    native.displayList = true;
+  }
+  if (options.maxLines !== undefined && options.maxLines > 0) {
+    native.maxLines = Math.floor(options.maxLines);
+  }
+  if (options.maxHeight !== undefined && options.maxHeight > 0) {
+    native.maxHeight = options.maxHeight;
+  }
+  if (options.ellipsis) {
+    native.ellipsis = true;
+  }
+  if (options.fields && options.fields.length > 0) {
+    native.fields = options.fields;
+  }
+  if (options.compact) {
+    native.compact = true;
+  }
+  if (options.serializeThreads !== undefined && options.serializeThreads >= 0) {
+    native.serializeThreads = Math.min(64, Math.floor(options.serializeThreads));
+  }
+  if (options.layoutThreads !== undefined && options.layoutThreads >= 0) {
+    native.layoutThreads = Math.min(64, Math.floor(options.layoutThreads));
+  }
+  if (options.pipelineQueue !== undefined && options.pipelineQueue >= 0) {
+    native.pipelineQueue = Math.min(64, Math.floor(options.pipelineQueue));
+  }
+  addComplexityLimits(native, options);
+  return Object.keys(native).length > 0 ? JSON.stringify(native) : null;
+}
+
+/**
+ * Encode a string as UTF-8 into `heap` at `start`
+ * 将字符串以 UTF-8 编码写入 `heap` 的 `start` 处
+ * 
+ * Short ASCII strings (mode, small documents) are copied in a loop, which
+ * is cheaper than the fixed cost of `encodeInto()`.
+ * 短 ASCII 字符串（模式名、小文档）直接循环拷贝，比 `encodeInto()` 的固定开销更低。
+ * 
+ * @returns Bytes written, or -1 if the string needs more than `capacity` bytes
+ *          写入的字节数，超出 `capacity` 时返回 -1
+ * @internal
+ */
+function encodeUTF8Into(
+  encoder: TextEncoder,
+  value: string,
+  heap: Uint8Array,
+  start: number,
+  capacity: number
+): number {
+  if (value.length <= 64 && value.length <= capacity) {
+    let i = 0;
+    for (; i < value.length; i++) {
+      const code = value.charCodeAt(i);
+      if (code >= 0x80) {
+        break;
+      }
+      heap[start + i] = code;
+    }
+    if (i === value.length) {
+      return i;
+    }
+  }
+  const { read, written } = encoder.encodeInto(value, heap.subarray(start, start + capacity));
+  return read === value.length ? written : -1;
+}
 
 /**
  * HTML Layout Parser v2.0 - Main Parser Class
@@ -55,6 +168,10 @@ export class HtmlLayoutParser {
   protected environment: Environment;
   protected initialized = false;
   protected moduleLoader: (() => Promise<HtmlLayoutParserModule>) | null = null;
+  protected templateSlots = new Map<number, string[]>();
+  protected stagingPtr = 0;
+  protected stagingSize = 0;
+  protected encoder = new TextEncoder();
 
   constructor() {
     this.environment = 'unknown';
@@ -351,11 +468,10 @@ export class HtmlLayoutParser {
    * Parse HTML and calculate character layouts
    * 解析 HTML 并计算字符布局
    * 
-   * Memory safety: All allocated pointers are tracked and freed in finally block,
-   * ensuring no memory leaks even if exceptions occur.
+   * Input strings are encoded into a staging buffer that is kept in WASM
+   * memory across calls, so a parse allocates nothing for its arguments.
    * 
-   * 内存安全：所有分配的指针都会被跟踪并在 finally 块中释放，
-   * 确保即使发生异常也不会内存泄漏。
+   * 输入字符串编码到跨调用复用的 WASM 暂存缓冲区，解析参数无需逐次分配内存。
    * 
    * @typeParam T - Output mode type / 输出模式类型
    * @param html - HTML string to parse / 要解析的 HTML 字符串
@@ -388,48 +504,13 @@ export class HtmlLayoutParser {
      T extends 'byRow' ? Row[] :
      CharLayout[] {
     const module = this.ensureInitialized();
-    const mode = options.mode || 'flat';
     
     if (options.isDebug !== undefined) {
       this.setDebugMode(options.isDebug);
     }
 
-    let htmlPtr = 0;
-    let modePtr = 0;
-    let cssPtr = 0;
-
     try {
-      const htmlBytes = module.lengthBytesUTF8(html) + 1;
-      htmlPtr = module._malloc(htmlBytes);
-      if (htmlPtr === 0) {
-        throw new Error('Failed to allocate memory for HTML string');
-      }
-      module.stringToUTF8(html, htmlPtr, htmlBytes);
-
-      const modeBytes = module.lengthBytesUTF8(mode) + 1;
-      modePtr = module._malloc(modeBytes);
-      if (modePtr === 0) {
-        throw new Error('Failed to allocate memory for mode string');
-      }
-      module.stringToUTF8(mode, modePtr, modeBytes);
-
-      if (options.css) {
-        const cssBytes = module.lengthBytesUTF8(options.css) + 1;
-        cssPtr = module._malloc(cssBytes);
-        if (cssPtr === 0) {
-          throw new Error('Failed to allocate memory for CSS string');
-        }
-        module.stringToUTF8(options.css, cssPtr, cssBytes);
-      }
-
-      const resultPtr = module._parseHTML(
-        htmlPtr,
-        cssPtr,
-        options.viewportWidth,
-        modePtr,
-        0
-      );
-
+      const resultPtr = this.parseStaged(module, html, options);
       if (resultPtr === 0) {
         return [] as any;
       }
@@ -447,19 +528,41 @@ export class HtmlLayoutParser {
         this.debugLog(`Parse error: ${error}`);
       }
       return [] as any;
-    } finally {
-      if (htmlPtr !== 0) {
-        module._free(htmlPtr);
-      }
-      if (modePtr !== 0) {
-        module._free(modePtr);
-      }
-      if (cssPtr !== 0) {
-        module._free(cssPtr);
-      }
     }
   }
 
+  /**
+   * Parse HTML and return the serialized JSON as UTF-8 bytes
+   * 解析 HTML 并以 UTF-8 字节返回序列化的 JSON
+   *
+   * The bytes are copied straight out of WASM memory without building a JS
+   * string, and own their ArrayBuffer, so they can be transferred to another
+   * thread. Decode with `JSON.parse(new TextDecoder().decode(bytes))`.
+   * 字节直接从 WASM 内存拷贝，不生成 JS 字符串，且独占其 ArrayBuffer，
+   * 可转移到其他线程。
+   *
+   * @param html - HTML string to parse / 要解析的 HTML 字符串
+   * @param options - Parse options / 解析选项
+   * @returns JSON bytes, or null if the parse failed / JSON 字节，失败时返回 null
+   */
+  parseToBuffer(html: string, options: ParseOptions): Uint8Array | null {
+    const module = this.ensureInitialized();
+
+    if (options.isDebug !== undefined) {
+      this.setDebugMode(options.isDebug);
+    }
+
+    const resultPtr = this.parseStaged(module, html, options);
+    if (resultPtr === 0) {
+      return null;
+    }
+
+    const end = module.HEAPU8.indexOf(0, resultPtr);
+    const bytes = module.HEAPU8.slice(resultPtr, end);
+    module._freeString(resultPtr);
+    return bytes;
+  }
+
   /**
    * Parse HTML with external CSS (convenience method)
    * 使用外部 CSS 解析 HTML（便捷方法）
@@ -490,6 +593,120 @@ export class HtmlLayoutParser {
     return this.parse<T>(html, { ...options, css });
   }
 
+  /**
+   * Parse HTML into the compact dialect
+   * 以紧凑格式解析 HTML
+   * 
+   * Same as `parse()` with `compact: true`: styles are deduplicated into a
+   * table and characters use short keys, which cuts the output size and
+   * `JSON.parse` time on large documents. Use `expandCompactLayout()` to get
+   * the regular shape back.
+   * 等同于 `compact: true` 的 `parse()`：样式去重为样式表，字符使用短键名，
+   * 可减小大文档的输出体积和 `JSON.parse` 耗时。
+   * 
+   * @param html - HTML string to parse / 要解析的 HTML 字符串
+   * @param options - Parse options / 解析选项
+   * @returns Compact layout data / 紧凑格式布局数据
+   */
+  parseCompact(html: string, options: ParseOptions): CompactLayout {
+    const result = this.parse(html, { ...options, compact: true }) as unknown;
+    return (Array.isArray(result) ? { styles: [], data: result } : result) as CompactLayout;
+  }
+
+  /**
+   * Parse HTML and receive the output in chunks
+   * 解析 HTML 并分块接收输出
+   * 
+   * Produces the same JSON text as `parse()`, handed to `onChunk` in pieces
+   * of at most `chunkSize` bytes while it is serialized. The output is never
+   * held as one string in WASM memory or JS, so large results can be parsed
+   * incrementally or forwarded before serialization completes. Chunks never
+   * split a character. The result cache is not used; `getMetrics()` reports
+   * `outputSize`, `chunkCount` and `peakMemory`.
+   * 
+   * 生成与 `parse()` 相同的 JSON 文本，在序列化过程中按不超过 `chunkSize`
+   * 字节分块交给 `onChunk`。输出不会以完整字符串形式驻留在 WASM 内存或 JS 中，
+   * 大结果可在序列化完成前增量解析或转发。分块不会截断字符。不使用结果缓存。
+   * 
+   * @param html - HTML string to parse / 要解析的 HTML 字符串
+   * @param options - Parse options and chunk size / 解析选项与块大小
+   * @param onChunk - Receives each chunk; return false to stop / 接收每个分块，返回 false 终止
+   * @returns true if the whole output was delivered / 完整输出后返回 true
+   * @throws Rethrows an error thrown by `onChunk` / 重新抛出 `onChunk` 抛出的错误
+   * 
+   * @example
+   * ```typescript
+   * parser.parseStream(html, { viewportWidth: 800, chunkSize: 64 * 1024 }, chunk => {
+   *   socket.write(chunk);
+   * });
+   * ```
+   */
+  parseStream(html: string, options: StreamParseOptions, onChunk: ParseChunkHandler): boolean {
+    const module = this.ensureInitialized();
+    if (typeof module._parseHTMLStream !== 'function') {
+      return false;
+    }
+
+    if (options.isDebug !== undefined) {
+      this.setDebugMode(options.isDebug);
+    }
+
+    const decoder = new TextDecoder();
+    let failure: { error: unknown } | null = null;
+    module.onParseChunk = (ptr: number, size: number) => {
+      try {
+        // HEAPU8 is read per chunk: the heap may have grown since the call started
+        return onChunk(decoder.decode(module.HEAPU8.subarray(ptr, ptr + size))) !== false;
+      } catch (error) {
+        failure = { error };
+        return false;
+      }
+    };
+
+    let htmlPtr = 0;
+    let modePtr = 0;
+    let cssPtr = 0;
+    let optionsPtr = 0;
+    try {
+      htmlPtr = this.allocateUTF8(module, html);
+      modePtr = this.allocateUTF8(module, options.mode || 'flat');
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
+
+      const delivered = module._parseHTMLStream(
+        htmlPtr,
+        cssPtr,
+        options.viewportWidth,
+        modePtr,
+        optionsPtr,
+        options.chunkSize ?? 0
+      ) === 1;
+      if (failure !== null) {
+        throw (failure as { error: unknown }).error;
+      }
+      return delivered;
+    } finally {
+      module.onParseChunk = undefined;
+      if (htmlPtr !== 0) {
+        module._free(htmlPtr);
+      }
+      if (modePtr !== 0) {
+        module._free(modePtr);
+      }
+      if (cssPtr !== 0) {
+        module._free(cssPtr);
+      }
+      if (optionsPtr !== 0) {
+        module._free(optionsPtr);
+      }
+    }
+  }
+
   /**
    * Parse HTML and return result with full diagnostics
    * 解析 HTML 并返回带完整诊断信息的结果
@@ -542,6 +759,7 @@ export class HtmlLayoutParser {
     let htmlPtr = 0;
     let modePtr = 0;
     let cssPtr = 0;
+    let optionsPtr = 0;
 
     try {
       const htmlBytes = module.lengthBytesUTF8(html) + 1;
@@ -588,12 +806,29 @@ export class HtmlLayoutParser {
         module.stringToUTF8(options.css, cssPtr, cssBytes);
       }
 
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        const optionsBytes = module.lengthBytesUTF8(optionsJson) + 1;
+        optionsPtr = module._malloc(optionsBytes);
+        if (optionsPtr === 0) {
+          return {
+            success: false,
+            errors: [{
+              code: ErrorCode.MemoryAllocationFailed,
+              message: 'Failed to allocate memory for options string',
+              severity: 'error'
+            }]
+          };
+        }
+        module.stringToUTF8(optionsJson, optionsPtr, optionsBytes);
+      }
+
       const resultPtr = module._parseHTMLWithDiagnostics(
         htmlPtr,
         cssPtr,
         options.viewportWidth,
         modePtr,
-        0
+        optionsPtr
       );
 
       if (resultPtr === 0) {
@@ -632,80 +867,949 @@ export class HtmlLayoutParser {
       if (cssPtr !== 0) {
         module._free(cssPtr);
       }
+      if (optionsPtr !== 0) {
+        module._free(optionsPtr);
+      }
     }
   }
 
   /**
-   * Get the last parse result with diagnostics
-   * 获取上次解析结果（带诊断信息）
+   * Parse HTML once and lay it out at several viewport widths
+   * 一次解析 HTML 并按多个视口宽度布局
    * 
-   * @returns Last parse result with diagnostics / 上次解析结果（带诊断信息）
+   * Parsing, style cascade and font setup are shared; only layout runs per
+   * width, and styles are recomputed only when a media query breakpoint is
+   * crossed. `getMetrics()` reports `widthCount`, `mediaRestyles` and
+   * `sharedTimeSaved`. The `displayList` option is not supported here.
+   * 
+   * 解析、样式层叠和字体设置只执行一次；每个宽度只重新布局，
+   * 仅在跨越媒体查询断点时重新计算样式。
+   * `getMetrics()` 报告 `widthCount`、`mediaRestyles` 和 `sharedTimeSaved`。
+   * 此方法不支持 `displayList` 选项。
+   * 
+   * @typeParam T - Output mode type / 输出模式类型
+   * @param html - HTML string to parse / 要解析的 HTML 字符串
+   * @param widths - Viewport widths in pixels / 视口宽度列表（像素）
+   * @param options - Parse options without viewportWidth / 不含 viewportWidth 的解析选项
+   * @returns One result per width, in the order of `widths` / 每个宽度一个结果，顺序与 `widths` 相同
+   * 
+   * @example
+   * ```typescript
+   * const previews = parser.parseMultiWidth(html, [320, 768, 1280], { css });
+   * for (const { viewportWidth, data } of previews) {
+   *   console.log(viewportWidth, data.length);
+   * }
+   * ```
    */
-  getLastParseResult(): ParseResultWithDiagnostics {
+  parseMultiWidth<T extends OutputMode = 'flat'>(
+    html: string,
+    widths: number[],
+    options: Omit<ParseOptions, 'viewportWidth'> = {}
+  ): MultiWidthResult<
+    T extends 'full' ? LayoutDocument :
+    T extends 'simple' ? SimpleOutput :
+    T extends 'byRow' ? Row[] :
+    CharLayout[]
+  >[] {
     const module = this.ensureInitialized();
-
-    const resultPtr = module._getLastParseResult();
-    if (resultPtr === 0) {
-      return {
-        success: false,
-        errors: [{
-          code: ErrorCode.InternalError,
-          message: 'getLastParseResult returned null pointer',
-          severity: 'error'
-        }]
-      };
+    if (typeof module._parseHTMLMultiWidth !== 'function' || widths.length === 0) {
+      return [];
     }
 
-    const resultJson = module.UTF8ToString(resultPtr);
-    module._freeString(resultPtr);
+    if (options.isDebug !== undefined) {
+      this.setDebugMode(options.isDebug);
+    }
 
+    let htmlPtr = 0;
+    let cssPtr = 0;
+    let widthsPtr = 0;
+    let modePtr = 0;
+    let optionsPtr = 0;
     try {
-      return JSON.parse(resultJson);
-    } catch {
-      return {
-        success: false,
-        errors: [{
-          code: ErrorCode.SerializationFailed,
-          message: 'Failed to parse result JSON',
-          severity: 'error'
-        }]
-      };
-    }
-  }
+      htmlPtr = this.allocateUTF8(module, html);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      widthsPtr = module._malloc(widths.length * 4);
+      if (widthsPtr === 0) {
+        throw new Error('Failed to allocate memory for widths');
+      }
+      new Int32Array(module.HEAPU8.buffer, widthsPtr, widths.length).set(widths.map(w => Math.floor(w)));
+      modePtr = this.allocateUTF8(module, options.mode || 'flat');
+      const optionsJson = this.buildOptionsJson({ ...options, viewportWidth: 0 });
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
 
+      const resultPtr = module._parseHTMLMultiWidth(htmlPtr, cssPtr, widthsPtr, widths.length, modePtr, optionsPtr);
+      if (resultPtr === 0) {
+        return [];
+      }
 
-  // ============================================================================
-  // Utility API / 工具 API
-  // ============================================================================
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      return JSON.parse(result);
+    } catch (error) {
+      this.debugLog(`Multi-width parse error: ${error}`);
+      return [];
+    } finally {
+      for (const ptr of [htmlPtr, cssPtr, widthsPtr, modePtr, optionsPtr]) {
+        if (ptr !== 0) {
+          module._free(ptr);
+        }
+      }
+    }
+  }
 
   /**
-   * Get parser version
-   * 获取解析器版本
+   * Measure the rendered size of HTML without producing glyph layouts
+   * 测量 HTML 渲染尺寸，不生成字符布局
    * 
-   * @returns Version string (e.g., "2.0.0") / 版本字符串（如 "2.0.0"）
+   * Runs parse, style and layout only; drawing and per-character output are
+   * skipped, which makes this the cheap way to get item heights for
+   * virtualized lists.
+   * 
+   * 只执行解析、样式计算和布局，跳过绘制和逐字符输出，
+   * 适合为虚拟列表获取条目高度。
+   * 
+   * @param html - HTML string to measure / 要测量的 HTML 字符串
+   * @param options - Viewport width and CSS / 视口宽度和 CSS
+   * @returns Measurement, or null on failure / 测量结果，失败时返回 null
    * 
    * @example
    * ```typescript
-   * console.log(parser.getVersion()); // "2.0.0"
+   * const { height, lineCount } = parser.measure(itemHtml, { viewportWidth: 360 })!;
    * ```
    */
-  getVersion(): string {
+  measure(html: string, options: MeasureOptions): MeasureResult | null {
     const module = this.ensureInitialized();
-
-    const resultPtr = module._getVersion();
-    if (resultPtr === 0) {
-      return '';
+    if (typeof module._measureHTML !== 'function') {
+      return null;
     }
 
-    const result = module.UTF8ToString(resultPtr);
-    module._freeString(resultPtr);
-    return result;
-  }
+    let htmlPtr = 0;
+    let cssPtr = 0;
+    let optionsPtr = 0;
+    try {
+      htmlPtr = this.allocateUTF8(module, html);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
 
-  /**
-   * Get memory metrics
-   * 获取内存指标
-   * 
+      const resultPtr = module._measureHTML(htmlPtr, cssPtr, options.viewportWidth, optionsPtr);
+      if (resultPtr === 0) {
+        return null;
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      const parsed = JSON.parse(result);
+      return parsed.height === undefined ? null : parsed;
+    } catch (error) {
+      this.debugLog(`Measure error: ${error}`);
+      return null;
+    } finally {
+      if (htmlPtr !== 0) {
+        module._free(htmlPtr);
+      }
+      if (cssPtr !== 0) {
+        module._free(cssPtr);
+      }
+      if (optionsPtr !== 0) {
+        module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Measure several HTML documents at one width in a single call
+   * 在一次调用中按同一宽度测量多个 HTML 文档
+   * 
+   * Like `measure()` for each item, without a JS/WASM round trip per item.
+   * Empty items produce `null` entries. `getMetrics().itemCount` reports the
+   * number of items.
+   * 
+   * 等同于对每个条目调用 `measure()`，但无需每个条目都往返 JS/WASM。
+   * 空条目返回 `null`。`getMetrics().itemCount` 报告条目数。
+   * 
+   * @param items - HTML strings to measure / 要测量的 HTML 字符串
+   * @param options - Viewport width and shared CSS / 视口宽度和共享 CSS
+   * @returns One measurement per item, in order / 每个条目一个测量结果，顺序不变
+   */
+  measureBatch(items: string[], options: MeasureOptions): Array<MeasureResult | null> {
+    const module = this.ensureInitialized();
+    if (typeof module._measureHTMLBatch !== 'function' || items.length === 0) {
+      return [];
+    }
+
+    const itemPtrs: number[] = [];
+    let ptrsPtr = 0;
+    let cssPtr = 0;
+    let optionsPtr = 0;
+    try {
+      for (const item of items) {
+        itemPtrs.push(this.allocateUTF8(module, item));
+      }
+      ptrsPtr = module._malloc(items.length * 4);
+      if (ptrsPtr === 0) {
+        throw new Error('Failed to allocate memory for item pointers');
+      }
+      new Int32Array(module.HEAPU8.buffer, ptrsPtr, items.length).set(itemPtrs);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
+
+      const resultPtr = module._measureHTMLBatch(ptrsPtr, items.length, cssPtr, options.viewportWidth, optionsPtr);
+      if (resultPtr === 0) {
+        return [];
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      return JSON.parse(result);
+    } catch (error) {
+      this.debugLog(`Measure batch error: ${error}`);
+      return [];
+    } finally {
+      for (const ptr of [...itemPtrs, ptrsPtr, cssPtr, optionsPtr]) {
+        if (ptr !== 0) {
+          module._free(ptr);
+        }
+      }
+    }
+  }
+
+  /**
+   * Parse several HTML documents at one width in a single call
+   * 在一次调用中按同一宽度解析多个 HTML 文档
+   * 
+   * Like `parse()` for each item. With `pipelineQueue > 0` (the default) and
+   * a threaded build, one document is parsed while the previous one is laid
+   * out and the one before that is serialized. Empty or failing items produce
+   * `null` entries. `getMetrics()` reports `itemsPerSecond` and the
+   * `stageOccupancy` of each stage.
+   * 
+   * 等同于对每个条目调用 `parse()`。当 `pipelineQueue > 0`（默认）且为多线程构建时，
+   * 解析一个文档的同时布局上一个文档并序列化再上一个文档。空条目或失败条目返回
+   * `null`。`getMetrics()` 报告 `itemsPerSecond` 与各阶段的 `stageOccupancy`。
+   * 
+   * @param items - HTML strings to parse / 要解析的 HTML 字符串
+   * @param options - Viewport width, shared CSS and output mode / 视口宽度、共享 CSS 和输出模式
+   * @returns One result per item, in order / 每个条目一个结果，顺序不变
+   */
+  parseBatch<T extends OutputMode = 'flat'>(
+    items: string[],
+    options: BatchParseOptions & { mode?: T }
+  ): Array<(
+    T extends 'full' ? LayoutDocument :
+    T extends 'simple' ? SimpleOutput :
+    T extends 'byRow' ? Row[] :
+    CharLayout[]
+  ) | null> {
+    const module = this.ensureInitialized();
+    if (typeof module._parseHTMLBatch !== 'function' || items.length === 0) {
+      return [];
+    }
+
+    if (options.isDebug !== undefined) {
+      this.setDebugMode(options.isDebug);
+    }
+
+    const itemPtrs: number[] = [];
+    let ptrsPtr = 0;
+    let cssPtr = 0;
+    let modePtr = 0;
+    let optionsPtr = 0;
+    try {
+      for (const item of items) {
+        itemPtrs.push(this.allocateUTF8(module, item));
+      }
+      ptrsPtr = module._malloc(items.length * 4);
+      if (ptrsPtr === 0) {
+        throw new Error('Failed to allocate memory for item pointers');
+      }
+      new Int32Array(module.HEAPU8.buffer, ptrsPtr, items.length).set(itemPtrs);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      modePtr = this.allocateUTF8(module, options.mode || 'flat');
+
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
+
+      const resultPtr = module._parseHTMLBatch(ptrsPtr, items.length, cssPtr, options.viewportWidth, modePtr, optionsPtr);
+      if (resultPtr === 0) {
+        return [];
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      return JSON.parse(result);
+    } catch (error) {
+      this.debugLog(`Parse batch error: ${error}`);
+      return [];
+    } finally {
+      for (const ptr of [...itemPtrs, ptrsPtr, cssPtr, modePtr, optionsPtr]) {
+        if (ptr !== 0) {
+          module._free(ptr);
+        }
+      }
+    }
+  }
+
+  /**
+   * Find the largest font size at which HTML fits in a box
+   * 求 HTML 适配盒子的最大字号
+   * 
+   * The document is parsed once; every computed font-size is multiplied by
+   * `fontSize / 16` and whole pixel sizes between `minSize` and `maxSize` are
+   * binary-searched with layout-only probes. Glyph positions are produced
+   * once, for the chosen size. When even `minSize` overflows, the result uses
+   * `minSize` and `fits` is false.
+   * 
+   * 文档只解析一次；所有计算字号乘以 `fontSize / 16`，在 `minSize` 与
+   * `maxSize` 之间以仅布局的探测二分查找整数像素字号。字符位置只在选定字号下
+   * 生成一次。若 `minSize` 仍溢出，则使用 `minSize` 且 `fits` 为 false。
+   * 
+   * @typeParam T - Output mode type / 输出模式类型
+   * @param html - HTML string to parse / 要解析的 HTML 字符串
+   * @param options - Box size and search range / 盒子尺寸和查找范围
+   * @returns Fit result, or null on failure / 适配结果，失败时返回 null
+   * 
+   * @example
+   * ```typescript
+   * const fit = parser.fitToBox(labelHtml, { width: 300, height: 80, minSize: 8, maxSize: 48 });
+   * if (fit && !fit.fits) {
+   *   console.warn(`Label overflows even at ${fit.fontSize}px`);
+   * }
+   * ```
+   */
+  fitToBox<T extends OutputMode = 'flat'>(
+    html: string,
+    options: FitToBoxOptions & { mode?: T }
+  ): FitToBoxResult<
+    T extends 'full' ? LayoutDocument :
+    T extends 'simple' ? SimpleOutput :
+    T extends 'byRow' ? Row[] :
+    CharLayout[]
+  > | null {
+    const module = this.ensureInitialized();
+    if (typeof module._fitToBox !== 'function') {
+      return null;
+    }
+
+    let htmlPtr = 0;
+    let cssPtr = 0;
+    let modePtr = 0;
+    let optionsPtr = 0;
+    try {
+      htmlPtr = this.allocateUTF8(module, html);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      modePtr = this.allocateUTF8(module, options.mode || 'flat');
+      const native: Record<string, unknown> = {};
+      if (options.displayList) {
+        native.displayList = true;
+      }
+      if (options.heightOnly) {
+        native.heightOnly = true;
+      }
+      if (options.maxLines !== undefined && options.maxLines > 0) {
+        native.maxLines = Math.floor(options.maxLines);
+      }
+      if (options.maxHeight !== undefined && options.maxHeight > 0) {
+        native.maxHeight = options.maxHeight;
+      }
+      if (options.ellipsis) {
+        native.ellipsis = true;
+      }
+      addComplexityLimits(native, options);
+      if (Object.keys(native).length > 0) {
+        optionsPtr = this.allocateUTF8(module, JSON.stringify(native));
+      }
+
+      const resultPtr = module._fitToBox(
+        htmlPtr, cssPtr, options.width, options.height,
+        options.minSize ?? 8, options.maxSize ?? 72, modePtr, optionsPtr
+      );
+      if (resultPtr === 0) {
+        return null;
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      const parsed = JSON.parse(result);
+      return parsed.data === undefined ? null : parsed;
+    } catch (error) {
+      this.debugLog(`Fit to box error: ${error}`);
+      return null;
+    } finally {
+      for (const ptr of [htmlPtr, cssPtr, modePtr, optionsPtr]) {
+        if (ptr !== 0) {
+          module._free(ptr);
+        }
+      }
+    }
+  }
+
+  // ============================================================================
+  // Template API / 模板 API
+  // ============================================================================
+
+  /**
+   * Compile a template document with text slots
+   * 编译带文本插槽的模板文档
+   * 
+   * Elements with a `data-slot` attribute are slots. The template is parsed
+   * and styled once; `layoutTemplate()` then only replaces slot text and
+   * re-runs layout, which is much faster than a full `parse()` per variant.
+   * Templates must be compiled again after fonts are loaded or unloaded.
+   * 
+   * 带 `data-slot` 属性的元素为插槽。模板只解析和计算样式一次；
+   * `layoutTemplate()` 仅替换插槽文本并重新布局，比每个变体完整 `parse()` 快得多。
+   * 加载或卸载字体后需要重新编译模板。
+   * 
+   * @param html - Template HTML / 模板 HTML
+   * @param options - Compile options / 编译选项
+   * @returns Template handle (positive number), 0 on failure
+   *          模板句柄（正数），失败时返回 0
+   * 
+   * @example
+   * ```typescript
+   * const tpl = parser.compileTemplate(
+   *   '<div class="badge"><b data-slot="name">Name</b> <span data-slot="role">Role</span></div>',
+   *   { viewportWidth: 200, css: '.badge { padding: 4px }' }
+   * );
+   * const a = parser.layoutTemplate(tpl, ['Ada', 'Engineer']);
+   * const b = parser.layoutTemplate(tpl, { name: 'Grace' });
+   * parser.destroyTemplate(tpl);
+   * ```
+   */
+  compileTemplate(html: string, options: TemplateOptions): number {
+    const module = this.ensureInitialized();
+    if (typeof module._compileTemplate !== 'function') {
+      return 0;
+    }
+
+    let htmlPtr = 0;
+    let cssPtr = 0;
+    let optionsPtr = 0;
+    try {
+      htmlPtr = this.allocateUTF8(module, html);
+      if (options.css) {
+        cssPtr = this.allocateUTF8(module, options.css);
+      }
+      const optionsJson = this.buildOptionsJson(options);
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
+      return module._compileTemplate(htmlPtr, cssPtr, options.viewportWidth, optionsPtr);
+    } catch (error) {
+      this.debugLog(`Template compile error: ${error}`);
+      return 0;
+    } finally {
+      if (htmlPtr !== 0) {
+        module._free(htmlPtr);
+      }
+      if (cssPtr !== 0) {
+        module._free(cssPtr);
+      }
+      if (optionsPtr !== 0) {
+        module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Lay out a compiled template with new slot values
+   * 使用新的插槽值布局已编译模板
+   * 
+   * On failure an empty result is returned; call `getLastParseResult()` for
+   * the error (for example `FontSetChanged` after fonts changed).
+   * 失败时返回空结果；通过 `getLastParseResult()` 获取错误
+   * （例如字体更改后的 `FontSetChanged`）。
+   * 
+   * @typeParam T - Output mode type / 输出模式类型
+   * @param handle - Handle from `compileTemplate()` / `compileTemplate()` 返回的句柄
+   * @param values - Slot values by position or name / 按位置或名称的插槽值
+   * @param options - Layout options / 布局选项
+   * @returns Layout data based on mode / 基于模式的布局数据
+   */
+  layoutTemplate<T extends OutputMode = 'flat'>(
+    handle: number,
+    values: TemplateSlotValues,
+    options: TemplateLayoutOptions = {}
+  ): T extends 'full' ? LayoutDocument :
+     T extends 'simple' ? SimpleOutput :
+     T extends 'byRow' ? Row[] :
+     CharLayout[] {
+    const module = this.ensureInitialized();
+    if (typeof module._layoutTemplate !== 'function') {
+      return [] as any;
+    }
+
+    const ordered = Array.isArray(values)
+      ? values
+      : this.getTemplateSlots(handle).map(name => values[name] ?? null);
+
+    let valuesPtr = 0;
+    let modePtr = 0;
+    let optionsPtr = 0;
+    try {
+      valuesPtr = this.allocateUTF8(module, JSON.stringify(ordered));
+      modePtr = this.allocateUTF8(module, options.mode || 'flat');
+      const optionsJson = this.buildOptionsJson({ ...options, viewportWidth: 0 });
+      if (optionsJson) {
+        optionsPtr = this.allocateUTF8(module, optionsJson);
+      }
+
+      const resultPtr = module._layoutTemplate(handle, valuesPtr, modePtr, optionsPtr);
+      if (resultPtr === 0) {
+        return [] as any;
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      return JSON.parse(result);
+    } catch (error) {
+      this.debugLog(`Template layout error: ${error}`);
+      return [] as any;
+    } finally {
+      if (valuesPtr !== 0) {
+        module._free(valuesPtr);
+      }
+      if (modePtr !== 0) {
+        module._free(modePtr);
+      }
+      if (optionsPtr !== 0) {
+        module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Get the slot names of a compiled template in document order
+   * 按文档顺序获取已编译模板的插槽名称
+   * 
+   * @param handle - Handle from `compileTemplate()` / `compileTemplate()` 返回的句柄
+   * @returns `data-slot` values, empty for an unknown handle / `data-slot` 值，未知句柄返回空数组
+   */
+  getTemplateSlots(handle: number): string[] {
+    const cached = this.templateSlots.get(handle);
+    if (cached) {
+      return cached;
+    }
+
+    const module = this.ensureInitialized();
+    if (typeof module._getTemplateSlots !== 'function') {
+      return [];
+    }
+
+    const resultPtr = module._getTemplateSlots(handle);
+    if (resultPtr === 0) {
+      return [];
+    }
+    const result = module.UTF8ToString(resultPtr);
+    module._freeString(resultPtr);
+
+    try {
+      const slots: string[] = JSON.parse(result);
+      if (slots.length > 0) {
+        this.templateSlots.set(handle, slots);
+      }
+      return slots;
+    } catch {
+      return [];
+    }
+  }
+
+  /**
+   * Destroy a compiled template and release its document
+   * 销毁已编译模板并释放其文档
+   * 
+   * @param handle - Handle from `compileTemplate()` / `compileTemplate()` 返回的句柄
+   */
+  destroyTemplate(handle: number): void {
+    const module = this.ensureInitialized();
+    this.templateSlots.delete(handle);
+    if (typeof module._destroyTemplate === 'function') {
+      module._destroyTemplate(handle);
+    }
+  }
+
+  /**
+   * Parse and style HTML into a snapshot
+   * 解析 HTML 并计算样式，生成快照
+   * 
+   * A snapshot holds the element tree with its computed styles. It is plain
+   * bytes: cache it on disk or send it to other processes, and lay it out
+   * with `parseSnapshot()`, which skips HTML parsing, CSS parsing and
+   * selector matching. `<style>`/`<script>` contents and comments are not
+   * kept. Styles are computed at `viewportWidth` (vw units, media queries).
+   * 
+   * 快照包含元素树及其计算样式，是普通字节：可缓存到磁盘或发送给其他进程，
+   * 再通过 `parseSnapshot()` 布局，跳过 HTML 解析、CSS 解析和选择器匹配。
+   * 不保留 `<style>`/`<script>` 内容和注释。样式按 `viewportWidth` 计算
+   * （vw 单位、媒体查询）。
+   * 
+   * @param html - HTML string / HTML 字符串
+   * @param options - Snapshot options / 快照选项
+   * @returns Snapshot bytes, or null on failure (see `getLastParseResult()`)
+   *          快照字节，失败时返回 null（见 `getLastParseResult()`）
+   * 
+   * @example
+   * ```typescript
+   * const snapshot = parser.createSnapshot(html, { viewportWidth: 800, css });
+   * // Later, possibly in another process with the same fonts loaded
+   * const layouts = otherParser.parseSnapshot(snapshot!);
+   * ```
+   */
+  createSnapshot(html: string, options: SnapshotOptions): Uint8Array | null {
+    const module = this.ensureInitialized();
+    if (typeof module._createSnapshot !== 'function' || typeof module._getSnapshot !== 'function') {
+      return null;
+    }
+
+    try {
+      const optionsJson = this.buildOptionsJson(options);
+      const [htmlArg, cssArg, optionsArg] = this.stageStrings(module, [html, options.css ?? '', optionsJson ?? '']);
+      const size = module._createSnapshot(
+        htmlArg.ptr, options.css ? cssArg.ptr : 0, options.viewportWidth, optionsJson ? optionsArg.ptr : 0
+      );
+      const ptr = module._getSnapshot();
+      if (size <= 0 || ptr === 0) {
+        return null;
+      }
+      return module.HEAPU8.slice(ptr, ptr + size);
+    } catch (error) {
+      this.debugLog(`Snapshot creation error: ${error}`);
+      return null;
+    }
+  }
+
+  /**
+   * Lay out a document snapshot
+   * 布局文档快照
+   * 
+   * The snapshot may come from another parser instance or process, but the
+   * fonts it uses must be loaded under the same names. On failure an empty
+   * result is returned; call `getLastParseResult()` for the error
+   * (`InvalidSnapshot` for truncated or corrupt bytes).
+   * 快照可来自其他解析器实例或进程，但其使用的字体需以相同名称加载。
+   * 失败时返回空结果；通过 `getLastParseResult()` 获取错误
+   * （字节被截断或损坏时为 `InvalidSnapshot`）。
+   * 
+   * @typeParam T - Output mode type / 输出模式类型
+   * @param snapshot - Bytes from `createSnapshot()` / `createSnapshot()` 返回的字节
+   * @param options - Layout options / 布局选项
+   * @returns Layout data based on mode / 基于模式的布局数据
+   */
+  parseSnapshot<T extends OutputMode = 'flat'>(
+    snapshot: Uint8Array,
+    options: SnapshotParseOptions = {}
+  ): T extends 'full' ? LayoutDocument :
+     T extends 'simple' ? SimpleOutput :
+     T extends 'byRow' ? Row[] :
+     CharLayout[] {
+    const module = this.ensureInitialized();
+    if (typeof module._parseSnapshot !== 'function') {
+      return [] as any;
+    }
+
+    if (options.isDebug !== undefined) {
+      this.setDebugMode(options.isDebug);
+    }
+
+    let snapshotPtr = 0;
+    try {
+      snapshotPtr = module._malloc(Math.max(snapshot.length, 1));
+      if (snapshotPtr === 0) {
+        throw new Error('Failed to allocate memory for the snapshot');
+      }
+      module.HEAPU8.set(snapshot, snapshotPtr);
+
+      const optionsJson = this.buildOptionsJson({ ...options, viewportWidth: 0 });
+      const [modeArg, optionsArg] = this.stageStrings(module, [options.mode || 'flat', optionsJson ?? '']);
+      const resultPtr = module._parseSnapshot(
+        snapshotPtr,
+        snapshot.length,
+        options.viewportWidth ?? 0,
+        modeArg.ptr,
+        optionsJson ? optionsArg.ptr : 0
+      );
+      if (resultPtr === 0) {
+        return [] as any;
+      }
+
+      const result = module.UTF8ToString(resultPtr);
+      module._freeString(resultPtr);
+      return JSON.parse(result);
+    } catch (error) {
+      this.debugLog(`Snapshot layout error: ${error}`);
+      return [] as any;
+    } finally {
+      if (snapshotPtr !== 0) {
+        module._free(snapshotPtr);
+      }
+    }
+  }
+
+  /**
+   * Stage the arguments of a parse and call `_parseHTMLSized`
+   * 暂存解析参数并调用 `_parseHTMLSized`
+   * 
+   * @returns Result pointer to free with `_freeString`, 0 on failure
+   *          需使用 `_freeString` 释放的结果指针，失败时为 0
+   * @internal
+   */
+  protected parseStaged(module: HtmlLayoutParserModule, html: string, options: ParseOptions): number {
+    const optionsJson = this.buildOptionsJson(options);
+    const [htmlArg, cssArg, modeArg, optionsArg] = this.stageStrings(module, [
+      html,
+      options.css ?? '',
+      options.mode || 'flat',
+      optionsJson ?? ''
+    ]);
+    return module._parseHTMLSized(
+      htmlArg.ptr,
+      htmlArg.length,
+      options.css ? cssArg.ptr : 0,
+      cssArg.length,
+      options.viewportWidth,
+      modeArg.ptr,
+      optionsJson ? optionsArg.ptr : 0
+    );
+  }
+
+  /**
+   * Encode strings back to back into the staging buffer
+   * 将字符串依次编码到暂存缓冲区
+   * 
+   * Each string is NUL-terminated. The buffer is kept across calls and only
+   * grows; strings are encoded straight into WASM memory, and the exact
+   * UTF-8 length is only computed when a string does not fit. The staged
+   * bytes are overwritten by the next call, so only use this for calls that
+   * do not run JS callbacks.
+   * 每个字符串以 NUL 结尾。缓冲区跨调用保留且只增不减；字符串直接编码写入
+   * WASM 内存，仅在空间不足时计算精确的 UTF-8 长度。暂存内容会被下次调用覆盖，
+   * 因此仅用于不回调 JS 的调用。
+   * 
+   * @returns Pointer and byte length (without the NUL) of each string
+   *          每个字符串的指针与字节长度（不含 NUL）
+   * @throws Error if the buffer cannot grow / 缓冲区无法扩容时抛出错误
+   * @internal
+   */
+  protected stageStrings(module: HtmlLayoutParserModule, values: string[]): Array<{ ptr: number; length: number }> {
+    const staged: Array<{ offset: number; length: number }> = [];
+    let used = 0;
+    for (const value of values) {
+      for (;;) {
+        // One byte is kept for the NUL terminator
+        const free = this.stagingSize - used - 1;
+        const written = free >= value.length
+          ? encodeUTF8Into(this.encoder, value, module.HEAPU8, this.stagingPtr + used, free)
+          : -1;
+        if (written >= 0) {
+          module.HEAPU8[this.stagingPtr + used + written] = 0;
+          staged.push({ offset: used, length: written });
+          used += written + 1;
+          break;
+        }
+        this.growStaging(module, used, used + module.lengthBytesUTF8(value) + 1);
+      }
+    }
+    return staged.map(({ offset, length }) => ({ ptr: this.stagingPtr + offset, length }));
+  }
+
+  /**
+   * Grow the staging buffer, keeping its first `keep` bytes
+   * 扩容暂存缓冲区并保留前 `keep` 字节
+   * @internal
+   */
+  protected growStaging(module: HtmlLayoutParserModule, keep: number, required: number): void {
+    const size = Math.max(required, this.stagingSize * 2, 64 * 1024);
+    const ptr = module._malloc(size);
+    if (ptr === 0) {
+      throw new Error('Failed to allocate memory for the staging buffer');
+    }
+    if (this.stagingPtr !== 0) {
+      module.HEAPU8.copyWithin(ptr, this.stagingPtr, this.stagingPtr + keep);
+      module._free(this.stagingPtr);
+    }
+    this.stagingPtr = ptr;
+    this.stagingSize = size;
+  }
+
+  /**
+   * Copy a string into WASM memory
+   * 将字符串拷贝到 WASM 内存
+   * 
+   * @returns Pointer to free with `_free` / 需使用 `_free` 释放的指针
+   * @throws Error if allocation fails / 分配失败时抛出错误
+   * @internal
+   */
+  protected allocateUTF8(module: HtmlLayoutParserModule, value: string): number {
+    const bytes = module.lengthBytesUTF8(value) + 1;
+    const ptr = module._malloc(bytes);
+    if (ptr === 0) {
+      throw new Error('Failed to allocate memory for string');
+    }
+    module.stringToUTF8(value, ptr, bytes);
+    return ptr;
+  }
+
+  /**
+   * Build the optionsJson argument for the WASM parse functions
+   * 构建 WASM 解析函数的 optionsJson 参数
+   * 
+   * @returns JSON string, or null when no native option is set
+   *          JSON 字符串，未设置原生选项时返回 null
+   * @internal
+   */
+  protected buildOptionsJson(options: BatchParseOptions): string | null {
+    return buildOptionsJson(options);
+  }
+
+  /**
+   * Get the raw display list recorded by the last parse
+   * 获取上次解析记录的原始绘制列表
+   * 
+   * The bytes are copied out of WASM memory, so the returned array can be
+   * transferred to another thread. Only available when the last parse was
+   * called with `displayList: true`.
+   * 
+   * 字节会从 WASM 内存中拷贝出来，因此返回的数组可以传递到其他线程。
+   * 仅当上次解析使用 `displayList: true` 时可用。
+   * 
+   * @returns Display list bytes, or null if none was recorded
+   *          绘制列表字节，未记录时返回 null
+   */
+  getDisplayListBuffer(): Uint8Array | null {
+    const module = this.ensureInitialized();
+    if (typeof module._getDisplayList !== 'function') {
+      return null;
+    }
+
+    const size = module._getDisplayListSize();
+    const ptr = module._getDisplayList();
+    if (ptr === 0 || size <= 0) {
+      return null;
+    }
+    return module.HEAPU8.slice(ptr, ptr + size);
+  }
+
+  /**
+   * Get the decoded display list recorded by the last parse
+   * 获取上次解析记录的绘制列表（已解码）
+   * 
+   * Records are in paint order: backgrounds, borders, bullet markers and
+   * clip push/pop. Text is not included; it is the parse output itself.
+   * 
+   * 记录按绘制顺序排列：背景、边框、项目符号标记和裁剪压入/弹出。
+   * 不包含文本，文本即解析结果本身。
+   * 
+   * @returns Display list records, or null if none was recorded
+   *          绘制列表记录，未记录时返回 null
+   * 
+   * @example
+   * ```typescript
+   * const chars = parser.parse(html, { viewportWidth: 800, displayList: true });
+   * for (const op of parser.getDisplayList() ?? []) {
+   *   if (op.op === 'fillRect') {
+   *     ctx.fillStyle = op.color;
+   *     ctx.fillRect(op.clipBox.x, op.clipBox.y, op.clipBox.width, op.clipBox.height);
+   *   }
+   * }
+   * ```
+   */
+  getDisplayList(): DisplayListOp[] | null {
+    const bytes = this.getDisplayListBuffer();
+    return bytes ? decodeDisplayList(bytes) : null;
+  }
+
+  /**
+   * Get the last parse result with diagnostics
+   * 获取上次解析结果（带诊断信息）
+   * 
+   * @returns Last parse result with diagnostics / 上次解析结果（带诊断信息）
+   */
+  getLastParseResult(): ParseResultWithDiagnostics {
+    const module = this.ensureInitialized();
+
+    const resultPtr = module._getLastParseResult();
+    if (resultPtr === 0) {
+      return {
+        success: false,
+        errors: [{
+          code: ErrorCode.InternalError,
+          message: 'getLastParseResult returned null pointer',
+          severity: 'error'
+        }]
+      };
+    }
+
+    const resultJson = module.UTF8ToString(resultPtr);
+    module._freeString(resultPtr);
+
+    try {
+      return JSON.parse(resultJson);
+    } catch {
+      return {
+        success: false,
+        errors: [{
+          code: ErrorCode.SerializationFailed,
+          message: 'Failed to parse result JSON',
+          severity: 'error'
+        }]
+      };
+    }
+  }
+
+
+  // ============================================================================
+  // Utility API / 工具 API
+  // ============================================================================
+
+  /**
+   * Get parser version
+   * 获取解析器版本
+   * 
+   * @returns Version string (e.g., "2.0.0") / 版本字符串（如 "2.0.0"）
+   * 
+   * @example
+   * ```typescript
+   * console.log(parser.getVersion()); // "2.0.0"
+   * ```
+   */
+  getVersion(): string {
+    const module = this.ensureInitialized();
+
+    const resultPtr = module._getVersion();
+    if (resultPtr === 0) {
+      return '';
+    }
+
+    const result = module.UTF8ToString(resultPtr);
+    module._freeString(resultPtr);
+    return result;
+  }
+
+  /**
+   * Get memory metrics
+   * 获取内存指标
+   * 
    * @returns Memory metrics or null if unavailable / 内存指标，如果不可用则返回 null
    */
   getMetrics(): MemoryMetrics | null {
@@ -838,6 +1942,90 @@ export class HtmlLayoutParser {
     }
   }
 
+  // ============================================================================
+  // Cache API / 缓存 API
+  // ============================================================================
+
+  /**
+   * Enable the layout result cache with a byte budget
+   * 设置布局结果缓存的字节预算
+   * 
+   * When enabled, repeating a parse with the same HTML, CSS, viewport width,
+   * mode and options returns the stored result without parsing. Entries are
+   * evicted least-recently-used first, and all entries are dropped when fonts
+   * are loaded, unloaded or the default font changes.
+   * 
+   * 启用后，使用相同 HTML、CSS、视口宽度、模式和选项重复解析时将直接返回
+   * 缓存结果而不再解析。超出预算时按最近最少使用淘汰；加载、卸载字体或
+   * 更改默认字体时清空所有条目。
+   * 
+   * @param maxBytes - Byte budget, 0 disables the cache (default: disabled)
+   *                   字节预算，0 表示禁用（默认禁用）
+   * 
+   * @example
+   * ```typescript
+   * parser.setResultCacheBudget(32 * 1024 * 1024);
+   * parser.parse(html, { viewportWidth: 800 }); // miss
+   * parser.parse(html, { viewportWidth: 800 }); // hit
+   * console.log(parser.getCacheStats()?.resultCache.hitRate); // 0.5
+   * ```
+   */
+  setResultCacheBudget(maxBytes: number): void {
+    const module = this.ensureInitialized();
+    if (typeof module._setResultCacheBudget === 'function') {
+      module._setResultCacheBudget(Math.max(0, Math.floor(maxBytes)));
+    }
+  }
+
+  /**
+   * Get font metrics and layout result cache statistics
+   * 获取字体度量缓存和布局结果缓存统计
+   * 
+   * @returns Cache statistics or null if unavailable / 缓存统计，不可用时返回 null
+   */
+  getCacheStats(): CacheStats | null {
+    const module = this.ensureInitialized();
+    if (typeof module._getCacheStats !== 'function') {
+      return null;
+    }
+
+    const resultPtr = module._getCacheStats();
+    if (resultPtr === 0) {
+      return null;
+    }
+
+    const result = module.UTF8ToString(resultPtr);
+    module._freeString(resultPtr);
+
+    try {
+      return JSON.parse(result);
+    } catch {
+      return null;
+    }
+  }
+
+  /**
+   * Reset cache hit/miss counters without dropping cached data
+   * 重置缓存命中/未命中计数（不清除缓存数据）
+   */
+  resetCacheStats(): void {
+    const module = this.ensureInitialized();
+    if (typeof module._resetCacheStats === 'function') {
+      module._resetCacheStats();
+    }
+  }
+
+  /**
+   * Clear font metrics and layout result caches
+   * 清除字体度量缓存和布局结果缓存
+   */
+  clearCache(): void {
+    const module = this.ensureInitialized();
+    if (typeof module._clearCache === 'function') {
+      module._clearCache();
+    }
+  }
+
   /**
    * Destroy the parser and release all resources
    * 销毁解析器并释放所有资源
@@ -862,6 +2050,11 @@ export class HtmlLayoutParser {
    */
   destroy(): void {
     if (this.module) {
+      if (this.stagingPtr !== 0) {
+        this.module._free(this.stagingPtr);
+        this.stagingPtr = 0;
+        this.stagingSize = 0;
+      }
       if (typeof this.module._destroy === 'function') {
         this.module._destroy();
       } else {
@@ -869,6 +2062,7 @@ export class HtmlLayoutParser {
       }
       this.module = null;
       this.initialized = false;
+      this.templateSlots.clear();
     }
   }
 }
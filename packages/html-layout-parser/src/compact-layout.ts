@@ -0,0 +1,149 @@
+/**
+ * HTML Layout Parser v2.0 - Compact Layout Expander
+ * HTML 布局解析器 v2.0 - 紧凑格式展开器
+ *
+ * Restores the regular output shape from a result parsed with
+ * `compact: true`. The dialect is documented in src/json_serializer.h.
+ * 将使用 `compact: true` 解析的结果还原为常规输出结构。
+ *
+ * @module html-layout-parser
+ */
+
+import type {
+  CharLayout,
+  CompactChar,
+  CompactLayout,
+  CompactStyle
+} from './types';
+
+const NO_STYLE: CompactStyle = {};
+
+/**
+ * Expand one compact character, writing only the requested fields
+ * 展开单个紧凑字符（仅写入所请求的字段）
+ * @internal
+ */
+function expandChar(
+  char: CompactChar,
+  styles: CompactStyle[],
+  wanted: (field: keyof CharLayout) => boolean
+): Partial<CharLayout> {
+  const style = styles[char.s ?? 0] ?? NO_STYLE;
+  const color = style.c ?? '#000000FF';
+  const out: Partial<CharLayout> = {};
+
+  if (wanted('character')) out.character = char.c;
+  if (wanted('x')) out.x = char.x;
+  if (wanted('y')) out.y = char.y;
+  if (wanted('width')) out.width = char.w;
+  if (wanted('height')) out.height = char.h;
+  if (wanted('fontFamily')) out.fontFamily = style.f;
+  if (wanted('fontSize')) out.fontSize = style.fs;
+  if (wanted('fontWeight')) out.fontWeight = style.fw ?? 400;
+  if (wanted('fontStyle')) out.fontStyle = style.st ?? 'normal';
+  if (wanted('color')) out.color = color;
+  if (wanted('backgroundColor')) out.backgroundColor = style.bg ?? '#00000000';
+  if (wanted('opacity')) out.opacity = style.op ?? 1;
+  if (wanted('textDecoration')) {
+    const td = style.td ?? {};
+    out.textDecoration = {
+      underline: td.u ?? false,
+      overline: td.o ?? false,
+      lineThrough: td.l ?? false,
+      color: td.c ?? color,
+      style: td.st ?? 'solid',
+      thickness: td.th ?? 1
+    };
+  }
+  if (wanted('letterSpacing')) out.letterSpacing = style.ls ?? 0;
+  if (wanted('wordSpacing')) out.wordSpacing = style.ws ?? 0;
+  if (wanted('transform')) {
+    const [scaleX, scaleY, skewX, skewY, rotate] = style.tf ?? [1, 1, 0, 0, 0];
+    out.transform = { scaleX, scaleY, skewX, skewY, rotate };
+  }
+  if (wanted('baseline')) out.baseline = char.b;
+  if (wanted('direction')) out.direction = style.d ?? 'ltr';
+  if (wanted('fontId')) out.fontId = style.id;
+
+  return out;
+}
+
+/**
+ * Expand a compact result into the regular output of its mode
+ * 将紧凑格式结果展开为对应模式的常规输出
+ *
+ * Omitted style keys are indistinguishable from fields excluded by
+ * `options.fields`, so pass the same `fields` that were used for parsing.
+ * 省略的样式键无法与 `options.fields` 排除的字段区分，请传入解析时使用的 `fields`。
+ *
+ * @param compact - Result of a parse with `compact: true` / 紧凑格式解析结果
+ * @param fields - Fields requested when parsing (default: all) / 解析时请求的字段（默认：全部）
+ * @returns Data in the regular shape of the output mode / 常规结构的布局数据
+ *
+ * @example
+ * ```typescript
+ * const compact = parser.parseCompact(html, { viewportWidth: 800 });
+ * const layouts = expandCompactLayout<CharLayout[]>(compact);
+ * ```
+ */
+export function expandCompactLayout<T = CharLayout[]>(
+  compact: CompactLayout,
+  fields?: ReadonlyArray<keyof CharLayout>
+): T {
+  const { styles } = compact;
+  const selected = fields && fields.length > 0 ? new Set(fields) : null;
+  const wanted = (field: keyof CharLayout) => selected === null || selected.has(field);
+  const expandChars = (chars: CompactChar[]) => chars.map(char => expandChar(char, styles, wanted));
+  const data = compact.data as any;
+
+  // flat: characters; byRow: rows with children
+  if (Array.isArray(data)) {
+    return data.map((item: any) =>
+      Array.isArray(item.children)
+        ? { ...item, children: expandChars(item.children) }
+        : expandChar(item, styles, wanted)
+    ) as T;
+  }
+
+  // simple: lines with characters
+  if (data && Array.isArray(data.lines)) {
+    return {
+      ...data,
+      lines: data.lines.map((line: any) => ({ ...line, characters: expandChars(line.characters) }))
+    } as T;
+  }
+
+  // full: pages -> blocks -> lines -> runs; runs take their properties from style s
+  if (data && Array.isArray(data.pages)) {
+    const expandRun = (run: any) => {
+      const { s, characters, ...rest } = run;
+      if (s === undefined) {
+        return { ...rest, characters: expandChars(characters) };
+      }
+      const style = expandChar({ s }, styles, () => true);
+      return {
+        ...rest,
+        fontFamily: style.fontFamily,
+        fontSize: style.fontSize,
+        fontWeight: style.fontWeight,
+        fontStyle: style.fontStyle,
+        color: style.color,
+        backgroundColor: style.backgroundColor,
+        textDecoration: style.textDecoration,
+        characters: expandChars(characters)
+      };
+    };
+    return {
+      ...data,
+      pages: data.pages.map((page: any) => ({
+        ...page,
+        blocks: page.blocks.map((block: any) => ({
+          ...block,
+          lines: block.lines.map((line: any) => ({ ...line, runs: line.runs.map(expandRun) }))
+        }))
+      }))
+    } as T;
+  }
+
+  return data as T;
+}
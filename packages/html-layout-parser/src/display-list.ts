@@ -0,0 +1,227 @@
+/**
+ * HTML Layout Parser v2.0 - Display List Decoder
+ * HTML 布局解析器 v2.0 - 绘制列表解码器
+ *
+ * Decodes the binary display list recorded by the WASM module when parsing
+ * with `displayList: true`. The layout is documented in src/display_list.h.
+ * 解码使用 `displayList: true` 解析时 WASM 模块记录的二进制绘制列表。
+ *
+ * @module html-layout-parser
+ */
+
+import type {
+  DisplayListOp,
+  DisplayRect,
+  DisplayRadii,
+  DisplayLayer,
+  DisplayColorStop,
+  DisplayBorderEdge
+} from './types';
+
+const MAGIC = 0x4c444c48; // 'HLDL'
+const VERSION = 1;
+
+const BORDER_STYLES = [
+  'none', 'hidden', 'dotted', 'dashed', 'solid',
+  'double', 'groove', 'ridge', 'inset', 'outset'
+];
+
+const LIST_STYLE_TYPES = [
+  'none', 'circle', 'disc', 'square', 'armenian', 'cjk-ideographic',
+  'decimal', 'decimal-leading-zero', 'georgian', 'hebrew', 'hiragana',
+  'hiragana-iroha', 'katakana', 'katakana-iroha', 'lower-alpha', 'lower-greek',
+  'lower-latin', 'lower-roman', 'upper-alpha', 'upper-latin', 'upper-roman'
+];
+
+const textDecoder = new TextDecoder();
+
+/**
+ * Sequential little-endian reader
+ * 顺序小端读取器
+ * @internal
+ */
+class Reader {
+  offset: number;
+
+  constructor(private view: DataView, private bytes: Uint8Array, offset: number) {
+    this.offset = offset;
+  }
+
+  u32(): number {
+    const value = this.view.getUint32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  i32(): number {
+    const value = this.view.getInt32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  f32(): number {
+    const value = this.view.getFloat32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  color(): string {
+    let hex = '#';
+    for (let i = 0; i < 4; i++) {
+      hex += this.bytes[this.offset + i].toString(16).padStart(2, '0').toUpperCase();
+    }
+    this.offset += 4;
+    return hex;
+  }
+
+  rect(): DisplayRect {
+    return { x: this.f32(), y: this.f32(), width: this.f32(), height: this.f32() };
+  }
+
+  radii(): DisplayRadii {
+    return {
+      topLeftX: this.f32(),
+      topLeftY: this.f32(),
+      topRightX: this.f32(),
+      topRightY: this.f32(),
+      bottomRightX: this.f32(),
+      bottomRightY: this.f32(),
+      bottomLeftX: this.f32(),
+      bottomLeftY: this.f32()
+    };
+  }
+
+  layer(isRoot: boolean): DisplayLayer {
+    return { borderBox: this.rect(), borderRadius: this.radii(), clipBox: this.rect(), isRoot };
+  }
+
+  stops(): DisplayColorStop[] {
+    const count = this.u32();
+    const stops: DisplayColorStop[] = [];
+    for (let i = 0; i < count; i++) {
+      const offset = this.f32();
+      const color = this.color();
+      const hint = this.f32();
+      stops.push(Number.isNaN(hint) ? { offset, color } : { offset, color, hint });
+    }
+    return stops;
+  }
+
+  edge(): DisplayBorderEdge {
+    const width = this.f32();
+    const style = BORDER_STYLES[this.u32()] ?? 'none';
+    return { width, style, color: this.color() };
+  }
+
+  string(): string {
+    const length = this.u32();
+    const value = textDecoder.decode(this.bytes.subarray(this.offset, this.offset + length));
+    this.offset += (length + 3) & ~3;
+    return value;
+  }
+
+  point(): { x: number; y: number } {
+    return { x: this.f32(), y: this.f32() };
+  }
+}
+
+/**
+ * Decode a binary display list into records
+ * 将二进制绘制列表解码为记录数组
+ *
+ * Unknown record types are skipped, so newer modules can add records
+ * without breaking older decoders.
+ * 未知记录类型会被跳过，以便新模块添加记录时不破坏旧解码器。
+ *
+ * @param bytes - Display list bytes / 绘制列表字节
+ * @returns Records in paint order / 按绘制顺序的记录
+ * @throws Error if the header is invalid / 头部无效时抛出错误
+ */
+export function decodeDisplayList(bytes: Uint8Array): DisplayListOp[] {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.byteLength < 16 || view.getUint32(0, true) !== MAGIC) {
+    throw new Error('Invalid display list: bad magic');
+  }
+  if (view.getUint16(4, true) !== VERSION) {
+    throw new Error(`Unsupported display list version: ${view.getUint16(4, true)}`);
+  }
+
+  const headerSize = view.getUint16(6, true);
+  const opCount = view.getUint32(8, true);
+  const byteLength = Math.min(view.getUint32(12, true), bytes.byteLength);
+  const ops: DisplayListOp[] = [];
+
+  let offset = headerSize;
+  for (let i = 0; i < opCount && offset + 8 <= byteLength; i++) {
+    const op = bytes[offset];
+    const isRoot = (bytes[offset + 1] & 1) !== 0;
+    const recordLength = view.getUint32(offset + 4, true);
+    const r = new Reader(view, bytes, offset + 8);
+
+    switch (op) {
+      case 1:
+        ops.push({ op: 'fillRect', ...r.layer(isRoot), color: r.color() });
+        break;
+      case 2:
+        ops.push({
+          op: 'borders',
+          rect: r.rect(),
+          radii: r.radii(),
+          left: r.edge(),
+          top: r.edge(),
+          right: r.edge(),
+          bottom: r.edge(),
+          isRoot
+        });
+        break;
+      case 3:
+        ops.push({ op: 'linearGradient', ...r.layer(isRoot), start: r.point(), end: r.point(), stops: r.stops() });
+        break;
+      case 4:
+        ops.push({ op: 'radialGradient', ...r.layer(isRoot), center: r.point(), radius: r.point(), stops: r.stops() });
+        break;
+      case 5:
+        ops.push({
+          op: 'conicGradient',
+          ...r.layer(isRoot),
+          center: r.point(),
+          angle: r.f32(),
+          radius: r.f32(),
+          stops: r.stops()
+        });
+        break;
+      case 6:
+        ops.push({
+          op: 'image',
+          ...r.layer(isRoot),
+          originBox: r.rect(),
+          repeat: r.u32(),
+          attachment: r.u32(),
+          url: r.string()
+        });
+        break;
+      case 7:
+        ops.push({
+          op: 'listMarker',
+          rect: r.rect(),
+          color: r.color(),
+          markerType: LIST_STYLE_TYPES[r.u32()] ?? 'none',
+          index: r.i32(),
+          image: r.string()
+        });
+        break;
+      case 8:
+        ops.push({ op: 'pushClip', rect: r.rect(), radii: r.radii() });
+        break;
+      case 9:
+        ops.push({ op: 'popClip' });
+        break;
+      default:
+        break;
+    }
+
+    offset += recordLength;
+  }
+
+  return ops;
+}
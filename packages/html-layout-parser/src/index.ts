@@ -46,6 +46,9 @@ import type { Environment, CreateHtmlLayoutParserModule } from './types';
 // Re-export all types
 export * from './types';
 export { BaseParser as HtmlLayoutParserBase };
+export { decodeDisplayList } from './display-list';
+export { expandCompactLayout } from './compact-layout';
+export { HtmlLayoutParserPool, serveParserPool } from './pool';
 export { isESMSupported, isCJSSupported } from './wasm-loader';
 
 /**
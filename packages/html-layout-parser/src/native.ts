@@ -0,0 +1,538 @@
+/**
+ * HTML Layout Parser v2.0 - Native Node.js Addon Parser
+ * HTML 布局解析器 v2.0 - Node.js 原生插件解析器
+ *
+ * Same API as `HtmlLayoutParser`, backed by the N-API addon built from the
+ * same C++ sources (`./build-node.sh` → `native-output/html_layout_parser.node`).
+ * Compared with the WASM build it avoids copying strings into linear memory,
+ * is not limited to 4GB, reads `Buffer` input in place, and can run parses on
+ * the libuv threadpool with `parseAsync()` / `measureAsync()`.
+ *
+ * 与 `HtmlLayoutParser` API 相同，由同一套 C++ 源码编译的 N-API 插件实现。
+ * 相比 WASM 版本，无需把字符串拷贝进线性内存，不受 4GB 限制，
+ * 可原地读取 `Buffer` 输入，并可通过 `parseAsync()` / `measureAsync()`
+ * 在 libuv 线程池中解析。
+ *
+ * The addon keeps one global parser state: all instances share fonts and
+ * caches, and async parses run one at a time off the main thread.
+ * 插件只有一份全局解析器状态：所有实例共享字体和缓存，异步解析在主线程外逐个执行。
+ *
+ * @packageDocumentation
+ * @module html-layout-parser/node
+ */
+
+import { createRequire } from 'module';
+import type {
+  HtmlLayoutParserAddon,
+  NativeInput,
+  CharLayout,
+  FontInfo,
+  MemoryMetrics,
+  ParseOptions,
+  OutputMode,
+  LayoutDocument,
+  SimpleOutput,
+  Row,
+  ParseResultWithDiagnostics,
+  CompactLayout,
+  StreamParseOptions,
+  ParseChunkHandler,
+  Environment,
+  DisplayListOp,
+  CacheStats,
+  MultiWidthResult,
+  FitToBoxOptions,
+  MeasureOptions,
+  MeasureResult,
+  FitToBoxResult,
+  TemplateOptions,
+  TemplateLayoutOptions,
+  TemplateSlotValues,
+  SnapshotOptions,
+  SnapshotParseOptions,
+  BatchParseOptions
+} from './types';
+import { ErrorCode } from './types';
+import { addComplexityLimits, buildOptionsJson } from './HtmlLayoutParser';
+import { decodeDisplayList } from './display-list';
+
+type ModeResult<T extends OutputMode> =
+  T extends 'full' ? LayoutDocument :
+  T extends 'simple' ? SimpleOutput :
+  T extends 'byRow' ? Row[] :
+  CharLayout[];
+
+/**
+ * HTML Layout Parser backed by the native Node.js addon
+ * 基于 Node.js 原生插件的 HTML 布局解析器
+ *
+ * @example
+ * ```typescript
+ * import { NativeHtmlLayoutParser } from 'html-layout-parser/node';
+ *
+ * const parser = new NativeHtmlLayoutParser();
+ * await parser.init();
+ * parser.setDefaultFont(await parser.loadFontFromFile('./fonts/arial.ttf', 'Arial'));
+ *
+ * const html = await readFile('page.html'); // Buffer, read in place
+ * const layouts = await parser.parseAsync(html, { viewportWidth: 800 });
+ * ```
+ */
+export class NativeHtmlLayoutParser {
+  protected addon: HtmlLayoutParserAddon | null = null;
+  protected templateSlots = new Map<number, string[]>();
+
+  /**
+   * Load the addon
+   * 加载原生插件
+   *
+   * @param addonPath - Path to html_layout_parser.node (default: next to this module)
+   *                    html_layout_parser.node 路径（默认：与本模块同目录）
+   */
+  async init(addonPath?: string): Promise<void> {
+    if (this.addon) {
+      return;
+    }
+
+    const require = createRequire(import.meta.url);
+    const candidates = [
+      addonPath,
+      './html_layout_parser.node',
+    ].filter(Boolean) as string[];
+
+    for (const path of candidates) {
+      try {
+        this.addon = require(path) as HtmlLayoutParserAddon;
+        return;
+      } catch (error) {
+        console.debug(`Failed to load native addon from ${path}:`, error);
+      }
+    }
+
+    throw new Error('Failed to load native addon: html_layout_parser.node not found. Run ./build-node.sh');
+  }
+
+  /**
+   * Ensure the addon is loaded
+   * 确保插件已加载
+   * @internal
+   */
+  protected ensureInitialized(): HtmlLayoutParserAddon {
+    if (!this.addon) {
+      throw new Error('Native addon not initialized. Call init() first.');
+    }
+    return this.addon;
+  }
+
+  /**
+   * Parse a JSON result, falling back on malformed output
+   * 解析 JSON 结果，格式错误时返回回退值
+   * @internal
+   */
+  protected parseJson<R>(json: string | null, fallback: R): R {
+    if (!json) {
+      return fallback;
+    }
+    try {
+      return JSON.parse(json);
+    } catch {
+      return fallback;
+    }
+  }
+
+  // ============================================================================
+  // Debug Mode and Font API / 调试模式与字体 API
+  // ============================================================================
+
+  setDebugMode(isDebug: boolean): void {
+    this.ensureInitialized().setDebugMode(isDebug);
+  }
+
+  getDebugMode(): boolean {
+    return this.ensureInitialized().getDebugMode();
+  }
+
+  /**
+   * Load a font from binary data; the bytes are copied by the parser
+   * 从二进制数据加载字体；字节由解析器拷贝
+   */
+  loadFont(fontData: Uint8Array, fontName: string): number {
+    return this.ensureInitialized().loadFont(fontData, fontName);
+  }
+
+  /**
+   * Load a font from a file path
+   * 从文件路径加载字体
+   */
+  async loadFontFromFile(fontPath: string, fontName: string): Promise<number> {
+    try {
+      const { readFile } = await import('fs/promises');
+      return this.loadFont(await readFile(fontPath), fontName);
+    } catch (error) {
+      throw new Error(`Failed to load font from file '${fontPath}': ${error}`);
+    }
+  }
+
+  /**
+   * Load multiple fonts from file paths (0 for failed loads)
+   * 从文件路径加载多个字体（失败为 0）
+   */
+  async loadFontsFromFiles(fonts: Array<{ path: string; name: string }>): Promise<number[]> {
+    const results: number[] = [];
+    for (const font of fonts) {
+      try {
+        results.push(await this.loadFontFromFile(font.path, font.name));
+      } catch {
+        results.push(0);
+      }
+    }
+    return results;
+  }
+
+  unloadFont(fontId: number): void {
+    this.ensureInitialized().unloadFont(fontId);
+  }
+
+  setDefaultFont(fontId: number): void {
+    this.ensureInitialized().setDefaultFont(fontId);
+  }
+
+  getLoadedFonts(): FontInfo[] {
+    return this.parseJson<FontInfo[]>(this.ensureInitialized().getLoadedFonts(), []);
+  }
+
+  clearAllFonts(): void {
+    this.ensureInitialized().clearAllFonts();
+  }
+
+  // ============================================================================
+  // HTML Parsing API / HTML 解析 API
+  // ============================================================================
+
+  /**
+   * Parse HTML and calculate character layouts
+   * 解析 HTML 并计算字符布局
+   *
+   * @param html - HTML string, or UTF-8 bytes read without copying
+   *               HTML 字符串，或无需拷贝读取的 UTF-8 字节
+   */
+  parse<T extends OutputMode = 'flat'>(html: NativeInput, options: ParseOptions): ModeResult<T> {
+    const addon = this.ensureInitialized();
+    if (options.isDebug !== undefined) {
+      addon.setDebugMode(options.isDebug);
+    }
+    const result = addon.parseHTML(
+      html, options.css || null, options.viewportWidth, options.mode || 'flat', buildOptionsJson(options)
+    );
+    return this.parseJson(result, [] as any);
+  }
+
+  /**
+   * Parse HTML on the libuv threadpool
+   * 在 libuv 线程池中解析 HTML
+   *
+   * The event loop stays free while the document is laid out. A `Buffer`
+   * input must not be modified until the promise settles.
+   * 布局期间事件循环保持空闲。Promise 完成前不得修改 `Buffer` 输入。
+   */
+  async parseAsync<T extends OutputMode = 'flat'>(html: NativeInput, options: ParseOptions): Promise<ModeResult<T>> {
+    const addon = this.ensureInitialized();
+    const result = await addon.parseHTMLAsync(
+      html, options.css || null, options.viewportWidth, options.mode || 'flat', buildOptionsJson(options)
+    );
+    return this.parseJson(result, [] as any);
+  }
+
+  parseWithCSS<T extends OutputMode = 'flat'>(
+    html: NativeInput,
+    css: string,
+    options: Omit<ParseOptions, 'css'>
+  ): ModeResult<T> {
+    return this.parse<T>(html, { ...options, css });
+  }
+
+  parseCompact(html: NativeInput, options: ParseOptions): CompactLayout {
+    const result = this.parse(html, { ...options, compact: true }) as unknown;
+    return (Array.isArray(result) ? { styles: [], data: result } : result) as CompactLayout;
+  }
+
+  /**
+   * Parse HTML and receive the output in chunks (see `HtmlLayoutParser.parseStream()`)
+   * 解析 HTML 并分块接收输出
+   *
+   * `onChunk` runs synchronously while the parser is locked and must not call
+   * back into the parser.
+   * `onChunk` 在解析器加锁期间同步执行，不得再调用解析器。
+   */
+  parseStream(html: NativeInput, options: StreamParseOptions, onChunk: ParseChunkHandler): boolean {
+    const addon = this.ensureInitialized();
+    if (options.isDebug !== undefined) {
+      addon.setDebugMode(options.isDebug);
+    }
+    return addon.parseHTMLStream(
+      html, options.css || null, options.viewportWidth, options.mode || 'flat', buildOptionsJson(options),
+      options.chunkSize ?? 0, onChunk
+    );
+  }
+
+  parseWithDiagnostics<T extends OutputMode = 'flat'>(
+    html: NativeInput,
+    options: ParseOptions
+  ): ParseResultWithDiagnostics<ModeResult<T>> {
+    const addon = this.ensureInitialized();
+    if (options.isDebug !== undefined) {
+      addon.setDebugMode(options.isDebug);
+    }
+    const result = addon.parseHTMLWithDiagnostics(
+      html, options.css || null, options.viewportWidth, options.mode || 'flat', buildOptionsJson(options)
+    );
+    return this.parseJson(result, {
+      success: false,
+      errors: [{
+        code: ErrorCode.SerializationFailed,
+        message: 'Failed to parse result JSON',
+        severity: 'error'
+      }]
+    });
+  }
+
+  parseMultiWidth<T extends OutputMode = 'flat'>(
+    html: NativeInput,
+    widths: number[],
+    options: Omit<ParseOptions, 'viewportWidth'> = {}
+  ): MultiWidthResult<ModeResult<T>>[] {
+    if (widths.length === 0) {
+      return [];
+    }
+    const addon = this.ensureInitialized();
+    if (options.isDebug !== undefined) {
+      addon.setDebugMode(options.isDebug);
+    }
+    const result = addon.parseHTMLMultiWidth(
+      html, options.css || null, widths.map(w => Math.floor(w)), options.mode || 'flat',
+      buildOptionsJson({ ...options, viewportWidth: 0 })
+    );
+    return this.parseJson(result, []);
+  }
+
+  measure(html: NativeInput, options: MeasureOptions): MeasureResult | null {
+    const result = this.ensureInitialized().measureHTML(
+      html, options.css || null, options.viewportWidth, buildOptionsJson(options)
+    );
+    const parsed = this.parseJson<MeasureResult | null>(result, null);
+    return parsed && parsed.height !== undefined ? parsed : null;
+  }
+
+  /**
+   * Measure HTML on the libuv threadpool
+   * 在 libuv 线程池中测量 HTML
+   */
+  async measureAsync(html: NativeInput, options: MeasureOptions): Promise<MeasureResult | null> {
+    const result = await this.ensureInitialized().measureHTMLAsync(
+      html, options.css || null, options.viewportWidth, buildOptionsJson(options)
+    );
+    const parsed = this.parseJson<MeasureResult | null>(result, null);
+    return parsed && parsed.height !== undefined ? parsed : null;
+  }
+
+  measureBatch(items: NativeInput[], options: MeasureOptions): Array<MeasureResult | null> {
+    if (items.length === 0) {
+      return [];
+    }
+    const result = this.ensureInitialized().measureHTMLBatch(
+      items, options.css || null, options.viewportWidth, buildOptionsJson(options)
+    );
+    return this.parseJson(result, []);
+  }
+
+  parseBatch<T extends OutputMode = 'flat'>(
+    items: NativeInput[],
+    options: BatchParseOptions & { mode?: T }
+  ): Array<ModeResult<T> | null> {
+    if (items.length === 0) {
+      return [];
+    }
+    const addon = this.ensureInitialized();
+    if (options.isDebug !== undefined) {
+      addon.setDebugMode(options.isDebug);
+    }
+    const result = addon.parseHTMLBatch(
+      items, options.css || null, options.viewportWidth, options.mode || 'flat', buildOptionsJson(options)
+    );
+    return this.parseJson(result, []);
+  }
+
+  fitToBox<T extends OutputMode = 'flat'>(
+    html: NativeInput,
+    options: FitToBoxOptions & { mode?: T }
+  ): FitToBoxResult<ModeResult<T>> | null {
+    const native: Record<string, unknown> = {};
+    if (options.displayList) {
+      native.displayList = true;
+    }
+    if (options.heightOnly) {
+      native.heightOnly = true;
+    }
+    if (options.maxLines !== undefined && options.maxLines > 0) {
+      native.maxLines = Math.floor(options.maxLines);
+    }
+    if (options.maxHeight !== undefined && options.maxHeight > 0) {
+      native.maxHeight = options.maxHeight;
+    }
+    if (options.ellipsis) {
+      native.ellipsis = true;
+    }
+    addComplexityLimits(native, options);
+    const result = this.ensureInitialized().fitToBox(
+      html, options.css || null, options.width, options.height,
+      options.minSize ?? 8, options.maxSize ?? 72, options.mode || 'flat',
+      Object.keys(native).length > 0 ? JSON.stringify(native) : null
+    );
+    const parsed = this.parseJson<FitToBoxResult<ModeResult<T>> | null>(result, null);
+    return parsed && parsed.data !== undefined ? parsed : null;
+  }
+
+  // ============================================================================
+  // Template API / 模板 API
+  // ============================================================================
+
+  compileTemplate(html: NativeInput, options: TemplateOptions): number {
+    return this.ensureInitialized().compileTemplate(
+      html, options.css || null, options.viewportWidth, buildOptionsJson(options)
+    );
+  }
+
+  layoutTemplate<T extends OutputMode = 'flat'>(
+    handle: number,
+    values: TemplateSlotValues,
+    options: TemplateLayoutOptions = {}
+  ): ModeResult<T> {
+    const addon = this.ensureInitialized();
+    const ordered = Array.isArray(values)
+      ? values
+      : this.getTemplateSlots(handle).map(name => values[name] ?? null);
+    const result = addon.layoutTemplate(
+      handle, JSON.stringify(ordered), options.mode || 'flat',
+      buildOptionsJson({ ...options, viewportWidth: 0 })
+    );
+    return this.parseJson(result, [] as any);
+  }
+
+  getTemplateSlots(handle: number): string[] {
+    const cached = this.templateSlots.get(handle);
+    if (cached) {
+      return cached;
+    }
+    const slots = this.parseJson<string[]>(this.ensureInitialized().getTemplateSlots(handle), []);
+    if (slots.length > 0) {
+      this.templateSlots.set(handle, slots);
+    }
+    return slots;
+  }
+
+  destroyTemplate(handle: number): void {
+    this.templateSlots.delete(handle);
+    this.ensureInitialized().destroyTemplate(handle);
+  }
+
+  // ============================================================================
+  // Snapshot API / 快照 API
+  // ============================================================================
+
+  createSnapshot(html: NativeInput, options: SnapshotOptions): Uint8Array | null {
+    return this.ensureInitialized().createSnapshot(
+      html, options.css || null, options.viewportWidth, buildOptionsJson(options)
+    );
+  }
+
+  parseSnapshot<T extends OutputMode = 'flat'>(
+    snapshot: Uint8Array,
+    options: SnapshotParseOptions = {}
+  ): ModeResult<T> {
+    const result = this.ensureInitialized().parseSnapshot(
+      snapshot, options.viewportWidth ?? 0, options.mode || 'flat',
+      buildOptionsJson({ ...options, viewportWidth: 0 })
+    );
+    return this.parseJson(result, [] as any);
+  }
+
+  // ============================================================================
+  // Results, Utility and Cache API / 结果、工具与缓存 API
+  // ============================================================================
+
+  getDisplayListBuffer(): Uint8Array | null {
+    return this.ensureInitialized().getDisplayList();
+  }
+
+  getDisplayList(): DisplayListOp[] | null {
+    const bytes = this.getDisplayListBuffer();
+    return bytes ? decodeDisplayList(bytes) : null;
+  }
+
+  getLastParseResult(): ParseResultWithDiagnostics {
+    return this.parseJson(this.ensureInitialized().getLastParseResult(), {
+      success: false,
+      errors: [{
+        code: ErrorCode.SerializationFailed,
+        message: 'Failed to parse result JSON',
+        severity: 'error'
+      }]
+    });
+  }
+
+  getVersion(): string {
+    return this.ensureInitialized().getVersion();
+  }
+
+  getMetrics(): MemoryMetrics | null {
+    return this.parseJson<MemoryMetrics | null>(this.ensureInitialized().getMetrics(), null);
+  }
+
+  getEnvironment(): Environment {
+    return 'node';
+  }
+
+  isInitialized(): boolean {
+    return this.addon !== null;
+  }
+
+  getTotalMemoryUsage(): number {
+    return this.ensureInitialized().getTotalMemoryUsage();
+  }
+
+  checkMemoryThreshold(): boolean {
+    return this.ensureInitialized().checkMemoryThreshold();
+  }
+
+  getMemoryMetrics(): MemoryMetrics | null {
+    return this.parseJson<MemoryMetrics | null>(this.ensureInitialized().getMemoryMetrics(), null);
+  }
+
+  setResultCacheBudget(maxBytes: number): void {
+    this.ensureInitialized().setResultCacheBudget(Math.max(0, Math.floor(maxBytes)));
+  }
+
+  getCacheStats(): CacheStats | null {
+    return this.parseJson<CacheStats | null>(this.ensureInitialized().getCacheStats(), null);
+  }
+
+  resetCacheStats(): void {
+    this.ensureInitialized().resetCacheStats();
+  }
+
+  clearCache(): void {
+    this.ensureInitialized().clearCache();
+  }
+
+  /**
+   * Release fonts, templates and caches of the shared addon state
+   * 释放共享插件状态中的字体、模板和缓存
+   */
+  destroy(): void {
+    if (this.addon) {
+      this.addon.destroy();
+      this.addon = null;
+      this.templateSlots.clear();
+    }
+  }
+}
@@ -53,6 +53,10 @@ import type { CreateHtmlLayoutParserModule } from './types';
 // Re-export all types
 export * from './types';
 export { BaseParser as HtmlLayoutParserBase };
+export { decodeDisplayList } from './display-list';
+export { expandCompactLayout } from './compact-layout';
+export { HtmlLayoutParserPool, serveParserPool } from './pool';
+export { NativeHtmlLayoutParser } from './native';
 
 /**
  * HTML Layout Parser for Node.js environment
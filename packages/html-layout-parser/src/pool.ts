@@ -0,0 +1,437 @@
+/**
+ * HTML Layout Parser v2.0 - Worker Pool
+ * HTML 布局解析器 v2.0 - Worker 池
+ *
+ * `HtmlLayoutParserPool` runs parses on N workers (Web Workers or Node.js
+ * worker_threads), each holding its own WASM instance. Fonts are broadcast
+ * to every worker, parse requests go to the worker with the shortest queue,
+ * and results come back as transferred UTF-8 bytes instead of structured
+ * clones. Each worker script calls `serveParserPool()`. A worker that errors
+ * or exits is taken out of the pool and its pending requests are rejected.
+ *
+ * `HtmlLayoutParserPool` 在 N 个 worker（Web Worker 或 Node.js worker_threads）
+ * 上执行解析，每个 worker 持有独立的 WASM 实例。字体广播到所有 worker，
+ * 解析请求分派给队列最短的 worker，结果以转移的 UTF-8 字节返回而非结构化克隆。
+ * 每个 worker 脚本需调用 `serveParserPool()`。出错或退出的 worker 会被移出池，
+ * 其待处理请求被拒绝。
+ *
+ * @module html-layout-parser
+ */
+
+import type {
+  OutputMode,
+  ParseOptions,
+  ParseResult,
+  ParserPoolOptions,
+  PoolParseResult,
+  PoolParser,
+  PoolPort,
+  PoolWorkerMetrics
+} from './types';
+
+/** @internal */
+type PoolRequest =
+  | { id: number; type: 'init'; wasmPath?: string }
+  | { id: number; type: 'loadFont'; fontData: Uint8Array; fontName: string }
+  | { id: number; type: 'unloadFont'; fontId: number }
+  | { id: number; type: 'setDefaultFont'; fontId: number }
+  | { id: number; type: 'clearAllFonts' }
+  | { id: number; type: 'parse'; html: string; options: ParseOptions }
+  | { id: number; type: 'destroy' };
+
+/** @internal */
+type DistributiveOmit<T, K extends keyof any> = T extends unknown ? Omit<T, K> : never;
+
+/** @internal */
+interface PoolResponse {
+  id: number;
+  error?: string;
+  fontId?: number;
+  output?: Uint8Array | null;
+  displayList?: Uint8Array | null;
+  busyTime: number;
+}
+
+/** @internal */
+interface PendingRequest {
+  resolve: (response: PoolResponse) => void;
+  reject: (error: Error) => void;
+}
+
+/** @internal */
+interface PoolWorkerState {
+  index: number;
+  port: PoolPort;
+  pending: Map<number, PendingRequest>;
+  completed: number;
+  failed: number;
+  busyTime: number;
+}
+
+/**
+ * Subscribe to messages from a Web or Node.js endpoint
+ * 订阅 Web 或 Node.js 端点的消息
+ * @internal
+ */
+function listen(port: PoolPort, handler: (data: unknown) => void): void {
+  if (typeof port.on === 'function') {
+    port.on('message', handler);
+  } else if (typeof port.addEventListener === 'function') {
+    port.addEventListener('message', event => handler(event.data));
+  } else {
+    throw new Error('Pool port has neither on() nor addEventListener()');
+  }
+}
+
+/**
+ * Subscribe to the crash of a Web or Node.js worker
+ * 订阅 Web 或 Node.js worker 的崩溃
+ * @internal
+ */
+function listenForFailure(port: PoolPort, handler: (error: Error) => void): void {
+  if (typeof port.on === 'function') {
+    port.on('error', error => handler(error instanceof Error ? error : new Error(String(error))));
+    port.on('exit', code => handler(new Error(`Worker exited with code ${code}`)));
+  } else if (typeof port.addEventListener === 'function') {
+    port.addEventListener('error', event => handler(new Error(event.message ?? 'Worker error')));
+  }
+}
+
+/**
+ * Pool of parser workers
+ * 解析器 worker 池
+ *
+ * @example Node.js worker_threads
+ * ```typescript
+ * // parse-worker.mjs
+ * import { parentPort } from 'worker_threads';
+ * import { HtmlLayoutParser, serveParserPool } from 'html-layout-parser/node';
+ * serveParserPool(new HtmlLayoutParser(), parentPort);
+ *
+ * // main.mjs
+ * import { Worker } from 'worker_threads';
+ * import { HtmlLayoutParserPool } from 'html-layout-parser/node';
+ *
+ * const pool = new HtmlLayoutParserPool({
+ *   size: 4,
+ *   createWorker: () => new Worker(new URL('./parse-worker.mjs', import.meta.url))
+ * });
+ * await pool.init();
+ * pool.setDefaultFont(await pool.loadFont(fontData, 'Arial'));
+ * const layouts = await Promise.all(pages.map(html => pool.parse(html, { viewportWidth: 800 })));
+ * await pool.destroy();
+ * ```
+ *
+ * @example Web Workers
+ * ```typescript
+ * // parse-worker.ts
+ * import { HtmlLayoutParser, serveParserPool } from 'html-layout-parser/worker';
+ * serveParserPool(new HtmlLayoutParser());
+ *
+ * // main.ts
+ * const pool = new HtmlLayoutParserPool({
+ *   createWorker: () => new Worker(new URL('./parse-worker.ts', import.meta.url), { type: 'module' })
+ * });
+ * ```
+ */
+export class HtmlLayoutParserPool {
+  protected readonly options: ParserPoolOptions;
+  protected workers: PoolWorkerState[] = [];
+  protected nextId = 1;
+  protected nextWorker = 0;
+  protected startTime = 0;
+  protected decoder = new TextDecoder();
+
+  constructor(options: ParserPoolOptions) {
+    this.options = options;
+  }
+
+  /**
+   * Create the workers and initialize their parsers
+   * 创建 worker 并初始化其解析器
+   */
+  async init(): Promise<void> {
+    if (this.workers.length > 0) {
+      return;
+    }
+
+    const size = Math.max(1, Math.floor(this.options.size ?? 4));
+    for (let index = 0; index < size; index++) {
+      const port = await this.options.createWorker(index);
+      const state: PoolWorkerState = {
+        index,
+        port,
+        pending: new Map(),
+        completed: 0,
+        failed: 0,
+        busyTime: 0
+      };
+      listen(port, data => this.handleResponse(state, data as PoolResponse));
+      listenForFailure(port, error => this.handleFailure(state, error));
+      this.workers.push(state);
+    }
+
+    this.startTime = performance.now();
+    await this.broadcast({ type: 'init', wasmPath: this.options.wasmPath });
+  }
+
+  /**
+   * Number of running workers
+   * 运行中的 worker 数量
+   */
+  get size(): number {
+    return this.workers.length;
+  }
+
+  /**
+   * Load a font into every worker
+   * 将字体加载到所有 worker
+   *
+   * Every worker receives the same fonts in the same order, so they assign
+   * the same font ID.
+   * 所有 worker 以相同顺序收到相同字体，因此分配的字体 ID 相同。
+   *
+   * @returns Font ID, 0 on failure / 字体 ID，失败时返回 0
+   */
+  async loadFont(fontData: Uint8Array, fontName: string): Promise<number> {
+    const responses = await this.broadcast({ type: 'loadFont', fontData, fontName });
+    const fontId = responses[0].fontId ?? 0;
+    if (responses.some(response => response.fontId !== fontId)) {
+      throw new Error(`Font '${fontName}' got different IDs across pool workers`);
+    }
+    return fontId;
+  }
+
+  /**
+   * Unload a font from every worker
+   * 从所有 worker 卸载字体
+   */
+  async unloadFont(fontId: number): Promise<void> {
+    await this.broadcast({ type: 'unloadFont', fontId });
+  }
+
+  /**
+   * Set the default font of every worker
+   * 设置所有 worker 的默认字体
+   */
+  async setDefaultFont(fontId: number): Promise<void> {
+    await this.broadcast({ type: 'setDefaultFont', fontId });
+  }
+
+  /**
+   * Clear the fonts of every worker
+   * 清除所有 worker 的字体
+   */
+  async clearAllFonts(): Promise<void> {
+    await this.broadcast({ type: 'clearAllFonts' });
+  }
+
+  /**
+   * Parse HTML on the least loaded worker
+   * 在负载最低的 worker 上解析 HTML
+   *
+   * Same result as `HtmlLayoutParser.parse()`: an empty array on failure.
+   * 与 `HtmlLayoutParser.parse()` 结果相同：失败时返回空数组。
+   */
+  async parse<T extends OutputMode = 'flat'>(html: string, options: ParseOptions): Promise<ParseResult<T>> {
+    const { output } = await this.parseToBuffer(html, options);
+    if (output === null) {
+      return [] as any;
+    }
+    try {
+      return JSON.parse(this.decoder.decode(output));
+    } catch {
+      return [] as any;
+    }
+  }
+
+  /**
+   * Parse HTML on the least loaded worker and keep the output as bytes
+   * 在负载最低的 worker 上解析 HTML，输出保持为字节
+   *
+   * The worker transfers its buffers, so nothing is copied on the way back.
+   * Useful when the result is forwarded (network, another worker) or decoded
+   * lazily.
+   * worker 转移其缓冲区，返回过程中不发生拷贝。适用于转发结果或延迟解码。
+   */
+  async parseToBuffer(html: string, options: ParseOptions): Promise<PoolParseResult> {
+    const worker = this.pickWorker();
+    const response = await this.send(worker, { type: 'parse', html, options });
+    return {
+      output: response.output ?? null,
+      displayList: response.displayList ?? null,
+      worker: worker.index
+    };
+  }
+
+  /**
+   * Queue length and utilization of each worker
+   * 每个 worker 的队列长度与利用率
+   */
+  getWorkerMetrics(): PoolWorkerMetrics[] {
+    const elapsed = performance.now() - this.startTime;
+    return this.workers.map(worker => ({
+      index: worker.index,
+      pending: worker.pending.size,
+      completed: worker.completed,
+      failed: worker.failed,
+      busyTime: worker.busyTime,
+      utilization: elapsed > 0 ? Math.min(1, worker.busyTime / elapsed) : 0
+    }));
+  }
+
+  /**
+   * Destroy the worker parsers and terminate the workers
+   * 销毁 worker 中的解析器并终止 worker
+   */
+  async destroy(): Promise<void> {
+    const workers = this.workers;
+    try {
+      await this.broadcast({ type: 'destroy' });
+    } finally {
+      this.workers = [];
+      for (const worker of workers) {
+        for (const request of worker.pending.values()) {
+          request.reject(new Error('Parser pool destroyed'));
+        }
+        worker.pending.clear();
+        worker.port.terminate?.();
+      }
+    }
+  }
+
+  /**
+   * Worker with the fewest pending requests; ties rotate
+   * 待处理请求最少的 worker；相同时轮换
+   * @internal
+   */
+  protected pickWorker(): PoolWorkerState {
+    const count = this.workers.length;
+    if (count === 0) {
+      throw new Error('Parser pool has no running workers. Call init() first.');
+    }
+
+    let best = this.nextWorker % count;
+    for (let i = 1; i < count; i++) {
+      const position = (this.nextWorker + i) % count;
+      if (this.workers[position].pending.size < this.workers[best].pending.size) {
+        best = position;
+      }
+    }
+    this.nextWorker = (best + 1) % count;
+    return this.workers[best];
+  }
+
+  /** @internal */
+  protected broadcast(request: DistributiveOmit<PoolRequest, 'id'>): Promise<PoolResponse[]> {
+    return Promise.all(this.workers.map(worker => this.send(worker, request)));
+  }
+
+  /** @internal */
+  protected send(worker: PoolWorkerState, request: DistributiveOmit<PoolRequest, 'id'>): Promise<PoolResponse> {
+    const id = this.nextId++;
+    return new Promise<PoolResponse>((resolve, reject) => {
+      worker.pending.set(id, { resolve, reject });
+      worker.port.postMessage({ ...request, id });
+    });
+  }
+
+  /** @internal */
+  protected handleResponse(worker: PoolWorkerState, response: PoolResponse): void {
+    const request = worker.pending.get(response.id);
+    if (!request) {
+      return;
+    }
+    worker.pending.delete(response.id);
+    worker.busyTime += response.busyTime;
+
+    if (response.error !== undefined) {
+      worker.failed++;
+      request.reject(new Error(`Pool worker ${worker.index}: ${response.error}`));
+    } else {
+      worker.completed++;
+      request.resolve(response);
+    }
+  }
+
+  /**
+   * Take a crashed worker out of the pool and reject its pending requests
+   * 将崩溃的 worker 移出池并拒绝其待处理请求
+   * @internal
+   */
+  protected handleFailure(worker: PoolWorkerState, error: Error): void {
+    const position = this.workers.indexOf(worker);
+    if (position < 0) {
+      return;
+    }
+    this.workers.splice(position, 1);
+    worker.failed += worker.pending.size;
+    for (const request of worker.pending.values()) {
+      request.reject(new Error(`Pool worker ${worker.index}: ${error.message}`));
+    }
+    worker.pending.clear();
+    worker.port.terminate?.();
+  }
+}
+
+/**
+ * Answer pool requests inside a worker
+ * 在 worker 中响应池请求
+ *
+ * Requests are handled one at a time in arrival order. Parse output and the
+ * display list are transferred back to the pool.
+ * 请求按到达顺序逐个处理。解析输出与绘制列表以转移方式返回给池。
+ *
+ * @param parser - Uninitialized or initialized parser / 解析器（可未初始化）
+ * @param port - `parentPort` in Node.js; defaults to the worker scope / Node.js 中传 `parentPort`，默认为 worker 作用域
+ */
+export function serveParserPool(parser: PoolParser, port: PoolPort = globalThis as unknown as PoolPort): void {
+  let queue = Promise.resolve();
+
+  const handle = async (request: PoolRequest): Promise<void> => {
+    const start = performance.now();
+    const response: PoolResponse = { id: request.id, busyTime: 0 };
+    const transfer: ArrayBuffer[] = [];
+
+    try {
+      switch (request.type) {
+        case 'init':
+          await parser.init(request.wasmPath);
+          break;
+        case 'loadFont':
+          response.fontId = parser.loadFont(request.fontData, request.fontName);
+          break;
+        case 'unloadFont':
+          parser.unloadFont(request.fontId);
+          break;
+        case 'setDefaultFont':
+          parser.setDefaultFont(request.fontId);
+          break;
+        case 'clearAllFonts':
+          parser.clearAllFonts();
+          break;
+        case 'parse':
+          response.output = parser.parseToBuffer(request.html, request.options);
+          response.displayList = request.options.displayList ? parser.getDisplayListBuffer() : null;
+          for (const bytes of [response.output, response.displayList]) {
+            if (bytes) {
+              transfer.push(bytes.buffer as ArrayBuffer);
+            }
+          }
+          break;
+        case 'destroy':
+          parser.destroy();
+          break;
+      }
+    } catch (error) {
+      response.error = error instanceof Error ? error.message : String(error);
+    }
+
+    response.busyTime = performance.now() - start;
+    port.postMessage(response, transfer);
+  };
+
+  listen(port, data => {
+    queue = queue.then(() => handle(data as PoolRequest));
+  });
+}
@@ -62,6 +62,46 @@ export enum ErrorCode {
    * HTML 内容超过最大大小限制
    */
   HtmlTooLarge = 1006,
+  /** 
+   * Template handle does not exist or was destroyed
+   * 模板句柄不存在或已销毁
+   */
+  InvalidTemplate = 1007,
+  /** 
+   * Slot values are not an array of strings or null
+   * 插槽值不是字符串或 null 组成的数组
+   */
+  InvalidSlotValues = 1008,
+  /** 
+   * Snapshot bytes are truncated, corrupt or from another format version
+   * 快照字节被截断、损坏或格式版本不匹配
+   */
+  InvalidSnapshot = 1009,
+  /** 
+   * Elements nest deeper than the maxDepth option
+   * 元素嵌套深度超过 maxDepth 选项
+   */
+  DomTooDeep = 1010,
+  /** 
+   * Document has more elements than the maxElements option
+   * 文档元素数超过 maxElements 选项
+   */
+  TooManyElements = 1011,
+  /** 
+   * Style sheets have more selectors than the maxCssRules option
+   * 样式表选择器数超过 maxCssRules 选项
+   */
+  TooManyCssRules = 1012,
+  /** 
+   * Tables have more grid cells than the maxTableCells option
+   * 表格网格单元数超过 maxTableCells 选项
+   */
+  TooManyTableCells = 1013,
+  /** 
+   * Output has more characters than the maxGlyphs option
+   * 输出字符数超过 maxGlyphs 选项
+   */
+  TooManyGlyphs = 1014,
   
   // Font-related errors (2xxx) / 字体相关错误 (2xxx)
   /** 
@@ -99,6 +139,11 @@ export enum ErrorCode {
    * 字体内存使用超过阈值
    */
   FontMemoryExceeded = 2007,
+  /** 
+   * Fonts changed after a template was compiled
+   * 模板编译后字体集已更改
+   */
+  FontSetChanged = 2008,
   
   // Parsing errors (3xxx) / 解析错误 (3xxx)
   /** 
@@ -240,6 +285,73 @@ export interface PerformanceMetrics {
    * 处理速度（字符/秒）
    */
   charsPerSecond: number;
+  /** 
+   * Whether the result was served from the layout result cache
+   * 结果是否来自布局结果缓存
+   */
+  cacheHit?: boolean;
+  /** 
+   * Number of widths laid out from one parse (1 for parse())
+   * 单次解析布局的宽度数（parse() 为 1）
+   */
+  widthCount?: number;
+  /** 
+   * Style recalculations caused by crossing media query breakpoints
+   * 跨越媒体查询断点导致的样式重算次数
+   */
+  mediaRestyles?: number;
+  /** 
+   * Parse time not repeated across widths: parseTime * (widthCount - 1) (ms)
+   * 多宽度共享解析节省的时间（毫秒）
+   */
+  sharedTimeSaved?: number;
+  /** 
+   * Layout-only probes run by fitToBox()
+   * fitToBox() 执行的仅布局探测次数
+   */
+  fitProbes?: number;
+  /** 
+   * Documents processed by measureBatch() or parseBatch()
+   * measureBatch() 或 parseBatch() 处理的文档数
+   */
+  itemCount?: number;
+  /** 
+   * Documents per second of the last batch call
+   * 上次批处理调用每秒处理的文档数
+   */
+  itemsPerSecond?: number;
+  /** 
+   * Busy fraction (0-1) of each parseBatch() stage over the wall time
+   * parseBatch() 各阶段忙碌时间占总耗时的比例（0-1）
+   * 
+   * A stage close to 1 is the bottleneck of the pipeline.
+   * 接近 1 的阶段是流水线瓶颈。
+   */
+  stageOccupancy?: {
+    parse: number;
+    layout: number;
+    serialize: number;
+  };
+  /** 
+   * True when layout stopped at maxLines / maxHeight
+   * 布局在 maxLines / maxHeight 处截断时为 true
+   */
+  truncated?: boolean;
+  /** 
+   * Size of the serialized output in bytes
+   * 序列化输出大小（字节）
+   */
+  outputSize?: number;
+  /** 
+   * Chunks delivered by parseStream() (0 for other calls)
+   * parseStream() 输出的块数（其他调用为 0）
+   */
+  chunkCount?: number;
+  /** 
+   * Peak heap growth during the last parse in bytes (0 where unavailable)
+   * 上次解析期间堆内存的峰值增长（字节，不可用时为 0）
+   */
+  peakMemory?: number;
   /** 
    * Memory usage information
    * 内存使用信息
@@ -894,6 +1006,142 @@ export interface MemoryMetrics {
   fonts: FontInfo[];
 }
 
+/** 
+ * Layout result cache statistics
+ * 布局结果缓存统计
+ */
+export interface ResultCacheStats {
+  /** Cache enabled (budget > 0) / 缓存是否启用 */
+  enabled: boolean;
+  /** Parses served from the cache / 命中次数 */
+  hits: number;
+  /** Parses that missed the cache / 未命中次数 */
+  misses: number;
+  /** Entries evicted to stay within the budget / 因预算淘汰的条目数 */
+  evictions: number;
+  /** Cached results / 缓存条目数 */
+  entries: number;
+  /** Hit rate (0-1), null if no lookups / 命中率，无查询时为 null */
+  hitRate: number | null;
+  /** Bytes held by cached results / 缓存占用字节 */
+  memoryUsage: number;
+  /** Byte budget / 字节预算 */
+  budget: number;
+}
+
+/** 
+ * Cache statistics
+ * 缓存统计
+ */
+export interface CacheStats {
+  /** Font metrics cache hits / 字体度量缓存命中次数 */
+  hits: number;
+  /** Font metrics cache misses / 字体度量缓存未命中次数 */
+  misses: number;
+  /** Font metrics cache entries / 字体度量缓存条目数 */
+  entries: number;
+  /** Font metrics cache hit rate, null if no queries / 字体度量缓存命中率 */
+  hitRate: number | null;
+  /** Font metrics cache memory in bytes / 字体度量缓存内存（字节） */
+  memoryUsage: number;
+  /** Layout result cache / 布局结果缓存 */
+  resultCache: ResultCacheStats;
+}
+
+// =============================================================================
+// Display List Types / 绘制列表类型
+// =============================================================================
+
+/** 
+ * Rectangle in pixels
+ * 矩形（像素）
+ */
+export interface DisplayRect {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+/** 
+ * Corner radii in pixels (top-left, top-right, bottom-right, bottom-left)
+ * 圆角半径（像素，左上、右上、右下、左下）
+ */
+export interface DisplayRadii {
+  topLeftX: number;
+  topLeftY: number;
+  topRightX: number;
+  topRightY: number;
+  bottomRightX: number;
+  bottomRightY: number;
+  bottomLeftX: number;
+  bottomLeftY: number;
+}
+
+/** 
+ * Background layer geometry shared by fills, gradients and images
+ * 填充、渐变和图片共享的背景层几何信息
+ */
+export interface DisplayLayer {
+  /** Paint boundary / 绘制边界 */
+  borderBox: DisplayRect;
+  /** Radii of borderBox / borderBox 圆角 */
+  borderRadius: DisplayRadii;
+  /** Additional clip rectangle / 额外裁剪矩形 */
+  clipBox: DisplayRect;
+  /** Painted on the root element / 根元素背景 */
+  isRoot: boolean;
+}
+
+/** 
+ * Gradient color stop
+ * 渐变色标
+ */
+export interface DisplayColorStop {
+  /** Position along the gradient (0-1) / 渐变位置 (0-1) */
+  offset: number;
+  /** Color (#RRGGBBAA) / 颜色 */
+  color: string;
+  /** Interpolation hint, if any / 插值提示（可选） */
+  hint?: number;
+}
+
+/** 
+ * Border edge
+ * 边框边
+ */
+export interface DisplayBorderEdge {
+  width: number;
+  /** CSS border-style keyword / CSS border-style 关键字 */
+  style: string;
+  /** Color (#RRGGBBAA) / 颜色 */
+  color: string;
+}
+
+/** 
+ * Display list record, in paint order
+ * 绘制列表记录（按绘制顺序）
+ */
+export type DisplayListOp =
+  | ({ op: 'fillRect'; color: string } & DisplayLayer)
+  | ({ op: 'linearGradient'; start: { x: number; y: number }; end: { x: number; y: number }; stops: DisplayColorStop[] } & DisplayLayer)
+  | ({ op: 'radialGradient'; center: { x: number; y: number }; radius: { x: number; y: number }; stops: DisplayColorStop[] } & DisplayLayer)
+  | ({ op: 'conicGradient'; center: { x: number; y: number }; angle: number; radius: number; stops: DisplayColorStop[] } & DisplayLayer)
+  | ({ op: 'image'; originBox: DisplayRect; repeat: number; attachment: number; url: string } & DisplayLayer)
+  | {
+      op: 'borders';
+      rect: DisplayRect;
+      radii: DisplayRadii;
+      left: DisplayBorderEdge;
+      top: DisplayBorderEdge;
+      right: DisplayBorderEdge;
+      bottom: DisplayBorderEdge;
+      isRoot: boolean;
+    }
+  | { op: 'listMarker'; rect: DisplayRect; color: string; markerType: string; index: number; image: string }
+  | { op: 'pushClip'; rect: DisplayRect; radii: DisplayRadii }
+  | { op: 'popClip' };
+
 // =============================================================================
 // Parse Options Types / 解析选项类型
 // =============================================================================
@@ -909,6 +1157,47 @@ export interface MemoryMetrics {
  */
 export type OutputMode = 'full' | 'simple' | 'flat' | 'byRow';
 
+/** 
+ * Limits on the size of a document's trees, 0 or unset for no limit
+ * 文档树规模限制，0 或不设置表示不限制
+ * 
+ * Keep the worst case of adversarial or broken input bounded. Tree limits
+ * are checked while the document is built, before any style is matched or
+ * layout runs; `maxGlyphs` is checked while drawing. A document over a limit
+ * fails with the matching error code (`DomTooDeep`, `TooManyElements`,
+ * `TooManyCssRules`, `TooManyTableCells`, `TooManyGlyphs`).
+ * 用于限制恶意或损坏输入的最坏开销。树规模限制在构建文档时检查，早于样式匹配和布局；
+ * `maxGlyphs` 在绘制时检查。超出限制的文档以对应错误码失败
+ * （`DomTooDeep`、`TooManyElements`、`TooManyCssRules`、`TooManyTableCells`、`TooManyGlyphs`）。
+ */
+export interface ComplexityLimits {
+  /** 
+   * Maximum element nesting depth (`<html>` is 1)
+   * 最大元素嵌套深度（`<html>` 为 1）
+   */
+  maxDepth?: number;
+  /** 
+   * Maximum number of elements
+   * 最大元素数
+   */
+  maxElements?: number;
+  /** 
+   * Maximum selectors in the document's style sheets, external CSS included (`a, b` counts twice)
+   * 文档样式表（含外部 CSS）的最大选择器数（`a, b` 计为两个）
+   */
+  maxCssRules?: number;
+  /** 
+   * Maximum table grid cells of all tables (a cell spanning n columns takes n)
+   * 所有表格的最大网格单元数（跨 n 列的单元格占 n 个）
+   */
+  maxTableCells?: number;
+  /** 
+   * Maximum characters in the output
+   * 输出的最大字符数
+   */
+  maxGlyphs?: number;
+}
+
 /** 
  * Parse options for HTML parsing
  * HTML 解析选项
@@ -924,7 +1213,7 @@ export type OutputMode = 'full' | 'simple' | 'flat' | 'byRow';
  * };
  * ```
  */
-export interface ParseOptions {
+export interface ParseOptions extends ComplexityLimits {
   /** 
    * Viewport width in pixels (required)
    * 视口宽度（像素，必需）
@@ -979,6 +1268,497 @@ export interface ParseOptions {
    * - Memory usage / 内存使用
    */
   isDebug?: boolean;
+  /** 
+   * Record backgrounds, borders, list markers and clips (default: false)
+   * 记录背景、边框、列表标记和裁剪（默认：false）
+   * 
+   * Read the result with `getDisplayList()` after parsing.
+   * 解析后通过 `getDisplayList()` 读取结果。
+   */
+  displayList?: boolean;
+  /** 
+   * Stop layout after this many text lines (default: no limit)
+   * 布局到指定行数后停止（默认：不限制）
+   * 
+   * Content after the cut is neither laid out nor drawn, so previews of long
+   * documents cost about as much as the visible part. `getMetrics().truncated`
+   * reports whether anything was cut.
+   * 截断之后的内容既不布局也不绘制，长文档预览的开销与可见部分相当。
+   * `getMetrics().truncated` 报告是否发生截断。
+   */
+  maxLines?: number;
+  /** 
+   * Stop layout at this document height in pixels (default: no limit)
+   * 布局到指定文档高度（像素）后停止（默认：不限制）
+   */
+  maxHeight?: number;
+  /** 
+   * End a truncated layout with an ellipsis (default: false)
+   * 截断时在最后一行末尾添加省略号（默认：false）
+   * 
+   * Without this option the ellipsis is only added to blocks styled with
+   * `text-overflow: ellipsis`.
+   * 未设置时仅对带有 `text-overflow: ellipsis` 的块添加省略号。
+   */
+  ellipsis?: boolean;
+  /** 
+   * Only serialize these CharLayout fields (default: all fields)
+   * 仅序列化指定的 CharLayout 字段（默认：全部字段）
+   * 
+   * Characters then carry just the listed properties, which shrinks the
+   * output and the serialize time on large documents. Unknown names make the
+   * options invalid.
+   * 字符对象仅包含所列属性，可显著减小大文档的输出体积和序列化耗时。
+   * 未知字段名会使选项无效。
+   */
+  fields?: ReadonlyArray<keyof CharLayout>;
+  /** 
+   * Emit the compact dialect (default: false)
+   * 输出紧凑格式（默认：false）
+   * 
+   * The result becomes a `CompactLayout`: styles are deduplicated into a
+   * table, characters use short keys and default values are omitted.
+   * Restore the regular shape with `expandCompactLayout()`.
+   * 结果为 `CompactLayout`：样式去重为样式表，字符使用短键名并省略默认值。
+   * 可通过 `expandCompactLayout()` 还原为常规结构。
+   */
+  compact?: boolean;
+  /** 
+   * Threads serializing large flat outputs (default: 0, automatic; 1 disables)
+   * 序列化大型扁平输出的线程数（默认：0 自动；1 为禁用）
+   * 
+   * Only the native addon and pthreads WASM builds use threads; the output
+   * is identical for any value. Ignored by `parseStream()`.
+   * 仅原生插件和 pthreads WASM 构建使用线程；任意取值输出均相同。
+   * `parseStream()` 会忽略此选项。
+   */
+  serializeThreads?: number;
+  /** 
+   * Threads laying out independent sections (default: 1, serial; 0 automatic)
+   * 并行布局独立区块的线程数（默认：1 串行；0 自动）
+   * 
+   * Children of a block that establish their own block formatting context
+   * (for example `overflow: hidden` or `display: flex` sections) are laid out
+   * concurrently, then stacked in order. Only the native addon and pthreads
+   * WASM builds use threads; the output is identical for any value. Ignored
+   * while `maxLines` or `maxHeight` is set.
+   * 块的子元素若建立独立块格式化上下文（如 `overflow: hidden` 或 `display: flex`
+   * 区块），将并行布局后按顺序堆叠。仅原生插件和 pthreads WASM 构建使用线程；
+   * 任意取值输出均相同。设置 `maxLines` 或 `maxHeight` 时忽略。
+   */
+  layoutThreads?: number;
+}
+
+/** 
+ * Options for parseStream()
+ * parseStream() 选项
+ */
+export interface StreamParseOptions extends ParseOptions {
+  /** 
+   * Maximum chunk size in bytes (default: 256KB)
+   * 单块最大字节数（默认：256KB）
+   */
+  chunkSize?: number;
+}
+
+/** 
+ * Options for parseBatch()
+ * parseBatch() 选项
+ */
+export interface BatchParseOptions extends ParseOptions {
+  /** 
+   * Documents queued between pipeline stages (default: 2; 0 runs each document start to finish)
+   * 流水线阶段间排队的文档数（默认：2；0 表示逐个文档顺序执行）
+   * 
+   * Parsing, layout and serialization of different documents overlap on
+   * separate threads; each stage still handles documents in order. Only the
+   * native addon and pthreads WASM builds use threads.
+   * 不同文档的解析、布局和序列化在不同线程上重叠执行；每个阶段仍按顺序处理文档。
+   * 仅原生插件和 pthreads WASM 构建使用线程。
+   */
+  pipelineQueue?: number;
+}
+
+/** 
+ * Receives one chunk of streamed output; return false to stop the stream
+ * 接收一块流式输出；返回 false 可终止输出
+ */
+export type ParseChunkHandler = (chunk: string) => boolean | void;
+
+/** 
+ * Deduplicated style entry of the compact dialect; omitted keys take the default
+ * 紧凑格式中去重后的样式条目；省略的键取默认值
+ */
+export interface CompactStyle {
+  /** fontFamily */
+  f?: string;
+  /** fontSize */
+  fs?: number;
+  /** fontWeight (default 400) */
+  fw?: number;
+  /** fontStyle (default 'normal') */
+  st?: string;
+  /** color (default '#000000FF') */
+  c?: string;
+  /** backgroundColor (default '#00000000') */
+  bg?: string;
+  /** opacity (default 1) */
+  op?: number;
+  /** 
+   * textDecoration: underline, overline, lineThrough (default false),
+   * color (default: the style color), style (default 'solid'), thickness (default 1)
+   */
+  td?: { u?: boolean; o?: boolean; l?: boolean; c?: string; st?: string; th?: number };
+  /** letterSpacing (default 0) */
+  ls?: number;
+  /** wordSpacing (default 0) */
+  ws?: number;
+  /** transform as [scaleX, scaleY, skewX, skewY, rotate] (default identity) */
+  tf?: [number, number, number, number, number];
+  /** direction (default 'ltr') */
+  d?: string;
+  /** fontId */
+  id?: number;
+}
+
+/** 
+ * Character of the compact dialect
+ * 紧凑格式中的字符
+ */
+export interface CompactChar {
+  /** character */
+  c?: string;
+  x?: number;
+  y?: number;
+  /** width */
+  w?: number;
+  /** height */
+  h?: number;
+  /** baseline */
+  b?: number;
+  /** Index into `styles` (default 0) */
+  s?: number;
+}
+
+/** 
+ * Result of a parse with `compact: true`
+ * 使用 `compact: true` 解析的结果
+ * 
+ * `data` has the shape of the requested output mode with every character
+ * replaced by a `CompactChar`; full-mode runs carry `s` instead of their
+ * font and color properties unless `fields` leaves some of those out.
+ * `data` 保持所请求输出模式的结构，其中每个字符替换为 `CompactChar`；
+ * full 模式的 Run 以 `s` 代替字体和颜色属性。
+ */
+export interface CompactLayout<T = unknown> {
+  /** 
+   * Style table referenced by `CompactChar.s`
+   * 由 `CompactChar.s` 引用的样式表
+   */
+  styles: CompactStyle[];
+  /** 
+   * Layout data in the compact dialect
+   * 紧凑格式的布局数据
+   */
+  data: T;
+}
+
+/** 
+ * Layout of one width from parseMultiWidth()
+ * parseMultiWidth() 中单个宽度的布局结果
+ */
+export interface MultiWidthResult<T = CharLayout[]> {
+  /** 
+   * Viewport width in pixels
+   * 视口宽度（像素）
+   */
+  viewportWidth: number;
+  /** 
+   * Layout data for this width
+   * 该宽度下的布局数据
+   */
+  data: T;
+}
+
+/** 
+ * Options for measure() and measureBatch()
+ * measure() 与 measureBatch() 选项
+ */
+export interface MeasureOptions extends ComplexityLimits {
+  /** 
+   * Viewport width in pixels (required)
+   * 视口宽度（像素，必需）
+   */
+  viewportWidth: number;
+  /** 
+   * External CSS string to apply (shared by every item of a batch)
+   * 要应用的外部 CSS 字符串（批量时所有条目共用）
+   */
+  css?: string;
+  /** 
+   * Stop layout after this many text lines (default: no limit)
+   * 布局到指定行数后停止（默认：不限制）
+   */
+  maxLines?: number;
+  /** 
+   * Stop layout at this document height in pixels (default: no limit)
+   * 布局到指定文档高度（像素）后停止（默认：不限制）
+   */
+  maxHeight?: number;
+}
+
+/** 
+ * Border box of a top-level block
+ * 顶层块的边框盒
+ */
+export interface MeasuredBlock {
+  /** X coordinate / X 坐标 */
+  x: number;
+  /** Y coordinate / Y 坐标 */
+  y: number;
+  /** Width / 宽度 */
+  width: number;
+  /** Height / 高度 */
+  height: number;
+}
+
+/** 
+ * Document size measured without glyph output
+ * 不生成字符布局的文档尺寸测量结果
+ */
+export interface MeasureResult {
+  /** 
+   * Document width in pixels
+   * 文档宽度（像素）
+   */
+  width: number;
+  /** 
+   * Document height in pixels
+   * 文档高度（像素）
+   */
+  height: number;
+  /** 
+   * Number of non-empty text lines in the whole document
+   * 整个文档中非空文本行数
+   */
+  lineCount: number;
+  /** 
+   * True when layout stopped at maxLines / maxHeight
+   * 布局在 maxLines / maxHeight 处截断时为 true
+   */
+  truncated: boolean;
+  /** 
+   * Border boxes of the in-flow block children of <body>
+   * <body> 的常规流块级子元素的边框盒
+   */
+  blocks: MeasuredBlock[];
+}
+
+/** 
+ * Options for fitToBox()
+ * fitToBox() 选项
+ */
+export interface FitToBoxOptions extends ComplexityLimits {
+  /** 
+   * Box width in pixels, also used as the viewport width (required)
+   * 盒子宽度（像素，同时作为视口宽度，必需）
+   */
+  width: number;
+  /** 
+   * Box height in pixels (required)
+   * 盒子高度（像素，必需）
+   */
+  height: number;
+  /** 
+   * Smallest base font size to try in pixels (default: 8)
+   * 尝试的最小基准字号（像素，默认：8）
+   */
+  minSize?: number;
+  /** 
+   * Largest base font size to try in pixels (default: 72)
+   * 尝试的最大基准字号（像素，默认：72）
+   */
+  maxSize?: number;
+  /** 
+   * Only check the height; horizontal overflow is allowed (default: false)
+   * 仅检查高度，允许水平溢出（默认：false）
+   */
+  heightOnly?: boolean;
+  /** 
+   * Only sizes whose text fits in this many lines fit (default: no limit)
+   * 仅当文本不超过该行数时才算适配（默认：不限制）
+   * 
+   * When no size fits, the result at `minSize` is cut after these lines.
+   * 没有适配的字号时，`minSize` 下的结果在这些行之后截断。
+   */
+  maxLines?: number;
+  /** 
+   * Stop layout at this document height in pixels; cut text does not fit (default: no limit)
+   * 布局到指定文档高度（像素）后停止；被截断的文本不算适配（默认：不限制）
+   */
+  maxHeight?: number;
+  /** 
+   * End a truncated layout with an ellipsis (default: false)
+   * 截断时在最后一行末尾添加省略号（默认：false）
+   */
+  ellipsis?: boolean;
+  /** 
+   * External CSS string to apply
+   * 要应用的外部 CSS 字符串
+   */
+  css?: string;
+  /** 
+   * Output mode (default: 'flat')
+   * 输出模式（默认：'flat'）
+   */
+  mode?: OutputMode;
+  /** 
+   * Record backgrounds, borders, list markers and clips (default: false)
+   * 记录背景、边框、列表标记和裁剪（默认：false）
+   */
+  displayList?: boolean;
+}
+
+/** 
+ * Result of fitToBox()
+ * fitToBox() 结果
+ */
+export interface FitToBoxResult<T = CharLayout[]> {
+  /** 
+   * Chosen base font size in pixels (size of text without a font-size rule)
+   * 选定的基准字号（像素，即未设置 font-size 的文本字号）
+   */
+  fontSize: number;
+  /** 
+   * Factor applied to every computed font-size: fontSize / 16
+   * 应用于所有计算字号的系数：fontSize / 16
+   */
+  scale: number;
+  /** 
+   * False when the content overflows even at minSize
+   * 最小字号仍溢出时为 false
+   */
+  fits: boolean;
+  /** 
+   * Number of layout-only probes
+   * 仅布局探测次数
+   */
+  probes: number;
+  /** 
+   * Laid out document width in pixels
+   * 布局后文档宽度（像素）
+   */
+  width: number;
+  /** 
+   * Laid out document height in pixels
+   * 布局后文档高度（像素）
+   */
+  height: number;
+  /** 
+   * Layout data at the chosen size
+   * 选定字号下的布局数据
+   */
+  data: T;
+}
+
+/** 
+ * Template compile options
+ * 模板编译选项
+ * 
+ * The tree limits are checked when the template is compiled; `maxGlyphs`
+ * is a `layoutTemplate()` option.
+ * 树限制在编译模板时检查；`maxGlyphs` 是 `layoutTemplate()` 的选项。
+ */
+export interface TemplateOptions extends Omit<ComplexityLimits, 'maxGlyphs'> {
+  /** 
+   * Viewport width in pixels (required)
+   * 视口宽度（像素，必需）
+   */
+  viewportWidth: number;
+  /** 
+   * External CSS string to apply
+   * 要应用的外部 CSS 字符串
+   */
+  css?: string;
+}
+
+/** 
+ * Template layout options
+ * 模板布局选项
+ */
+export interface TemplateLayoutOptions extends Pick<ComplexityLimits, 'maxGlyphs'> {
+  /** 
+   * Output mode (default: 'flat')
+   * 输出模式（默认：'flat'）
+   */
+  mode?: OutputMode;
+  /** 
+   * Record backgrounds, borders, list markers and clips (default: false)
+   * 记录背景、边框、列表标记和裁剪（默认：false）
+   */
+  displayList?: boolean;
+  /** 
+   * Stop layout after this many text lines (default: no limit)
+   * 布局到指定行数后停止（默认：不限制）
+   */
+  maxLines?: number;
+  /** 
+   * Stop layout at this document height in pixels (default: no limit)
+   * 布局到指定文档高度（像素）后停止（默认：不限制）
+   */
+  maxHeight?: number;
+  /** 
+   * End a truncated layout with an ellipsis (default: false)
+   * 截断时在最后一行末尾添加省略号（默认：false）
+   */
+  ellipsis?: boolean;
+}
+
+/** 
+ * Slot values for a template layout
+ * 模板布局的插槽值
+ * 
+ * An array is matched to slots in document order; an object is matched by
+ * `data-slot` name. `null` or missing slots keep the template text.
+ * 数组按文档顺序对应插槽；对象按 `data-slot` 名称对应。
+ * `null` 或缺失的插槽保留模板文本。
+ */
+export type TemplateSlotValues = Array<string | null> | Record<string, string | null>;
+
+/** 
+ * Snapshot creation options
+ * 快照创建选项
+ * 
+ * `maxGlyphs` is a `parseSnapshot()` option.
+ * `maxGlyphs` 是 `parseSnapshot()` 的选项。
+ */
+export interface SnapshotOptions extends Omit<ComplexityLimits, 'maxGlyphs'> {
+  /** 
+   * Viewport width the styles are computed for (required)
+   * 计算样式所用的视口宽度（必需）
+   */
+  viewportWidth: number;
+  /** 
+   * External CSS string to apply
+   * 要应用的外部 CSS 字符串
+   */
+  css?: string;
+}
+
+/** 
+ * Snapshot layout options
+ * 快照布局选项
+ * 
+ * Same as `ParseOptions` without `css`; CSS was applied when the snapshot
+ * was created.
+ * 与 `ParseOptions` 相同但不含 `css`；CSS 已在创建快照时应用。
+ */
+export interface SnapshotParseOptions extends Omit<ParseOptions, 'viewportWidth' | 'css'> {
+  /** 
+   * Layout width in pixels (default: the width the snapshot was styled at)
+   * 布局宽度（像素，默认：快照计算样式时的宽度）
+   */
+  viewportWidth?: number;
 }
 
 /** 
@@ -1006,6 +1786,95 @@ export type ParseResult<T extends OutputMode = 'flat'> =
  */
 export type Environment = 'web' | 'worker' | 'node' | 'unknown';
 
+// =============================================================================
+// Worker Pool Types / Worker 池类型
+// =============================================================================
+
+/**
+ * Message endpoint used by the pool: a Web Worker, a Node.js `Worker`,
+ * the worker's own scope (`self` / `parentPort`) or a `MessagePort`
+ * 池使用的消息端点：Web Worker、Node.js `Worker`、Worker 自身作用域
+ * （`self` / `parentPort`）或 `MessagePort`
+ */
+export interface PoolPort {
+  postMessage(message: unknown, transfer?: ArrayBuffer[]): void;
+  /** Web style listener; `error` takes the worker out of the pool / Web 风格监听；`error` 会将 worker 移出池 */
+  addEventListener?(type: 'message' | 'error', listener: (event: { data?: unknown; message?: string }) => void): void;
+  /** Node.js style listener; `error` and `exit` take the worker out of the pool / Node.js 风格监听；`error` 与 `exit` 会将 worker 移出池 */
+  on?(event: 'message' | 'error' | 'exit', listener: (value: unknown) => void): unknown;
+  /** Called by `HtmlLayoutParserPool.destroy()` / 由 `destroy()` 调用 */
+  terminate?(): unknown;
+}
+
+/**
+ * Options for HtmlLayoutParserPool
+ * HtmlLayoutParserPool 选项
+ */
+export interface ParserPoolOptions {
+  /**
+   * Number of workers (default: 4)
+   * Worker 数量（默认：4）
+   */
+  size?: number;
+  /**
+   * Create worker `index`; the worker script must call `serveParserPool()`
+   * 创建第 `index` 个 worker；worker 脚本需调用 `serveParserPool()`
+   */
+  createWorker: (index: number) => PoolPort | Promise<PoolPort>;
+  /**
+   * Passed to `init()` of each worker's parser
+   * 传给每个 worker 中解析器的 `init()`
+   */
+  wasmPath?: string;
+}
+
+/**
+ * Parse result delivered by a pool worker as transferred bytes
+ * 池 worker 以转移字节形式返回的解析结果
+ */
+export interface PoolParseResult {
+  /** UTF-8 JSON output, null if the parse failed / UTF-8 JSON 输出，失败时为 null */
+  output: Uint8Array | null;
+  /** Display list bytes when `displayList: true` / 使用 `displayList: true` 时的绘制列表字节 */
+  displayList: Uint8Array | null;
+  /** Index of the worker that ran the parse / 执行解析的 worker 索引 */
+  worker: number;
+}
+
+/**
+ * Utilization of one pool worker
+ * 单个池 worker 的利用率
+ */
+export interface PoolWorkerMetrics {
+  /** Worker index / Worker 索引 */
+  index: number;
+  /** Requests sent and not yet answered / 已发送未完成的请求数 */
+  pending: number;
+  /** Requests completed, including font broadcasts / 已完成的请求数（含字体广播） */
+  completed: number;
+  /** Requests that failed / 失败的请求数 */
+  failed: number;
+  /** Time spent handling requests inside the worker (ms) / worker 内处理请求的耗时（毫秒） */
+  busyTime: number;
+  /** busyTime divided by the time since init() (0-1) / busyTime 与 init() 以来时长之比（0-1） */
+  utilization: number;
+}
+
+/**
+ * Parser driven by `serveParserPool()` inside a worker
+ * worker 中由 `serveParserPool()` 驱动的解析器
+ */
+export interface PoolParser {
+  init(wasmPath?: string): Promise<void>;
+  loadFont(fontData: Uint8Array, fontName: string): number;
+  unloadFont(fontId: number): void;
+  setDefaultFont(fontId: number): void;
+  clearAllFonts(): void;
+  parseToBuffer(html: string, options: ParseOptions): Uint8Array | null;
+  getDisplayListBuffer(): Uint8Array | null;
+  destroy(): void;
+}
+
 // =============================================================================
 // WASM Module Types / WASM 模块类型
 // =============================================================================
@@ -1084,6 +1953,19 @@ export interface HtmlLayoutParserModule {
     modePtr: number,
     optionsPtr: number
   ): number;
+  /** 
+   * Parse HTML whose html and css byte lengths are passed explicitly
+   * 使用显式字节长度（html 与 css）解析 HTML
+   */
+  _parseHTMLSized(
+    htmlPtr: number,
+    htmlLen: number,
+    cssPtr: number,
+    cssLen: number,
+    viewportWidth: number,
+    modePtr: number,
+    optionsPtr: number
+  ): number;
   /** 
    * Parse HTML with full diagnostics
    * 解析 HTML 并返回完整诊断信息
@@ -1095,11 +1977,126 @@ export interface HtmlLayoutParserModule {
     modePtr: number,
     optionsPtr: number
   ): number;
+  /** 
+   * Parse HTML and pass the output to onParseChunk in chunks
+   * 解析 HTML 并将输出分块交给 onParseChunk
+   */
+  _parseHTMLStream?(
+    htmlPtr: number,
+    cssPtr: number,
+    viewportWidth: number,
+    modePtr: number,
+    optionsPtr: number,
+    chunkSize: number
+  ): number;
+  /** 
+   * Chunk receiver used by _parseHTMLStream; the bytes are only valid during the call
+   * _parseHTMLStream 使用的分块接收函数；字节仅在调用期间有效
+   */
+  onParseChunk?: (ptr: number, size: number) => boolean | void;
   /** 
    * Get last parse result with diagnostics
    * 获取上次解析结果（带诊断信息）
    */
   _getLastParseResult(): number;
+  /** 
+   * Parse once and lay out at several widths (widthsPtr points to int32 values)
+   * 一次解析并按多个宽度布局（widthsPtr 指向 int32 数组）
+   */
+  _parseHTMLMultiWidth?(
+    htmlPtr: number,
+    cssPtr: number,
+    widthsPtr: number,
+    widthCount: number,
+    modePtr: number,
+    optionsPtr: number
+  ): number;
+  /** 
+   * Measure HTML without glyph output
+   * 仅测量 HTML 尺寸（不生成字符布局）
+   */
+  _measureHTML?(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  /** 
+   * Measure a batch of HTML documents (htmlPtrsPtr points to itemCount string pointers)
+   * 批量测量 HTML 文档（htmlPtrsPtr 指向 itemCount 个字符串指针）
+   */
+  _measureHTMLBatch?(htmlPtrsPtr: number, itemCount: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  /** 
+   * Parse a batch of HTML documents (htmlPtrsPtr points to itemCount string pointers)
+   * 批量解析 HTML 文档（htmlPtrsPtr 指向 itemCount 个字符串指针）
+   */
+  _parseHTMLBatch?(
+    htmlPtrsPtr: number,
+    itemCount: number,
+    cssPtr: number,
+    viewportWidth: number,
+    modePtr: number,
+    optionsPtr: number
+  ): number;
+  /** 
+   * Find the largest base font size at which HTML fits in a box
+   * 求 HTML 适配盒子的最大基准字号
+   */
+  _fitToBox?(
+    htmlPtr: number,
+    cssPtr: number,
+    boxWidth: number,
+    boxHeight: number,
+    minSize: number,
+    maxSize: number,
+    modePtr: number,
+    optionsPtr: number
+  ): number;
+  /** 
+   * Compile a template with data-slot text slots, returns handle (0 on failure)
+   * 编译带 data-slot 文本插槽的模板，返回句柄（失败为 0）
+   */
+  _compileTemplate?(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  /** 
+   * Lay out a compiled template with slot values JSON
+   * 使用插槽值 JSON 布局已编译模板
+   */
+  _layoutTemplate?(handle: number, valuesPtr: number, modePtr: number, optionsPtr: number): number;
+  /** 
+   * Get template slot names as JSON
+   * 获取模板插槽名称（JSON 格式）
+   */
+  _getTemplateSlots?(handle: number): number;
+  /** 
+   * Destroy a compiled template
+   * 销毁已编译模板
+   */
+  _destroyTemplate?(handle: number): void;
+  /** 
+   * Parse and style HTML into a snapshot, returns its size (0 on failure)
+   * 解析 HTML 并计算样式生成快照，返回其大小（失败为 0）
+   */
+  _createSnapshot?(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  /** 
+   * Get pointer to the last created snapshot (0 if none)
+   * 获取上次创建的快照指针（无则为 0）
+   */
+  _getSnapshot?(): number;
+  /** 
+   * Get byte length of the last created snapshot
+   * 获取上次创建的快照字节数
+   */
+  _getSnapshotSize?(): number;
+  /** 
+   * Lay out a document loaded from snapshot bytes
+   * 从快照字节加载文档并布局
+   */
+  _parseSnapshot?(snapshotPtr: number, snapshotSize: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  /** 
+   * Get pointer to the last recorded display list (0 if none)
+   * 获取上次记录的绘制列表指针（无则为 0）
+   */
+  _getDisplayList(): number;
+  /** 
+   * Get byte length of the last recorded display list
+   * 获取上次记录的绘制列表字节数
+   */
+  _getDisplayListSize(): number;
   /** 
    * Free string allocated by C++
    * 释放 C++ 分配的字符串
@@ -1145,6 +2142,26 @@ export interface HtmlLayoutParserModule {
    * 获取当前调试模式状态（0 = 关，1 = 开）
    */
   _getDebugMode(): number;
+  /** 
+   * Get cache statistics as JSON
+   * 获取缓存统计（JSON 格式）
+   */
+  _getCacheStats?(): number;
+  /** 
+   * Reset cache statistics counters
+   * 重置缓存统计计数器
+   */
+  _resetCacheStats?(): void;
+  /** 
+   * Clear font metrics and layout result caches
+   * 清除字体度量缓存和布局结果缓存
+   */
+  _clearCache?(): void;
+  /** 
+   * Set the layout result cache byte budget (0 disables)
+   * 设置布局结果缓存字节预算（0 表示禁用）
+   */
+  _setResultCacheBudget?(maxBytes: number): void;
 }
 
 /** 
@@ -1166,3 +2183,64 @@ export type EmscriptenModule = HtmlLayoutParserModule;
  * 模块工厂函数类型
  */
 export type ModuleFactory = CreateHtmlLayoutParserModule;
+
+/**
+ * Input accepted by the native addon: a string, or UTF-8 bytes read in place
+ * 原生插件接受的输入：字符串，或原地读取的 UTF-8 字节
+ */
+export type NativeInput = string | Uint8Array;
+
+/**
+ * Node.js N-API addon interface (html_layout_parser.node)
+ * Node.js N-API 原生插件接口
+ * 
+ * Mirrors the WASM exports; strings are passed and returned directly instead
+ * of through heap pointers.
+ * 与 WASM 导出一一对应；字符串直接传入和返回，不经过堆指针。
+ * 
+ * @internal This interface is for internal use only
+ * @internal 此接口仅供内部使用
+ */
+export interface HtmlLayoutParserAddon {
+  setDebugMode(isDebug: boolean): void;
+  getDebugMode(): boolean;
+  loadFont(fontData: Uint8Array, fontName: string): number;
+  unloadFont(fontId: number): void;
+  setDefaultFont(fontId: number): void;
+  getLoadedFonts(): string;
+  clearAllFonts(): void;
+  parseHTML(html: NativeInput, css: string | null, viewportWidth: number, mode: string, optionsJson: string | null): string;
+  /** Runs on the libuv threadpool / 在 libuv 线程池中运行 */
+  parseHTMLAsync(html: NativeInput, css: string | null, viewportWidth: number, mode: string, optionsJson: string | null): Promise<string>;
+  parseHTMLStream(
+    html: NativeInput, css: string | null, viewportWidth: number, mode: string, optionsJson: string | null,
+    chunkSize: number, onChunk: (chunk: string) => boolean | void
+  ): boolean;
+  parseHTMLWithDiagnostics(html: NativeInput, css: string | null, viewportWidth: number, mode: string, optionsJson: string | null): string;
+  parseHTMLMultiWidth(html: NativeInput, css: string | null, widths: number[], mode: string, optionsJson: string | null): string;
+  fitToBox(html: NativeInput, css: string | null, width: number, height: number, minSize: number, maxSize: number, mode: string, optionsJson: string | null): string;
+  measureHTML(html: NativeInput, css: string | null, viewportWidth: number, optionsJson: string | null): string;
+  /** Runs on the libuv threadpool / 在 libuv 线程池中运行 */
+  measureHTMLAsync(html: NativeInput, css: string | null, viewportWidth: number, optionsJson: string | null): Promise<string>;
+  measureHTMLBatch(items: NativeInput[], css: string | null, viewportWidth: number, optionsJson: string | null): string;
+  parseHTMLBatch(items: NativeInput[], css: string | null, viewportWidth: number, mode: string, optionsJson: string | null): string;
+  getDisplayList(): Uint8Array | null;
+  getLastParseResult(): string;
+  compileTemplate(html: NativeInput, css: string | null, viewportWidth: number, optionsJson: string | null): number;
+  layoutTemplate(handle: number, slotValuesJson: string, mode: string, optionsJson: string | null): string;
+  getTemplateSlots(handle: number): string;
+  destroyTemplate(handle: number): void;
+  createSnapshot(html: NativeInput, css: string | null, viewportWidth: number, optionsJson: string | null): Uint8Array | null;
+  parseSnapshot(snapshot: Uint8Array, viewportWidth: number, mode: string, optionsJson: string | null): string;
+  destroy(): void;
+  getTotalMemoryUsage(): number;
+  checkMemoryThreshold(): boolean;
+  getMemoryMetrics(): string;
+  getVersion(): string;
+  getMetrics(): string;
+  getDetailedMetrics(): string;
+  getCacheStats(): string;
+  resetCacheStats(): void;
+  clearCache(): void;
+  setResultCacheBudget(maxBytes: number): void;
+}
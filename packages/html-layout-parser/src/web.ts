@@ -27,6 +27,9 @@ import type { CreateHtmlLayoutParserModule } from './types';
 // Re-export all types
 export * from './types';
 export { BaseParser as HtmlLayoutParserBase };
+export { decodeDisplayList } from './display-list';
+export { expandCompactLayout } from './compact-layout';
+export { HtmlLayoutParserPool } from './pool';
 
 /**
  * HTML Layout Parser for Web browser environment
@@ -49,6 +49,9 @@ import type { CreateHtmlLayoutParserModule } from './types';
 // Re-export all types
 export * from './types';
 export { BaseParser as HtmlLayoutParserBase };
+export { decodeDisplayList } from './display-list';
+export { expandCompactLayout } from './compact-layout';
+export { serveParserPool } from './pool';
 
 // Web Worker type declaration
 declare const self: typeof globalThis & {
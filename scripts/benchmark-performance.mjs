@@ -1,14 +1,17 @@
 #!/usr/bin/env node
-import { readFileSync, existsSync } from 'fs';
-import { join, dirname } from 'path';
+import { readFileSync, existsSync, statSync } from 'fs';
+import { join, dirname, resolve } from 'path';
 import { fileURLToPath } from 'url';
 import { createRequire } from 'module';
 import { Script } from 'node:vm';
+import { Worker, isMainThread, parentPort } from 'worker_threads';
+import { cpus } from 'os';
 
 const __dirname = dirname(fileURLToPath(import.meta.url));
 const rootDir = join(__dirname, '..');
-const wasmJsPath = join(rootDir, 'wasm-output', 'html_layout_parser.js');
+const defaultWasmJsPath = join(rootDir, 'wasm-output', 'html_layout_parser.js');
 const fontPath = join(rootDir, 'examples', 'font', 'aliBaBaFont65.ttf');
+const nativeAddonPath = join(rootDir, 'native-output', 'html_layout_parser.node');
 
 function parseArgs(argv) {
   const args = {
@@ -16,6 +19,8 @@ function parseArgs(argv) {
     iterations: 30,
     mode: 'flat',
     viewport: 800,
+    suite: 'basic',
+    wasm: defaultWasmJsPath,
   };
 
   for (const arg of argv) {
@@ -27,6 +32,11 @@ function parseArgs(argv) {
       args.mode = arg.split('=')[1];
     } else if (arg.startsWith('--viewport=')) {
       args.viewport = Number(arg.split('=')[1]);
+    } else if (arg.startsWith('--suite=')) {
+      args.suite = arg.split('=')[1];
+    } else if (arg.startsWith('--wasm=')) {
+      // Alternate build (e.g. ./build.sh --wasm-exceptions output) to compare variants
+      args.wasm = resolve(arg.slice('--wasm='.length));
     }
   }
 
@@ -51,6 +61,9 @@ function formatInt(value) {
   return Number(value).toFixed(0);
 }
 
+const args = parseArgs(process.argv.slice(2));
+const wasmJsPath = args.wasm;
+
 if (!existsSync(wasmJsPath)) {
   console.error(
     `WASM module not found at ${wasmJsPath}. ` +
@@ -64,8 +77,6 @@ if (!existsSync(fontPath)) {
   process.exit(1);
 }
 
-const args = parseArgs(process.argv.slice(2));
-
 // Run the UMD bundle in a CommonJS-like wrapper so module.exports is populated.
 function loadWasmFactory(filePath) {
   const source = readFileSync(filePath, 'utf8');
@@ -117,10 +128,14 @@ function loadFont(fontData, fontName) {
   }
 }
 
-function parseHTML(html, viewportWidth, mode, css) {
+// Returns the byte length of the serialized result and, with `decode`,
+// the time to read it into JS and JSON.parse it; with `keepBytes` a copy of
+// the output that can be transferred to another thread
+function parseHTML(html, viewportWidth, mode, css, parseOptions, decode = false, keepBytes = false) {
   let htmlPtr = 0;
   let modePtr = 0;
   let cssPtr = 0;
+  let optionsPtr = 0;
 
   try {
     htmlPtr = mallocString(html);
@@ -128,11 +143,24 @@ function parseHTML(html, viewportWidth, mode, css) {
     if (css) {
       cssPtr = mallocString(css);
     }
+    if (parseOptions) {
+      optionsPtr = mallocString(JSON.stringify(parseOptions));
+    }
 
-    const resultPtr = module._parseHTML(htmlPtr, cssPtr, viewportWidth, modePtr, 0);
-    if (resultPtr !== 0) {
-      module._freeString(resultPtr);
+    const resultPtr = module._parseHTML(htmlPtr, cssPtr, viewportWidth, modePtr, optionsPtr);
+    if (resultPtr === 0) {
+      return { outputBytes: 0, decodeTime: 0, output: null };
     }
+    const outputBytes = module.HEAPU8.indexOf(0, resultPtr) - resultPtr;
+    let decodeTime = 0;
+    if (decode) {
+      const decodeStart = performance.now();
+      JSON.parse(module.UTF8ToString(resultPtr));
+      decodeTime = performance.now() - decodeStart;
+    }
+    const output = keepBytes ? module.HEAPU8.slice(resultPtr, resultPtr + outputBytes) : null;
+    module._freeString(resultPtr);
+    return { outputBytes, decodeTime, output };
   } finally {
     if (htmlPtr) {
       module._free(htmlPtr);
@@ -143,7 +171,278 @@ function parseHTML(html, viewportWidth, mode, css) {
     if (cssPtr) {
       module._free(cssPtr);
     }
+    if (optionsPtr) {
+      module._free(optionsPtr);
+    }
+  }
+}
+
+// Same call as the TS wrapper makes: the arguments are encoded back to back
+// into a grow-only staging buffer and passed to parseHTMLSized with their
+// lengths, so nothing is malloc'ed, measured or strlen'ed per call
+const staging = { ptr: 0, size: 0 };
+const encoder = new TextEncoder();
+
+// Short ASCII strings are copied in a loop, cheaper than encodeInto's fixed cost
+function encodeUTF8Into(value, start, capacity) {
+  const heap = module.HEAPU8;
+  if (value.length <= 64) {
+    let i = 0;
+    while (i < value.length && value.charCodeAt(i) < 0x80) {
+      heap[start + i] = value.charCodeAt(i);
+      i += 1;
+    }
+    if (i === value.length) {
+      return i;
+    }
   }
+  const { read, written } = encoder.encodeInto(value, heap.subarray(start, start + capacity));
+  return read === value.length ? written : -1;
+}
+
+function stageStrings(values) {
+  const staged = [];
+  let used = 0;
+  for (const value of values) {
+    for (;;) {
+      const free = staging.size - used - 1;
+      const written = free >= value.length ? encodeUTF8Into(value, staging.ptr + used, free) : -1;
+      if (written >= 0) {
+        module.HEAPU8[staging.ptr + used + written] = 0;
+        staged.push({ offset: used, length: written });
+        used += written + 1;
+        break;
+      }
+      const size = Math.max(used + module.lengthBytesUTF8(value) + 1, staging.size * 2, 64 * 1024);
+      const ptr = module._malloc(size);
+      if (ptr === 0) {
+        throw new Error('Failed to allocate the staging buffer');
+      }
+      if (staging.ptr) {
+        module.HEAPU8.copyWithin(ptr, staging.ptr, staging.ptr + used);
+        module._free(staging.ptr);
+      }
+      staging.ptr = ptr;
+      staging.size = size;
+    }
+  }
+  return staged.map(({ offset, length }) => ({ ptr: staging.ptr + offset, length }));
+}
+
+function parseHTMLStaged(html, viewportWidth, mode, css, parseOptions) {
+  const optionsJson = parseOptions ? JSON.stringify(parseOptions) : '';
+  const [htmlArg, cssArg, modeArg, optionsArg] = stageStrings([html, css ?? '', mode, optionsJson]);
+  const resultPtr = module._parseHTMLSized(htmlArg.ptr, htmlArg.length, css ? cssArg.ptr : 0, cssArg.length,
+    viewportWidth, modeArg.ptr, optionsJson ? optionsArg.ptr : 0);
+  if (resultPtr !== 0) {
+    module._freeString(resultPtr);
+  }
+}
+
+// Streams the result in chunkSize pieces; with `decode` the chunks are joined
+// and JSON.parsed once the stream ends, as a consumer needing the object would
+function parseHTMLStream(html, viewportWidth, mode, css, parseOptions, chunkSize, decode = false) {
+  const htmlPtr = mallocString(html);
+  const modePtr = mallocString(mode);
+  const cssPtr = css ? mallocString(css) : 0;
+  const optionsPtr = parseOptions ? mallocString(JSON.stringify(parseOptions)) : 0;
+  const decoder = new TextDecoder();
+  const chunks = [];
+  const startTime = performance.now();
+  let firstChunkTime = 0;
+  let outputBytes = 0;
+  module.onParseChunk = (ptr, size) => {
+    if (outputBytes === 0) {
+      firstChunkTime = performance.now() - startTime;
+    }
+    outputBytes += size;
+    if (decode) {
+      chunks.push(decoder.decode(module.HEAPU8.subarray(ptr, ptr + size)));
+    }
+  };
+
+  try {
+    module._parseHTMLStream(htmlPtr, cssPtr, viewportWidth, modePtr, optionsPtr, chunkSize);
+    let decodeTime = 0;
+    if (decode) {
+      const decodeStart = performance.now();
+      JSON.parse(chunks.join(''));
+      decodeTime = performance.now() - decodeStart;
+    }
+    return { outputBytes, decodeTime, firstChunkTime };
+  } finally {
+    module.onParseChunk = undefined;
+    module._free(htmlPtr);
+    module._free(modePtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+    if (optionsPtr) {
+      module._free(optionsPtr);
+    }
+  }
+}
+
+function compileTemplate(html, viewportWidth, css) {
+  const htmlPtr = mallocString(html);
+  const cssPtr = css ? mallocString(css) : 0;
+  try {
+    return module._compileTemplate(htmlPtr, cssPtr, viewportWidth);
+  } finally {
+    module._free(htmlPtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+  }
+}
+
+function layoutTemplate(handle, values, mode) {
+  const valuesPtr = mallocString(JSON.stringify(values));
+  const modePtr = mallocString(mode);
+  try {
+    const resultPtr = module._layoutTemplate(handle, valuesPtr, modePtr, 0);
+    if (resultPtr !== 0) {
+      module._freeString(resultPtr);
+    }
+  } finally {
+    module._free(valuesPtr);
+    module._free(modePtr);
+  }
+}
+
+// Returns a malloc'd copy of the snapshot bytes, as if read from a cache
+function createSnapshot(html, viewportWidth, css) {
+  const htmlPtr = mallocString(html);
+  const cssPtr = css ? mallocString(css) : 0;
+  try {
+    const size = module._createSnapshot(htmlPtr, cssPtr, viewportWidth);
+    if (size <= 0) {
+      return null;
+    }
+    const ptr = module._malloc(size);
+    module.HEAPU8.copyWithin(ptr, module._getSnapshot(), module._getSnapshot() + size);
+    return { ptr, size };
+  } finally {
+    module._free(htmlPtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+  }
+}
+
+function parseSnapshot(snapshot, mode) {
+  const modePtr = mallocString(mode);
+  try {
+    const resultPtr = module._parseSnapshot(snapshot.ptr, snapshot.size, 0, modePtr, 0);
+    if (resultPtr !== 0) {
+      module._freeString(resultPtr);
+    }
+  } finally {
+    module._free(modePtr);
+  }
+}
+
+function parseHTMLMultiWidth(html, widths, mode, css) {
+  const htmlPtr = mallocString(html);
+  const modePtr = mallocString(mode);
+  const cssPtr = css ? mallocString(css) : 0;
+  const widthsPtr = module._malloc(widths.length * 4);
+  try {
+    new Int32Array(module.HEAPU8.buffer, widthsPtr, widths.length).set(widths);
+    const resultPtr = module._parseHTMLMultiWidth(htmlPtr, cssPtr, widthsPtr, widths.length, modePtr, 0);
+    if (resultPtr !== 0) {
+      module._freeString(resultPtr);
+    }
+  } finally {
+    module._free(htmlPtr);
+    module._free(modePtr);
+    module._free(widthsPtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+  }
+}
+
+function measureHTMLBatch(items, viewportWidth, css) {
+  const itemPtrs = items.map(mallocString);
+  const ptrsPtr = module._malloc(items.length * 4);
+  const cssPtr = css ? mallocString(css) : 0;
+  try {
+    new Int32Array(module.HEAPU8.buffer, ptrsPtr, items.length).set(itemPtrs);
+    const resultPtr = module._measureHTMLBatch(ptrsPtr, items.length, cssPtr, viewportWidth, 0);
+    if (resultPtr !== 0) {
+      module._freeString(resultPtr);
+    }
+  } finally {
+    itemPtrs.forEach((ptr) => module._free(ptr));
+    module._free(ptrsPtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+  }
+}
+
+function fitToBox(html, css, box) {
+  const htmlPtr = mallocString(html);
+  const modePtr = mallocString(args.mode);
+  const cssPtr = css ? mallocString(css) : 0;
+  try {
+    const resultPtr = module._fitToBox(htmlPtr, cssPtr, box.width, box.height, box.minSize, box.maxSize, modePtr, 0);
+    if (resultPtr !== 0) {
+      module._freeString(resultPtr);
+    }
+  } finally {
+    module._free(htmlPtr);
+    module._free(modePtr);
+    if (cssPtr) {
+      module._free(cssPtr);
+    }
+  }
+}
+
+// The JS-side search fitToBox replaces: one full parse per probed root font size
+function fitByParsing(html, css, box) {
+  const sum = { parseTime: 0, layoutTime: 0, serializeTime: 0, totalTime: 0, characterCount: 0 };
+  const fits = (size) => {
+    const htmlPtr = mallocString(html);
+    const modePtr = mallocString('flat');
+    const cssPtr = mallocString(`${css ?? ''} html { font-size: ${size}px }`);
+    let bottom = 0;
+    try {
+      const resultPtr = module._parseHTML(htmlPtr, cssPtr, box.width, modePtr, 0);
+      if (resultPtr !== 0) {
+        for (const char of JSON.parse(module.UTF8ToString(resultPtr))) {
+          bottom = Math.max(bottom, char.y + char.height);
+        }
+        module._freeString(resultPtr);
+      }
+    } finally {
+      module._free(htmlPtr);
+      module._free(modePtr);
+      module._free(cssPtr);
+    }
+    const metrics = getMetrics();
+    for (const key of Object.keys(sum)) {
+      sum[key] += metrics?.[key] ?? 0;
+    }
+    return bottom <= box.height;
+  };
+
+  let lo = box.minSize;
+  let hi = box.maxSize;
+  if (fits(hi)) {
+    return sum;
+  }
+  while (hi - lo > 1) {
+    const mid = Math.floor((lo + hi) / 2);
+    if (fits(mid)) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  fits(lo);
+  return sum;
 }
 
 function getMetrics() {
@@ -162,9 +461,202 @@ function getMetrics() {
   }
 }
 
-function runBenchmarkCase(label, html) {
-  for (let i = 0; i < args.warmup; i += 1) {
-    parseHTML(html, args.viewport, args.mode);
+// Native addon (./build-node.sh), loaded only by the native and serialize suites
+let addon = null;
+
+function loadNativeAddon(fontData) {
+  if (!existsSync(nativeAddonPath)) {
+    console.error(`Native addon not found at ${nativeAddonPath}. Please run ./build-node.sh first.`);
+    process.exit(1);
+  }
+  addon = createRequire(import.meta.url)(nativeAddonPath);
+  const nativeFontId = addon.loadFont(fontData, 'BenchmarkFont');
+  if (!nativeFontId) {
+    console.error('Failed to load benchmark font into the native addon.');
+    process.exit(1);
+  }
+  addon.setDefaultFont(nativeFontId);
+}
+
+function getNativeMetrics() {
+  try {
+    return JSON.parse(addon.getMetrics());
+  } catch {
+    return null;
+  }
+}
+
+// Pool suite: the script re-runs itself in worker_threads, one WASM instance
+// per worker, and each parse result comes back as a transferred byte buffer
+const poolWorkers = new Map();
+
+function servePoolRequests() {
+  parentPort.on('message', ({ id, html, css, parseOptions }) => {
+    const start = performance.now();
+    const { output } = parseHTML(html, args.viewport, args.mode, css, parseOptions, false, true);
+    const metrics = getMetrics();
+    const busyTime = performance.now() - start;
+    parentPort.postMessage({ id, output, metrics, busyTime }, output ? [output.buffer] : []);
+  });
+  parentPort.postMessage({ ready: true });
+}
+
+async function startPoolWorkers(size) {
+  if (poolWorkers.has(size)) {
+    return poolWorkers.get(size);
+  }
+  const workers = await Promise.all(Array.from({ length: size }, () => new Promise((resolve, reject) => {
+    const worker = new Worker(fileURLToPath(import.meta.url), { argv: process.argv.slice(2) });
+    const state = { worker, pending: new Map(), nextId: 1, busyTime: 0 };
+    worker.on('message', (reply) => {
+      if (reply.ready) {
+        resolve(state);
+        return;
+      }
+      state.busyTime += reply.busyTime;
+      state.pending.get(reply.id)(reply);
+      state.pending.delete(reply.id);
+    });
+    worker.on('error', reject);
+  })));
+  poolWorkers.set(size, workers);
+  return workers;
+}
+
+// Sends every item to the worker with the fewest pending requests and sums
+// the per-parse metrics; busyTime is the total time workers spent parsing
+async function parseOnPool(workers, items, css, parseOptions) {
+  const sum = { parseTime: 0, layoutTime: 0, serializeTime: 0, totalTime: 0, characterCount: 0, busyTime: 0 };
+  await Promise.all(items.map((html) => {
+    const state = workers.reduce((best, w) => (w.pending.size < best.pending.size ? w : best));
+    const id = state.nextId++;
+    return new Promise((resolve) => {
+      state.pending.set(id, resolve);
+      state.worker.postMessage({ id, html, css, parseOptions });
+    }).then(({ metrics, busyTime }) => {
+      for (const key of ['parseTime', 'layoutTime', 'serializeTime', 'totalTime', 'characterCount']) {
+        sum[key] += metrics?.[key] ?? 0;
+      }
+      sum.busyTime += busyTime;
+    });
+  }));
+  return sum;
+}
+
+async function runBenchmarkCase(label, html, css, options = {}) {
+  const warmup = Math.min(args.warmup, options.maxWarmup ?? args.warmup);
+  const iterations = Math.min(args.iterations, options.maxIterations ?? args.iterations);
+
+  // Cache cases keep the budget for the case only; warmup fills the cache
+  module._setResultCacheBudget(options.resultCacheBudget ?? 0);
+
+  // Template cases compile `html` once and lay out options.slotValues(i) per run;
+  // snapshot cases create a snapshot of `html` once and lay it out per run;
+  // width cases lay out every options.widths entry per run, either in one
+  // parseHTMLMultiWidth call or (options.separateWidths) one parseHTML each;
+  // fit cases search the font size for options.fitBox, natively or by parsing;
+  // item cases process the `html` array, measured in one batch or parsed one by one
+  // (options.staged: through the staging buffer and parseHTMLSized), or natively
+  // in one pipelined parseHTMLBatch call;
+  // native cases call the addon instead of WASM; options.concurrency queues that
+  // many parseHTMLAsync calls on the libuv threadpool per run;
+  // stream cases deliver the output in options.stream byte chunks;
+  // pool cases spread the `html` array over options.pool worker threads;
+  // other cases accept html as a function of the run index to vary content
+  let templateHandle = 0;
+  let snapshot = null;
+  let outputBytes = 0;
+  let decodeTime = 0;
+  let firstChunkTime = 0;
+  let poolBusyTime = 0;
+  let stageOccupancy = null;
+  const workers = options.pool ? await startPoolWorkers(options.pool) : null;
+  if (options.slotValues) {
+    templateHandle = compileTemplate(html, args.viewport, css);
+    if (!templateHandle) {
+      throw new Error(`Failed to compile template for ${label}`);
+    }
+  }
+  if (options.snapshot) {
+    snapshot = createSnapshot(html, args.viewport, css);
+    if (!snapshot) {
+      throw new Error(`Failed to create snapshot for ${label}`);
+    }
+    outputBytes = snapshot.size;
+  }
+  const run = (i) => {
+    if (workers) {
+      return parseOnPool(workers, html, css, options.parseOptions).then((sum) => {
+        poolBusyTime = sum.busyTime;
+        return sum;
+      });
+    } else if (options.backend === 'native' && options.concurrency) {
+      const parses = Array.from({ length: options.concurrency }, () =>
+        addon.parseHTMLAsync(html, css ?? null, args.viewport, args.mode, null));
+      return Promise.all(parses).then(getNativeMetrics);
+    } else if (options.backend === 'native' && options.items === 'batch') {
+      const optionsJson = options.parseOptions ? JSON.stringify(options.parseOptions) : null;
+      addon.parseHTMLBatch(html, css ?? null, args.viewport, args.mode, optionsJson);
+      const metrics = getNativeMetrics();
+      stageOccupancy = metrics?.stageOccupancy ?? null;
+      return metrics;
+    } else if (options.backend === 'native') {
+      const optionsJson = options.parseOptions ? JSON.stringify(options.parseOptions) : null;
+      addon.parseHTML(html, css ?? null, args.viewport, args.mode, optionsJson);
+      return getNativeMetrics();
+    } else if (templateHandle) {
+      layoutTemplate(templateHandle, options.slotValues(i), args.mode);
+    } else if (snapshot) {
+      parseSnapshot(snapshot, args.mode);
+    } else if (options.widths && options.separateWidths) {
+      const sum = { parseTime: 0, layoutTime: 0, serializeTime: 0, totalTime: 0, characterCount: 0 };
+      for (const width of options.widths) {
+        parseHTML(html, width, args.mode, css, options.parseOptions);
+        const metrics = getMetrics();
+        for (const key of Object.keys(sum)) {
+          sum[key] += metrics?.[key] ?? 0;
+        }
+      }
+      return sum;
+    } else if (options.items === 'parse') {
+      const sum = { parseTime: 0, layoutTime: 0, serializeTime: 0, totalTime: 0, characterCount: 0 };
+      for (const item of html) {
+        if (options.staged) {
+          parseHTMLStaged(item, args.viewport, args.mode, css, options.parseOptions);
+        } else {
+          parseHTML(item, args.viewport, args.mode, css, options.parseOptions);
+        }
+        const metrics = getMetrics();
+        for (const key of Object.keys(sum)) {
+          sum[key] += metrics?.[key] ?? 0;
+        }
+      }
+      return sum;
+    } else if (options.items === 'measure') {
+      measureHTMLBatch(html, args.viewport, css);
+    } else if (options.stream) {
+      const output = parseHTMLStream(html, args.viewport, args.mode, css, options.parseOptions, options.stream,
+        options.decode);
+      outputBytes = output.outputBytes;
+      decodeTime = output.decodeTime;
+      firstChunkTime = output.firstChunkTime;
+    } else if (options.fitBox && options.fitByParsing) {
+      return fitByParsing(html, css, options.fitBox);
+    } else if (options.fitBox) {
+      fitToBox(html, css, options.fitBox);
+    } else if (options.widths) {
+      parseHTMLMultiWidth(html, options.widths, args.mode, css);
+    } else {
+      const output = parseHTML(typeof html === 'function' ? html(i) : html, args.viewport, args.mode, css,
+        options.parseOptions, options.decode);
+      outputBytes = output.outputBytes;
+      decodeTime = output.decodeTime;
+    }
+    return getMetrics();
+  };
+
+  for (let i = 0; i < warmup; i += 1) {
+    await run(i);
   }
 
   const totals = {
@@ -172,30 +664,56 @@ function runBenchmarkCase(label, html) {
     layoutTime: 0,
     serializeTime: 0,
     totalTime: 0,
+    decodeTime: 0,
+    firstChunkTime: 0,
   };
   let characterCount = 0;
+  let peakMemory = 0;
+  let wallTime = 0;
+  let busyTime = 0;
+  let nativeTime = 0;
 
-  for (let i = 0; i < args.iterations; i += 1) {
-    parseHTML(html, args.viewport, args.mode);
-    const metrics = getMetrics();
+  for (let i = 0; i < iterations; i += 1) {
+    // wallClock cases time the whole call, including JS <-> module string transfer
+    const startTime = performance.now();
+    let metrics = await run(warmup + i);
     if (!metrics) {
       throw new Error('Failed to read metrics from WASM module');
     }
+    nativeTime += metrics.totalTime;
+    if (options.wallClock) {
+      metrics = { ...metrics, totalTime: performance.now() - startTime };
+    }
+    wallTime += performance.now() - startTime;
+    busyTime += poolBusyTime;
 
     characterCount = metrics.characterCount;
+    peakMemory = Math.max(peakMemory, metrics.peakMemory ?? 0);
     totals.parseTime += metrics.parseTime;
     totals.layoutTime += metrics.layoutTime;
     totals.serializeTime += metrics.serializeTime;
     totals.totalTime += metrics.totalTime;
+    totals.decodeTime += decodeTime;
+    totals.firstChunkTime += firstChunkTime;
   }
 
   const avg = {
-    parseTime: totals.parseTime / args.iterations,
-    layoutTime: totals.layoutTime / args.iterations,
-    serializeTime: totals.serializeTime / args.iterations,
-    totalTime: totals.totalTime / args.iterations,
+    parseTime: totals.parseTime / iterations,
+    layoutTime: totals.layoutTime / iterations,
+    serializeTime: totals.serializeTime / iterations,
+    totalTime: totals.totalTime / iterations,
+    decodeTime: totals.decodeTime / iterations,
+    firstChunkTime: totals.firstChunkTime / iterations,
   };
 
+  module._setResultCacheBudget(0);
+  if (templateHandle) {
+    module._destroyTemplate(templateHandle);
+  }
+  if (snapshot) {
+    module._free(snapshot.ptr);
+  }
+
   const avgCharsPerSecond = characterCount > 0
     ? (characterCount * 1000) / avg.totalTime
     : 0;
@@ -205,6 +723,15 @@ function runBenchmarkCase(label, html) {
     characterCount,
     avg,
     avgCharsPerSecond,
+    itemsPerRun: options.items || options.pool ? html.length : (options.concurrency ?? 1),
+    outputBytes,
+    peakMemory,
+    // Share of the pool's wall time its workers spent parsing
+    poolUtilization: options.pool ? busyTime / (wallTime * options.pool) : 0,
+    // Busy share of each parseHTMLBatch stage in the last run
+    stageOccupancy,
+    // Wall time per item not spent inside the parser: argument and result transfer
+    callOverhead: options.items && options.wallClock ? (wallTime - nativeTime) / (iterations * html.length) : 0,
   };
 }
 
@@ -218,47 +745,563 @@ if (!fontId) {
 
 module._setDefaultFont(fontId);
 
-const cases = [
-  { label: 'Simple', html: '<div>Hello World</div>' },
-  {
-    label: 'Medium',
-    html: '<div>' + Array(10).fill('<p>This is a test paragraph with some text content.</p>').join('') + '</div>',
-  },
-  {
-    label: 'Large',
-    html: '<div>' + Array(100).fill('<p>This is a test paragraph with some text content for performance testing.</p>').join('') + '</div>',
-  },
-  {
-    label: 'Very Large',
-    html: '<div>' + Array(300).fill('<p>This is a longer test paragraph with more content for stress testing the parser performance.</p>').join('') + '</div>',
-  },
-];
-
-console.log('HTML Layout Parser Benchmark');
-console.log(`Warmup: ${args.warmup} runs`);
-console.log(`Iterations: ${args.iterations} runs`);
-console.log(`Mode: ${args.mode}`);
-console.log(`Viewport: ${args.viewport}px`);
-console.log('');
-
-const results = [];
-
-try {
-  for (const testCase of cases) {
-    results.push(runBenchmarkCase(testCase.label, testCase.html));
-  }
-
-  for (const result of results) {
-    console.log(
-      `${result.label} (${result.characterCount} chars): ` +
-        `${formatInt(result.avgCharsPerSecond)} chars/sec, ` +
-        `total ${formatMs(result.avg.totalTime)} ` +
-        `(parse ${formatMs(result.avg.parseTime)}, ` +
-        `layout ${formatMs(result.avg.layoutTime)}, ` +
-        `serialize ${formatMs(result.avg.serializeTime)})`
-    );
-  }
-} finally {
-  module._clearAllFonts();
-  module._destroy();
+if (args.suite === 'native' || args.suite === 'serialize' || args.suite === 'sections' || args.suite === 'batch') {
+  loadNativeAddon(fontData);
+}
+
+function buildTable(rows, cols, style = '') {
+  const cells = [];
+  for (let r = 0; r < rows; r += 1) {
+    const row = [];
+    for (let c = 0; c < cols; c += 1) {
+      row.push(`<td>${r * cols + c} cell text</td>`);
+    }
+    cells.push(`<tr>${row.join('')}</tr>`);
+  }
+  return `<table${style ? ` style="${style}"` : ''}>${cells.join('')}</table>`;
+}
+
+function buildFlexItems(count, itemStyle) {
+  const items = [];
+  for (let i = 0; i < count; i += 1) {
+    items.push(`<div style="${itemStyle}">Item ${i} label</div>`);
+  }
+  return items.join('');
+}
+
+function buildFloats(count) {
+  const parts = [];
+  for (let i = 0; i < count; i += 1) {
+    const side = i % 3 ? 'left' : 'right';
+    parts.push(`<span style="float: ${side}; width: ${16 + (i * 5) % 30}px; height: ${14 + (i * 7) % 40}px">${i}</span>`);
+    if (i % 4 === 0) {
+      parts.push(`<p>Paragraph ${i} with text wrapping around badges.</p>`);
+    }
+  }
+  return `<div>${parts.join('')}</div>`;
+}
+
+function buildOrderedList(count, style = '') {
+  const items = [];
+  for (let i = 0; i < count; i += 1) {
+    items.push(`<li>Clause ${i}</li>`);
+  }
+  return `<ol${style ? ` style="${style}"` : ''}>${items.join('')}</ol>`;
+}
+
+function buildNumberedHeadings(chapters, sections) {
+  const parts = [];
+  for (let c = 0; c < chapters; c += 1) {
+    parts.push('<h1>Chapter</h1>');
+    for (let s = 0; s < sections; s += 1) {
+      parts.push('<h2>Section</h2><p>Body text</p>');
+    }
+  }
+  return parts.join('');
+}
+
+function buildCards(count) {
+  const cards = [];
+  for (let i = 0; i < count; i += 1) {
+    cards.push(`<div class="card"><h3>Card ${i}</h3><ul><li>First point</li><li>Second point</li></ul></div>`);
+  }
+  return cards.join('');
+}
+
+const cardCss = '.card { background: #f5f5f5; border: 1px solid #ccc; border-radius: 4px; padding: 8px; margin: 4px; overflow: hidden } ' +
+  'h3 { background: linear-gradient(to right, #369, #69c); color: white }';
+
+function buildLabel(name, sku, price) {
+  return `<div class="label"><h4 data-slot="name">${name}</h4>` +
+    `<p>SKU <b data-slot="sku">${sku}</b></p><p class="price" data-slot="price">${price}</p></div>`;
+}
+
+const labelCss = '.label { width: 200px; padding: 6px; border: 1px solid #333 } h4 { margin: 0 } ' +
+  '.price { text-align: right; font-weight: bold }';
+
+const responsiveCardCss = cardCss + ' .card { float: left; width: 30% } ' +
+  '@media (max-width: 900px) { .card { width: 45% } } @media (max-width: 480px) { .card { float: none; width: auto } }';
+const listItemCss = 'body { margin: 0 } .item { padding: 8px; border-bottom: 1px solid #ccc } h3 { margin: 0 0 4px }';
+const listItems = Array.from({ length: 200 }, (_, i) =>
+  `<div class="item"><h3>Item ${i}</h3><p>${'Lorem ipsum dolor sit amet, consectetur adipiscing elit. '.repeat(i % 7 + 1)}</p></div>`);
+
+function buildArticle(bytes) {
+  const paragraphs = [];
+  let size = 0;
+  for (let i = 0; size < bytes; i += 1) {
+    const paragraph = `<p>Paragraph ${i}: Lorem ipsum dolor sit amet, <b>consectetur</b> adipiscing elit, ` +
+      'sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>';
+    paragraphs.push(paragraph);
+    size += paragraph.length;
+  }
+  return paragraphs.join('');
+}
+
+function buildSections(count, paragraphs) {
+  const sections = [];
+  for (let i = 0; i < count; i += 1) {
+    const body = Array.from({ length: paragraphs }, (_, p) =>
+      `<p>Section ${i}, paragraph ${p}: Lorem ipsum dolor sit amet, <b>consectetur</b> adipiscing elit.</p>`);
+    sections.push(`<section><h2>Section ${i}</h2>${body.join('')}</section>`);
+  }
+  return sections.join('');
+}
+
+// overflow: hidden gives every section its own block formatting context
+const sectionCss = 'body { margin: 0; font-size: 8px; line-height: 10px } section { overflow: hidden; margin: 8px 0 } ' +
+  'h2 { margin: 0 } p { margin: 0 }';
+
+const previewArticle = buildArticle(1024 * 1024);
+const previewCss = 'body { margin: 0; line-height: 20px } p { margin: 0 0 8px }';
+
+const fitLabelBox = { width: 220, height: 160, minSize: 8, maxSize: 72 };
+const previewWidths = [320, 375, 414, 768, 1024, 1280, 1440];
+const complexityLimits = { maxDepth: 512, maxElements: 100000, maxCssRules: 10000, maxTableCells: 100000, maxGlyphs: 100000 };
+
+const suites = {
+  basic: [
+    { label: 'Simple', html: '<div>Hello World</div>' },
+    {
+      label: 'Medium',
+      html: '<div>' + Array(10).fill('<p>This is a test paragraph with some text content.</p>').join('') + '</div>',
+    },
+    {
+      label: 'Large',
+      html: '<div>' + Array(100).fill('<p>This is a test paragraph with some text content for performance testing.</p>').join('') + '</div>',
+    },
+    {
+      label: 'Very Large',
+      html: '<div>' + Array(300).fill('<p>This is a longer test paragraph with more content for stress testing the parser performance.</p>').join('') + '</div>',
+    },
+  ],
+  table: [
+    { label: 'Table 100x8', html: buildTable(100, 8), css: 'td { padding: 2px; }' },
+    {
+      label: 'Table 5000x8',
+      html: buildTable(5000, 8),
+      css: 'td { padding: 2px; }',
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+    {
+      label: 'Table 5000x8 (fixed)',
+      html: buildTable(5000, 8, 'table-layout: fixed; width: 100%'),
+      css: 'td { padding: 2px; }',
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+  ],
+  flex: [
+    {
+      label: 'Flex wrap 1000 items',
+      html: `<div style="display: flex; flex-wrap: wrap">${buildFlexItems(1000, 'padding: 4px; margin: 2px')}</div>`,
+    },
+    {
+      label: 'Flex card grid 1000 items',
+      html: `<div style="display: flex; flex-wrap: wrap">${buildFlexItems(1000, 'flex: 1 1 120px; padding: 8px; margin: 4px; border: 1px solid #ccc')}</div>`,
+    },
+  ],
+  floats: [
+    { label: 'Floats 500 badges', html: buildFloats(500) },
+    {
+      label: 'Floats 5000 badges',
+      html: buildFloats(5000),
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+  ],
+  lists: [
+    { label: 'Ordered list 2000 items', html: buildOrderedList(2000) },
+    { label: 'Roman list 2000 items', html: buildOrderedList(2000, 'list-style-type: upper-roman') },
+    {
+      label: 'Ordered list 10000 items',
+      html: buildOrderedList(10000),
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+    {
+      label: 'Counter list 10000 items',
+      html: buildOrderedList(10000),
+      css: 'ol { counter-reset: clause; list-style: none } li { counter-increment: clause } ' +
+        'li:before { content: counter(clause) ". " }',
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+    {
+      label: 'Counter headings 50x10',
+      html: buildNumberedHeadings(50, 10),
+      css: 'body { counter-reset: chapter } h1 { counter-increment: chapter } h2 { counter-increment: section } ' +
+        'h1:before { content: counter(chapter) ". " } h2:before { content: counter(chapter) "." counter(section) " " }',
+    },
+  ],
+  decorations: [
+    { label: 'Cards 500 (glyphs only)', html: buildCards(500), css: cardCss },
+    {
+      label: 'Cards 500 (with display list)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { parseOptions: { displayList: true } },
+    },
+  ],
+  template: [
+    {
+      label: 'Label via parseHTML',
+      html: (i) => buildLabel(`Product ${i}`, `SKU-${i * 7}`, `$${i % 100}.99`),
+      css: labelCss,
+    },
+    {
+      label: 'Label via layoutTemplate',
+      html: buildLabel('Product', 'SKU', '$0.00'),
+      css: labelCss,
+      options: { slotValues: (i) => [`Product ${i}`, `SKU-${i * 7}`, `$${i % 100}.99`] },
+    },
+  ],
+  // Parse + style per run vs loading a pre-styled snapshot (output = snapshot size)
+  snapshot: [
+    { label: 'Cards 500 (parseHTML)', html: buildCards(500), css: cardCss },
+    { label: 'Cards 500 (parseSnapshot)', html: buildCards(500), css: cardCss, options: { snapshot: true } },
+    {
+      label: 'Counter list 10000 items (parseHTML)',
+      html: buildOrderedList(10000),
+      css: 'ol { counter-reset: clause; list-style: none } li { counter-increment: clause } ' +
+        'li:before { content: counter(clause) ". " }',
+      options: { maxWarmup: 1, maxIterations: 3 },
+    },
+    {
+      label: 'Counter list 10000 items (parseSnapshot)',
+      html: buildOrderedList(10000),
+      css: 'ol { counter-reset: clause; list-style: none } li { counter-increment: clause } ' +
+        'li:before { content: counter(clause) ". " }',
+      options: { snapshot: true, maxWarmup: 1, maxIterations: 3 },
+    },
+  ],
+  multiwidth: [
+    {
+      label: 'Cards 200 x 7 widths (separate parses)',
+      html: buildCards(200),
+      css: responsiveCardCss,
+      options: { widths: previewWidths, separateWidths: true },
+    },
+    {
+      label: 'Cards 200 x 7 widths (parseHTMLMultiWidth)',
+      html: buildCards(200),
+      css: responsiveCardCss,
+      options: { widths: previewWidths },
+    },
+  ],
+  // Per-call JS <-> WASM overhead on batches of small documents
+  calls: [
+    {
+      label: 'Simple x1000 (malloc per string)',
+      html: Array.from({ length: 1000 }, (_, i) => `<div>Label ${i}</div>`),
+      options: { items: 'parse', wallClock: true, maxIterations: 10 },
+    },
+    {
+      label: 'Simple x1000 (staging buffer)',
+      html: Array.from({ length: 1000 }, (_, i) => `<div>Label ${i}</div>`),
+      options: { items: 'parse', staged: true, wallClock: true, maxIterations: 10 },
+    },
+    {
+      label: 'List items x200 (malloc per string)',
+      html: listItems,
+      css: listItemCss,
+      options: { items: 'parse', wallClock: true, maxIterations: 10 },
+    },
+    {
+      label: 'List items x200 (staging buffer)',
+      html: listItems,
+      css: listItemCss,
+      options: { items: 'parse', staged: true, wallClock: true, maxIterations: 10 },
+    },
+  ],
+  measure: [
+    {
+      label: 'List items x200 (parseHTML each)',
+      html: listItems,
+      css: listItemCss,
+      options: { items: 'parse', maxIterations: 10 },
+    },
+    {
+      label: 'List items x200 (measureHTMLBatch)',
+      html: listItems,
+      css: listItemCss,
+      options: { items: 'measure', maxIterations: 10 },
+    },
+  ],
+  fit: [
+    {
+      label: 'Label fit 8-72px (parse per probe)',
+      html: buildLabel('Fresh organic apples from the valley', 'SKU-2231', '$3.99'),
+      css: labelCss,
+      options: { fitBox: fitLabelBox, fitByParsing: true },
+    },
+    {
+      label: 'Label fit 8-72px (fitToBox)',
+      html: buildLabel('Fresh organic apples from the valley', 'SKU-2231', '$3.99'),
+      css: labelCss,
+      options: { fitBox: fitLabelBox },
+    },
+  ],
+  preview: [
+    {
+      label: 'Article 1MB (full layout)',
+      html: previewArticle,
+      css: previewCss,
+      options: { maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (maxLines: 1)',
+      html: previewArticle,
+      css: previewCss,
+      options: { parseOptions: { maxLines: 1, ellipsis: true }, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (maxHeight: 200)',
+      html: previewArticle,
+      css: previewCss,
+      options: { parseOptions: { maxHeight: 200, ellipsis: true }, maxWarmup: 1, maxIterations: 5 },
+    },
+  ],
+  // options.fields projections on a large document: output size and serialize time
+  fields: [
+    { label: 'Cards 500 (all fields)', html: buildCards(500), css: cardCss },
+    {
+      label: 'Cards 500 (character, x, y, width, fontId)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { parseOptions: { fields: ['character', 'x', 'y', 'width', 'fontId'] } },
+    },
+    {
+      label: 'Cards 500 (character, x, y)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { parseOptions: { fields: ['character', 'x', 'y'] } },
+    },
+    {
+      label: 'Cards 500 (text styling fields)',
+      html: buildCards(500),
+      css: cardCss,
+      options: {
+        parseOptions: { fields: ['character', 'x', 'y', 'width', 'height', 'fontFamily', 'fontSize', 'color'] },
+      },
+    },
+    {
+      label: 'Article 1MB (all fields)',
+      html: previewArticle,
+      css: previewCss,
+      options: { maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (character, x, y, width, fontId)',
+      html: previewArticle,
+      css: previewCss,
+      options: { parseOptions: { fields: ['character', 'x', 'y', 'width', 'fontId'] }, maxWarmup: 1, maxIterations: 5 },
+    },
+  ],
+  // Compact dialect vs today's format: output size, serialize time and JS decode time
+  compact: [
+    { label: 'Cards 500 (default)', html: buildCards(500), css: cardCss, options: { decode: true } },
+    {
+      label: 'Cards 500 (compact)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { parseOptions: { compact: true }, decode: true },
+    },
+    {
+      label: 'Article 1MB (default)',
+      html: previewArticle,
+      css: previewCss,
+      options: { decode: true, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (compact)',
+      html: previewArticle,
+      css: previewCss,
+      options: { parseOptions: { compact: true }, decode: true, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (compact, character/x/y/width/fontId)',
+      html: previewArticle,
+      css: previewCss,
+      options: {
+        parseOptions: { compact: true, fields: ['character', 'x', 'y', 'width', 'fontId'] },
+        decode: true,
+        maxWarmup: 1,
+        maxIterations: 5,
+      },
+    },
+  ],
+  // Same process, same inputs: WASM module vs native addon, timed wall clock
+  native: [
+    { label: 'Cards 500 (WASM)', html: buildCards(500), css: cardCss, options: { wallClock: true } },
+    {
+      label: 'Cards 500 (native)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { backend: 'native', wallClock: true },
+    },
+    {
+      label: 'Cards 500 from Buffer (native)',
+      html: Buffer.from(buildCards(500)),
+      css: cardCss,
+      options: { backend: 'native', wallClock: true },
+    },
+    {
+      label: 'Cards 500 x8 (native parseHTMLAsync)',
+      html: Buffer.from(buildCards(500)),
+      css: cardCss,
+      options: { backend: 'native', concurrency: 8, wallClock: true, maxIterations: 10 },
+    },
+    {
+      label: 'Article 1MB (WASM)',
+      html: previewArticle,
+      css: previewCss,
+      options: { wallClock: true, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (native)',
+      html: Buffer.from(previewArticle),
+      css: previewCss,
+      options: { backend: 'native', wallClock: true, maxWarmup: 1, maxIterations: 5 },
+    },
+  ],
+  // Flat output of the native addon serialized on 1..8 threads (see serialize time)
+  serialize: [1, 2, 4, 8].map((threads) => ({
+    label: `Article 1MB flat (native, ${threads} serializer thread${threads > 1 ? 's' : ''})`,
+    html: Buffer.from(previewArticle),
+    css: previewCss,
+    options: { backend: 'native', parseOptions: { serializeThreads: threads }, maxWarmup: 1, maxIterations: 5 },
+  })),
+  // 200 independent sections laid out on 1..8 threads (see layout time)
+  sections: [1, 2, 4, 8].map((threads) => ({
+    label: `Sections 200 x20 (native, ${threads} layout thread${threads > 1 ? 's' : ''})`,
+    html: Buffer.from(buildSections(200, 20)),
+    css: sectionCss,
+    options: { backend: 'native', parseOptions: { layoutThreads: threads }, maxWarmup: 1, maxIterations: 5 },
+  })),
+  // 32 documents parsed in one parseHTMLBatch call, stage by stage (queue 0)
+  // or pipelined with 2 / 4 documents queued between stages
+  batch: [0, 2, 4].map((queue) => ({
+    label: `Cards 100 x32 (native parseHTMLBatch, ${queue ? `pipeline queue ${queue}` : 'no pipeline'})`,
+    html: Array.from({ length: 32 }, () => buildCards(100)),
+    css: cardCss,
+    options: { backend: 'native', items: 'batch', parseOptions: { pipelineQueue: queue }, wallClock: true, maxIterations: 10 },
+  })),
+  // Whole-string result vs chunked delivery; both decoded to objects, timed wall clock
+  stream: [
+    {
+      label: 'Article 1MB (parseHTML)',
+      html: previewArticle,
+      css: previewCss,
+      options: { decode: true, wallClock: true, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (parseHTMLStream, 256KB chunks)',
+      html: previewArticle,
+      css: previewCss,
+      options: { stream: 256 * 1024, decode: true, wallClock: true, maxWarmup: 1, maxIterations: 5 },
+    },
+    {
+      label: 'Article 1MB (parseHTMLStream, 64KB chunks)',
+      html: previewArticle,
+      css: previewCss,
+      options: { stream: 64 * 1024, decode: true, wallClock: true, maxWarmup: 1, maxIterations: 5 },
+    },
+  ],
+  // Throughput of 32 documents spread over 1..N worker threads (docs/sec
+  // scales with the pool until it runs out of cores)
+  pool: [1, 2, 4, 8].filter((size) => size === 1 || size <= cpus().length).map((size) => ({
+    label: `Cards 200 x32 (pool of ${size})`,
+    html: Array.from({ length: 32 }, () => buildCards(200)),
+    css: cardCss,
+    options: { pool: size, wallClock: true, maxIterations: 10 },
+  })),
+  cache: [
+    { label: 'Cards 500 (uncached)', html: buildCards(500), css: cardCss },
+    {
+      label: 'Cards 500 (result cache)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { resultCacheBudget: 64 * 1024 * 1024 },
+    },
+  ],
+  // Cost of enforcing complexity limits on a normal document, and how soon
+  // pathological documents are rejected with them
+  limits: [
+    { label: 'Cards 500 (no limits)', html: buildCards(500), css: cardCss },
+    {
+      label: 'Cards 500 (within limits)',
+      html: buildCards(500),
+      css: cardCss,
+      options: { parseOptions: complexityLimits },
+    },
+    {
+      label: 'Nested divs 100000 (maxDepth 512)',
+      html: '<div>'.repeat(100000) + 'deep',
+      options: { parseOptions: complexityLimits },
+    },
+    {
+      label: 'Word 1M chars (maxGlyphs 100000)',
+      html: '<p>' + 'x'.repeat(1000000) + '</p>',
+      options: { parseOptions: complexityLimits, maxWarmup: 1, maxIterations: 5 },
+    },
+  ],
+};
+
+async function runSuite() {
+  const cases = suites[args.suite];
+  if (!cases) {
+    console.error(`Unknown --suite value: ${args.suite} (available: ${Object.keys(suites).join(', ')})`);
+    process.exit(1);
+  }
+
+  console.log('HTML Layout Parser Benchmark');
+  console.log(`Warmup: ${args.warmup} runs`);
+  console.log(`Iterations: ${args.iterations} runs`);
+  console.log(`Mode: ${args.mode}`);
+  console.log(`Viewport: ${args.viewport}px`);
+  console.log(`Suite: ${args.suite}`);
+  console.log(`Module: ${wasmJsPath}`);
+  const wasmBinaryPath = wasmJsPath.replace(/\.(m?js|cjs)$/, '.wasm');
+  if (existsSync(wasmBinaryPath)) {
+    console.log(`WASM size: ${(statSync(wasmBinaryPath).size / 1024).toFixed(1)} KB`);
+  }
+  console.log('');
+
+  const results = [];
+
+  try {
+    for (const testCase of cases) {
+      results.push(await runBenchmarkCase(testCase.label, testCase.html, testCase.css, testCase.options));
+    }
+
+    for (const result of results) {
+      console.log(
+        `${result.label} (${result.characterCount} chars): ` +
+          `${formatInt(result.avgCharsPerSecond)} chars/sec, ` +
+          `${formatInt((1000 * result.itemsPerRun) / result.avg.totalTime)} ${result.itemsPerRun > 1 ? 'items' : 'docs'}/sec, ` +
+          `total ${formatMs(result.avg.totalTime)} ` +
+          `(parse ${formatMs(result.avg.parseTime)}, ` +
+          `layout ${formatMs(result.avg.layoutTime)}, ` +
+          `serialize ${formatMs(result.avg.serializeTime)})` +
+          (result.outputBytes > 0 ? `, output ${(result.outputBytes / 1024).toFixed(1)} KB` : '') +
+          (result.avg.decodeTime > 0 ? `, JSON.parse ${formatMs(result.avg.decodeTime)}` : '') +
+          (result.avg.firstChunkTime > 0 ? `, first chunk ${formatMs(result.avg.firstChunkTime)}` : '') +
+          (args.suite === 'stream' ? `, peak ${(result.peakMemory / 1048576).toFixed(1)} MB` : '') +
+          (result.poolUtilization > 0 ? `, utilization ${(result.poolUtilization * 100).toFixed(0)}%` : '') +
+          (result.stageOccupancy ? `, occupancy ${Object.entries(result.stageOccupancy)
+            .map(([stage, value]) => `${stage} ${(value * 100).toFixed(0)}%`).join(' / ')}` : '') +
+          (result.callOverhead > 0 ? `, overhead ${(result.callOverhead * 1000).toFixed(1)} µs/call` : '')
+      );
+    }
+  } finally {
+    module._clearAllFonts();
+    module._destroy();
+    addon?.destroy();
+    for (const workers of poolWorkers.values()) {
+      await Promise.all(workers.map(({ worker }) => worker.terminate()));
+    }
+  }
+}
+
+// Pool suite workers only answer parse requests
+if (isMainThread) {
+  await runSuite();
+} else {
+  servePoolRequests();
 }
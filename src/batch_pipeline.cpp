@@ -0,0 +1,169 @@
+/**
+ * @file batch_pipeline.cpp
+ * @brief Pipelined batch execution (批处理流水线)
+ */
+
+#include "batch_pipeline.h"
+#include "multi_font_manager.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+// std::thread is only usable in WASM when built with -pthread
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define WASM_V2_PIPELINE_THREADS 1
+#endif
+
+namespace wasm_litehtml_v2 {
+
+namespace {
+
+/**
+ * @brief Item indices handed from one stage to the next (阶段间有界队列)
+ *
+ * push() blocks while the queue is full, pop() while it is empty and open.
+ */
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : m_capacity(capacity) {}
+
+    void push(size_t item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_items.size() < m_capacity; });
+        m_items.push_back(item);
+        m_notEmpty.notify_one();
+    }
+
+    /**
+     * @return false once the queue is closed and drained
+     */
+    bool pop(size_t& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return !m_items.empty() || m_closed; });
+        if (m_items.empty()) {
+            return false;
+        }
+        item = m_items.front();
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::deque<size_t> m_items;
+    size_t m_capacity;
+    bool m_closed = false;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Run one stage on one item, adding its time and keeping the first error (执行单个阶段)
+ */
+void runStage(const BatchPipeline::Stage& stage, size_t item, double& busyTime, std::exception_ptr& error) {
+    auto start = Clock::now();
+    try {
+        stage(item);
+    } catch (...) {
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+    busyTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+PipelineStats BatchPipeline::run(size_t itemCount, const std::vector<Stage>& stages, size_t queueCapacity) {
+    PipelineStats stats;
+    stats.busyTime.assign(stages.size(), 0.0);
+    std::vector<std::exception_ptr> errors(stages.size());
+    auto start = Clock::now();
+
+    // Stages [0, started) run on their own threads, the rest on the calling thread
+    size_t started = 0;
+    std::vector<std::unique_ptr<BoundedQueue>> queues;
+    std::vector<std::thread> workers;
+
+#ifdef WASM_V2_PIPELINE_THREADS
+    if (queueCapacity > 0 && stages.size() > 1 && itemCount > 1) {
+        for (size_t i = 0; i + 1 < stages.size(); ++i) {
+            queues.emplace_back(new BoundedQueue(queueCapacity));
+        }
+        MultiFontManager::getInstance().beginConcurrentMeasurement();
+        try {
+            for (; started + 1 < stages.size(); ++started) {
+                size_t stage = started;
+                workers.emplace_back([&, stage] {
+                    size_t item = 0;
+                    if (stage == 0) {
+                        for (; item < itemCount; ++item) {
+                            runStage(stages[0], item, stats.busyTime[0], errors[0]);
+                            queues[0]->push(item);
+                        }
+                    } else {
+                        while (queues[stage - 1]->pop(item)) {
+                            runStage(stages[stage], item, stats.busyTime[stage], errors[stage]);
+                            queues[stage]->push(item);
+                        }
+                    }
+                    queues[stage]->close();
+                });
+            }
+        } catch (const std::system_error&) {
+        }
+        stats.pipelined = started > 0;
+    }
+#else
+    (void)queueCapacity;
+#endif
+
+    // The calling thread runs the remaining stages, taking items from the last
+    // started stage, or from the input when no thread could be started
+    auto finish = [&](size_t item) {
+        for (size_t stage = started; stage < stages.size(); ++stage) {
+            runStage(stages[stage], item, stats.busyTime[stage], errors[stage]);
+        }
+    };
+    if (started == 0) {
+        for (size_t item = 0; item < itemCount; ++item) {
+            finish(item);
+        }
+    } else {
+        size_t item = 0;
+        while (queues[started - 1]->pop(item)) {
+            finish(item);
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (!queues.empty()) {
+        MultiFontManager::getInstance().endConcurrentMeasurement();
+    }
+    stats.wallTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return stats;
+}
+
+} // namespace wasm_litehtml_v2
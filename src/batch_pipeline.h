@@ -0,0 +1,77 @@
+/**
+ * @file batch_pipeline.h
+ * @brief Pipelined batch execution (批处理流水线)
+ *
+ * A batch runs every item through the same stages, for documents parse,
+ * layout + draw and serialize. Run one after the other, a document's stages
+ * never overlap. The pipeline gives every stage its own thread and connects
+ * neighbouring stages with bounded queues, so while item N is serialized,
+ * item N+1 is laid out and item N+2 is parsed:
+ *
+ *   stage 0 thread --[queue]--> stage 1 thread --[queue]--> last stage (calling thread)
+ *
+ * Each stage handles the items in order, so results come out in input
+ * order whatever the timing. The queue capacity bounds the items in flight
+ * and with them the memory held by parsed documents.
+ *
+ * Threads are only used where std::thread is (native builds and WASM built
+ * with -pthread); elsewhere, or with a queue capacity of 0, the calling
+ * thread runs each item through all stages before starting the next.
+ */
+
+#ifndef WASM_V2_BATCH_PIPELINE_H
+#define WASM_V2_BATCH_PIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Timing of one pipeline run (流水线运行统计)
+ */
+struct PipelineStats {
+    double wallTime = 0.0;              // Whole run (ms) (总耗时)
+    std::vector<double> busyTime;       // Time spent inside each stage (ms) (各阶段忙碌时间)
+    bool pipelined = false;             // Stages ran on their own threads (是否多线程流水线)
+
+    /**
+     * @brief Share of the run a stage was busy, 0..1 (阶段占用率)
+     */
+    double occupancy(size_t stage) const {
+        return wallTime > 0 && stage < busyTime.size() ? busyTime[stage] / wallTime : 0.0;
+    }
+};
+
+/**
+ * @brief Runs item stages on a thread pipeline (多线程流水线执行器)
+ */
+class BatchPipeline {
+public:
+    /**
+     * @brief Stage function, called once per item index (阶段函数)
+     *
+     * Stages of different items run concurrently; a stage must only touch
+     * its own item and state no other stage writes. Font access is
+     * thread-safe while the pipeline runs (MultiFontManager concurrent section).
+     */
+    typedef std::function<void(size_t item)> Stage;
+
+    /**
+     * @brief Run every stage on items 0 .. itemCount - 1 (执行流水线)
+     * @param itemCount Number of items
+     * @param stages Stages in order
+     * @param queueCapacity Items waiting between two stages, 0 = no pipeline
+     * @return Wall and per-stage busy time
+     *
+     * Each stage sees the items in order and item i reaches stage k only
+     * after stage k - 1 finished it. If a stage throws, the remaining items
+     * are still processed and the first exception is rethrown at the end.
+     */
+    static PipelineStats run(size_t itemCount, const std::vector<Stage>& stages, size_t queueCapacity);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_BATCH_PIPELINE_H
@@ -0,0 +1,94 @@
+/**
+ * @file chunk_stream.cpp
+ * @brief Chunked output stream implementation for HTML Layout Parser v2.0
+ */
+
+#include "chunk_stream.h"
+#include <algorithm>
+#include <cstring>
+
+namespace wasm_litehtml_v2 {
+
+namespace {
+
+/**
+ * @brief Length of the prefix that ends on a UTF-8 sequence boundary
+ *
+ * Only the last three bytes can belong to an incomplete sequence; invalid
+ * bytes are passed through unchanged.
+ */
+size_t completeUtf8Prefix(const char* data, size_t size) {
+    const size_t lookback = std::min<size_t>(3, size);
+    for (size_t i = 1; i <= lookback; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[size - i]);
+        if ((c & 0xC0) == 0x80) {
+            continue;  // Continuation byte, keep looking for the lead byte
+        }
+        if (c >= 0xC0) {
+            size_t needed = c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : 2);
+            if (needed > i) {
+                return size - i;
+            }
+        }
+        break;
+    }
+    return size;
+}
+
+} // namespace
+
+ChunkStreamBuf::ChunkStreamBuf(size_t chunkSize, ChunkCallback callback, void* userData)
+    : m_callback(callback), m_userData(userData) {
+    if (chunkSize == 0) {
+        chunkSize = kDefaultChunkSize;
+    }
+    m_buffer.resize(std::max(chunkSize, kMinChunkSize));
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+bool ChunkStreamBuf::finish() {
+    if (m_stopped) {
+        return false;
+    }
+    if (pptr() == pbase()) {
+        return true;
+    }
+    return deliver(true);
+}
+
+ChunkStreamBuf::int_type ChunkStreamBuf::overflow(int_type ch) {
+    if (m_stopped || !deliver(false)) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+bool ChunkStreamBuf::deliver(bool final) {
+    char* begin = m_buffer.data();
+    size_t used = static_cast<size_t>(pptr() - pbase());
+    size_t cut = final ? used : completeUtf8Prefix(begin, used);
+
+    if (cut > 0) {
+        if (m_callback == nullptr || m_callback(begin, cut, m_userData) == 0) {
+            m_stopped = true;
+            return false;
+        }
+        m_totalBytes += cut;
+        ++m_chunkCount;
+    }
+
+    // Carry the bytes of a split UTF-8 sequence into the next chunk
+    size_t tail = used - cut;
+    if (tail > 0) {
+        std::memmove(begin, begin + cut, tail);
+    }
+    setp(begin, begin + m_buffer.size());
+    pbump(static_cast<int>(tail));
+    return true;
+}
+
+} // namespace wasm_litehtml_v2
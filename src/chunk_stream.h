@@ -0,0 +1,97 @@
+/**
+ * @file chunk_stream.h
+ * @brief Chunked output stream for HTML Layout Parser v2.0
+ *
+ * This module provides:
+ * - A std::streambuf that hands its contents to a callback in fixed-size
+ *   chunks, so serialized output never has to exist as one string
+ * - Chunk boundaries that never split a UTF-8 sequence, so each chunk can
+ *   be decoded on its own
+ * - Byte and chunk counters for metrics
+ *
+ * Design principles:
+ * - One buffer of chunkSize bytes is reused for every chunk
+ * - The callback may stop the stream; later writes are then discarded and
+ *   the owning std::ostream reports failure
+ */
+
+#ifndef WASM_V2_CHUNK_STREAM_H
+#define WASM_V2_CHUNK_STREAM_H
+
+#include <cstddef>
+#include <streambuf>
+#include <vector>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Receives one chunk of output (分块回调)
+ * @param data Chunk bytes, valid only during the call
+ * @param size Chunk size in bytes
+ * @param userData Pointer passed to ChunkStreamBuf
+ * @return Non-zero to continue, 0 to stop the stream
+ */
+typedef int (*ChunkCallback)(const char* data, size_t size, void* userData);
+
+/**
+ * @brief Stream buffer that delivers fixed-size chunks (定长分块输出缓冲)
+ */
+class ChunkStreamBuf : public std::streambuf {
+public:
+    static const size_t kDefaultChunkSize = 256 * 1024;  // Used when chunkSize is 0 (默认块大小)
+    static const size_t kMinChunkSize = 64;              // Smaller requests are raised to this (最小块大小)
+
+    /**
+     * @brief Create a chunk buffer (创建分块缓冲)
+     * @param chunkSize Maximum chunk size in bytes (0 for the default)
+     * @param callback Chunk receiver
+     * @param userData Passed to every callback
+     */
+    ChunkStreamBuf(size_t chunkSize, ChunkCallback callback, void* userData);
+
+    /**
+     * @brief Deliver the buffered remainder as the last chunk (输出剩余数据)
+     * @return false if the stream was stopped by the callback
+     */
+    bool finish();
+
+    /**
+     * @brief Whether the callback stopped the stream (是否已被回调终止)
+     */
+    bool stopped() const { return m_stopped; }
+
+    /**
+     * @brief Bytes delivered so far (已输出字节数)
+     */
+    size_t totalBytes() const { return m_totalBytes; }
+
+    /**
+     * @brief Chunks delivered so far (已输出块数)
+     */
+    int chunkCount() const { return m_chunkCount; }
+
+    /**
+     * @brief Size of the reused chunk buffer (块缓冲大小)
+     */
+    size_t chunkSize() const { return m_buffer.size(); }
+
+protected:
+    int_type overflow(int_type ch) override;
+
+private:
+    /**
+     * @brief Deliver the buffered bytes up to the last complete UTF-8 sequence (输出完整 UTF-8 序列)
+     */
+    bool deliver(bool final);
+
+    std::vector<char> m_buffer;
+    ChunkCallback m_callback;
+    void* m_userData;
+    size_t m_totalBytes = 0;
+    int m_chunkCount = 0;
+    bool m_stopped = false;
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_CHUNK_STREAM_H
@@ -0,0 +1,220 @@
+/**
+ * @file display_list.cpp
+ * @brief Display list implementation (绘制列表实现)
+ */
+
+#include "display_list.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace wasm_litehtml_v2 {
+
+DisplayList::DisplayList()
+    : m_opCount(0)
+    , m_opStart(0)
+{
+    reset();
+}
+
+void DisplayList::reset() {
+    // Zeroed header, filled in by release() (头部由 release() 填写)
+    m_data.assign(HEADER_SIZE, 0);
+    m_opCount = 0;
+    m_opStart = 0;
+}
+
+std::vector<uint8_t> DisplayList::release() {
+    uint32_t byteLength = static_cast<uint32_t>(m_data.size());
+    uint16_t version = VERSION;
+    uint16_t headerSize = HEADER_SIZE;
+    uint32_t magic = MAGIC;
+
+    uint8_t header[HEADER_SIZE];
+    memcpy(header, &magic, 4);
+    memcpy(header + 4, &version, 2);
+    memcpy(header + 6, &headerSize, 2);
+    memcpy(header + 8, &m_opCount, 4);
+    memcpy(header + 12, &byteLength, 4);
+    std::copy(header, header + HEADER_SIZE, m_data.begin());
+
+    std::vector<uint8_t> result;
+    result.swap(m_data);
+    reset();
+    return result;
+}
+
+// ========== Records (记录) ==========
+
+void DisplayList::fillRect(const litehtml::background_layer& layer, const litehtml::web_color& color) {
+    beginOp(DisplayOp::FillRect, layer.is_root ? 1 : 0);
+    putLayer(layer);
+    putColor(color);
+    endOp();
+}
+
+void DisplayList::borders(const litehtml::borders& borders, const litehtml::position& drawPos, bool root) {
+    beginOp(DisplayOp::Borders, root ? 1 : 0);
+    putRect(drawPos);
+    putRadii(borders.radius);
+    for (const litehtml::border* side : {&borders.left, &borders.top, &borders.right, &borders.bottom}) {
+        putF32(side->width);
+        putU32(static_cast<uint32_t>(side->style));
+        putColor(side->color);
+    }
+    endOp();
+}
+
+void DisplayList::linearGradient(const litehtml::background_layer& layer,
+                                 const litehtml::background_layer::linear_gradient& gradient) {
+    beginOp(DisplayOp::LinearGradient, layer.is_root ? 1 : 0);
+    putLayer(layer);
+    putF32(gradient.start.x);
+    putF32(gradient.start.y);
+    putF32(gradient.end.x);
+    putF32(gradient.end.y);
+    putStops(gradient);
+    endOp();
+}
+
+void DisplayList::radialGradient(const litehtml::background_layer& layer,
+                                 const litehtml::background_layer::radial_gradient& gradient) {
+    beginOp(DisplayOp::RadialGradient, layer.is_root ? 1 : 0);
+    putLayer(layer);
+    putF32(gradient.position.x);
+    putF32(gradient.position.y);
+    putF32(gradient.radius.x);
+    putF32(gradient.radius.y);
+    putStops(gradient);
+    endOp();
+}
+
+void DisplayList::conicGradient(const litehtml::background_layer& layer,
+                                const litehtml::background_layer::conic_gradient& gradient) {
+    beginOp(DisplayOp::ConicGradient, layer.is_root ? 1 : 0);
+    putLayer(layer);
+    putF32(gradient.position.x);
+    putF32(gradient.position.y);
+    putF32(gradient.angle);
+    putF32(gradient.radius);
+    putStops(gradient);
+    endOp();
+}
+
+void DisplayList::image(const litehtml::background_layer& layer, const std::string& url) {
+    beginOp(DisplayOp::Image, layer.is_root ? 1 : 0);
+    putLayer(layer);
+    putRect(layer.origin_box);
+    putU32(static_cast<uint32_t>(layer.repeat));
+    putU32(static_cast<uint32_t>(layer.attachment));
+    putString(url);
+    endOp();
+}
+
+void DisplayList::listMarker(const litehtml::list_marker& marker) {
+    beginOp(DisplayOp::ListMarker);
+    putRect(marker.pos);
+    putColor(marker.color);
+    putU32(static_cast<uint32_t>(marker.marker_type));
+    putI32(marker.index);
+    putString(marker.image);
+    endOp();
+}
+
+void DisplayList::pushClip(const litehtml::position& pos, const litehtml::border_radiuses& radius) {
+    beginOp(DisplayOp::PushClip);
+    putRect(pos);
+    putRadii(radius);
+    endOp();
+}
+
+void DisplayList::popClip() {
+    beginOp(DisplayOp::PopClip);
+    endOp();
+}
+
+// ========== Encoding Helpers (编码辅助) ==========
+
+void DisplayList::beginOp(DisplayOp op, uint8_t flags) {
+    m_opStart = m_data.size();
+    m_data.push_back(static_cast<uint8_t>(op));
+    m_data.push_back(flags);
+    m_data.push_back(0);
+    m_data.push_back(0);
+    putU32(0);
+}
+
+void DisplayList::endOp() {
+    uint32_t byteLength = static_cast<uint32_t>(m_data.size() - m_opStart);
+    memcpy(&m_data[m_opStart + 4], &byteLength, 4);
+    m_opCount++;
+}
+
+void DisplayList::putU32(uint32_t value) {
+    size_t offset = m_data.size();
+    m_data.resize(offset + 4);
+    memcpy(&m_data[offset], &value, 4);
+}
+
+void DisplayList::putI32(int32_t value) {
+    size_t offset = m_data.size();
+    m_data.resize(offset + 4);
+    memcpy(&m_data[offset], &value, 4);
+}
+
+void DisplayList::putF32(float value) {
+    size_t offset = m_data.size();
+    m_data.resize(offset + 4);
+    memcpy(&m_data[offset], &value, 4);
+}
+
+void DisplayList::putColor(const litehtml::web_color& color) {
+    m_data.push_back(color.red);
+    m_data.push_back(color.green);
+    m_data.push_back(color.blue);
+    m_data.push_back(color.alpha);
+}
+
+void DisplayList::putRect(const litehtml::position& pos) {
+    putF32(pos.x);
+    putF32(pos.y);
+    putF32(pos.width);
+    putF32(pos.height);
+}
+
+void DisplayList::putRadii(const litehtml::border_radiuses& radius) {
+    putF32(radius.top_left_x);
+    putF32(radius.top_left_y);
+    putF32(radius.top_right_x);
+    putF32(radius.top_right_y);
+    putF32(radius.bottom_right_x);
+    putF32(radius.bottom_right_y);
+    putF32(radius.bottom_left_x);
+    putF32(radius.bottom_left_y);
+}
+
+void DisplayList::putLayer(const litehtml::background_layer& layer) {
+    putRect(layer.border_box);
+    putRadii(layer.border_radius);
+    putRect(layer.clip_box);
+}
+
+void DisplayList::putStops(const litehtml::background_layer::gradient_base& gradient) {
+    putU32(static_cast<uint32_t>(gradient.color_points.size()));
+    for (const auto& point : gradient.color_points) {
+        putF32(point.offset);
+        putColor(point.color);
+        putF32(point.hint ? *point.hint : NAN);
+    }
+}
+
+void DisplayList::putString(const std::string& str) {
+    putU32(static_cast<uint32_t>(str.size()));
+    m_data.insert(m_data.end(), str.begin(), str.end());
+    // Keep the next record 4-byte aligned (保持 4 字节对齐)
+    while (m_data.size() % 4 != 0) {
+        m_data.push_back(0);
+    }
+}
+
+} // namespace wasm_litehtml_v2
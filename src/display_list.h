@@ -0,0 +1,130 @@
+/**
+ * @file display_list.h
+ * @brief Display list - binary recording of box decorations (绘制列表)
+ *
+ * WasmContainer records the non-text paint calls made by litehtml
+ * (backgrounds, gradients, borders, list markers, images and clip
+ * push/pop) in paint order, so a canvas renderer can replay them next to
+ * the glyph output without walking the DOM a second time.
+ *
+ * Binary layout (little-endian, every record 4-byte aligned):
+ *
+ *   Header (16 bytes)
+ *     u32 magic       'HLDL' (0x4C444C48)
+ *     u16 version     DisplayList::VERSION
+ *     u16 headerSize  16
+ *     u32 opCount     number of records
+ *     u32 byteLength  total size including the header
+ *
+ *   Record
+ *     u8  op          DisplayOp
+ *     u8  flags       op specific (bit 0: element is the document root)
+ *     u16 reserved
+ *     u32 byteLength  record size, header included (multiple of 4)
+ *     ... payload
+ *
+ *   Payload building blocks
+ *     rect    f32 x, y, width, height
+ *     radii   f32 top-left x/y, top-right x/y, bottom-right x/y, bottom-left x/y
+ *     color   u8 r, g, b, a
+ *     layer   rect borderBox, radii borderRadius, rect clipBox
+ *     stops   u32 count, then count x (f32 offset, color, f32 hint or NaN)
+ *     string  u32 byteLength, UTF-8 bytes padded to 4
+ *
+ *   Payloads
+ *     FillRect        layer, color
+ *     Borders         rect drawPos, radii, 4 x (f32 width, u32 style, color)
+ *                     for left, top, right, bottom
+ *     LinearGradient  layer, f32 startX, startY, endX, endY, stops
+ *     RadialGradient  layer, f32 centerX, centerY, radiusX, radiusY, stops
+ *     ConicGradient   layer, f32 centerX, centerY, angle, radius, stops
+ *     Image           layer, rect originBox, u32 repeat, u32 attachment, string url
+ *     ListMarker      rect, color, u32 markerType, i32 index, string image
+ *     PushClip        rect, radii
+ *     PopClip         (empty)
+ */
+
+#ifndef WASM_V2_DISPLAY_LIST_H
+#define WASM_V2_DISPLAY_LIST_H
+
+#include <litehtml.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Display list record types (绘制指令类型)
+ */
+enum class DisplayOp : uint8_t {
+    FillRect = 1,           // Solid background fill (纯色背景)
+    Borders = 2,            // Box borders (边框)
+    LinearGradient = 3,     // linear-gradient() background (线性渐变)
+    RadialGradient = 4,     // radial-gradient() background (径向渐变)
+    ConicGradient = 5,      // conic-gradient() background (锥形渐变)
+    Image = 6,              // background-image url() (背景图片)
+    ListMarker = 7,         // Bullet or image list marker (列表标记)
+    PushClip = 8,           // Push a clip rectangle (压入裁剪)
+    PopClip = 9             // Pop the last clip rectangle (弹出裁剪)
+};
+
+/**
+ * @brief Binary display list writer (二进制绘制列表写入器)
+ */
+class DisplayList {
+public:
+    static constexpr uint32_t MAGIC = 0x4C444C48;   // "HLDL"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t HEADER_SIZE = 16;
+
+    DisplayList();
+
+    void fillRect(const litehtml::background_layer& layer, const litehtml::web_color& color);
+    void borders(const litehtml::borders& borders, const litehtml::position& drawPos, bool root);
+    void linearGradient(const litehtml::background_layer& layer,
+                        const litehtml::background_layer::linear_gradient& gradient);
+    void radialGradient(const litehtml::background_layer& layer,
+                        const litehtml::background_layer::radial_gradient& gradient);
+    void conicGradient(const litehtml::background_layer& layer,
+                       const litehtml::background_layer::conic_gradient& gradient);
+    void image(const litehtml::background_layer& layer, const std::string& url);
+    void listMarker(const litehtml::list_marker& marker);
+    void pushClip(const litehtml::position& pos, const litehtml::border_radiuses& radius);
+    void popClip();
+
+    /**
+     * @brief Number of recorded records (记录条数)
+     */
+    uint32_t opCount() const { return m_opCount; }
+
+    /**
+     * @brief Finalize the header and move the bytes out (完成并取出字节)
+     *
+     * The list is reset to an empty state afterwards.
+     */
+    std::vector<uint8_t> release();
+
+private:
+    std::vector<uint8_t> m_data;    // Header + records (头部与记录)
+    uint32_t m_opCount;             // Records written so far (已写记录数)
+    size_t m_opStart;               // Offset of the open record (当前记录起始偏移)
+
+    void reset();
+    void beginOp(DisplayOp op, uint8_t flags = 0);
+    void endOp();
+
+    void putU32(uint32_t value);
+    void putI32(int32_t value);
+    void putF32(float value);
+    void putColor(const litehtml::web_color& color);
+    void putRect(const litehtml::position& pos);
+    void putRadii(const litehtml::border_radiuses& radius);
+    void putLayer(const litehtml::background_layer& layer);
+    void putStops(const litehtml::background_layer::gradient_base& gradient);
+    void putString(const std::string& str);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_DISPLAY_LIST_H
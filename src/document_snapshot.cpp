@@ -0,0 +1,729 @@
+/**
+ * @file document_snapshot.cpp
+ * @brief Document Snapshot implementation (预样式文档快照实现)
+ */
+
+#include "document_snapshot.h"
+#include <litehtml/el_before_after.h>
+#include <litehtml/el_space.h>
+#include <litehtml/el_text.h>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+namespace wasm_litehtml_v2 {
+
+namespace {
+
+/**
+ * @brief FNV-1a hash of a byte range (FNV-1a 校验和)
+ */
+uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Appends snapshot values to a byte buffer (快照写入器)
+ *
+ * The operator() overloads are the css_properties::visit_fields() callbacks.
+ */
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void putU8(uint8_t value) { m_out.push_back(value); }
+    void putU32(uint32_t value) { putBytes(&value, 4); }
+    void putI32(int32_t value) { putBytes(&value, 4); }
+    void putF32(float value) { putBytes(&value, 4); }
+
+    void putString(const std::string& str) {
+        putU32(static_cast<uint32_t>(str.size()));
+        putBytes(str.data(), str.size());
+    }
+
+    template<class Enum>
+    typename std::enable_if<std::is_enum<Enum>::value>::type operator()(Enum value) {
+        putI32(static_cast<int32_t>(value));
+    }
+    void operator()(int value) { putI32(value); }
+    void operator()(float value) { putF32(value); }
+    void operator()(const std::string& value) { putString(value); }
+
+    void operator()(const litehtml::css_length& length) {
+        putU8(static_cast<uint8_t>(length.units()));
+        putU8(length.is_predefined() ? 1 : 0);
+        if (length.is_predefined()) {
+            putI32(length.predef());
+        } else {
+            putF32(length.val());
+        }
+    }
+
+    void operator()(const litehtml::web_color& color) {
+        putU8(color.red);
+        putU8(color.green);
+        putU8(color.blue);
+        putU8(color.alpha);
+        putU8(color.is_current_color ? 1 : 0);
+    }
+
+    void operator()(const litehtml::css_margins& box) {
+        (*this)(box.left);
+        (*this)(box.right);
+        (*this)(box.top);
+        (*this)(box.bottom);
+    }
+
+    void operator()(const litehtml::css_offsets& box) {
+        (*this)(box.left);
+        (*this)(box.top);
+        (*this)(box.right);
+        (*this)(box.bottom);
+    }
+
+    void operator()(const litehtml::css_border& border) {
+        (*this)(border.width);
+        (*this)(border.style);
+        (*this)(border.color);
+    }
+
+    void operator()(const litehtml::css_borders& borders) {
+        (*this)(borders.left);
+        (*this)(borders.top);
+        (*this)(borders.right);
+        (*this)(borders.bottom);
+        (*this)(borders.radius.top_left_x);
+        (*this)(borders.radius.top_left_y);
+        (*this)(borders.radius.top_right_x);
+        (*this)(borders.radius.top_right_y);
+        (*this)(borders.radius.bottom_right_x);
+        (*this)(borders.radius.bottom_right_y);
+        (*this)(borders.radius.bottom_left_x);
+        (*this)(borders.radius.bottom_left_y);
+    }
+
+    void operator()(const litehtml::css_size& size) {
+        (*this)(size.width);
+        (*this)(size.height);
+    }
+
+    void operator()(const litehtml::gradient::color_stop& stop) {
+        putU8(stop.is_color_hint ? 1 : 0);
+        (*this)(stop.color);
+        putU8(stop.length ? 1 : 0);
+        if (stop.length) {
+            (*this)(*stop.length);
+        }
+        putU8(stop.angle ? 1 : 0);
+        if (stop.angle) {
+            putF32(*stop.angle);
+        }
+    }
+
+    void operator()(const litehtml::image& image) {
+        (*this)(image.type);
+        putString(image.url);
+        if (image.type != litehtml::image::type_gradient) {
+            return;
+        }
+        const litehtml::gradient& gradient = image.m_gradient;
+        // string_id values are process specific, store the name
+        putString(litehtml::_s(gradient.m_type));
+        putU32(gradient.m_side);
+        putF32(gradient.angle);
+        (*this)(gradient.m_colors);
+        (*this)(gradient.position_x);
+        (*this)(gradient.position_y);
+        (*this)(gradient.radial_shape);
+        (*this)(gradient.radial_extent);
+        (*this)(gradient.radial_radius_x);
+        (*this)(gradient.radial_radius_y);
+        putF32(gradient.conic_from_angle);
+        (*this)(gradient.color_space);
+        (*this)(gradient.hue_interpolation);
+    }
+
+    void operator()(const litehtml::background& bg) {
+        (*this)(bg.m_image);
+        putString(bg.m_baseurl);
+        (*this)(bg.m_color);
+        (*this)(bg.m_attachment);
+        (*this)(bg.m_position_x);
+        (*this)(bg.m_position_y);
+        (*this)(bg.m_size);
+        (*this)(bg.m_repeat);
+        (*this)(bg.m_clip);
+        (*this)(bg.m_origin);
+    }
+
+    template<class T>
+    void operator()(const std::vector<T>& items) {
+        putU32(static_cast<uint32_t>(items.size()));
+        for (const T& item : items) {
+            (*this)(item);
+        }
+    }
+
+    void putFont(const litehtml::font_description& font) {
+        putString(font.family);
+        putF32(font.size);
+        (*this)(font.style);
+        putI32(font.weight);
+        putI32(font.decoration_line);
+        (*this)(font.decoration_thickness);
+        (*this)(font.decoration_style);
+        (*this)(font.decoration_color);
+        putString(font.emphasis_style);
+        (*this)(font.emphasis_color);
+        putI32(font.emphasis_position);
+    }
+
+private:
+    void putBytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_out.insert(m_out.end(), bytes, bytes + size);
+    }
+
+    std::vector<uint8_t>& m_out;
+};
+
+/**
+ * @brief Reads snapshot values with bounds checks (快照读取器)
+ *
+ * Reading past the end sets the failed flag and yields zero values, so
+ * callers check failed() once per record instead of after every field.
+ */
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_pos(0), m_failed(false) {}
+
+    bool failed() const { return m_failed; }
+    size_t remaining() const { return m_size - m_pos; }
+
+    uint8_t getU8() {
+        uint8_t value = 0;
+        getBytes(&value, 1);
+        return value;
+    }
+    uint32_t getU32() {
+        uint32_t value = 0;
+        getBytes(&value, 4);
+        return value;
+    }
+    int32_t getI32() {
+        int32_t value = 0;
+        getBytes(&value, 4);
+        return value;
+    }
+    float getF32() {
+        float value = 0;
+        getBytes(&value, 4);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t size = getU32();
+        if (size > remaining()) {
+            m_failed = true;
+            return std::string();
+        }
+        std::string str(reinterpret_cast<const char*>(m_data + m_pos), size);
+        m_pos += size;
+        return str;
+    }
+
+    /**
+     * @brief Read an element count, rejecting counts the remaining bytes cannot hold
+     */
+    uint32_t getCount() {
+        uint32_t count = getU32();
+        if (count > remaining()) {
+            m_failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    template<class Enum>
+    typename std::enable_if<std::is_enum<Enum>::value>::type operator()(Enum& value) {
+        value = static_cast<Enum>(getI32());
+    }
+    void operator()(int& value) { value = getI32(); }
+    void operator()(float& value) { value = getF32(); }
+    void operator()(std::string& value) { value = getString(); }
+
+    void operator()(litehtml::css_length& length) {
+        litehtml::css_units units = static_cast<litehtml::css_units>(getU8());
+        if (getU8() != 0) {
+            length.predef(getI32());
+        } else {
+            length.set_value(getF32(), units);
+        }
+    }
+
+    void operator()(litehtml::web_color& color) {
+        color.red = getU8();
+        color.green = getU8();
+        color.blue = getU8();
+        color.alpha = getU8();
+        color.is_current_color = getU8() != 0;
+    }
+
+    void operator()(litehtml::css_margins& box) {
+        (*this)(box.left);
+        (*this)(box.right);
+        (*this)(box.top);
+        (*this)(box.bottom);
+    }
+
+    void operator()(litehtml::css_offsets& box) {
+        (*this)(box.left);
+        (*this)(box.top);
+        (*this)(box.right);
+        (*this)(box.bottom);
+    }
+
+    void operator()(litehtml::css_border& border) {
+        (*this)(border.width);
+        (*this)(border.style);
+        (*this)(border.color);
+    }
+
+    void operator()(litehtml::css_borders& borders) {
+        (*this)(borders.left);
+        (*this)(borders.top);
+        (*this)(borders.right);
+        (*this)(borders.bottom);
+        (*this)(borders.radius.top_left_x);
+        (*this)(borders.radius.top_left_y);
+        (*this)(borders.radius.top_right_x);
+        (*this)(borders.radius.top_right_y);
+        (*this)(borders.radius.bottom_right_x);
+        (*this)(borders.radius.bottom_right_y);
+        (*this)(borders.radius.bottom_left_x);
+        (*this)(borders.radius.bottom_left_y);
+    }
+
+    void operator()(litehtml::css_size& size) {
+        (*this)(size.width);
+        (*this)(size.height);
+    }
+
+    void operator()(litehtml::gradient::color_stop& stop) {
+        stop.is_color_hint = getU8() != 0;
+        (*this)(stop.color);
+        if (getU8() != 0) {
+            litehtml::css_length length;
+            (*this)(length);
+            stop.length = length;
+        }
+        if (getU8() != 0) {
+            stop.angle = getF32();
+        }
+    }
+
+    void operator()(litehtml::image& image) {
+        (*this)(image.type);
+        image.url = getString();
+        if (image.type != litehtml::image::type_gradient) {
+            return;
+        }
+        litehtml::gradient& gradient = image.m_gradient;
+        gradient.m_type = litehtml::_id(getString());
+        gradient.m_side = getU32();
+        gradient.angle = getF32();
+        (*this)(gradient.m_colors);
+        (*this)(gradient.position_x);
+        (*this)(gradient.position_y);
+        (*this)(gradient.radial_shape);
+        (*this)(gradient.radial_extent);
+        (*this)(gradient.radial_radius_x);
+        (*this)(gradient.radial_radius_y);
+        gradient.conic_from_angle = getF32();
+        (*this)(gradient.color_space);
+        (*this)(gradient.hue_interpolation);
+    }
+
+    void operator()(litehtml::background& bg) {
+        (*this)(bg.m_image);
+        bg.m_baseurl = getString();
+        (*this)(bg.m_color);
+        (*this)(bg.m_attachment);
+        (*this)(bg.m_position_x);
+        (*this)(bg.m_position_y);
+        (*this)(bg.m_size);
+        (*this)(bg.m_repeat);
+        (*this)(bg.m_clip);
+        (*this)(bg.m_origin);
+    }
+
+    template<class T>
+    void operator()(std::vector<T>& items) {
+        uint32_t count = getCount();
+        items.clear();
+        items.resize(count);
+        for (T& item : items) {
+            (*this)(item);
+        }
+    }
+
+    litehtml::font_description getFont() {
+        litehtml::font_description font;
+        font.family = getString();
+        font.size = getF32();
+        (*this)(font.style);
+        font.weight = getI32();
+        font.decoration_line = getI32();
+        (*this)(font.decoration_thickness);
+        (*this)(font.decoration_style);
+        (*this)(font.decoration_color);
+        font.emphasis_style = getString();
+        (*this)(font.emphasis_color);
+        font.emphasis_position = getI32();
+        return font;
+    }
+
+private:
+    void getBytes(void* out, size_t size) {
+        if (size > remaining()) {
+            m_failed = true;
+            m_pos = m_size;
+            return;
+        }
+        memcpy(out, m_data + m_pos, size);
+        m_pos += size;
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_failed;
+};
+
+/**
+ * @brief Collects the font and style tables while writing the node tree (快照编码器)
+ */
+class SnapshotEncoder {
+public:
+    SnapshotEncoder() : m_nodeWriter(m_nodes) {}
+
+    void writeNode(const litehtml::element::ptr& el) {
+        if (std::dynamic_pointer_cast<litehtml::el_before>(el)) {
+            m_nodeWriter.putU8(static_cast<uint8_t>(NodeKind::Before));
+            writeStyledChildren(el);
+        } else if (std::dynamic_pointer_cast<litehtml::el_after>(el)) {
+            m_nodeWriter.putU8(static_cast<uint8_t>(NodeKind::After));
+            writeStyledChildren(el);
+        } else if (auto text = std::dynamic_pointer_cast<litehtml::el_text>(el)) {
+            bool space = std::dynamic_pointer_cast<litehtml::el_space>(el) != nullptr;
+            m_nodeWriter.putU8(static_cast<uint8_t>(space ? NodeKind::Space : NodeKind::Text));
+            std::string str;
+            text->get_text(str);
+            m_nodeWriter.putString(str);
+        } else if (auto tag = std::dynamic_pointer_cast<litehtml::html_tag>(el)) {
+            m_nodeWriter.putU8(static_cast<uint8_t>(NodeKind::Element));
+            m_nodeWriter.putString(tag->get_tagName());
+            const litehtml::string_map& attrs = tag->attrs();
+            m_nodeWriter.putU32(static_cast<uint32_t>(attrs.size()));
+            for (const auto& attr : attrs) {
+                m_nodeWriter.putString(attr.first);
+                m_nodeWriter.putString(attr.second);
+            }
+            writeStyledChildren(el);
+        }
+    }
+
+    /**
+     * @brief Assemble header, tables and nodes (组装快照)
+     */
+    std::vector<uint8_t> finish(int viewportWidth, int viewportHeight, litehtml::document_mode mode) {
+        std::vector<uint8_t> out(DocumentSnapshot::HEADER_SIZE, 0);
+        SnapshotWriter writer(out);
+        writer.putU32(static_cast<uint32_t>(m_fonts.size()));
+        for (const auto& font : m_fonts) {
+            writer.putFont(font);
+        }
+        writer.putU32(static_cast<uint32_t>(m_styles.size()));
+        for (const auto* style : m_styles) {
+            out.insert(out.end(), style->begin(), style->end());
+        }
+        out.insert(out.end(), m_nodes.begin(), m_nodes.end());
+
+        uint32_t header[7] = {
+            DocumentSnapshot::MAGIC,
+            static_cast<uint32_t>(DocumentSnapshot::VERSION) | (static_cast<uint32_t>(DocumentSnapshot::HEADER_SIZE) << 16),
+            static_cast<uint32_t>(out.size()),
+            checksum(out.data() + DocumentSnapshot::HEADER_SIZE, out.size() - DocumentSnapshot::HEADER_SIZE),
+            static_cast<uint32_t>(viewportWidth),
+            static_cast<uint32_t>(viewportHeight),
+            static_cast<uint32_t>(mode)
+        };
+        memcpy(out.data(), header, sizeof(header));
+        return out;
+    }
+
+private:
+    bool isSnapshotNode(const litehtml::element::ptr& el) const {
+        // <style>, <script>, comments and CDATA are never rendered (不参与渲染的节点)
+        return std::dynamic_pointer_cast<litehtml::html_tag>(el) ||
+               std::dynamic_pointer_cast<litehtml::el_text>(el);
+    }
+
+    void writeStyledChildren(const litehtml::element::ptr& el) {
+        m_nodeWriter.putU32(styleIndex(el->css()));
+        uint32_t childCount = 0;
+        for (const auto& child : el->children()) {
+            if (isSnapshotNode(child)) {
+                childCount++;
+            }
+        }
+        m_nodeWriter.putU32(childCount);
+        for (const auto& child : el->children()) {
+            if (isSnapshotNode(child)) {
+                writeNode(child);
+            }
+        }
+    }
+
+    uint32_t fontIndex(const litehtml::css_properties& css) {
+        if (css.get_font() == 0) {
+            return DocumentSnapshot::NO_FONT;
+        }
+        litehtml::font_description font = css.get_font_description();
+        auto result = m_fontIndex.emplace(font.hash(), static_cast<uint32_t>(m_fonts.size()));
+        if (result.second) {
+            m_fonts.push_back(std::move(font));
+        }
+        return result.first->second;
+    }
+
+    uint32_t styleIndex(const litehtml::css_properties& css) {
+        m_styleBytes.clear();
+        SnapshotWriter writer(m_styleBytes);
+        writer.putU32(fontIndex(css));
+        css.visit_fields(writer);
+
+        auto result = m_styleIndex.emplace(std::string(m_styleBytes.begin(), m_styleBytes.end()),
+                                           static_cast<uint32_t>(m_styles.size()));
+        if (result.second) {
+            m_styles.push_back(&result.first->first);
+        }
+        return result.first->second;
+    }
+
+    std::vector<litehtml::font_description> m_fonts;
+    std::unordered_map<std::string, uint32_t> m_fontIndex;
+    std::unordered_map<std::string, uint32_t> m_styleIndex;   // Style bytes -> index (样式去重)
+    std::vector<const std::string*> m_styles;                  // Keys of m_styleIndex in index order
+    std::vector<uint8_t> m_styleBytes;
+    std::vector<uint8_t> m_nodes;
+    SnapshotWriter m_nodeWriter;
+};
+
+/**
+ * @brief Rebuilds the element tree of a snapshot (快照解码器)
+ */
+class SnapshotDecoder {
+public:
+    SnapshotDecoder(SnapshotReader& reader, const litehtml::document::ptr& doc,
+                    const std::vector<litehtml::css_properties>& styles)
+        : m_reader(reader), m_doc(doc), m_styles(styles) {}
+
+    litehtml::element::ptr readNode(const litehtml::element::ptr& parent, std::string& error) {
+        NodeKind kind = static_cast<NodeKind>(m_reader.getU8());
+        litehtml::element::ptr el;
+
+        switch (kind) {
+            case NodeKind::Element: {
+                std::string tagName = m_reader.getString();
+                litehtml::string_map attrs;
+                uint32_t attrCount = m_reader.getCount();
+                for (uint32_t i = 0; i < attrCount && !m_reader.failed(); ++i) {
+                    std::string name = m_reader.getString();
+                    attrs[name] = m_reader.getString();
+                }
+                if (m_reader.failed()) {
+                    break;
+                }
+                el = m_doc->create_element(tagName.c_str(), attrs);
+                break;
+            }
+            case NodeKind::Before:
+                el = std::make_shared<litehtml::el_before>(m_doc);
+                break;
+            case NodeKind::After:
+                el = std::make_shared<litehtml::el_after>(m_doc);
+                break;
+            case NodeKind::Text:
+            case NodeKind::Space: {
+                std::string text = m_reader.getString();
+                if (m_reader.failed() || !parent) {
+                    break;
+                }
+                if (kind == NodeKind::Space) {
+                    el = std::make_shared<litehtml::el_space>(text.c_str(), m_doc);
+                } else {
+                    el = std::make_shared<litehtml::el_text>(text.c_str(), m_doc);
+                }
+                parent->appendChild(el);
+                // Text nodes copy the computed style of their parent
+                el->compute_styles();
+                return el;
+            }
+            default:
+                break;
+        }
+
+        if (!el) {
+            error = m_reader.failed() ? "snapshot is truncated" : "invalid node in snapshot";
+            return nullptr;
+        }
+
+        uint32_t style = m_reader.getU32();
+        if (style >= m_styles.size()) {
+            error = "style index out of range";
+            return nullptr;
+        }
+        el->css_w() = m_styles[style];
+        if (parent) {
+            parent->appendChild(el);
+        }
+        if (el->is_replaced()) {
+            // Replaced elements keep their source (e.g. img src) outside the computed style
+            el->parse_attributes();
+        }
+
+        uint32_t childCount = m_reader.getCount();
+        for (uint32_t i = 0; i < childCount; ++i) {
+            if (!readNode(el, error)) {
+                return nullptr;
+            }
+        }
+        if (m_reader.failed()) {
+            error = "snapshot is truncated";
+            return nullptr;
+        }
+        return el;
+    }
+
+private:
+    SnapshotReader& m_reader;
+    litehtml::document::ptr m_doc;
+    const std::vector<litehtml::css_properties>& m_styles;
+};
+
+} // namespace
+
+std::vector<uint8_t> DocumentSnapshot::save(litehtml::document& doc, int viewportWidth, int viewportHeight) {
+    SnapshotEncoder encoder;
+    if (doc.root()) {
+        encoder.writeNode(doc.root());
+    }
+    return encoder.finish(viewportWidth, viewportHeight, doc.mode());
+}
+
+int DocumentSnapshot::viewportWidth(const uint8_t* data, size_t size) {
+    if (data == nullptr || size < HEADER_SIZE) {
+        return 0;
+    }
+    uint32_t header[7];
+    memcpy(header, data, sizeof(header));
+    if (header[0] != MAGIC) {
+        return 0;
+    }
+    return static_cast<int>(header[4]);
+}
+
+litehtml::document::ptr DocumentSnapshot::load(const uint8_t* data, size_t size,
+                                               litehtml::document_container* container, std::string& error) {
+    if (data == nullptr || size < HEADER_SIZE) {
+        error = "snapshot is smaller than its header";
+        return nullptr;
+    }
+    uint32_t header[7];
+    memcpy(header, data, sizeof(header));
+    if (header[0] != MAGIC) {
+        error = "not a document snapshot";
+        return nullptr;
+    }
+    uint16_t version = static_cast<uint16_t>(header[1] & 0xFFFF);
+    uint16_t headerSize = static_cast<uint16_t>(header[1] >> 16);
+    if (version != VERSION || headerSize != HEADER_SIZE) {
+        error = "unsupported snapshot version " + std::to_string(version);
+        return nullptr;
+    }
+    if (header[2] != size) {
+        error = "snapshot size mismatch: header says " + std::to_string(header[2]) +
+                " bytes, got " + std::to_string(size);
+        return nullptr;
+    }
+    if (header[3] != checksum(data + HEADER_SIZE, size - HEADER_SIZE)) {
+        error = "snapshot checksum mismatch";
+        return nullptr;
+    }
+
+    litehtml::document::ptr doc = std::make_shared<litehtml::document>(container);
+    // The mode is used by set_attr(), so it is set before any element is created
+    doc->set_mode(static_cast<litehtml::document_mode>(header[6]));
+
+    SnapshotReader reader(data + HEADER_SIZE, size - HEADER_SIZE);
+
+    // Fonts are resolved once each in this process (每个字体只解析一次)
+    struct ResolvedFont {
+        litehtml::uint_ptr font;
+        litehtml::font_metrics metrics;
+    };
+    std::vector<ResolvedFont> fonts(reader.getCount());
+    for (auto& font : fonts) {
+        litehtml::font_description descr = reader.getFont();
+        if (reader.failed()) {
+            break;
+        }
+        font.font = doc->get_font(descr, &font.metrics);
+    }
+
+    std::vector<litehtml::css_properties> styles(reader.getCount());
+    for (auto& style : styles) {
+        uint32_t fontIndex = reader.getU32();
+        style.visit_fields(reader);
+        if (reader.failed()) {
+            break;
+        }
+        if (fontIndex == NO_FONT) {
+            continue;
+        }
+        if (fontIndex >= fonts.size()) {
+            error = "font index out of range";
+            return nullptr;
+        }
+        style.set_font(fonts[fontIndex].font);
+        style.set_font_metrics(fonts[fontIndex].metrics);
+        // line-height: normal follows the metrics of the font loaded here
+        if (style.line_height().css_value.is_predefined()) {
+            style.line_height_w().computed_value = fonts[fontIndex].metrics.height;
+        }
+    }
+    if (reader.failed()) {
+        error = "snapshot is truncated";
+        return nullptr;
+    }
+
+    litehtml::element::ptr root;
+    if (reader.remaining() > 0) {
+        SnapshotDecoder decoder(reader, doc, styles);
+        root = decoder.readNode(nullptr, error);
+        if (!root) {
+            return nullptr;
+        }
+    }
+
+    doc->set_styled_root(root);
+    return doc;
+}
+
+} // namespace wasm_litehtml_v2
@@ -0,0 +1,115 @@
+/**
+ * @file document_snapshot.h
+ * @brief Document Snapshot - binary pre-styled documents (预样式文档快照)
+ *
+ * A snapshot stores a parsed and styled litehtml document: the element tree
+ * with tag names, attributes and text fragments, the computed css_properties
+ * of every element and the font descriptors they use. Loading a snapshot
+ * rebuilds the element tree and installs the computed styles directly, so
+ * Gumbo, the CSS parser and selector matching never run. Snapshots are plain
+ * bytes and can be cached on disk and shared between processes.
+ *
+ * Binary layout (little-endian):
+ *
+ *   Header (28 bytes)
+ *     u32 magic          'HLSS' (0x53534C48)
+ *     u16 version        DocumentSnapshot::VERSION
+ *     u16 headerSize     28
+ *     u32 byteLength     total size including the header
+ *     u32 checksum       FNV-1a of the bytes after the header
+ *     u32 viewportWidth  viewport the styles were computed for
+ *     u32 viewportHeight
+ *     u32 mode           litehtml::document_mode
+ *
+ *   Body
+ *     u32 fontCount, fontCount x font
+ *     u32 styleCount, styleCount x style
+ *     node (the root element, children follow depth-first)
+ *
+ *   Building blocks
+ *     string  u32 byteLength, UTF-8 bytes
+ *     length  u8 units, u8 predefined, i32 keyword (predefined) or f32 value
+ *     color   u8 r, g, b, a, u8 isCurrentColor
+ *     font    string family, f32 size, i32 style, i32 weight, i32 decorationLine,
+ *             length decorationThickness, i32 decorationStyle, color decorationColor,
+ *             string emphasisStyle, color emphasisColor, i32 emphasisPosition
+ *     style   u32 font index (NO_FONT if none), then every computed value in
+ *             css_properties::visit_fields() order
+ *     node    u8 NodeKind, then
+ *               Element      string tag, u32 attrCount x (string name, string value),
+ *                            u32 style, u32 childCount, children
+ *               Before/After u32 style, u32 childCount, children
+ *               Text/Space   string text (styles are inherited from the parent)
+ *
+ * Identical computed styles are stored once in the style table. Computed
+ * styles depend on the viewport (vw/vh units, media queries) and the font
+ * scale, so a snapshot lays out like a document parsed at its viewport.
+ */
+
+#ifndef WASM_V2_DOCUMENT_SNAPSHOT_H
+#define WASM_V2_DOCUMENT_SNAPSHOT_H
+
+#include <litehtml.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Snapshot node types (快照节点类型)
+ */
+enum class NodeKind : uint8_t {
+    Element = 1,            // html_tag created by tag name (元素)
+    Before = 2,             // ::before generated content (前置伪元素)
+    After = 3,              // ::after generated content (后置伪元素)
+    Text = 4,               // Word (文本)
+    Space = 5               // White space (空白)
+};
+
+/**
+ * @brief Pre-styled document snapshot codec (预样式文档快照编解码)
+ */
+class DocumentSnapshot {
+public:
+    static constexpr uint32_t MAGIC = 0x53534C48;   // "HLSS"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t HEADER_SIZE = 28;
+    static constexpr uint32_t NO_FONT = 0xFFFFFFFF;
+
+    /**
+     * @brief Encode a styled document (编码已计算样式的文档)
+     * @param doc Document created by createFromString(), before render()
+     * @param viewportWidth Viewport the document was styled for
+     * @param viewportHeight Viewport height the document was styled for
+     * @return Snapshot bytes
+     *
+     * <style> and <script> contents, comments and CDATA sections are
+     * dropped; they are not rendered.
+     */
+    static std::vector<uint8_t> save(litehtml::document& doc, int viewportWidth, int viewportHeight);
+
+    /**
+     * @brief Rebuild a document from snapshot bytes (从快照重建文档)
+     * @param data Snapshot bytes
+     * @param size Snapshot size in bytes
+     * @param container Container that creates the fonts; must outlive the document
+     * @param error Output: reason when the snapshot is rejected
+     * @return The document with its render tree built, or null on error
+     *
+     * Fonts are resolved by family name in the current process, so the same
+     * fonts must be loaded as when the snapshot was created.
+     */
+    static litehtml::document::ptr load(const uint8_t* data, size_t size,
+                                        litehtml::document_container* container, std::string& error);
+
+    /**
+     * @brief Read the styled viewport width from a snapshot header (读取快照视口宽度)
+     * @return Viewport width, or 0 if the header is invalid
+     */
+    static int viewportWidth(const uint8_t* data, size_t size);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_DOCUMENT_SNAPSHOT_H
@@ -46,6 +46,14 @@ enum class ErrorCode {
     InvalidMode = 1004,
     InvalidOptions = 1005,
     HtmlTooLarge = 1006,
+    InvalidTemplate = 1007,
+    InvalidSlotValues = 1008,
+    InvalidSnapshot = 1009,
+    DomTooDeep = 1010,
+    TooManyElements = 1011,
+    TooManyCssRules = 1012,
+    TooManyTableCells = 1013,
+    TooManyGlyphs = 1014,
     
     // Font-related errors (2xxx)
     FontNotLoaded = 2001,
@@ -55,6 +63,7 @@ enum class ErrorCode {
     FontIdNotFound = 2005,
     NoDefaultFont = 2006,
     FontMemoryExceeded = 2007,
+    FontSetChanged = 2008,
     
     // Parsing errors (3xxx)
     ParseFailed = 3001,
@@ -87,6 +96,14 @@ inline const char* errorCodeToString(ErrorCode code) {
         case ErrorCode::InvalidMode: return "INVALID_MODE";
         case ErrorCode::InvalidOptions: return "INVALID_OPTIONS";
         case ErrorCode::HtmlTooLarge: return "HTML_TOO_LARGE";
+        case ErrorCode::InvalidTemplate: return "INVALID_TEMPLATE";
+        case ErrorCode::InvalidSlotValues: return "INVALID_SLOT_VALUES";
+        case ErrorCode::InvalidSnapshot: return "INVALID_SNAPSHOT";
+        case ErrorCode::DomTooDeep: return "DOM_TOO_DEEP";
+        case ErrorCode::TooManyElements: return "TOO_MANY_ELEMENTS";
+        case ErrorCode::TooManyCssRules: return "TOO_MANY_CSS_RULES";
+        case ErrorCode::TooManyTableCells: return "TOO_MANY_TABLE_CELLS";
+        case ErrorCode::TooManyGlyphs: return "TOO_MANY_GLYPHS";
         case ErrorCode::FontNotLoaded: return "FONT_NOT_LOADED";
         case ErrorCode::FontLoadFailed: return "FONT_LOAD_FAILED";
         case ErrorCode::FontDataInvalid: return "FONT_DATA_INVALID";
@@ -94,6 +111,7 @@ inline const char* errorCodeToString(ErrorCode code) {
         case ErrorCode::FontIdNotFound: return "FONT_ID_NOT_FOUND";
         case ErrorCode::NoDefaultFont: return "NO_DEFAULT_FONT";
         case ErrorCode::FontMemoryExceeded: return "FONT_MEMORY_EXCEEDED";
+        case ErrorCode::FontSetChanged: return "FONT_SET_CHANGED";
         case ErrorCode::ParseFailed: return "PARSE_FAILED";
         case ErrorCode::DocumentCreationFailed: return "DOCUMENT_CREATION_FAILED";
         case ErrorCode::RenderFailed: return "RENDER_FAILED";
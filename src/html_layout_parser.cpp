@@ -13,13 +13,26 @@
  * @note Requirements: 3.1, 3.4, 3.5, 3.6, 4.1, 7.1, 7.6, 8.1, 8.2, 8.3, 8.4, 8.5
  */
 
+#ifdef __EMSCRIPTEN__
 #include <emscripten.h>
+#else
+#define EMSCRIPTEN_KEEPALIVE
+#endif
 #include <cstdint>
 #include <cstring>
 #include <cstdlib>
 #include <string>
 #include <chrono>
 #include <sstream>
+#include <map>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__EMSCRIPTEN__) || defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 #include <litehtml.h>
 #include "multi_font_manager.h"
@@ -28,6 +41,15 @@
 #include "error_types.h"
 #include "debug_log.h"
 #include "font_metrics_cache.h"
+#include "parse_options.h"
+#include "result_cache.h"
+#include "template_session.h"
+#include "document_snapshot.h"
+#include "layout_measure.h"
+#include "chunk_stream.h"
+#include "parallel_layout.h"
+#include "batch_pipeline.h"
+#include "html_layout_parser.h"
 
 using namespace wasm_litehtml_v2;
 
@@ -46,6 +68,20 @@ struct ParseMetrics {
     int characterCount = 0;         // Number of characters (字符数)
     size_t inputSize = 0;           // Input HTML size (bytes) (输入大小)
     double charsPerSecond = 0.0;    // Characters per second (处理速度)
+    bool cacheHit = false;          // Served from the result cache (结果缓存命中)
+    int widthCount = 1;             // Widths laid out from one parse (单次解析布局的宽度数)
+    int mediaRestyles = 0;          // Style recalcs caused by media breakpoints (媒体断点重算样式次数)
+    double sharedTimeSaved = 0.0;   // Parse time not repeated across widths (ms) (多宽度节省的解析耗时)
+    int fitProbes = 0;              // Layout-only probes run by fitToBox (fitToBox 探测次数)
+    int itemCount = 1;              // Documents processed by one batch call (单次批处理调用的文档数)
+    double itemsPerSecond = 0.0;    // Batch throughput (批处理吞吐量)
+    double parseOccupancy = 0.0;    // Share of a batch the parse stage was busy, 0..1 (解析阶段占用率)
+    double layoutOccupancy = 0.0;   // Share of a batch the layout stage was busy, 0..1 (布局阶段占用率)
+    double serializeOccupancy = 0.0; // Share of a batch the serialize stage was busy, 0..1 (序列化阶段占用率)
+    bool truncated = false;         // Layout stopped at maxLines / maxHeight (布局在行数/高度限制处截断)
+    size_t outputSize = 0;          // Serialized output size (bytes) (输出大小)
+    int chunkCount = 0;             // Chunks delivered by parseHTMLStream (流式输出块数)
+    size_t peakMemory = 0;          // Peak heap growth during the parse (bytes) (解析期间峰值堆增长)
 };
 
 static ParseMetrics g_lastMetrics;  // Last metrics snapshot (上次指标快照)
@@ -53,6 +89,16 @@ static ParseMetrics g_lastMetrics;  // Last metrics snapshot (上次指标快照
 // Last parse result for error tracking (上次解析结果)
 static ParseResult g_lastParseResult;
 
+// Display list recorded by the last parse, empty unless requested (上次绘制列表)
+static std::vector<uint8_t> g_lastDisplayList;
+
+// Compiled template sessions by handle (已编译的模板会话)
+static std::map<int, std::unique_ptr<TemplateSession>> g_templates;
+static int g_nextTemplateHandle = 1;
+
+// Snapshot bytes from the last createSnapshot() (上次创建的快照)
+static std::vector<uint8_t> g_lastSnapshot;
+
 /**
  * @brief Helper function to allocate and copy a string (分配并拷贝字符串)
  * @param str Source string
@@ -144,6 +190,451 @@ static std::string serializeParseResult(const ParseResult& result) {
     return oss.str();
 }
 
+/**
+ * @brief Validate the length and viewport of a parse request (校验输入长度与视口)
+ * @param htmlLen HTML length in bytes
+ * @param viewportWidth Viewport width in pixels
+ * @return true if valid; otherwise g_lastParseResult holds the error
+ * 
+ * @note Requirements: 8.2, 8.4
+ */
+static bool validateParseLength(size_t htmlLen, int viewportWidth) {
+    if (htmlLen == 0) {
+        DEBUG_LOG("Error: HTML string is empty");
+        g_lastParseResult = ParseResult::fail(ErrorCode::EmptyHtml, "HTML string is empty");
+        return false;
+    }
+    
+    if (viewportWidth <= 0) {
+        DEBUG_LOG("Error: Invalid viewport width: " << viewportWidth);
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, 
+            "Viewport width must be positive, got: " + std::to_string(viewportWidth));
+        return false;
+    }
+    
+    // Check for excessively large input (>10MB)
+    const size_t MAX_HTML_SIZE = 10 * 1024 * 1024;
+    if (htmlLen > MAX_HTML_SIZE) {
+        DEBUG_LOG("Error: HTML too large: " << formatBytes(htmlLen));
+        g_lastParseResult = ParseResult::fail(ErrorCode::HtmlTooLarge, 
+            "HTML size exceeds maximum allowed (10MB), got: " + std::to_string(htmlLen) + " bytes");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Validate HTML and viewport arguments of the parse entry points (校验解析参数)
+ * @param htmlString HTML content
+ * @param viewportWidth Viewport width in pixels
+ * @param htmlLen Output: HTML length in bytes
+ * @return true if valid; otherwise g_lastParseResult holds the error
+ * 
+ * @note Requirements: 8.2, 8.4
+ */
+static bool validateParseInput(const char* htmlString, int viewportWidth, size_t& htmlLen) {
+    if (htmlString == nullptr) {
+        DEBUG_LOG("Error: HTML string is null");
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "HTML string is null");
+        return false;
+    }
+    
+    htmlLen = strlen(htmlString);
+    return validateParseLength(htmlLen, viewportWidth);
+}
+
+/**
+ * @brief Apply the maxLines / maxHeight and layoutThreads options to a document before render() (应用布局选项)
+ */
+static void applyLayoutOptions(litehtml::document& doc, const ParseOptions& options) {
+    litehtml::layout_limit limit;
+    limit.max_lines = options.maxLines;
+    limit.max_height = options.maxHeight;
+    limit.ellipsis = options.ellipsis;
+    doc.set_layout_limit(limit);
+    ParallelLayout::install(doc, options.layoutThreads);
+}
+
+/**
+ * @brief Pass the complexity limits of the options to a container before createFromString() (设置复杂度限制)
+ */
+static void applyComplexityLimit(WasmContainer& container, const ParseOptions& options) {
+    litehtml::complexity_limit limit;
+    limit.max_depth = options.maxDepth;
+    limit.max_elements = options.maxElements;
+    limit.max_css_rules = options.maxCssRules;
+    limit.max_table_cells = options.maxTableCells;
+    container.setComplexityLimit(limit, options.maxGlyphs);
+}
+
+/**
+ * @brief Find the complexity limit a document or its drawing exceeded (检查复杂度限制)
+ * @param doc Document created with a container set up by applyComplexityLimit()
+ * @param container The document's container
+ * @param options Decoded options, for the limit in the message
+ * @param message Output: which limit was exceeded
+ * @return ErrorCode::Success if no limit was exceeded
+ *
+ * Tree limits are known once the document is created, the glyph limit
+ * once it is drawn.
+ */
+static ErrorCode complexityError(const litehtml::document& doc, const WasmContainer& container,
+                                 const ParseOptions& options, std::string& message) {
+    switch (doc.complexity_exceeded()) {
+        case litehtml::complexity_depth:
+            message = "Elements nest deeper than maxDepth (" + std::to_string(options.maxDepth) + ")";
+            return ErrorCode::DomTooDeep;
+        case litehtml::complexity_elements:
+            message = "Document has more than maxElements (" + std::to_string(options.maxElements) + ") elements";
+            return ErrorCode::TooManyElements;
+        case litehtml::complexity_css_rules:
+            message = "Style sheets have more than maxCssRules (" + std::to_string(options.maxCssRules) + ") selectors";
+            return ErrorCode::TooManyCssRules;
+        case litehtml::complexity_table_cells:
+            message = "Tables have more than maxTableCells (" + std::to_string(options.maxTableCells) + ") cells";
+            return ErrorCode::TooManyTableCells;
+        case litehtml::complexity_ok:
+            break;
+    }
+    if (container.glyphLimitReached()) {
+        message = "Output has more than maxGlyphs (" + std::to_string(options.maxGlyphs) + ") characters";
+        return ErrorCode::TooManyGlyphs;
+    }
+    return ErrorCode::Success;
+}
+
+/**
+ * @brief Parse, style and render one document and append its measurement (测量单个文档)
+ * @param container Container reused across the documents of a batch
+ * @param htmlString HTML content (validated by the caller, need not be NUL-terminated)
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param options Decoded options (layout and complexity limits)
+ * @param out Output: measurement JSON object is appended
+ * @param error Output: reason when the document is rejected
+ * @return ErrorCode::Success, or why the document could not be measured
+ *
+ * Adds parse, layout and serialize times to g_lastMetrics.
+ */
+static ErrorCode measureDocument(WasmContainer& container, const char* htmlString, size_t htmlLen, 
+                                 const char* cssString, int viewportWidth, const ParseOptions& options, 
+                                 std::string& out, std::string& error) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    std::string fullHtml;
+    if (cssString != nullptr && *cssString != '\0') {
+        fullHtml = "<style>";
+        fullHtml += cssString;
+        fullHtml += "</style>";
+    }
+    fullHtml.append(htmlString, htmlLen);
+    
+    applyComplexityLimit(container, options);
+    litehtml::document::ptr doc = litehtml::document::createFromString(fullHtml.c_str(), &container);
+    if (!doc) {
+        error = "Failed to create document from HTML string";
+        return ErrorCode::DocumentCreationFailed;
+    }
+    ErrorCode code = complexityError(*doc, container, options, error);
+    if (code != ErrorCode::Success) {
+        return code;
+    }
+    auto parseEndTime = std::chrono::high_resolution_clock::now();
+    
+    // render() only: draw() would create a CharLayout per glyph
+    applyLayoutOptions(*doc, options);
+    doc->render(viewportWidth);
+    LayoutMeasurement measurement = LayoutMeasure::measure(*doc);
+    g_lastMetrics.truncated = g_lastMetrics.truncated || measurement.truncated;
+    auto layoutEndTime = std::chrono::high_resolution_clock::now();
+    
+    LayoutMeasure::appendJson(measurement, out);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    
+    g_lastMetrics.parseTime += std::chrono::duration<double, std::milli>(parseEndTime - startTime).count();
+    g_lastMetrics.layoutTime += std::chrono::duration<double, std::milli>(layoutEndTime - parseEndTime).count();
+    g_lastMetrics.serializeTime += std::chrono::duration<double, std::milli>(endTime - layoutEndTime).count();
+    return ErrorCode::Success;
+}
+
+/**
+ * @brief Copy g_lastMetrics into a successful g_lastParseResult (记录成功结果)
+ */
+static void finishMeasureResult(const std::string& jsonResult) {
+    g_lastParseResult.success = true;
+    g_lastParseResult.data = jsonResult;
+    g_lastParseResult.metrics.parseTime = g_lastMetrics.parseTime;
+    g_lastParseResult.metrics.layoutTime = g_lastMetrics.layoutTime;
+    g_lastParseResult.metrics.serializeTime = g_lastMetrics.serializeTime;
+    g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
+    g_lastParseResult.metrics.characterCount = 0;
+    g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
+    g_lastParseResult.metrics.charsPerSecond = 0;
+    g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
+    g_lastParseResult.metricsEnabled = true;
+}
+
+/**
+ * @brief Heap bytes currently allocated by malloc (当前堆内存占用)
+ * @return Allocated bytes, or 0 where the allocator cannot report them
+ */
+static size_t heapBytesInUse() {
+#if defined(__EMSCRIPTEN__)
+    return static_cast<size_t>(mallinfo().uordblks);
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#elif defined(__APPLE__)
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+#else
+    return 0;
+#endif
+}
+
+// Heap in use when the current parse started (本次解析开始时的堆占用)
+static size_t g_heapBaseline = 0;
+
+/**
+ * @brief Record heap growth since the parse started in g_lastMetrics.peakMemory (采样峰值内存)
+ * 
+ * Called where a parse holds the most memory: after drawing (document and
+ * character layouts) and once the output exists.
+ */
+static void sampleHeap() {
+    size_t used = heapBytesInUse();
+    if (used > g_heapBaseline) {
+        g_lastMetrics.peakMemory = std::max(g_lastMetrics.peakMemory, used - g_heapBaseline);
+    }
+}
+
+/**
+ * @brief Reset the last-parse state, validate the input and decode options (开始一次解析)
+ * @param htmlString HTML content, need not be NUL-terminated
+ * @param htmlLen HTML length in bytes
+ * @param viewportWidth Viewport width in pixels
+ * @param optionsJson Options JSON (optional)
+ * @param options Output: decoded options; invalid options fall back to defaults with a warning
+ * @return true if the input is valid; otherwise g_lastParseResult holds the error
+ */
+static bool beginParse(const char* htmlString, size_t htmlLen, int viewportWidth,
+                       const char* optionsJson, ParseOptions& options) {
+    // Reset metrics and result
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    g_heapBaseline = heapBytesInUse();
+    
+    DEBUG_LOG("=== Parse operation started ===");
+    
+    // Input validation - Requirements: 8.2, 8.4
+    if (htmlString == nullptr) {
+        DEBUG_LOG("Error: HTML string is null");
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "HTML string is null");
+        return false;
+    }
+    if (!validateParseLength(htmlLen, viewportWidth)) {
+        return false;
+    }
+    
+    g_lastMetrics.inputSize = htmlLen;
+    
+    // Unknown or malformed options fall back to defaults with a warning
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        DEBUG_LOG("Warning: Invalid options: " << optionsError);
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    return true;
+}
+
+/**
+ * @brief Render and draw a created document into its container (布局并绘制文档)
+ * @param container Container the document was created with
+ * @param doc Parsed and styled document
+ * @param viewportWidth Viewport width in pixels
+ * @param viewportHeight Viewport height used as the draw clip
+ * @param options Decoded options
+ * 
+ * Sets layoutTime, truncated and characterCount in g_lastMetrics and moves
+ * a requested display list into g_lastDisplayList.
+ */
+static void layoutDocument(WasmContainer& container, litehtml::document& doc, int viewportWidth,
+                           int viewportHeight, const ParseOptions& options) {
+    container.setDisplayListEnabled(options.displayList);
+    
+    // Render and layout
+    DEBUG_LOG("Layout calculation started (viewport=" << viewportWidth << "x" << viewportHeight << ")");
+    auto layoutStartTime = std::chrono::high_resolution_clock::now();
+    
+    applyLayoutOptions(doc, options);
+    doc.render(viewportWidth);
+    g_lastMetrics.truncated = doc.layout_truncated();
+    
+    // Draw to collect character layouts
+    litehtml::position clip(0, 0, viewportWidth, viewportHeight);
+    doc.draw(0, 0, 0, &clip);
+    
+    if (options.displayList) {
+        DEBUG_LOG("Display list recorded (ops=" << container.getDisplayList().opCount() << ")");
+        g_lastDisplayList = container.getDisplayList().release();
+    }
+    
+    auto layoutEndTime = std::chrono::high_resolution_clock::now();
+    double layoutTime = std::chrono::duration<double, std::milli>(layoutEndTime - layoutStartTime).count();
+    
+    const std::vector<CharLayout>& layouts = container.getCharLayouts();
+    g_lastMetrics.layoutTime = layoutTime;
+    g_lastMetrics.characterCount = static_cast<int>(layouts.size());
+    sampleHeap();
+    
+    DEBUG_LOG_TIMING("Layout calculation", layoutTime);
+    DEBUG_LOG("Characters extracted: " << layouts.size());
+}
+
+/**
+ * @brief Parse, render and draw one document into a container (解析、布局并绘制文档)
+ * @param container Receives the character layouts (and display list if enabled)
+ * @param htmlString HTML content (validated by beginParse)
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL)
+ * @param cssLen CSS length in bytes
+ * @param viewportWidth Viewport width in pixels
+ * @param viewportHeight Viewport height used as the draw clip
+ * @param options Decoded options
+ * @return The document, or null if it could not be created (g_lastParseResult holds the error)
+ * 
+ * Sets parseTime in g_lastMetrics, then lays out with layoutDocument().
+ * Documents over a complexity limit are rejected before layout, or after
+ * drawing for maxGlyphs.
+ * Callers keep the document until serialization is done: releasing its
+ * memory first makes glibc trim the heap and the serializer's allocations
+ * slower.
+ */
+static litehtml::document::ptr drawDocument(WasmContainer& container, const char* htmlString, size_t htmlLen,
+                         const char* cssString, size_t cssLen, int viewportWidth, int viewportHeight,
+                         const ParseOptions& options) {
+    // Parse HTML
+    auto parseStartTime = std::chrono::high_resolution_clock::now();
+    
+    // Build HTML with optional external CSS
+    // Use reserve to minimize string reallocations
+    std::string fullHtml;
+    if (cssString != nullptr && cssLen > 0) {
+        fullHtml.reserve(htmlLen + cssLen + 20); // +20 for <style></style> tags
+        fullHtml = "<style>";
+        fullHtml.append(cssString, cssLen);
+        fullHtml += "</style>";
+        fullHtml.append(htmlString, htmlLen);
+        
+        DEBUG_LOG("CSS parsing started");
+    } else {
+        fullHtml.assign(htmlString, htmlLen);
+    }
+    
+    applyComplexityLimit(container, options);
+    litehtml::document::ptr doc = litehtml::document::createFromString(
+        fullHtml.c_str(),
+        &container
+    );
+    
+    if (!doc) {
+        DEBUG_LOG("Error: Failed to create document");
+        g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
+            "Failed to create document from HTML string");
+        return nullptr;
+    }
+    std::string limitError;
+    ErrorCode limitCode = complexityError(*doc, container, options, limitError);
+    if (limitCode != ErrorCode::Success) {
+        DEBUG_LOG("Error: " << limitError);
+        g_lastParseResult = ParseResult::fail(limitCode, limitError);
+        return nullptr;
+    }
+    
+    auto parseEndTime = std::chrono::high_resolution_clock::now();
+    double parseTime = std::chrono::duration<double, std::milli>(parseEndTime - parseStartTime).count();
+    
+    DEBUG_LOG_TIMING("HTML parsing", parseTime);
+    if (cssString != nullptr && cssLen > 0) {
+        DEBUG_LOG_TIMING("CSS parsing", parseTime); // CSS is parsed together with HTML
+    }
+    g_lastMetrics.parseTime = parseTime;
+    
+    layoutDocument(container, *doc, viewportWidth, viewportHeight, options);
+    limitCode = complexityError(*doc, container, options, limitError);
+    if (limitCode != ErrorCode::Success) {
+        DEBUG_LOG("Error: " << limitError);
+        g_lastParseResult = ParseResult::fail(limitCode, limitError);
+        return nullptr;
+    }
+    return doc;
+}
+
+/**
+ * @brief Mark g_lastParseResult successful and copy g_lastMetrics into it (记录成功的解析结果)
+ * 
+ * Expects totalTime and characterCount in g_lastMetrics; adds the empty
+ * output and font memory warnings.
+ */
+static void finishParseResult() {
+    // Calculate characters per second
+    if (g_lastMetrics.totalTime > 0) {
+        g_lastMetrics.charsPerSecond = (g_lastMetrics.characterCount * 1000.0) / g_lastMetrics.totalTime;
+    }
+    
+    // Update parse result with success
+    g_lastParseResult.success = true;
+    g_lastParseResult.metrics.parseTime = g_lastMetrics.parseTime;
+    g_lastParseResult.metrics.layoutTime = g_lastMetrics.layoutTime;
+    g_lastParseResult.metrics.serializeTime = g_lastMetrics.serializeTime;
+    g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
+    g_lastParseResult.metrics.characterCount = g_lastMetrics.characterCount;
+    g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
+    g_lastParseResult.metrics.charsPerSecond = g_lastMetrics.charsPerSecond;
+    g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
+    g_lastParseResult.metricsEnabled = true;
+    
+    // Add warning if no characters were extracted
+    if (g_lastMetrics.characterCount == 0) {
+        DEBUG_LOG("Warning: No characters extracted from HTML");
+        g_lastParseResult.addWarning(ErrorCode::InvalidInput, 
+            "No characters were extracted from the HTML. The document may be empty or contain only non-text elements.");
+    }
+    
+    // Check memory threshold and add warning if exceeded
+    MultiFontManager& manager = MultiFontManager::getInstance();
+    if (manager.checkMemoryThreshold()) {
+        DEBUG_LOG("Warning: Memory usage exceeds 50MB threshold");
+        g_lastParseResult.addWarning(ErrorCode::FontMemoryExceeded, 
+            "Memory usage exceeds 50MB threshold. Consider unloading unused fonts.");
+    }
+    
+    // Log memory usage
+    DEBUG_LOG_MEMORY(manager.getTotalMemoryUsage(), manager.getLoadedFontCount());
+}
+
+#ifdef __EMSCRIPTEN__
+/**
+ * @brief Hand a chunk to Module.onParseChunk(ptr, size) (将数据块交给 JS)
+ * 
+ * The bytes live in the chunk buffer and are overwritten by the next chunk,
+ * so the handler must copy or decode them before returning. Returning
+ * false stops the stream; a missing handler fails the parse.
+ */
+EM_JS(int, js_onParseChunk, (const char* data, size_t size), {
+    if (typeof Module['onParseChunk'] !== 'function') {
+        return 0;
+    }
+    return Module['onParseChunk'](data, size) === false ? 0 : 1;
+});
+
+static int forwardChunkToJs(const char* data, size_t size, void* /*userData*/) {
+    return js_onParseChunk(data, size);
+}
+#endif
+
 extern "C" {
 
 // ============================================================================
@@ -265,176 +756,1392 @@ void clearAllFonts() {
     DEBUG_LOG_MEMORY(manager.getTotalMemoryUsage(), manager.getLoadedFontCount());
 }
 
-// ============================================================================
-// HTML Parsing API
-// ============================================================================
-
+// ============================================================================
+// HTML Parsing API
+// ============================================================================
+
+/**
+ * @brief Parse HTML and calculate character layouts (解析 HTML 并计算字符布局)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON string with layout data (caller must free with freeString)
+ * 
+ * Recognised options:
+ * - displayList: true to record backgrounds, borders, markers and clips;
+ *   read the binary result with getDisplayList()/getDisplayListSize()
+ * 
+ * @note Requirements: 3.1, 3.4, 3.5, 3.6, 4.1, 7.1, 7.6, 8.1, 8.2, 8.4
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTML(
+    const char* htmlString,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson
+) {
+    return parseHTMLBytes(htmlString, htmlString != nullptr ? strlen(htmlString) : 0, 
+                          cssString, viewportWidth, mode, optionsJson);
+}
+
+/**
+ * @brief Parse HTML given as a byte range (按字节范围解析 HTML)
+ * @param htmlString HTML content, need not be NUL-terminated
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON string with layout data (caller must free with freeString)
+ * 
+ * Same as parseHTML(); lets hosts that own the input bytes (the Node addon
+ * reading a Buffer) pass them without a terminating copy.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTMLBytes(
+    const char* htmlString,
+    size_t htmlLen,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson
+) {
+    return parseHTMLSized(htmlString, htmlLen, cssString, cssString != nullptr ? strlen(cssString) : 0,
+                          viewportWidth, mode, optionsJson);
+}
+
+/**
+ * @brief Parse HTML and CSS given as byte ranges (按字节范围解析 HTML 与 CSS)
+ * @param htmlString HTML content, need not be NUL-terminated
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL), need not be NUL-terminated
+ * @param cssLen CSS length in bytes
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON string with layout data (caller must free with freeString)
+ * 
+ * Same as parseHTML() without scanning the inputs for their length. The JS
+ * wrapper encodes html, css, mode and options back to back into one reused
+ * staging buffer and passes the lengths it got from TextEncoder.encodeInto().
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTMLSized(
+    const char* htmlString,
+    size_t htmlLen,
+    const char* cssString,
+    size_t cssLen,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson
+) {
+    ParseOptions options;
+    if (!beginParse(htmlString, htmlLen, viewportWidth, optionsJson, options)) {
+        return allocateString("[]");
+    }
+    
+    OutputMode outputMode = JsonSerializer::parseMode(mode);
+    
+    // Result cache lookup (结果缓存查找)
+    ResultCache& resultCache = ResultCache::getInstance();
+    Hash128 cacheKey;
+    uint64_t fontGeneration = MultiFontManager::getInstance().getGeneration();
+    if (resultCache.isEnabled()) {
+        auto lookupStartTime = std::chrono::high_resolution_clock::now();
+        
+        Hasher128 hasher;
+        hasher.update(htmlString, htmlLen);
+        if (cssString != nullptr) {
+            hasher.update(cssString, cssLen);
+        } else {
+            hasher.update(cssString);  // "null" marker
+        }
+        hasher.update(static_cast<uint64_t>(viewportWidth));
+        hasher.update(static_cast<uint64_t>(outputMode));
+        hasher.update(optionsJson);
+        hasher.update(fontGeneration);
+        cacheKey = hasher.digest();
+        
+        if (const CachedResult* cached = resultCache.find(cacheKey, fontGeneration)) {
+            g_lastDisplayList = cached->displayList;
+            g_lastMetrics.characterCount = cached->characterCount;
+            g_lastMetrics.cacheHit = true;
+            g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - lookupStartTime).count();
+            if (g_lastMetrics.totalTime > 0) {
+                g_lastMetrics.charsPerSecond = (g_lastMetrics.characterCount * 1000.0) / g_lastMetrics.totalTime;
+            }
+            
+            g_lastParseResult.success = true;
+            g_lastParseResult.data = cached->data;
+            g_lastParseResult.warnings = cached->warnings;
+            g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
+            g_lastParseResult.metrics.characterCount = g_lastMetrics.characterCount;
+            g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
+            g_lastParseResult.metrics.charsPerSecond = g_lastMetrics.charsPerSecond;
+            g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
+            g_lastParseResult.metricsEnabled = true;
+            
+            DEBUG_LOG("=== Parse served from result cache (chars=" << cached->characterCount << ") ===");
+            return allocateString(cached->data);
+        }
+    }
+    
+    DEBUG_LOG("HTML parsing started (length=" << formatBytes(htmlLen) << ", viewport=" << viewportWidth << "px)");
+    
+    // Log CSS info if provided
+    if (cssString != nullptr && cssLen > 0) {
+        DEBUG_LOG("External CSS provided (length=" << formatBytes(cssLen) << ")");
+    }
+    
+    try {
+        // Start timing
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        // Default viewport height
+        const int defaultViewportHeight = 10000;
+        
+        // Create container
+        WasmContainer container(viewportWidth, defaultViewportHeight);
+        litehtml::document::ptr doc = drawDocument(container, htmlString, htmlLen, cssString, cssLen,
+                                                   viewportWidth, defaultViewportHeight, options);
+        if (!doc) {
+            return allocateString("[]");
+        }
+        const std::vector<CharLayout>& layouts = container.getCharLayouts();
+        
+        // Output mode name for logging
+        std::string modeStr = mode ? mode : "flat";
+        
+        // Create viewport info
+        Viewport viewport;
+        viewport.width = viewportWidth;
+        viewport.height = defaultViewportHeight;
+        
+        // Serialize to JSON
+        DEBUG_LOG("Serialization started (mode=" << modeStr << ")");
+        auto serializeStartTime = std::chrono::high_resolution_clock::now();
+        
+        std::string jsonResult = JsonSerializer::serialize(layouts, outputMode, viewport, options.fields, options.compact,
+                                                           options.serializeThreads);
+        
+        auto serializeEndTime = std::chrono::high_resolution_clock::now();
+        double serializeTime = std::chrono::duration<double, std::milli>(serializeEndTime - serializeStartTime).count();
+        
+        DEBUG_LOG_TIMING("Serialization", serializeTime);
+        DEBUG_LOG("Output size: " << formatBytes(jsonResult.length()));
+        
+        g_lastMetrics.serializeTime = serializeTime;
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(serializeEndTime - startTime).count();
+        g_lastMetrics.outputSize = jsonResult.size();
+        g_lastParseResult.data = jsonResult;
+        finishParseResult();
+        sampleHeap();
+        
+        // Clear character layouts to release memory
+        container.clearCharLayouts();
+        
+        if (resultCache.isEnabled()) {
+            CachedResult entry;
+            entry.data = jsonResult;
+            entry.displayList = g_lastDisplayList;
+            entry.warnings = g_lastParseResult.warnings;
+            entry.characterCount = g_lastMetrics.characterCount;
+            resultCache.store(cacheKey, fontGeneration, std::move(entry));
+        }
+        
+        DEBUG_LOG("=== Parse operation completed (total=" << formatDuration(g_lastMetrics.totalTime) 
+                  << ", chars=" << g_lastMetrics.characterCount 
+                  << ", speed=" << static_cast<int>(g_lastMetrics.charsPerSecond) << " chars/sec) ===");
+        
+        char* output = allocateString(jsonResult);
+        sampleHeap();
+        return output;
+        
+    } catch (const std::exception& e) {
+        DEBUG_LOG("Error: Exception during parsing: " << e.what());
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("[]");
+    } catch (...) {
+        DEBUG_LOG("Error: Unknown exception during parsing");
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("[]");
+    }
+}
+
+/**
+ * @brief Parse HTML and deliver the output in chunks (解析 HTML 并分块输出结果)
+ * @param htmlString HTML content, need not be NUL-terminated
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @param chunkSize Maximum chunk size in bytes (0 for 256KB)
+ * @param onChunk Receives each chunk; returning 0 stops the stream
+ * @param userData Passed to onChunk
+ * @return 1 if the whole output was delivered, 0 on failure (see getLastParseResult())
+ * 
+ * Produces the same text as parseHTMLBytes() without ever holding it as one
+ * string: the serializer fills a chunkSize buffer that is handed to onChunk
+ * each time it is full, so the output costs one chunk of memory instead of
+ * several full copies. Chunks end on UTF-8 sequence boundaries. Nothing is
+ * delivered when validation or parsing fails. The result cache is bypassed
+ * and getLastParseResult() carries no data. options.serializeThreads is
+ * ignored: per-thread buffers would hold the whole output.
+ */
+EMSCRIPTEN_KEEPALIVE
+int parseHTMLToStream(
+    const char* htmlString,
+    size_t htmlLen,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson,
+    size_t chunkSize,
+    ParseChunkCallback onChunk,
+    void* userData
+) {
+    ParseOptions options;
+    if (!beginParse(htmlString, htmlLen, viewportWidth, optionsJson, options)) {
+        return 0;
+    }
+    
+    OutputMode outputMode = JsonSerializer::parseMode(mode);
+    
+    DEBUG_LOG("HTML parsing started (length=" << formatBytes(htmlLen) << ", viewport=" << viewportWidth << "px, streamed)");
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        const int defaultViewportHeight = 10000;
+        WasmContainer container(viewportWidth, defaultViewportHeight);
+        litehtml::document::ptr doc = drawDocument(container, htmlString, htmlLen, cssString, 
+                                                   cssString != nullptr ? strlen(cssString) : 0,
+                                                   viewportWidth, defaultViewportHeight, options);
+        if (!doc) {
+            return 0;
+        }
+        
+        Viewport viewport;
+        viewport.width = viewportWidth;
+        viewport.height = defaultViewportHeight;
+        
+        auto serializeStartTime = std::chrono::high_resolution_clock::now();
+        
+        ChunkStreamBuf chunks(chunkSize, onChunk, userData);
+        DEBUG_LOG("Streaming serialization started (chunk=" << formatBytes(chunks.chunkSize()) << ")");
+        std::ostream out(&chunks);
+        JsonSerializer::write(container.getCharLayouts(), outputMode, viewport, options.fields, options.compact, out);
+        sampleHeap();
+        bool delivered = chunks.finish();
+        
+        auto serializeEndTime = std::chrono::high_resolution_clock::now();
+        g_lastMetrics.serializeTime = std::chrono::duration<double, std::milli>(serializeEndTime - serializeStartTime).count();
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(serializeEndTime - startTime).count();
+        g_lastMetrics.outputSize = chunks.totalBytes();
+        g_lastMetrics.chunkCount = chunks.chunkCount();
+        
+        DEBUG_LOG_TIMING("Serialization", g_lastMetrics.serializeTime);
+        DEBUG_LOG("Output size: " << formatBytes(chunks.totalBytes()) << " in " << chunks.chunkCount() << " chunks");
+        
+        if (!delivered) {
+            DEBUG_LOG("Error: Output stream stopped by the chunk callback");
+            g_lastParseResult = ParseResult::fail(ErrorCode::SerializationFailed, 
+                "Output stream stopped by the chunk callback after " + std::to_string(chunks.totalBytes()) + " bytes");
+            return 0;
+        }
+        
+        finishParseResult();
+        
+        DEBUG_LOG("=== Parse operation completed (total=" << formatDuration(g_lastMetrics.totalTime) 
+                  << ", chars=" << g_lastMetrics.characterCount << ", streamed) ===");
+        return 1;
+        
+    } catch (const std::exception& e) {
+        DEBUG_LOG("Error: Exception during parsing: " << e.what());
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return 0;
+    } catch (...) {
+        DEBUG_LOG("Error: Unknown exception during parsing");
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return 0;
+    }
+}
+
+#ifdef __EMSCRIPTEN__
+/**
+ * @brief Parse HTML and deliver the output to Module.onParseChunk (解析并分块交给 JS)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @param chunkSize Maximum chunk size in bytes (0 for 256KB)
+ * @return 1 if the whole output was delivered, 0 on failure
+ * 
+ * WASM binding of parseHTMLToStream(). Each chunk is passed as
+ * Module.onParseChunk(ptr, size) and is only valid during that call.
+ */
+EMSCRIPTEN_KEEPALIVE
+int parseHTMLStream(
+    const char* htmlString,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson,
+    int chunkSize
+) {
+    return parseHTMLToStream(htmlString, htmlString != nullptr ? strlen(htmlString) : 0, 
+                             cssString, viewportWidth, mode, optionsJson,
+                             chunkSize > 0 ? static_cast<size_t>(chunkSize) : 0, 
+                             forwardChunkToJs, nullptr);
+}
+#endif
+
+/**
+ * @brief Parse HTML and return result with diagnostics (解析并返回诊断结果)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON string with ParseResult structure (caller must free with freeString)
+ * 
+ * This function returns a structured result including:
+ * - success: boolean indicating if parsing succeeded
+ * - data: parsed layout data (if successful)
+ * - errors: array of errors (if any)
+ * - warnings: array of warnings (if any)
+ * - metrics: performance metrics
+ * 
+ * @note Requirements: 8.1, 8.2, 8.4, 8.5
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTMLWithDiagnostics(
+    const char* htmlString,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson
+) {
+    // Call the regular parseHTML to do the actual work
+    const char* result = parseHTML(htmlString, cssString, viewportWidth, mode, optionsJson);
+    
+    // Free the result since we'll return a different format
+    if (result) {
+        free(const_cast<char*>(result));
+    }
+    
+    // Return the structured result
+    return allocateString(serializeParseResult(g_lastParseResult));
+}
+
+/**
+ * @brief Parse HTML once and lay it out at several viewport widths (一次解析，多宽度布局)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param widths Viewport widths in pixels
+ * @param widthCount Number of widths
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON array of {"viewportWidth":w,"data":...} in the order of widths
+ *         (caller must free with freeString)
+ * 
+ * Parsing, style cascade and font creation run once. For each width only
+ * render and draw are repeated; styles are recomputed only when a media
+ * query changes its result. The displayList option is not supported here.
+ * getMetrics() reports parseTime once, layoutTime and serializeTime summed
+ * over widths, and sharedTimeSaved = parseTime * (widthCount - 1).
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTMLMultiWidth(
+    const char* htmlString,
+    const char* cssString,
+    const int* widths,
+    int widthCount,
+    const char* mode,
+    const char* optionsJson
+) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    
+    if (widths == nullptr || widthCount <= 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, "At least one viewport width is required");
+        return allocateString("[]");
+    }
+    size_t htmlLen = 0;
+    if (!validateParseInput(htmlString, widths[0], htmlLen)) {
+        return allocateString("[]");
+    }
+    for (int i = 1; i < widthCount; ++i) {
+        if (widths[i] <= 0) {
+            g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, 
+                "Viewport width must be positive, got: " + std::to_string(widths[i]));
+            return allocateString("[]");
+        }
+    }
+    g_lastMetrics.inputSize = htmlLen;
+    g_lastMetrics.widthCount = widthCount;
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    if (options.displayList) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, 
+            "displayList is not supported by parseHTMLMultiWidth and was ignored");
+    }
+    
+    OutputMode outputMode = JsonSerializer::parseMode(mode);
+    
+    DEBUG_LOG("Multi-width parse started (length=" << formatBytes(htmlLen) << ", widths=" << widthCount << ")");
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        const int defaultViewportHeight = 10000;
+        
+        WasmContainer container(widths[0], defaultViewportHeight);
+        
+        std::string fullHtml;
+        if (cssString != nullptr && *cssString != '\0') {
+            fullHtml = "<style>";
+            fullHtml += cssString;
+            fullHtml += "</style>";
+        }
+        fullHtml += htmlString;
+        
+        applyComplexityLimit(container, options);
+        litehtml::document::ptr doc = litehtml::document::createFromString(fullHtml.c_str(), &container);
+        if (!doc) {
+            g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
+                "Failed to create document from HTML string");
+            return allocateString("[]");
+        }
+        std::string limitError;
+        ErrorCode limitCode = complexityError(*doc, container, options, limitError);
+        if (limitCode != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            return allocateString("[]");
+        }
+        
+        auto parseEndTime = std::chrono::high_resolution_clock::now();
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(parseEndTime - startTime).count();
+        
+        applyLayoutOptions(*doc, options);
+        
+        std::string jsonResult = "[";
+        for (int i = 0; i < widthCount; ++i) {
+            int width = widths[i];
+            auto layoutStartTime = std::chrono::high_resolution_clock::now();
+            
+            if (i > 0) {
+                container.setViewportWidth(width);
+                if (doc->media_changed()) {
+                    // Media queries may change display, so the render tree is rebuilt too
+                    doc->rebuild_render_tree();
+                    g_lastMetrics.mediaRestyles++;
+                    DEBUG_LOG("Media breakpoint crossed at width " << width << "px; styles recomputed");
+                }
+            }
+            
+            doc->render(width);
+            g_lastMetrics.truncated = g_lastMetrics.truncated || doc->layout_truncated();
+            litehtml::position clip(0, 0, width, defaultViewportHeight);
+            doc->draw(0, 0, 0, &clip);
+            
+            // A rebuilt render tree or the drawn glyphs may exceed a limit at this width
+            limitCode = complexityError(*doc, container, options, limitError);
+            if (limitCode != ErrorCode::Success) {
+                g_lastParseResult = ParseResult::fail(limitCode, "At width " + std::to_string(width) + ": " + limitError);
+                return allocateString("[]");
+            }
+            
+            auto layoutEndTime = std::chrono::high_resolution_clock::now();
+            
+            const std::vector<CharLayout>& layouts = container.getCharLayouts();
+            Viewport viewport;
+            viewport.width = width;
+            viewport.height = defaultViewportHeight;
+            
+            if (i > 0) {
+                jsonResult += ",";
+            }
+            jsonResult += "{\"viewportWidth\":" + std::to_string(width) + ",\"data\":";
+            jsonResult += JsonSerializer::serialize(layouts, outputMode, viewport, options.fields, options.compact,
+                                                    options.serializeThreads);
+            jsonResult += "}";
+            
+            auto serializeEndTime = std::chrono::high_resolution_clock::now();
+            g_lastMetrics.layoutTime += std::chrono::duration<double, std::milli>(layoutEndTime - layoutStartTime).count();
+            g_lastMetrics.serializeTime += std::chrono::duration<double, std::milli>(serializeEndTime - layoutEndTime).count();
+            g_lastMetrics.characterCount += static_cast<int>(layouts.size());
+            
+            container.clearCharLayouts();
+        }
+        jsonResult += "]";
+        
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        g_lastMetrics.sharedTimeSaved = g_lastMetrics.parseTime * (widthCount - 1);
+        if (g_lastMetrics.totalTime > 0) {
+            g_lastMetrics.charsPerSecond = (g_lastMetrics.characterCount * 1000.0) / g_lastMetrics.totalTime;
+        }
+        
+        g_lastParseResult.success = true;
+        g_lastParseResult.data = jsonResult;
+        g_lastParseResult.metrics.parseTime = g_lastMetrics.parseTime;
+        g_lastParseResult.metrics.layoutTime = g_lastMetrics.layoutTime;
+        g_lastParseResult.metrics.serializeTime = g_lastMetrics.serializeTime;
+        g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
+        g_lastParseResult.metrics.characterCount = g_lastMetrics.characterCount;
+        g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
+        g_lastParseResult.metrics.charsPerSecond = g_lastMetrics.charsPerSecond;
+        g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
+        g_lastParseResult.metricsEnabled = true;
+        
+        DEBUG_LOG("=== Multi-width parse completed (total=" << formatDuration(g_lastMetrics.totalTime) 
+                  << ", widths=" << widthCount << ", restyles=" << g_lastMetrics.mediaRestyles << ") ===");
+        
+        return allocateString(jsonResult);
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("[]");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("[]");
+    }
+}
+
+/**
+ * @brief Find the largest font size at which HTML fits in a box (求适配盒子的最大字号)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param boxWidth Box width in pixels (also the viewport width)
+ * @param boxHeight Box height in pixels
+ * @param minSize Smallest base font size to try, in pixels
+ * @param maxSize Largest base font size to try, in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional);
+ *        "heightOnly": true ignores horizontal overflow, and text cut by
+ *        "maxLines" / "maxHeight" counts as overflowing
+ * @return JSON object {"fontSize","scale","fits","probes","width","height","data"}
+ *         (caller must free with freeString)
+ * 
+ * The base font size is the size of text without a font-size rule (16px at
+ * scale 1); every computed font-size is multiplied by fontSize / 16. The
+ * document is parsed once. Each probe changes the scale, recomputes styles
+ * and runs layout only, comparing the document size with the box; glyph
+ * positions are drawn and serialized once, for the chosen size. Whole pixel
+ * sizes are searched, largest first, so a text that fits at maxSize costs a
+ * single probe. When even minSize overflows, minSize is used and "fits" is
+ * false.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* fitToBox(
+    const char* htmlString,
+    const char* cssString,
+    int boxWidth,
+    int boxHeight,
+    float minSize,
+    float maxSize,
+    const char* mode,
+    const char* optionsJson
+) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    
+    size_t htmlLen = 0;
+    if (!validateParseInput(htmlString, boxWidth, htmlLen)) {
+        return allocateString("{}");
+    }
+    int minPx = static_cast<int>(std::ceil(minSize));
+    int maxPx = static_cast<int>(std::floor(maxSize));
+    if (boxHeight <= 0 || minPx <= 0 || maxPx < minPx) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, 
+            "fitToBox needs a positive box height and 0 < minSize <= maxSize, got height " + 
+            std::to_string(boxHeight) + ", sizes " + std::to_string(minSize) + ".." + std::to_string(maxSize));
+        return allocateString("{}");
+    }
+    g_lastMetrics.inputSize = htmlLen;
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    OutputMode outputMode = JsonSerializer::parseMode(mode);
+    
+    DEBUG_LOG("Fit to box started (length=" << formatBytes(htmlLen) << ", box=" << boxWidth << "x" << boxHeight 
+              << ", sizes=" << minPx << ".." << maxPx << ")");
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        WasmContainer container(boxWidth, boxHeight);
+        container.setDisplayListEnabled(options.displayList);
+        
+        std::string fullHtml;
+        if (cssString != nullptr && *cssString != '\0') {
+            fullHtml = "<style>";
+            fullHtml += cssString;
+            fullHtml += "</style>";
+        }
+        fullHtml += htmlString;
+        
+        applyComplexityLimit(container, options);
+        litehtml::document::ptr doc = litehtml::document::createFromString(fullHtml.c_str(), &container);
+        if (!doc) {
+            g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
+                "Failed to create document from HTML string");
+            return allocateString("{}");
+        }
+        std::string limitError;
+        ErrorCode limitCode = complexityError(*doc, container, options, limitError);
+        if (limitCode != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            return allocateString("{}");
+        }
+        
+        auto parseEndTime = std::chrono::high_resolution_clock::now();
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(parseEndTime - startTime).count();
+        
+        applyLayoutOptions(*doc, options);
+        const float baseSize = static_cast<float>(container.get_default_font_size());
+        auto layoutAt = [&](int size) {
+            if (doc->set_font_scale(static_cast<float>(size) / baseSize)) {
+                doc->rebuild_render_tree();
+            }
+            doc->render(boxWidth);
+        };
+        auto probe = [&](int size) {
+            layoutAt(size);
+            g_lastMetrics.fitProbes++;
+            // Text cut by maxLines / maxHeight does not fit either
+            bool fits = !doc->layout_truncated() && doc->height() <= boxHeight && 
+                        (options.heightOnly || doc->width() <= boxWidth);
+            DEBUG_LOG("Probe " << size << "px: " << doc->width() << "x" << doc->height() << (fits ? " fits" : " overflows"));
+            return fits;
+        };
+        
+        // Invariant: lo fits (or is minSize), hi overflows
+        int chosen;
+        bool fits = true;
+        if (probe(maxPx)) {
+            chosen = maxPx;
+        } else if (minPx == maxPx || !probe(minPx)) {
+            chosen = minPx;
+            fits = false;
+        } else {
+            int lo = minPx;
+            int hi = maxPx;
+            while (hi - lo > 1) {
+                int mid = lo + (hi - lo) / 2;
+                if (probe(mid)) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            chosen = lo;
+        }
+        
+        // The last probe may have been at a different size
+        layoutAt(chosen);
+        g_lastMetrics.truncated = doc->layout_truncated();
+        litehtml::pixel_t docWidth = doc->width();
+        litehtml::pixel_t docHeight = doc->height();
+        litehtml::position clip(0, 0, boxWidth, std::max<litehtml::pixel_t>(boxHeight, docHeight));
+        doc->draw(0, 0, 0, &clip);
+        limitCode = complexityError(*doc, container, options, limitError);
+        if (limitCode != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            return allocateString("{}");
+        }
+        
+        auto layoutEndTime = std::chrono::high_resolution_clock::now();
+        g_lastMetrics.layoutTime = std::chrono::duration<double, std::milli>(layoutEndTime - parseEndTime).count();
+        
+        const std::vector<CharLayout>& layouts = container.getCharLayouts();
+        g_lastMetrics.characterCount = static_cast<int>(layouts.size());
+        Viewport viewport;
+        viewport.width = boxWidth;
+        viewport.height = boxHeight;
+        
+        std::ostringstream oss;
+        oss << "{\"fontSize\":" << chosen 
+            << ",\"scale\":" << doc->font_scale()
+            << ",\"fits\":" << (fits ? "true" : "false")
+            << ",\"probes\":" << g_lastMetrics.fitProbes
+            << ",\"width\":" << docWidth
+            << ",\"height\":" << docHeight
+            << ",\"data\":";
+        std::string jsonResult = oss.str();
+        jsonResult += JsonSerializer::serialize(layouts, outputMode, viewport, options.fields, options.compact,
+                                                options.serializeThreads);
+        jsonResult += "}";
+        
+        if (options.displayList) {
+            g_lastDisplayList = container.getDisplayList().release();
+        }
+        container.clearCharLayouts();
+        
+        auto endTime = std::chrono::high_resolution_clock::now();
+        g_lastMetrics.serializeTime = std::chrono::duration<double, std::milli>(endTime - layoutEndTime).count();
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        if (g_lastMetrics.totalTime > 0) {
+            g_lastMetrics.charsPerSecond = (g_lastMetrics.characterCount * 1000.0) / g_lastMetrics.totalTime;
+        }
+        
+        g_lastParseResult.success = true;
+        g_lastParseResult.data = jsonResult;
+        g_lastParseResult.metrics.parseTime = g_lastMetrics.parseTime;
+        g_lastParseResult.metrics.layoutTime = g_lastMetrics.layoutTime;
+        g_lastParseResult.metrics.serializeTime = g_lastMetrics.serializeTime;
+        g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
+        g_lastParseResult.metrics.characterCount = g_lastMetrics.characterCount;
+        g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
+        g_lastParseResult.metrics.charsPerSecond = g_lastMetrics.charsPerSecond;
+        g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
+        g_lastParseResult.metricsEnabled = true;
+        
+        DEBUG_LOG("=== Fit to box completed (total=" << formatDuration(g_lastMetrics.totalTime) 
+                  << ", size=" << chosen << "px, probes=" << g_lastMetrics.fitProbes << ") ===");
+        
+        return allocateString(jsonResult);
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("{}");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("{}");
+    }
+}
+
+/**
+ * @brief Measure HTML without producing glyph layouts (仅测量 HTML 尺寸)
+ * @param htmlString HTML content
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param optionsJson Additional options as JSON string (optional, currently unused)
+ * @return JSON object {"width","height","lineCount","blocks":[{"x","y","width","height"}]}
+ *         (caller must free with freeString)
+ * 
+ * Runs parse, style and render only; draw() and per-character serialization
+ * are skipped. blocks are the border boxes of the in-flow block children of
+ * <body>. getMetrics() reports characterCount 0.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* measureHTML(
+    const char* htmlString,
+    const char* cssString,
+    int viewportWidth,
+    const char* optionsJson
+) {
+    return measureHTMLBytes(htmlString, htmlString != nullptr ? strlen(htmlString) : 0, 
+                            cssString, viewportWidth, optionsJson);
+}
+
+/**
+ * @brief Measure HTML given as a byte range (按字节范围测量 HTML)
+ * @param htmlString HTML content, need not be NUL-terminated
+ * @param htmlLen HTML length in bytes
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return Same JSON object as measureHTML() (caller must free with freeString)
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* measureHTMLBytes(
+    const char* htmlString,
+    size_t htmlLen,
+    const char* cssString,
+    int viewportWidth,
+    const char* optionsJson
+) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    
+    if (htmlString == nullptr) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "HTML string is null");
+        return allocateString("{}");
+    }
+    if (!validateParseLength(htmlLen, viewportWidth)) {
+        return allocateString("{}");
+    }
+    g_lastMetrics.inputSize = htmlLen;
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        WasmContainer container(viewportWidth, 10000);
+        
+        std::string jsonResult;
+        std::string error;
+        ErrorCode code = measureDocument(container, htmlString, htmlLen, cssString, viewportWidth, options, 
+                                         jsonResult, error);
+        if (code != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(code, error);
+            return allocateString("{}");
+        }
+        
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        finishMeasureResult(jsonResult);
+        
+        DEBUG_LOG("Measure completed (total=" << formatDuration(g_lastMetrics.totalTime) << ")");
+        
+        return allocateString(jsonResult);
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("{}");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("{}");
+    }
+}
+
+/**
+ * @brief Measure a batch of HTML documents at one width (批量测量 HTML 尺寸)
+ * @param htmlStrings Array of itemCount pointers to HTML strings
+ * @param itemCount Number of documents
+ * @param cssString External CSS shared by all items (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param optionsJson Additional options as JSON string (optional, currently unused)
+ * @return JSON array with one measureHTML() object per item, in order
+ *         (caller must free with freeString)
+ * 
+ * Invalid or empty items produce null entries and a warning instead of
+ * failing the batch. getMetrics() sums parse, layout and serialize times
+ * over the items and reports itemCount.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* measureHTMLBatch(
+    const char* const* htmlStrings,
+    int itemCount,
+    const char* cssString,
+    int viewportWidth,
+    const char* optionsJson
+) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    
+    if (htmlStrings == nullptr || itemCount < 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "Item array is null");
+        return allocateString("[]");
+    }
+    if (viewportWidth <= 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, 
+            "Viewport width must be positive, got: " + std::to_string(viewportWidth));
+        return allocateString("[]");
+    }
+    g_lastMetrics.itemCount = itemCount;
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        WasmContainer container(viewportWidth, 10000);
+        
+        std::string jsonResult = "[";
+        for (int i = 0; i < itemCount; ++i) {
+            if (i > 0) {
+                jsonResult += ",";
+            }
+            const char* html = htmlStrings[i];
+            if (html == nullptr || *html == '\0') {
+                g_lastParseResult.addWarning(ErrorCode::EmptyHtml, "Item " + std::to_string(i) + " is empty");
+                jsonResult += "null";
+                continue;
+            }
+            size_t htmlLen = strlen(html);
+            g_lastMetrics.inputSize += htmlLen;
+            std::string error;
+            ErrorCode code = measureDocument(container, html, htmlLen, cssString, viewportWidth, options, 
+                                             jsonResult, error);
+            if (code != ErrorCode::Success) {
+                g_lastParseResult.addWarning(code, "Item " + std::to_string(i) + ": " + error);
+                jsonResult += "null";
+            }
+        }
+        jsonResult += "]";
+        
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        finishMeasureResult(jsonResult);
+        
+        DEBUG_LOG("Measure batch completed (items=" << itemCount 
+                  << ", total=" << formatDuration(g_lastMetrics.totalTime) << ")");
+        
+        return allocateString(jsonResult);
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("[]");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("[]");
+    }
+}
+
+/**
+ * @brief One document of a parseHTMLBatch() call (批处理中的单个文档)
+ */
+struct BatchDocument {
+    const char* html = nullptr;
+    size_t htmlLen = 0;
+    std::unique_ptr<WasmContainer> container;
+    litehtml::document::ptr doc;
+    ErrorCode error = ErrorCode::Success;   // Set when the item is skipped (跳过原因)
+    std::string message;
+    double parseTime = 0.0;
+    double layoutTime = 0.0;
+    double serializeTime = 0.0;
+    int characterCount = 0;
+    bool truncated = false;
+};
+
+/**
+ * @brief Parse a batch of HTML documents with one mode and options (批量解析 HTML)
+ * @param htmlStrings Array of itemCount pointers to HTML strings
+ * @param itemCount Number of documents
+ * @param cssString External CSS shared by all items (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional)
+ * @return JSON array with one parseHTML() result per item, in order
+ *         (caller must free with freeString)
+ * 
+ * Parse, layout + draw and serialize run as a pipeline (see
+ * batch_pipeline.h): in threaded builds each stage has its own thread, so
+ * the stages of neighbouring documents overlap. options.pipelineQueue
+ * bounds the documents waiting between two stages; 0 processes one document
+ * at a time. The output does not depend on the pipeline. Invalid or empty
+ * items produce null entries and a warning instead of failing the batch.
+ * The result cache and display lists are not used. getMetrics() sums the
+ * stage times over the items and reports itemCount, itemsPerSecond and the
+ * stageOccupancy of the three stages.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* parseHTMLBatch(
+    const char* const* htmlStrings,
+    int itemCount,
+    const char* cssString,
+    int viewportWidth,
+    const char* mode,
+    const char* optionsJson
+) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    g_heapBaseline = heapBytesInUse();
+    
+    if (htmlStrings == nullptr || itemCount < 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "Item array is null");
+        return allocateString("[]");
+    }
+    if (viewportWidth <= 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, 
+            "Viewport width must be positive, got: " + std::to_string(viewportWidth));
+        return allocateString("[]");
+    }
+    g_lastMetrics.itemCount = itemCount;
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    const OutputMode outputMode = JsonSerializer::parseMode(mode);
+    const int defaultViewportHeight = 10000;
+    const size_t cssLen = cssString != nullptr ? strlen(cssString) : 0;
+    const size_t MAX_HTML_SIZE = 10 * 1024 * 1024;
+    
+    std::vector<BatchDocument> items(static_cast<size_t>(itemCount));
+    for (size_t i = 0; i < items.size(); ++i) {
+        BatchDocument& item = items[i];
+        item.html = htmlStrings[i];
+        item.htmlLen = item.html != nullptr ? strlen(item.html) : 0;
+        if (item.htmlLen == 0) {
+            item.error = ErrorCode::EmptyHtml;
+            item.message = "Item " + std::to_string(i) + " is empty";
+        } else if (item.htmlLen > MAX_HTML_SIZE) {
+            item.error = ErrorCode::HtmlTooLarge;
+            item.message = "Item " + std::to_string(i) + " exceeds the maximum size (10MB), got: " + 
+                std::to_string(item.htmlLen) + " bytes";
+        }
+        g_lastMetrics.inputSize += item.htmlLen;
+    }
+    
+    // Stages run on different threads: they only touch their item, and the
+    // last stage alone appends to the output. A stage that throws fails its
+    // item only.
+    std::string jsonResult = "[";
+    auto failItem = [&](size_t i, const char* what) {
+        items[i].error = ErrorCode::InternalError;
+        items[i].message = "Exception during parsing of item " + std::to_string(i) + ": " + what;
+    };
+    auto parseStage = [&](size_t i) {
+        BatchDocument& item = items[i];
+        if (item.error != ErrorCode::Success) {
+            return;
+        }
+        auto startTime = std::chrono::high_resolution_clock::now();
+        try {
+            std::string fullHtml;
+            if (cssLen > 0) {
+                fullHtml.reserve(item.htmlLen + cssLen + 20);
+                fullHtml = "<style>";
+                fullHtml.append(cssString, cssLen);
+                fullHtml += "</style>";
+            }
+            fullHtml.append(item.html, item.htmlLen);
+            item.container.reset(new WasmContainer(viewportWidth, defaultViewportHeight));
+            applyComplexityLimit(*item.container, options);
+            item.doc = litehtml::document::createFromString(fullHtml.c_str(), item.container.get());
+            if (!item.doc) {
+                item.error = ErrorCode::DocumentCreationFailed;
+                item.message = "Failed to create document for item " + std::to_string(i);
+            } else {
+                std::string limitError;
+                item.error = complexityError(*item.doc, *item.container, options, limitError);
+                item.message = "Item " + std::to_string(i) + ": " + limitError;
+            }
+        } catch (const std::exception& e) {
+            failItem(i, e.what());
+        }
+        item.parseTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+    };
+    auto layoutStage = [&](size_t i) {
+        BatchDocument& item = items[i];
+        if (item.error != ErrorCode::Success) {
+            return;
+        }
+        auto startTime = std::chrono::high_resolution_clock::now();
+        try {
+            applyLayoutOptions(*item.doc, options);
+            item.doc->render(viewportWidth);
+            item.truncated = item.doc->layout_truncated();
+            litehtml::position clip(0, 0, viewportWidth, defaultViewportHeight);
+            item.doc->draw(0, 0, 0, &clip);
+            item.characterCount = static_cast<int>(item.container->getCharLayouts().size());
+            std::string limitError;
+            item.error = complexityError(*item.doc, *item.container, options, limitError);
+            item.message = "Item " + std::to_string(i) + ": " + limitError;
+        } catch (const std::exception& e) {
+            failItem(i, e.what());
+        }
+        item.layoutTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+    };
+    auto serializeStage = [&](size_t i) {
+        BatchDocument& item = items[i];
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::string output;
+        if (item.error == ErrorCode::Success) {
+            try {
+                Viewport viewport;
+                viewport.width = viewportWidth;
+                viewport.height = defaultViewportHeight;
+                output = JsonSerializer::serialize(item.container->getCharLayouts(), outputMode, viewport, 
+                                                   options.fields, options.compact, options.serializeThreads);
+            } catch (const std::exception& e) {
+                failItem(i, e.what());
+            }
+        }
+        if (i > 0) {
+            jsonResult += ",";
+        }
+        jsonResult += item.error == ErrorCode::Success ? output : "null";
+        // The document deletes its fonts through the container
+        item.doc.reset();
+        item.container.reset();
+        item.serializeTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+    };
+    
+    try {
+        PipelineStats stats = BatchPipeline::run(items.size(), { parseStage, layoutStage, serializeStage },
+                                                 static_cast<size_t>(options.pipelineQueue));
+        jsonResult += "]";
+        
+        for (const BatchDocument& item : items) {
+            if (item.error != ErrorCode::Success) {
+                g_lastParseResult.addWarning(item.error, item.message);
+            }
+            g_lastMetrics.parseTime += item.parseTime;
+            g_lastMetrics.layoutTime += item.layoutTime;
+            g_lastMetrics.serializeTime += item.serializeTime;
+            g_lastMetrics.characterCount += item.characterCount;
+            g_lastMetrics.truncated = g_lastMetrics.truncated || item.truncated;
+        }
+        g_lastMetrics.totalTime = stats.wallTime;
+        g_lastMetrics.outputSize = jsonResult.size();
+        if (stats.wallTime > 0) {
+            g_lastMetrics.itemsPerSecond = (itemCount * 1000.0) / stats.wallTime;
+        }
+        g_lastMetrics.parseOccupancy = stats.occupancy(0);
+        g_lastMetrics.layoutOccupancy = stats.occupancy(1);
+        g_lastMetrics.serializeOccupancy = stats.occupancy(2);
+        g_lastParseResult.data = jsonResult;
+        finishParseResult();
+        sampleHeap();
+        
+        DEBUG_LOG("Parse batch completed (items=" << itemCount 
+                  << ", total=" << formatDuration(g_lastMetrics.totalTime)
+                  << (stats.pipelined ? ", pipelined" : "") << ")");
+        
+        return allocateString(jsonResult);
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during parsing: ") + e.what());
+        return allocateString("[]");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during parsing");
+        return allocateString("[]");
+    }
+}
+
+/**
+ * @brief Get the display list recorded by the last parse (获取上次绘制列表)
+ * @return Pointer to the binary display list, NULL if none was recorded
+ * 
+ * The buffer is owned by the module and stays valid until the next parse
+ * or destroy(); do not pass it to freeString. See display_list.h for the
+ * binary layout.
+ */
+EMSCRIPTEN_KEEPALIVE
+const uint8_t* getDisplayList() {
+    return g_lastDisplayList.empty() ? nullptr : g_lastDisplayList.data();
+}
+
+/**
+ * @brief Get the size of the last display list in bytes (获取绘制列表字节数)
+ * @return Byte length, 0 if no display list was recorded
+ */
+EMSCRIPTEN_KEEPALIVE
+int getDisplayListSize() {
+    return static_cast<int>(g_lastDisplayList.size());
+}
+
+/**
+ * @brief Get the last parse result with diagnostics (获取最近解析结果)
+ * @return JSON string with ParseResult structure (caller must free with freeString)
+ * 
+ * @note Requirements: 8.1, 8.2, 8.4, 8.5
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* getLastParseResult() {
+    return allocateString(serializeParseResult(g_lastParseResult));
+}
+
+// ============================================================================
+// Template API
+// ============================================================================
+
+/**
+ * @brief Compile a template document with text slots (编译带插槽的模板文档)
+ * @param htmlString Template HTML; elements with a data-slot attribute are slots
+ * @param cssString External CSS (optional, can be NULL)
+ * @param viewportWidth Viewport width in pixels
+ * @param optionsJson Options as JSON string (optional); the complexity limits
+ *        other than maxGlyphs apply here
+ * @return Template handle (positive integer) on success, 0 on failure
+ * 
+ * The template is parsed and styled once. layoutTemplate() then replaces
+ * only the slot text and re-runs layout. Release with destroyTemplate().
+ * Error details are available from getLastParseResult().
+ */
+EMSCRIPTEN_KEEPALIVE
+int compileTemplate(const char* htmlString, const char* cssString, int viewportWidth, const char* optionsJson) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    
+    size_t htmlLen = 0;
+    if (!validateParseInput(htmlString, viewportWidth, htmlLen)) {
+        return 0;
+    }
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    DEBUG_LOG("Template compile started (length=" << formatBytes(htmlLen) << ", viewport=" << viewportWidth << "px)");
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        const int defaultViewportHeight = 10000;
+        std::unique_ptr<TemplateSession> session(new TemplateSession(viewportWidth, defaultViewportHeight));
+        applyComplexityLimit(session->getContainer(), options);
+        if (!session->compile(htmlString, cssString)) {
+            std::string limitError;
+            ErrorCode limitCode = session->getDocument()
+                ? complexityError(*session->getDocument(), session->getContainer(), options, limitError)
+                : ErrorCode::Success;
+            if (limitCode != ErrorCode::Success) {
+                g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            } else {
+                g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
+                    "Failed to create document from template HTML");
+            }
+            return 0;
+        }
+        
+        g_lastMetrics.inputSize = htmlLen;
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        g_lastMetrics.totalTime = g_lastMetrics.parseTime;
+        
+        if (session->getSlotCount() == 0) {
+            g_lastParseResult.addWarning(ErrorCode::InvalidTemplate, 
+                "Template has no data-slot elements; layouts will always be identical");
+        }
+        
+        int handle = g_nextTemplateHandle++;
+        DEBUG_LOG("Template compiled (handle=" << handle << ", slots=" << session->getSlotCount() << ")");
+        g_templates[handle] = std::move(session);
+        g_lastParseResult.success = true;
+        return handle;
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during template compile: ") + e.what());
+        return 0;
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during template compile");
+        return 0;
+    }
+}
+
 /**
- * @brief Parse HTML and calculate character layouts (解析 HTML 并计算字符布局)
- * @param htmlString HTML content
- * @param cssString External CSS (optional, can be NULL)
- * @param viewportWidth Viewport width in pixels
+ * @brief Lay out a compiled template with new slot values (使用新插槽值布局模板)
+ * @param handle Template handle from compileTemplate()
+ * @param slotValuesJson JSON array of strings or null, one per slot in document order;
+ *        null or missing entries keep the template text
  * @param mode Output mode: "full", "simple", "flat", or "byRow"
- * @param optionsJson Additional options as JSON string (optional)
+ * @param optionsJson Additional options as JSON string (optional, same keys as parseHTML)
  * @return JSON string with layout data (caller must free with freeString)
  * 
- * @note Requirements: 3.1, 3.4, 3.5, 3.6, 4.1, 7.1, 7.6, 8.1, 8.2, 8.4
+ * HTML parsing and style cascade are skipped: only slot text nodes are
+ * replaced and re-measured before layout. In the metrics, parseTime is the
+ * time spent updating slots.
  */
 EMSCRIPTEN_KEEPALIVE
-const char* parseHTML(
-    const char* htmlString,
-    const char* cssString,
-    int viewportWidth,
-    const char* mode,
-    const char* optionsJson
-) {
-    // Reset metrics and result
+const char* layoutTemplate(int handle, const char* slotValuesJson, const char* mode, const char* optionsJson) {
     g_lastMetrics = ParseMetrics();
     g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
     
-    DEBUG_LOG("=== Parse operation started ===");
-    
-    // Input validation - Requirements: 8.2, 8.4
-    if (htmlString == nullptr) {
-        DEBUG_LOG("Error: HTML string is null");
-        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidInput, "HTML string is null");
-        return allocateString("[]");
-    }
-    
-    size_t htmlLen = strlen(htmlString);
-    if (htmlLen == 0) {
-        DEBUG_LOG("Error: HTML string is empty");
-        g_lastParseResult = ParseResult::fail(ErrorCode::EmptyHtml, "HTML string is empty");
+    auto it = g_templates.find(handle);
+    if (it == g_templates.end()) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidTemplate, 
+            "Template handle not found: " + std::to_string(handle));
         return allocateString("[]");
     }
+    TemplateSession& session = *it->second;
     
-    if (viewportWidth <= 0) {
-        DEBUG_LOG("Error: Invalid viewport width: " << viewportWidth);
-        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidViewportWidth, 
-            "Viewport width must be positive, got: " + std::to_string(viewportWidth));
+    // Font handles inside the session are only valid for the font set it was compiled with
+    if (session.getFontGeneration() != MultiFontManager::getInstance().getGeneration()) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::FontSetChanged, 
+            "Fonts changed after the template was compiled; compile it again");
         return allocateString("[]");
     }
     
-    // Check for excessively large input (>10MB)
-    const size_t MAX_HTML_SIZE = 10 * 1024 * 1024;
-    if (htmlLen > MAX_HTML_SIZE) {
-        DEBUG_LOG("Error: HTML too large: " << formatBytes(htmlLen));
-        g_lastParseResult = ParseResult::fail(ErrorCode::HtmlTooLarge, 
-            "HTML size exceeds maximum allowed (10MB), got: " + std::to_string(htmlLen) + " bytes");
+    std::vector<SlotValue> values;
+    std::string valuesError;
+    if (!TemplateSession::parseSlotValues(slotValuesJson, values, valuesError)) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidSlotValues, 
+            "Invalid slot values JSON: " + valuesError);
         return allocateString("[]");
     }
     
-    g_lastMetrics.inputSize = htmlLen;
-    
-    DEBUG_LOG("HTML parsing started (length=" << formatBytes(htmlLen) << ", viewport=" << viewportWidth << "px)");
-    
-    // Log CSS info if provided
-    if (cssString != nullptr && strlen(cssString) > 0) {
-        DEBUG_LOG("External CSS provided (length=" << formatBytes(strlen(cssString)) << ")");
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
     }
     
     try {
-        // Start timing
         auto startTime = std::chrono::high_resolution_clock::now();
         
-        // Default viewport height
-        const int defaultViewportHeight = 10000;
-        
-        // Create container
-        WasmContainer container(viewportWidth, defaultViewportHeight);
-        
-        // Parse HTML
-        auto parseStartTime = std::chrono::high_resolution_clock::now();
-        
-        // Build HTML with optional external CSS
-        // Use reserve to minimize string reallocations
-        std::string fullHtml;
-        if (cssString != nullptr && strlen(cssString) > 0) {
-            size_t cssLen = strlen(cssString);
-            fullHtml.reserve(htmlLen + cssLen + 20); // +20 for <style></style> tags
-            fullHtml = "<style>";
-            fullHtml += cssString;
-            fullHtml += "</style>";
-            fullHtml += htmlString;
-            
-            DEBUG_LOG("CSS parsing started");
-        } else {
-            fullHtml = htmlString;
-        }
-        
-        litehtml::document::ptr doc = litehtml::document::createFromString(
-            fullHtml.c_str(),
-            &container
-        );
+        session.setSlotValues(values);
         
-        if (!doc) {
-            DEBUG_LOG("Error: Failed to create document");
-            g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
-                "Failed to create document from HTML string");
+        auto layoutStartTime = std::chrono::high_resolution_clock::now();
+        // Of the complexity limits only maxGlyphs applies: the tree was built by compileTemplate()
+        applyComplexityLimit(session.getContainer(), options);
+        applyLayoutOptions(*session.getDocument(), options);
+        const std::vector<CharLayout>& layouts = session.layout(options.displayList);
+        g_lastMetrics.truncated = session.getDocument()->layout_truncated();
+        std::string limitError;
+        ErrorCode limitCode = complexityError(*session.getDocument(), session.getContainer(), options, limitError);
+        if (limitCode != ErrorCode::Success) {
+            session.getContainer().clearCharLayouts();
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
             return allocateString("[]");
         }
-        
-        auto parseEndTime = std::chrono::high_resolution_clock::now();
-        double parseTime = std::chrono::duration<double, std::milli>(parseEndTime - parseStartTime).count();
-        
-        DEBUG_LOG_TIMING("HTML parsing", parseTime);
-        if (cssString != nullptr && strlen(cssString) > 0) {
-            DEBUG_LOG_TIMING("CSS parsing", parseTime); // CSS is parsed together with HTML
+        if (options.displayList) {
+            g_lastDisplayList = session.getContainer().getDisplayList().release();
         }
-        
-        // Render and layout
-        DEBUG_LOG("Layout calculation started (viewport=" << viewportWidth << "x" << defaultViewportHeight << ")");
-        auto layoutStartTime = std::chrono::high_resolution_clock::now();
-        
-        doc->render(viewportWidth);
-        
-        // Draw to collect character layouts
-        litehtml::position clip(0, 0, viewportWidth, defaultViewportHeight);
-        doc->draw(0, 0, 0, &clip);
-        
         auto layoutEndTime = std::chrono::high_resolution_clock::now();
-        double layoutTime = std::chrono::duration<double, std::milli>(layoutEndTime - layoutStartTime).count();
-        
-        // Get character layouts
-        const std::vector<CharLayout>& layouts = container.getCharLayouts();
-        g_lastMetrics.characterCount = static_cast<int>(layouts.size());
-        
-        DEBUG_LOG_TIMING("Layout calculation", layoutTime);
-        DEBUG_LOG("Characters extracted: " << layouts.size());
-        
-        // Parse output mode
-        OutputMode outputMode = JsonSerializer::parseMode(mode);
-        std::string modeStr = mode ? mode : "flat";
         
-        // Create viewport info
         Viewport viewport;
-        viewport.width = viewportWidth;
-        viewport.height = defaultViewportHeight;
-        
-        // Serialize to JSON
-        DEBUG_LOG("Serialization started (mode=" << modeStr << ")");
-        auto serializeStartTime = std::chrono::high_resolution_clock::now();
-        
-        std::string jsonResult = JsonSerializer::serialize(layouts, outputMode, viewport);
-        
+        viewport.width = session.getViewportWidth();
+        viewport.height = 10000;
+        std::string jsonResult = JsonSerializer::serialize(layouts, JsonSerializer::parseMode(mode), viewport, options.fields, options.compact,
+                                                           options.serializeThreads);
         auto serializeEndTime = std::chrono::high_resolution_clock::now();
-        double serializeTime = std::chrono::duration<double, std::milli>(serializeEndTime - serializeStartTime).count();
-        
-        DEBUG_LOG_TIMING("Serialization", serializeTime);
-        DEBUG_LOG("Output size: " << formatBytes(jsonResult.length()));
         
-        // Calculate timing metrics (in milliseconds)
-        g_lastMetrics.parseTime = parseTime;
-        g_lastMetrics.layoutTime = layoutTime;
-        g_lastMetrics.serializeTime = serializeTime;
+        g_lastMetrics.characterCount = static_cast<int>(layouts.size());
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(layoutStartTime - startTime).count();
+        g_lastMetrics.layoutTime = std::chrono::duration<double, std::milli>(layoutEndTime - layoutStartTime).count();
+        g_lastMetrics.serializeTime = std::chrono::duration<double, std::milli>(serializeEndTime - layoutEndTime).count();
         g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(serializeEndTime - startTime).count();
-        
-        // Calculate characters per second
         if (g_lastMetrics.totalTime > 0) {
             g_lastMetrics.charsPerSecond = (g_lastMetrics.characterCount * 1000.0) / g_lastMetrics.totalTime;
         }
         
-        // Update parse result with success
         g_lastParseResult.success = true;
         g_lastParseResult.data = jsonResult;
         g_lastParseResult.metrics.parseTime = g_lastMetrics.parseTime;
@@ -442,98 +2149,256 @@ const char* parseHTML(
         g_lastParseResult.metrics.serializeTime = g_lastMetrics.serializeTime;
         g_lastParseResult.metrics.totalTime = g_lastMetrics.totalTime;
         g_lastParseResult.metrics.characterCount = g_lastMetrics.characterCount;
-        g_lastParseResult.metrics.inputSize = g_lastMetrics.inputSize;
         g_lastParseResult.metrics.charsPerSecond = g_lastMetrics.charsPerSecond;
         g_lastParseResult.metrics.memoryUsed = MultiFontManager::getInstance().getTotalMemoryUsage();
         g_lastParseResult.metricsEnabled = true;
         
-        // Add warning if no characters were extracted
-        if (layouts.empty()) {
-            DEBUG_LOG("Warning: No characters extracted from HTML");
-            g_lastParseResult.addWarning(ErrorCode::InvalidInput, 
-                "No characters were extracted from the HTML. The document may be empty or contain only non-text elements.");
-        }
-        
-        // Check memory threshold and add warning if exceeded
-        MultiFontManager& manager = MultiFontManager::getInstance();
-        if (manager.checkMemoryThreshold()) {
-            DEBUG_LOG("Warning: Memory usage exceeds 50MB threshold");
-            g_lastParseResult.addWarning(ErrorCode::FontMemoryExceeded, 
-                "Memory usage exceeds 50MB threshold. Consider unloading unused fonts.");
-        }
-        
-        // Log memory usage
-        DEBUG_LOG_MEMORY(manager.getTotalMemoryUsage(), manager.getLoadedFontCount());
-        
-        // Clear character layouts to release memory
-        container.clearCharLayouts();
+        session.getContainer().clearCharLayouts();
         
-        DEBUG_LOG("=== Parse operation completed (total=" << formatDuration(g_lastMetrics.totalTime) 
-                  << ", chars=" << g_lastMetrics.characterCount 
-                  << ", speed=" << static_cast<int>(g_lastMetrics.charsPerSecond) << " chars/sec) ===");
+        DEBUG_LOG("Template layout completed (handle=" << handle << ", total=" 
+                  << formatDuration(g_lastMetrics.totalTime) << ", chars=" << g_lastMetrics.characterCount << ")");
         
         return allocateString(jsonResult);
         
     } catch (const std::exception& e) {
-        DEBUG_LOG("Error: Exception during parsing: " << e.what());
         g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
-            std::string("Exception during parsing: ") + e.what());
+            std::string("Exception during template layout: ") + e.what());
         return allocateString("[]");
     } catch (...) {
-        DEBUG_LOG("Error: Unknown exception during parsing");
         g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
-            "Unknown exception occurred during parsing");
+            "Unknown exception occurred during template layout");
         return allocateString("[]");
     }
 }
 
 /**
- * @brief Parse HTML and return result with diagnostics (解析并返回诊断结果)
+ * @brief Get the slot names of a compiled template (获取模板插槽名称)
+ * @param handle Template handle from compileTemplate()
+ * @return JSON array of data-slot values in document order, "[]" for an unknown
+ *         handle (caller must free with freeString)
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* getTemplateSlots(int handle) {
+    auto it = g_templates.find(handle);
+    if (it == g_templates.end()) {
+        return allocateString("[]");
+    }
+    return allocateString(it->second->getSlotsJson());
+}
+
+/**
+ * @brief Destroy a compiled template and release its document (销毁模板)
+ * @param handle Template handle from compileTemplate()
+ */
+EMSCRIPTEN_KEEPALIVE
+void destroyTemplate(int handle) {
+    g_templates.erase(handle);
+}
+
+// ============================================================================
+// Snapshot API
+// ============================================================================
+
+/**
+ * @brief Parse and style a document into a snapshot (创建预样式文档快照)
  * @param htmlString HTML content
  * @param cssString External CSS (optional, can be NULL)
- * @param viewportWidth Viewport width in pixels
- * @param mode Output mode: "full", "simple", "flat", or "byRow"
- * @param optionsJson Additional options as JSON string (optional)
- * @return JSON string with ParseResult structure (caller must free with freeString)
- * 
- * This function returns a structured result including:
- * - success: boolean indicating if parsing succeeded
- * - data: parsed layout data (if successful)
- * - errors: array of errors (if any)
- * - warnings: array of warnings (if any)
- * - metrics: performance metrics
+ * @param viewportWidth Viewport width the styles are computed for
+ * @param optionsJson Options as JSON string (optional); the complexity limits
+ *        other than maxGlyphs apply here
+ * @return Snapshot size in bytes, 0 on failure
  * 
- * @note Requirements: 8.1, 8.2, 8.4, 8.5
+ * The snapshot holds the element tree, computed styles and font
+ * descriptors; read it with getSnapshot(). It stays valid until the next
+ * createSnapshot() or destroy(). Error details are available from
+ * getLastParseResult().
  */
 EMSCRIPTEN_KEEPALIVE
-const char* parseHTMLWithDiagnostics(
-    const char* htmlString,
-    const char* cssString,
-    int viewportWidth,
-    const char* mode,
-    const char* optionsJson
-) {
-    // Call the regular parseHTML to do the actual work
-    const char* result = parseHTML(htmlString, cssString, viewportWidth, mode, optionsJson);
+int createSnapshot(const char* htmlString, const char* cssString, int viewportWidth, const char* optionsJson) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    std::vector<uint8_t>().swap(g_lastSnapshot);
     
-    // Free the result since we'll return a different format
-    if (result) {
-        free(const_cast<char*>(result));
+    size_t htmlLen = 0;
+    if (!validateParseInput(htmlString, viewportWidth, htmlLen)) {
+        return 0;
     }
     
-    // Return the structured result
-    return allocateString(serializeParseResult(g_lastParseResult));
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        std::string fullHtml;
+        if (cssString != nullptr && *cssString != '\0') {
+            fullHtml = "<style>";
+            fullHtml += cssString;
+            fullHtml += "</style>";
+        }
+        fullHtml += htmlString;
+        
+        const int defaultViewportHeight = 10000;
+        WasmContainer container(viewportWidth, defaultViewportHeight);
+        applyComplexityLimit(container, options);
+        litehtml::document::ptr doc = litehtml::document::createFromString(fullHtml.c_str(), &container);
+        std::string limitError;
+        ErrorCode limitCode = doc ? complexityError(*doc, container, options, limitError) : ErrorCode::Success;
+        if (limitCode != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            return 0;
+        }
+        if (!doc || !doc->root()) {
+            g_lastParseResult = ParseResult::fail(ErrorCode::DocumentCreationFailed, 
+                "Failed to create document from HTML string");
+            return 0;
+        }
+        auto parseEndTime = std::chrono::high_resolution_clock::now();
+        
+        g_lastSnapshot = DocumentSnapshot::save(*doc, viewportWidth, defaultViewportHeight);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        
+        g_lastMetrics.inputSize = htmlLen;
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(parseEndTime - startTime).count();
+        g_lastMetrics.serializeTime = std::chrono::duration<double, std::milli>(endTime - parseEndTime).count();
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        g_lastMetrics.outputSize = g_lastSnapshot.size();
+        g_lastParseResult.success = true;
+        
+        DEBUG_LOG("Snapshot created (size=" << formatBytes(g_lastSnapshot.size()) 
+                  << ", parse=" << formatDuration(g_lastMetrics.parseTime) << ")");
+        return static_cast<int>(g_lastSnapshot.size());
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during snapshot creation: ") + e.what());
+        return 0;
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during snapshot creation");
+        return 0;
+    }
 }
 
 /**
- * @brief Get the last parse result with diagnostics (获取最近解析结果)
- * @return JSON string with ParseResult structure (caller must free with freeString)
+ * @brief Get the bytes of the last snapshot (获取快照字节)
+ * @return Pointer to getSnapshotSize() bytes, NULL if there is no snapshot
+ */
+EMSCRIPTEN_KEEPALIVE
+const uint8_t* getSnapshot() {
+    return g_lastSnapshot.empty() ? nullptr : g_lastSnapshot.data();
+}
+
+/**
+ * @brief Get the size of the last snapshot in bytes (获取快照大小)
+ */
+EMSCRIPTEN_KEEPALIVE
+int getSnapshotSize() {
+    return static_cast<int>(g_lastSnapshot.size());
+}
+
+/**
+ * @brief Lay out a document loaded from a snapshot (从快照加载并布局文档)
+ * @param snapshot Snapshot bytes from createSnapshot(), possibly from another process
+ * @param snapshotSize Snapshot size in bytes
+ * @param viewportWidth Layout width in pixels, 0 for the width the snapshot was styled at
+ * @param mode Output mode: "full", "simple", "flat", or "byRow"
+ * @param optionsJson Additional options as JSON string (optional, same keys as parseHTML)
+ * @return JSON string with layout data (caller must free with freeString)
  * 
- * @note Requirements: 8.1, 8.2, 8.4, 8.5
+ * HTML parsing, CSS parsing and selector matching are skipped; in the
+ * metrics, parseTime is the time spent loading the snapshot. Styles keep
+ * the values computed at the snapshot viewport (vw units, media queries).
+ * Fonts are looked up by family name, so load the same fonts as when the
+ * snapshot was created.
  */
 EMSCRIPTEN_KEEPALIVE
-const char* getLastParseResult() {
-    return allocateString(serializeParseResult(g_lastParseResult));
+const char* parseSnapshot(const uint8_t* snapshot, size_t snapshotSize, int viewportWidth,
+                          const char* mode, const char* optionsJson) {
+    g_lastMetrics = ParseMetrics();
+    g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    g_heapBaseline = heapBytesInUse();
+    
+    if (viewportWidth <= 0) {
+        viewportWidth = DocumentSnapshot::viewportWidth(snapshot, snapshotSize);
+    }
+    if (viewportWidth <= 0) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InvalidSnapshot, "Not a document snapshot");
+        return allocateString("[]");
+    }
+    
+    ParseOptions options;
+    std::string optionsError;
+    if (!ParseOptions::fromJson(optionsJson, options, optionsError)) {
+        g_lastParseResult.addWarning(ErrorCode::InvalidOptions, "Invalid options JSON: " + optionsError);
+    }
+    g_lastMetrics.inputSize = snapshotSize;
+    
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        const int defaultViewportHeight = 10000;
+        WasmContainer container(viewportWidth, defaultViewportHeight);
+        // Of the complexity limits only maxGlyphs applies: the tree is not built from HTML
+        applyComplexityLimit(container, options);
+        std::string loadError;
+        litehtml::document::ptr doc = DocumentSnapshot::load(snapshot, snapshotSize, &container, loadError);
+        if (!doc) {
+            g_lastParseResult = ParseResult::fail(ErrorCode::InvalidSnapshot, 
+                "Invalid document snapshot: " + loadError);
+            return allocateString("[]");
+        }
+        g_lastMetrics.parseTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        DEBUG_LOG_TIMING("Snapshot load", g_lastMetrics.parseTime);
+        
+        layoutDocument(container, *doc, viewportWidth, defaultViewportHeight, options);
+        std::string limitError;
+        ErrorCode limitCode = complexityError(*doc, container, options, limitError);
+        if (limitCode != ErrorCode::Success) {
+            g_lastParseResult = ParseResult::fail(limitCode, limitError);
+            return allocateString("[]");
+        }
+        const std::vector<CharLayout>& layouts = container.getCharLayouts();
+        
+        Viewport viewport;
+        viewport.width = viewportWidth;
+        viewport.height = defaultViewportHeight;
+        
+        auto serializeStartTime = std::chrono::high_resolution_clock::now();
+        std::string jsonResult = JsonSerializer::serialize(layouts, JsonSerializer::parseMode(mode), viewport, options.fields, options.compact,
+                                                           options.serializeThreads);
+        auto serializeEndTime = std::chrono::high_resolution_clock::now();
+        
+        g_lastMetrics.serializeTime = std::chrono::duration<double, std::milli>(serializeEndTime - serializeStartTime).count();
+        g_lastMetrics.totalTime = std::chrono::duration<double, std::milli>(serializeEndTime - startTime).count();
+        g_lastMetrics.outputSize = jsonResult.size();
+        g_lastParseResult.data = jsonResult;
+        finishParseResult();
+        
+        container.clearCharLayouts();
+        
+        DEBUG_LOG("Snapshot layout completed (total=" << formatDuration(g_lastMetrics.totalTime) 
+                  << ", chars=" << g_lastMetrics.characterCount << ")");
+        
+        char* output = allocateString(jsonResult);
+        sampleHeap();
+        return output;
+        
+    } catch (const std::exception& e) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::InternalError, 
+            std::string("Exception during snapshot layout: ") + e.what());
+        return allocateString("[]");
+    } catch (...) {
+        g_lastParseResult = ParseResult::fail(ErrorCode::UnknownError, 
+            "Unknown exception occurred during snapshot layout");
+        return allocateString("[]");
+    }
 }
 
 // ============================================================================
@@ -573,6 +2438,9 @@ EMSCRIPTEN_KEEPALIVE
 void destroy() {
     DEBUG_LOG("Destroying parser and releasing all resources");
     
+    // Release template documents before the fonts they reference
+    g_templates.clear();
+    
     // Clear all fonts (releases FreeType resources)
     MultiFontManager& manager = MultiFontManager::getInstance();
     manager.clearAllFonts();
@@ -580,6 +2448,11 @@ void destroy() {
     // Reset metrics
     g_lastMetrics = ParseMetrics();
     g_lastParseResult = ParseResult();
+    std::vector<uint8_t>().swap(g_lastDisplayList);
+    std::vector<uint8_t>().swap(g_lastSnapshot);
+    
+    // Disable and drop the result cache
+    ResultCache::getInstance().setBudget(0);
     
     // Reset debug mode
     g_isDebug = false;
@@ -654,6 +2527,7 @@ const char* getVersion() {
  * - characterCount: Number of characters processed
  * - inputSize: Input HTML size (bytes)
  * - charsPerSecond: Processing speed (chars/sec)
+ * - cacheHit: true if the result was served from the result cache
  * - memory: Memory usage information
  * 
  * @note Requirements: 8.5, 7.6
@@ -673,6 +2547,20 @@ const char* getMetrics() {
     oss << "\"characterCount\":" << g_lastMetrics.characterCount << ",";
     oss << "\"inputSize\":" << g_lastMetrics.inputSize << ",";
     oss << "\"charsPerSecond\":" << g_lastMetrics.charsPerSecond << ",";
+    oss << "\"cacheHit\":" << (g_lastMetrics.cacheHit ? "true" : "false") << ",";
+    oss << "\"widthCount\":" << g_lastMetrics.widthCount << ",";
+    oss << "\"mediaRestyles\":" << g_lastMetrics.mediaRestyles << ",";
+    oss << "\"sharedTimeSaved\":" << g_lastMetrics.sharedTimeSaved << ",";
+    oss << "\"fitProbes\":" << g_lastMetrics.fitProbes << ",";
+    oss << "\"itemCount\":" << g_lastMetrics.itemCount << ",";
+    oss << "\"itemsPerSecond\":" << g_lastMetrics.itemsPerSecond << ",";
+    oss << "\"stageOccupancy\":{\"parse\":" << g_lastMetrics.parseOccupancy
+        << ",\"layout\":" << g_lastMetrics.layoutOccupancy
+        << ",\"serialize\":" << g_lastMetrics.serializeOccupancy << "},";
+    oss << "\"truncated\":" << (g_lastMetrics.truncated ? "true" : "false") << ",";
+    oss << "\"outputSize\":" << g_lastMetrics.outputSize << ",";
+    oss << "\"chunkCount\":" << g_lastMetrics.chunkCount << ",";
+    oss << "\"peakMemory\":" << g_lastMetrics.peakMemory << ",";
     
     // Memory metrics
     oss << "\"memory\":{";
@@ -768,6 +2656,8 @@ const char* getDetailedMetrics() {
  * - entries: total cached entries
  * - hitRate: cache hit rate (0.0-1.0, null if no queries)
  * - memoryUsage: estimated memory usage in bytes
+ * - resultCache: layout result cache statistics (enabled, hits, misses,
+ *   evictions, entries, hitRate, memoryUsage, budget)
  * 
  * @note Requirements: 7.7, 7.8
  */
@@ -789,7 +2679,8 @@ const char* getCacheStats() {
     } else {
         oss << "\"hitRate\":null,";
     }
-    oss << "\"memoryUsage\":" << cache.getMemoryUsage();
+    oss << "\"memoryUsage\":" << cache.getMemoryUsage() << ",";
+    oss << "\"resultCache\":" << ResultCache::getInstance().getStatsJson();
     oss << "}";
     
     return allocateString(oss.str());
@@ -806,22 +2697,40 @@ const char* getCacheStats() {
 EMSCRIPTEN_KEEPALIVE
 void resetCacheStats() {
     FontMetricsCache::getInstance().resetStats();
+    ResultCache::getInstance().resetStats();
     DEBUG_LOG("Cache statistics reset");
 }
 
 /**
  * @brief Clear all font metrics caches (清除所有字体度量缓存)
  * 
- * Clears all cached character width data. This is automatically
- * called when fonts are unloaded, but can be called manually
- * to free memory.
+ * Clears all cached character width data and cached layout results.
+ * This is automatically done when fonts are unloaded, but can be
+ * called manually to free memory.
  * 
  * @note Requirements: 7.7, 7.8
  */
 EMSCRIPTEN_KEEPALIVE
 void clearCache() {
     FontMetricsCache::getInstance().clearAll();
-    DEBUG_LOG("Font metrics cache cleared");
+    ResultCache::getInstance().clear();
+    DEBUG_LOG("Font metrics cache and result cache cleared");
+}
+
+/**
+ * @brief Enable or disable the layout result cache (设置结果缓存预算)
+ * @param maxBytes Byte budget for cached results; 0 disables the cache
+ * 
+ * When enabled, parseHTML returns the stored output for a repeated
+ * (html, css, viewportWidth, mode, optionsJson) tuple without parsing.
+ * Entries are evicted least-recently-used first once the budget is
+ * exceeded, and all entries are dropped when fonts are loaded, unloaded
+ * or the default font changes.
+ */
+EMSCRIPTEN_KEEPALIVE
+void setResultCacheBudget(int maxBytes) {
+    ResultCache::getInstance().setBudget(maxBytes > 0 ? static_cast<size_t>(maxBytes) : 0);
+    DEBUG_LOG("Result cache budget set to " << formatBytes(maxBytes > 0 ? maxBytes : 0));
 }
 
 } // extern "C"
@@ -49,6 +49,8 @@ export interface EmscriptenModule {
     mode: number
   ): number;
   
+  _parseHTMLSized(htmlPtr: number, htmlLen: number, cssPtr: number, cssLen: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  
   _parseHTMLWithDiagnostics(
     htmlPtr: number,
     cssPtr: number,
@@ -57,7 +59,24 @@ export interface EmscriptenModule {
     enableMetrics: number
   ): number;
   
+  _parseHTMLStream(htmlPtr: number, cssPtr: number, viewportWidth: number, modePtr: number, optionsPtr: number, chunkSize: number): number;
+  onParseChunk?: (ptr: number, size: number) => boolean | void;
   _getLastParseResult(): number;
+  _measureHTML(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _measureHTMLBatch(htmlPtrsPtr: number, itemCount: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _parseHTMLBatch(htmlPtrsPtr: number, itemCount: number, cssPtr: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  _fitToBox(htmlPtr: number, cssPtr: number, boxWidth: number, boxHeight: number, minSize: number, maxSize: number, modePtr: number, optionsPtr: number): number;
+  _parseHTMLMultiWidth(htmlPtr: number, cssPtr: number, widthsPtr: number, widthCount: number, modePtr: number, optionsPtr: number): number;
+  _compileTemplate(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _layoutTemplate(handle: number, valuesPtr: number, modePtr: number, optionsPtr: number): number;
+  _getTemplateSlots(handle: number): number;
+  _destroyTemplate(handle: number): void;
+  _createSnapshot(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _getSnapshot(): number;
+  _getSnapshotSize(): number;
+  _parseSnapshot(snapshotPtr: number, snapshotSize: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  _getDisplayList(): number;
+  _getDisplayListSize(): number;
   _freeString(ptr: number): void;
   
   // Version and info
@@ -81,6 +100,7 @@ export interface EmscriptenModule {
   _getCacheStats(): number;
   _resetCacheStats(): void;
   _clearCache(): void;
+  _setResultCacheBudget(maxBytes: number): void;
 
   // Module lifecycle
   onRuntimeInitialized?: () => void;
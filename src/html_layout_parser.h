@@ -0,0 +1,107 @@
+/**
+ * @file html_layout_parser.h
+ * @brief HTML Layout Parser v2.0 - C API (C 接口声明)
+ *
+ * Declarations of the functions defined in html_layout_parser.cpp. The WASM
+ * build exports them through EXPORTED_FUNCTIONS; native hosts (the Node addon
+ * in node-addon/) link the same sources and call them directly.
+ *
+ * Conventions:
+ * - Returned strings are allocated by the parser; release them with freeString()
+ * - parseHTMLStream() is WASM-only (it calls Module.onParseChunk); native
+ *   hosts use parseHTMLToStream() with their own callback
+ * - The parser keeps global state (fonts, last metrics, last result); calls
+ *   must not run concurrently
+ */
+
+#ifndef WASM_V2_HTML_LAYOUT_PARSER_H
+#define WASM_V2_HTML_LAYOUT_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+
+/**
+ * @brief Receives one chunk of streamed output (流式输出回调)
+ *
+ * The bytes are only valid during the call. Return non-zero to continue,
+ * 0 to stop the stream.
+ */
+typedef int (*ParseChunkCallback)(const char* data, size_t size, void* userData);
+
+// Debug mode (调试模式)
+void setDebugMode(bool isDebug);
+bool getDebugMode();
+
+// Font management (字体管理)
+int loadFont(const uint8_t* fontData, int fontDataSize, const char* fontName);
+void unloadFont(int fontId);
+void setDefaultFont(int fontId);
+const char* getLoadedFonts();
+void clearAllFonts();
+
+// Parsing (解析)
+const char* parseHTML(const char* htmlString, const char* cssString, int viewportWidth,
+                      const char* mode, const char* optionsJson);
+const char* parseHTMLBytes(const char* htmlString, size_t htmlLen, const char* cssString,
+                           int viewportWidth, const char* mode, const char* optionsJson);
+const char* parseHTMLSized(const char* htmlString, size_t htmlLen, const char* cssString, size_t cssLen,
+                           int viewportWidth, const char* mode, const char* optionsJson);
+int parseHTMLToStream(const char* htmlString, size_t htmlLen, const char* cssString, int viewportWidth,
+                      const char* mode, const char* optionsJson, size_t chunkSize,
+                      ParseChunkCallback onChunk, void* userData);
+const char* parseHTMLWithDiagnostics(const char* htmlString, const char* cssString, int viewportWidth,
+                                     const char* mode, const char* optionsJson);
+const char* parseHTMLMultiWidth(const char* htmlString, const char* cssString, const int* widths,
+                                int widthCount, const char* mode, const char* optionsJson);
+const char* parseHTMLBatch(const char* const* htmlStrings, int itemCount, const char* cssString,
+                           int viewportWidth, const char* mode, const char* optionsJson);
+const char* fitToBox(const char* htmlString, const char* cssString, int boxWidth, int boxHeight,
+                     float minSize, float maxSize, const char* mode, const char* optionsJson);
+
+// Measurement (测量)
+const char* measureHTML(const char* htmlString, const char* cssString, int viewportWidth,
+                        const char* optionsJson);
+const char* measureHTMLBytes(const char* htmlString, size_t htmlLen, const char* cssString,
+                             int viewportWidth, const char* optionsJson);
+const char* measureHTMLBatch(const char* const* htmlStrings, int itemCount, const char* cssString,
+                             int viewportWidth, const char* optionsJson);
+
+// Results (结果)
+const uint8_t* getDisplayList();
+int getDisplayListSize();
+const char* getLastParseResult();
+
+// Templates (模板)
+int compileTemplate(const char* htmlString, const char* cssString, int viewportWidth, const char* optionsJson);
+const char* layoutTemplate(int handle, const char* slotValuesJson, const char* mode, const char* optionsJson);
+const char* getTemplateSlots(int handle);
+void destroyTemplate(int handle);
+
+// Snapshots (快照)
+int createSnapshot(const char* htmlString, const char* cssString, int viewportWidth, const char* optionsJson);
+const uint8_t* getSnapshot();
+int getSnapshotSize();
+const char* parseSnapshot(const uint8_t* snapshot, size_t snapshotSize, int viewportWidth,
+                          const char* mode, const char* optionsJson);
+
+// Memory and lifecycle (内存与生命周期)
+void freeString(const char* str);
+void destroy();
+size_t getTotalMemoryUsage();
+bool checkMemoryThreshold();
+const char* getMemoryMetrics();
+
+// Metrics and caches (指标与缓存)
+const char* getVersion();
+const char* getMetrics();
+const char* getDetailedMetrics();
+const char* getCacheStats();
+void resetCacheStats();
+void clearCache();
+void setResultCacheBudget(int maxBytes);
+
+} // extern "C"
+
+#endif // WASM_V2_HTML_LAYOUT_PARSER_H
@@ -0,0 +1,217 @@
+/**
+ * @file json_reader.h
+ * @brief Minimal JSON reader for API arguments (API 参数的最小 JSON 读取器)
+ *
+ * The WASM API takes small JSON arguments (options objects, slot value
+ * arrays). This reader walks them in place without building a DOM:
+ * objects, arrays, strings, numbers, booleans, null, and skipping of
+ * arbitrary nested values.
+ */
+
+#ifndef WASM_V2_JSON_READER_H
+#define WASM_V2_JSON_READER_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Minimal cursor over a JSON text (最小 JSON 读取器)
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const char* text) : m_pos(text) {}
+
+    void skipWhitespace() {
+        while (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r') {
+            ++m_pos;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (*m_pos != c) {
+            return false;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    bool atEnd() {
+        skipWhitespace();
+        return *m_pos == '\0';
+    }
+
+    bool readString(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        out.clear();
+        while (*m_pos != '"') {
+            if (*m_pos == '\0') {
+                return false;
+            }
+            if (*m_pos == '\\') {
+                ++m_pos;
+                switch (*m_pos) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u':
+                        if (!readUnicodeEscape(out)) {
+                            return false;
+                        }
+                        continue;
+                    case '\0': return false;
+                    default: out += *m_pos; break;
+                }
+                ++m_pos;
+                continue;
+            }
+            out += *m_pos++;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    bool readBool(bool& out) {
+        skipWhitespace();
+        if (strncmp(m_pos, "true", 4) == 0) {
+            m_pos += 4;
+            out = true;
+            return true;
+        }
+        if (strncmp(m_pos, "false", 5) == 0) {
+            m_pos += 5;
+            out = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool readNumber(double& out) {
+        skipWhitespace();
+        if (*m_pos != '-' && (*m_pos < '0' || *m_pos > '9')) {
+            return false;
+        }
+        char* end = nullptr;
+        out = strtod(m_pos, &end);
+        if (end == m_pos) {
+            return false;
+        }
+        m_pos = end;
+        return true;
+    }
+
+    bool readNull() {
+        skipWhitespace();
+        if (strncmp(m_pos, "null", 4) == 0) {
+            m_pos += 4;
+            return true;
+        }
+        return false;
+    }
+
+    bool skipValue() {
+        skipWhitespace();
+        switch (*m_pos) {
+            case '"': {
+                std::string ignored;
+                return readString(ignored);
+            }
+            case '{':
+            case '[': {
+                char close = *m_pos == '{' ? '}' : ']';
+                bool isObject = *m_pos == '{';
+                ++m_pos;
+                if (consume(close)) {
+                    return true;
+                }
+                do {
+                    if (isObject) {
+                        std::string key;
+                        if (!readString(key) || !consume(':')) {
+                            return false;
+                        }
+                    }
+                    if (!skipValue()) {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume(close);
+            }
+            default: {
+                const char* start = m_pos;
+                while (*m_pos && strchr(",}] \t\n\r", *m_pos) == nullptr) {
+                    ++m_pos;
+                }
+                return m_pos != start;
+            }
+        }
+    }
+
+private:
+    bool readHex4(uint32_t& out) {
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = m_pos[i];
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') out |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') out |= static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+        }
+        m_pos += 4;
+        return true;
+    }
+
+    // m_pos is at the 'u' of "\uXXXX"; surrogate pairs are combined (解码 \u 转义)
+    bool readUnicodeEscape(std::string& out) {
+        ++m_pos;
+        uint32_t cp;
+        if (!readHex4(cp)) {
+            return false;
+        }
+        if (cp >= 0xD800 && cp <= 0xDBFF && m_pos[0] == '\\' && m_pos[1] == 'u') {
+            const char* save = m_pos;
+            m_pos += 2;
+            uint32_t low;
+            if (readHex4(low) && low >= 0xDC00 && low <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+                m_pos = save;
+            }
+        }
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            cp = 0xFFFD;  // Lone surrogate (孤立代理项)
+        }
+
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return true;
+    }
+
+    const char* m_pos;
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_JSON_READER_H
@@ -9,10 +9,11 @@
  * - byRow: Characters grouped by row (v1 isRow compatible)
  * 
  * Performance optimizations:
- * - Uses std::ostringstream for efficient string building
+ * - Writes to any std::ostream, so results can be streamed in chunks
  * - Pre-reserves capacity for vectors where possible
  * - Uses move semantics to avoid copies
  * - Inline escapeJson for common cases
+ * - Formats large flat arrays on worker threads (native and pthreads builds)
  * 
  * @note Requirements: 3.1, 3.2, 3.3, 3.4, 3.5, 3.6, 7.1
  */
@@ -22,7 +23,16 @@
 #include <sstream>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <cmath>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+// std::thread is only usable in WASM when built with -pthread
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define WASM_V2_SERIALIZE_THREADS 1
+#endif
 
 namespace wasm_litehtml_v2 {
 
@@ -53,7 +63,7 @@ static inline bool needsEscaping(const std::string& str) {
  * where we want to avoid creating intermediate strings.
  */
 [[maybe_unused]]
-static inline void writeEscapedJson(const std::string& str, std::ostringstream& oss) {
+static inline void writeEscapedJson(const std::string& str, std::ostream& oss) {
     // Fast path: no escaping needed (无需转义)
     if (!needsEscaping(str)) {
         oss << str;
@@ -83,6 +93,178 @@ static inline void writeEscapedJson(const std::string& str, std::ostringstream&
     }
 }
 
+/**
+ * @brief Writes the "key": prefixes of one JSON object (对象键写入器)
+ * 
+ * The first key opens the object, so optional fields need no comma
+ * bookkeeping; close() also handles an object with no keys.
+ */
+class ObjectKeys {
+public:
+    explicit ObjectKeys(std::ostream& oss) : m_oss(oss) {}
+    
+    std::ostream& operator()(const char* name) {
+        m_oss << m_separator << '"' << name << "\":";
+        m_separator = ',';
+        return m_oss;
+    }
+    
+    void close() {
+        if (m_separator == '{') {
+            m_oss << '{';
+        }
+        m_oss << '}';
+    }
+
+private:
+    std::ostream& m_oss;
+    char m_separator = '{';
+};
+
+// Fewest characters worth handing to a serializer thread
+static const size_t kMinCharsPerThread = 4096;
+
+// Thread limit for threads = 0 (automatic)
+static const int kMaxSerializeThreads = 8;
+
+// CharField bits stored in compact style entries rather than per character
+static const uint32_t kCompactStyleFields =
+    CharFieldFontFamily | CharFieldFontSize | CharFieldFontWeight | CharFieldFontStyle |
+    CharFieldColor | CharFieldBackgroundColor | CharFieldOpacity | CharFieldTextDecoration |
+    CharFieldLetterSpacing | CharFieldWordSpacing | CharFieldTransform | CharFieldDirection |
+    CharFieldFontId;
+
+// Style fields a full-mode run repeats; compact runs replace them with "s"
+static const uint32_t kRunStyleFields =
+    CharFieldFontFamily | CharFieldFontSize | CharFieldFontWeight | CharFieldFontStyle |
+    CharFieldColor | CharFieldBackgroundColor | CharFieldTextDecoration;
+
+/**
+ * @brief Deduplicated style entries of one compact document (紧凑格式样式表)
+ * 
+ * Consecutive characters usually share a style, so the previous character
+ * is checked first with isSameCompactStyle(). Otherwise the entry text is
+ * built and looked up, which also merges styles that differ only in fields
+ * excluded by options.fields.
+ */
+class CompactStyleTable {
+public:
+    explicit CompactStyleTable(uint32_t fields) : m_fields(fields) {}
+    
+    /**
+     * @brief Index of the style entry for a character, adding it if new (获取样式序号)
+     */
+    int indexOf(const CharLayout& layout) {
+        if (m_hasLast && JsonSerializer::isSameCompactStyle(m_last, layout)) {
+            return m_lastIndex;
+        }
+        
+        std::string entry = buildEntry(layout);
+        auto it = m_index.find(entry);
+        if (it == m_index.end()) {
+            it = m_index.emplace(std::move(entry), static_cast<int>(m_entries.size())).first;
+            m_entries.push_back(&it->first);
+        }
+        m_last = layout;
+        m_hasLast = true;
+        m_lastIndex = it->second;
+        return m_lastIndex;
+    }
+    
+    /**
+     * @brief Write the style table as a JSON array (写出样式表 JSON 数组)
+     */
+    void writeTo(std::ostream& out) const {
+        out << '[';
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            out << *m_entries[i];
+        }
+        out << ']';
+    }
+
+private:
+    std::string buildEntry(const CharLayout& layout) const {
+        std::ostringstream oss;
+        ObjectKeys key(oss);
+        const uint32_t fields = m_fields;
+        
+        if (fields & CharFieldFontFamily) {
+            key("f") << '"' << JsonSerializer::escapeJson(layout.fontFamily) << '"';
+        }
+        if (fields & CharFieldFontSize) {
+            key("fs") << layout.fontSize;
+        }
+        if ((fields & CharFieldFontWeight) && layout.fontWeight != 400) {
+            key("fw") << layout.fontWeight;
+        }
+        if ((fields & CharFieldFontStyle) && layout.fontStyle != "normal") {
+            key("st") << '"' << JsonSerializer::escapeJson(layout.fontStyle) << '"';
+        }
+        if ((fields & CharFieldColor) && layout.color != "#000000FF") {
+            key("c") << '"' << JsonSerializer::escapeJson(layout.color) << '"';
+        }
+        if ((fields & CharFieldBackgroundColor) && layout.backgroundColor != "#00000000") {
+            key("bg") << '"' << JsonSerializer::escapeJson(layout.backgroundColor) << '"';
+        }
+        if ((fields & CharFieldOpacity) && layout.opacity != 1.0f) {
+            key("op") << layout.opacity;
+        }
+        if (fields & CharFieldTextDecoration) {
+            const TextDecoration& decoration = layout.textDecoration;
+            std::ostringstream td;
+            ObjectKeys tdKey(td);
+            bool any = false;
+            if (decoration.underline) { tdKey("u") << "true"; any = true; }
+            if (decoration.overline) { tdKey("o") << "true"; any = true; }
+            if (decoration.lineThrough) { tdKey("l") << "true"; any = true; }
+            if (decoration.color != layout.color) {
+                tdKey("c") << '"' << JsonSerializer::escapeJson(decoration.color) << '"';
+                any = true;
+            }
+            if (decoration.style != "solid") {
+                tdKey("st") << '"' << JsonSerializer::escapeJson(decoration.style) << '"';
+                any = true;
+            }
+            if (decoration.thickness != 1.0f) { tdKey("th") << decoration.thickness; any = true; }
+            if (any) {
+                tdKey.close();
+                key("td") << td.str();
+            }
+        }
+        if ((fields & CharFieldLetterSpacing) && layout.letterSpacing != 0.0f) {
+            key("ls") << layout.letterSpacing;
+        }
+        if ((fields & CharFieldWordSpacing) && layout.wordSpacing != 0.0f) {
+            key("ws") << layout.wordSpacing;
+        }
+        if (fields & CharFieldTransform) {
+            const Transform& t = layout.transform;
+            if (t.scaleX != 1.0f || t.scaleY != 1.0f || t.skewX != 0.0f || t.skewY != 0.0f || t.rotate != 0.0f) {
+                key("tf") << '[' << t.scaleX << ',' << t.scaleY << ',' << t.skewX << ','
+                          << t.skewY << ',' << t.rotate << ']';
+            }
+        }
+        if ((fields & CharFieldDirection) && layout.direction != "ltr") {
+            key("d") << '"' << JsonSerializer::escapeJson(layout.direction) << '"';
+        }
+        if (fields & CharFieldFontId) {
+            key("id") << layout.fontId;
+        }
+        key.close();
+        return oss.str();
+    }
+    
+    uint32_t m_fields;
+    std::unordered_map<std::string, int> m_index;
+    std::vector<const std::string*> m_entries;  // Keys of m_index in index order
+    CharLayout m_last;
+    bool m_hasLast = false;
+    int m_lastIndex = 0;
+};
+
 // ============================================================================
 // Public Methods (公共方法)
 // ============================================================================
@@ -108,39 +290,219 @@ OutputMode JsonSerializer::parseMode(const char* modeStr) {
 std::string JsonSerializer::serialize(
     const std::vector<CharLayout>& layouts,
     OutputMode mode,
-    const Viewport& viewport
+    const Viewport& viewport,
+    uint32_t fields,
+    bool compact,
+    int threads
+) {
+    if (mode == OutputMode::Flat && !compact) {
+        CharFormat format;
+        format.fields = fields;
+        format.threads = threads;
+        std::vector<std::string> parts = formatFlatParallel(layouts, format);
+        if (!parts.empty()) {
+            // Join the ranges with one copy each into an exactly sized result
+            size_t size = parts.size() + 1;
+            for (const auto& part : parts) {
+                size += part.size();
+            }
+            std::string json;
+            json.reserve(size);
+            json += '[';
+            for (size_t i = 0; i < parts.size(); ++i) {
+                if (i > 0) {
+                    json += ',';
+                }
+                json += parts[i];
+            }
+            json += ']';
+            return json;
+        }
+    }
+    
+    std::ostringstream oss;
+    write(layouts, mode, viewport, fields, compact, oss, threads);
+    return oss.str();
+}
+
+void JsonSerializer::write(
+    const std::vector<CharLayout>& layouts,
+    OutputMode mode,
+    const Viewport& viewport,
+    uint32_t fields,
+    bool compact,
+    std::ostream& out,
+    int threads
+) {
+    CharFormat format;
+    format.fields = fields;
+    format.threads = threads;
+    if (!compact) {
+        writeMode(layouts, mode, viewport, format, out);
+        return;
+    }
+    
+    // Collect every style up front so the table can precede the data
+    CompactStyleTable styles(fields);
+    for (const auto& layout : layouts) {
+        styles.indexOf(layout);
+    }
+    format.styles = &styles;
+    
+    out << "{\"styles\":";
+    styles.writeTo(out);
+    out << ",\"data\":";
+    writeMode(layouts, mode, viewport, format, out);
+    out << '}';
+}
+
+void JsonSerializer::writeMode(
+    const std::vector<CharLayout>& layouts,
+    OutputMode mode,
+    const Viewport& viewport,
+    const CharFormat& format,
+    std::ostream& out
 ) {
     switch (mode) {
         case OutputMode::Full:
-            return serializeFull(layouts, viewport);
+            writeFull(layouts, viewport, format, out);
+            break;
         case OutputMode::Simple:
-            return serializeSimple(layouts, viewport);
+            writeSimple(layouts, viewport, format, out);
+            break;
         case OutputMode::ByRow:
-            return serializeByRow(layouts);
+            writeByRow(layouts, format, out);
+            break;
         case OutputMode::Flat:
         default:
-            return serializeFlat(layouts);
+            writeFlat(layouts, format, out);
+            break;
     }
 }
 
-std::string JsonSerializer::serializeFlat(const std::vector<CharLayout>& layouts) {
-    // Pre-allocate estimated capacity (rough estimate: ~500 bytes per character, 预估容量)
+std::string JsonSerializer::serializeFlat(const std::vector<CharLayout>& layouts, const CharFormat& format) {
     std::ostringstream oss;
-    
+    writeFlat(layouts, format, oss);
+    return oss.str();
+}
+
+std::string JsonSerializer::serializeByRow(const std::vector<CharLayout>& layouts, const CharFormat& format) {
+    std::ostringstream oss;
+    writeByRow(layouts, format, oss);
+    return oss.str();
+}
+
+std::string JsonSerializer::serializeSimple(
+    const std::vector<CharLayout>& layouts,
+    const Viewport& viewport,
+    const CharFormat& format
+) {
+    std::ostringstream oss;
+    writeSimple(layouts, viewport, format, oss);
+    return oss.str();
+}
+
+std::string JsonSerializer::serializeFull(
+    const std::vector<CharLayout>& layouts,
+    const Viewport& viewport,
+    const CharFormat& format
+) {
+    std::ostringstream oss;
+    writeFull(layouts, viewport, format, oss);
+    return oss.str();
+}
+
+void JsonSerializer::writeFlat(const std::vector<CharLayout>& layouts, const CharFormat& format, std::ostream& oss) {
     oss << "[";
     
+    std::vector<std::string> parts = formatFlatParallel(layouts, format);
+    if (!parts.empty()) {
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (i > 0) {
+                oss << ",";
+            }
+            oss.write(parts[i].data(), static_cast<std::streamsize>(parts[i].size()));
+        }
+        oss << "]";
+        return;
+    }
+    
     for (size_t i = 0; i < layouts.size(); ++i) {
         if (i > 0) {
             oss << ",";
         }
-        serializeCharLayout(layouts[i], oss);
+        serializeCharLayout(layouts[i], format, oss);
     }
     
     oss << "]";
-    return oss.str();
 }
 
-std::string JsonSerializer::serializeByRow(const std::vector<CharLayout>& layouts) {
+std::vector<std::string> JsonSerializer::formatFlatParallel(const std::vector<CharLayout>& layouts, const CharFormat& format) {
+#ifdef WASM_V2_SERIALIZE_THREADS
+    // The compact style table caches its last lookup, so it stays on one thread
+    if (format.styles != nullptr || format.threads == 1) {
+        return {};
+    }
+    size_t threads = static_cast<size_t>(format.threads);
+    if (format.threads <= 0) {
+        threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), kMaxSerializeThreads);
+    }
+    threads = std::min(threads, layouts.size() / kMinCharsPerThread);
+    if (threads < 2) {
+        return {};
+    }
+    
+    std::vector<std::string> parts(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    auto formatRange = [&](size_t part) {
+        try {
+            size_t begin = layouts.size() * part / threads;
+            size_t end = layouts.size() * (part + 1) / threads;
+            std::ostringstream oss;
+            for (size_t i = begin; i < end; ++i) {
+                if (i > begin) {
+                    oss << ",";
+                }
+                serializeCharLayout(layouts[i], format, oss);
+            }
+            parts[part] = oss.str();
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+    
+    // The calling thread formats the first range, and any range no thread
+    // could be started for
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t started = 1;
+    try {
+        for (; started < threads; ++started) {
+            workers.emplace_back(formatRange, started);
+        }
+    } catch (const std::system_error&) {
+    }
+    formatRange(0);
+    for (size_t part = started; part < threads; ++part) {
+        formatRange(part);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return parts;
+#else
+    (void)layouts;
+    (void)format;
+    return {};
+#endif
+}
+
+void JsonSerializer::writeByRow(const std::vector<CharLayout>& layouts, const CharFormat& format, std::ostream& oss) {
     // Group characters by Y coordinate (按 Y 坐标分组)
     std::map<int, std::vector<const CharLayout*>> rowMap;
     
@@ -157,7 +519,6 @@ std::string JsonSerializer::serializeByRow(const std::vector<CharLayout>& layout
     std::sort(yCoords.begin(), yCoords.end());
     
     // Serialize to JSON (序列化为 JSON)
-    std::ostringstream oss;
     oss << "[";
     
     for (size_t rowIndex = 0; rowIndex < yCoords.size(); ++rowIndex) {
@@ -184,24 +545,24 @@ std::string JsonSerializer::serializeByRow(const std::vector<CharLayout>& layout
             if (i > 0) {
                 oss << ",";
             }
-            serializeCharLayout(*sortedChildren[i], oss);
+            serializeCharLayout(*sortedChildren[i], format, oss);
         }
         
         oss << "]}";
     }
     
     oss << "]";
-    return oss.str();
 }
 
-std::string JsonSerializer::serializeSimple(
+void JsonSerializer::writeSimple(
     const std::vector<CharLayout>& layouts,
-    const Viewport& viewport
+    const Viewport& viewport,
+    const CharFormat& format,
+    std::ostream& oss
 ) {
     // Group into lines
     std::vector<Line> lines = groupIntoLines(layouts);
     
-    std::ostringstream oss;
     oss << "{";
     
     // Version
@@ -220,18 +581,18 @@ std::string JsonSerializer::serializeSimple(
         if (i > 0) {
             oss << ",";
         }
-        serializeLineSimple(lines[i], oss);
+        serializeLineSimple(lines[i], format, oss);
     }
     
     oss << "]";
     oss << "}";
-    
-    return oss.str();
 }
 
-std::string JsonSerializer::serializeFull(
+void JsonSerializer::writeFull(
     const std::vector<CharLayout>& layouts,
-    const Viewport& viewport
+    const Viewport& viewport,
+    const CharFormat& format,
+    std::ostream& oss
 ) {
     // Group into lines
     std::vector<Line> lines = groupIntoLines(layouts);
@@ -273,7 +634,6 @@ std::string JsonSerializer::serializeFull(
     doc.pages.push_back(std::move(page));
     
     // Serialize
-    std::ostringstream oss;
     oss << "{";
     
     // Version
@@ -295,13 +655,11 @@ std::string JsonSerializer::serializeFull(
         if (i > 0) {
             oss << ",";
         }
-        serializePage(doc.pages[i], oss);
+        serializePage(doc.pages[i], format, oss);
     }
     
     oss << "]";
     oss << "}";
-    
-    return oss.str();
 }
 
 std::string JsonSerializer::serializeResult(
@@ -373,7 +731,16 @@ std::string JsonSerializer::escapeJsonString(const std::string& str) {
     return escapeJson(str);
 }
 
-void JsonSerializer::serializeCharLayout(const CharLayout& layout, std::ostringstream& oss) {
+void JsonSerializer::serializeCharLayout(const CharLayout& layout, const CharFormat& format, std::ostream& oss) {
+    if (format.styles != nullptr) {
+        serializeCharLayoutCompact(layout, format, oss);
+        return;
+    }
+    if (format.fields != CharFieldAll) {
+        serializeCharLayoutProjected(layout, format.fields, oss);
+        return;
+    }
+    
     oss << "{";
     
     // Character (escaped)
@@ -422,7 +789,71 @@ void JsonSerializer::serializeCharLayout(const CharLayout& layout, std::ostrings
     oss << "}";
 }
 
-void JsonSerializer::serializeTextDecoration(const TextDecoration& decoration, std::ostringstream& oss) {
+void JsonSerializer::serializeCharLayoutProjected(const CharLayout& layout, uint32_t fields, std::ostream& oss) {
+    ObjectKeys key(oss);
+    
+    if (fields & CharFieldCharacter) {
+        key("character") << '"' << escapeJson(layout.character) << '"';
+    }
+    if (fields & CharFieldX) { key("x") << layout.x; }
+    if (fields & CharFieldY) { key("y") << layout.y; }
+    if (fields & CharFieldWidth) { key("width") << layout.width; }
+    if (fields & CharFieldHeight) { key("height") << layout.height; }
+    if (fields & CharFieldFontFamily) {
+        key("fontFamily") << '"' << escapeJson(layout.fontFamily) << '"';
+    }
+    if (fields & CharFieldFontSize) { key("fontSize") << layout.fontSize; }
+    if (fields & CharFieldFontWeight) { key("fontWeight") << layout.fontWeight; }
+    if (fields & CharFieldFontStyle) {
+        key("fontStyle") << '"' << escapeJson(layout.fontStyle) << '"';
+    }
+    if (fields & CharFieldColor) {
+        key("color") << '"' << escapeJson(layout.color) << '"';
+    }
+    if (fields & CharFieldBackgroundColor) {
+        key("backgroundColor") << '"' << escapeJson(layout.backgroundColor) << '"';
+    }
+    if (fields & CharFieldOpacity) { key("opacity") << layout.opacity; }
+    if (fields & CharFieldTextDecoration) {
+        serializeTextDecoration(layout.textDecoration, key("textDecoration"));
+    }
+    if (fields & CharFieldLetterSpacing) { key("letterSpacing") << layout.letterSpacing; }
+    if (fields & CharFieldWordSpacing) { key("wordSpacing") << layout.wordSpacing; }
+    if (fields & CharFieldTransform) {
+        serializeTransform(layout.transform, key("transform"));
+    }
+    if (fields & CharFieldBaseline) { key("baseline") << layout.baseline; }
+    if (fields & CharFieldDirection) {
+        key("direction") << '"' << escapeJson(layout.direction) << '"';
+    }
+    if (fields & CharFieldFontId) { key("fontId") << layout.fontId; }
+    
+    key.close();
+}
+
+void JsonSerializer::serializeCharLayoutCompact(const CharLayout& layout, const CharFormat& format, std::ostream& oss) {
+    ObjectKeys key(oss);
+    const uint32_t fields = format.fields;
+    
+    if (fields & CharFieldCharacter) {
+        key("c") << '"' << escapeJson(layout.character) << '"';
+    }
+    if (fields & CharFieldX) { key("x") << layout.x; }
+    if (fields & CharFieldY) { key("y") << layout.y; }
+    if (fields & CharFieldWidth) { key("w") << layout.width; }
+    if (fields & CharFieldHeight) { key("h") << layout.height; }
+    if (fields & CharFieldBaseline) { key("b") << layout.baseline; }
+    if (fields & kCompactStyleFields) {
+        int styleIndex = format.styles->indexOf(layout);
+        if (styleIndex != 0) {
+            key("s") << styleIndex;
+        }
+    }
+    
+    key.close();
+}
+
+void JsonSerializer::serializeTextDecoration(const TextDecoration& decoration, std::ostream& oss) {
     oss << "{";
     oss << "\"underline\":" << (decoration.underline ? "true" : "false") << ",";
     oss << "\"overline\":" << (decoration.overline ? "true" : "false") << ",";
@@ -433,7 +864,7 @@ void JsonSerializer::serializeTextDecoration(const TextDecoration& decoration, s
     oss << "}";
 }
 
-void JsonSerializer::serializeTransform(const Transform& transform, std::ostringstream& oss) {
+void JsonSerializer::serializeTransform(const Transform& transform, std::ostream& oss) {
     oss << "{";
     oss << "\"scaleX\":" << transform.scaleX << ",";
     oss << "\"scaleY\":" << transform.scaleY << ",";
@@ -443,7 +874,7 @@ void JsonSerializer::serializeTransform(const Transform& transform, std::ostring
     oss << "}";
 }
 
-void JsonSerializer::serializeBoxSpacing(const BoxSpacing& spacing, std::ostringstream& oss) {
+void JsonSerializer::serializeBoxSpacing(const BoxSpacing& spacing, std::ostream& oss) {
     oss << "{";
     oss << "\"top\":" << spacing.top << ",";
     oss << "\"right\":" << spacing.right << ",";
@@ -452,26 +883,34 @@ void JsonSerializer::serializeBoxSpacing(const BoxSpacing& spacing, std::ostring
     oss << "}";
 }
 
-void JsonSerializer::serializeRun(const Run& run, std::ostringstream& oss) {
+void JsonSerializer::serializeRun(const Run& run, const CharFormat& format, std::ostream& oss) {
     oss << "{";
     
     oss << "\"runIndex\":" << run.runIndex << ",";
     oss << "\"x\":" << run.x << ",";
     
-    // Font properties
-    oss << "\"fontFamily\":\"" << escapeJson(run.fontFamily) << "\",";
-    oss << "\"fontSize\":" << run.fontSize << ",";
-    oss << "\"fontWeight\":" << run.fontWeight << ",";
-    oss << "\"fontStyle\":\"" << escapeJson(run.fontStyle) << "\",";
-    
-    // Colors
-    oss << "\"color\":\"" << escapeJson(run.color) << "\",";
-    oss << "\"backgroundColor\":\"" << escapeJson(run.backgroundColor) << "\",";
-    
-    // Text decoration
-    oss << "\"textDecoration\":";
-    serializeTextDecoration(run.textDecoration, oss);
-    oss << ",";
+    // Compact runs reference the style of their first character when its
+    // entry holds every run property
+    const bool runStyleIndex = format.styles != nullptr &&
+        (format.fields & kRunStyleFields) == kRunStyleFields && !run.characters.empty();
+    if (runStyleIndex) {
+        oss << "\"s\":" << format.styles->indexOf(run.characters.front()) << ",";
+    } else {
+        // Font properties
+        oss << "\"fontFamily\":\"" << escapeJson(run.fontFamily) << "\",";
+        oss << "\"fontSize\":" << run.fontSize << ",";
+        oss << "\"fontWeight\":" << run.fontWeight << ",";
+        oss << "\"fontStyle\":\"" << escapeJson(run.fontStyle) << "\",";
+        
+        // Colors
+        oss << "\"color\":\"" << escapeJson(run.color) << "\",";
+        oss << "\"backgroundColor\":\"" << escapeJson(run.backgroundColor) << "\",";
+        
+        // Text decoration
+        oss << "\"textDecoration\":";
+        serializeTextDecoration(run.textDecoration, oss);
+        oss << ",";
+    }
     
     // Characters
     oss << "\"characters\":[";
@@ -479,14 +918,14 @@ void JsonSerializer::serializeRun(const Run& run, std::ostringstream& oss) {
         if (i > 0) {
             oss << ",";
         }
-        serializeCharLayout(run.characters[i], oss);
+        serializeCharLayout(run.characters[i], format, oss);
     }
     oss << "]";
     
     oss << "}";
 }
 
-void JsonSerializer::serializeLineFull(const Line& line, std::ostringstream& oss) {
+void JsonSerializer::serializeLineFull(const Line& line, const CharFormat& format, std::ostream& oss) {
     oss << "{";
     
     oss << "\"lineIndex\":" << line.lineIndex << ",";
@@ -502,14 +941,14 @@ void JsonSerializer::serializeLineFull(const Line& line, std::ostringstream& oss
         if (i > 0) {
             oss << ",";
         }
-        serializeRun(line.runs[i], oss);
+        serializeRun(line.runs[i], format, oss);
     }
     oss << "]";
     
     oss << "}";
 }
 
-void JsonSerializer::serializeLineSimple(const Line& line, std::ostringstream& oss) {
+void JsonSerializer::serializeLineSimple(const Line& line, const CharFormat& format, std::ostream& oss) {
     oss << "{";
     
     oss << "\"lineIndex\":" << line.lineIndex << ",";
@@ -525,14 +964,14 @@ void JsonSerializer::serializeLineSimple(const Line& line, std::ostringstream& o
         if (i > 0) {
             oss << ",";
         }
-        serializeCharLayout(line.characters[i], oss);
+        serializeCharLayout(line.characters[i], format, oss);
     }
     oss << "]";
     
     oss << "}";
 }
 
-void JsonSerializer::serializeBlock(const Block& block, std::ostringstream& oss) {
+void JsonSerializer::serializeBlock(const Block& block, const CharFormat& format, std::ostream& oss) {
     oss << "{";
     
     oss << "\"blockIndex\":" << block.blockIndex << ",";
@@ -563,14 +1002,14 @@ void JsonSerializer::serializeBlock(const Block& block, std::ostringstream& oss)
         if (i > 0) {
             oss << ",";
         }
-        serializeLineFull(block.lines[i], oss);
+        serializeLineFull(block.lines[i], format, oss);
     }
     oss << "]";
     
     oss << "}";
 }
 
-void JsonSerializer::serializePage(const Page& page, std::ostringstream& oss) {
+void JsonSerializer::serializePage(const Page& page, const CharFormat& format, std::ostream& oss) {
     oss << "{";
     
     oss << "\"pageIndex\":" << page.pageIndex << ",";
@@ -583,7 +1022,7 @@ void JsonSerializer::serializePage(const Page& page, std::ostringstream& oss) {
         if (i > 0) {
             oss << ",";
         }
-        serializeBlock(page.blocks[i], oss);
+        serializeBlock(page.blocks[i], format, oss);
     }
     oss << "]";
     
@@ -722,6 +1161,21 @@ bool JsonSerializer::isSameStyle(const CharLayout& a, const CharLayout& b) {
            a.textDecoration.style == b.textDecoration.style;
 }
 
+bool JsonSerializer::isSameCompactStyle(const CharLayout& a, const CharLayout& b) {
+    return isSameStyle(a, b) &&
+           a.fontId == b.fontId &&
+           a.opacity == b.opacity &&
+           a.textDecoration.thickness == b.textDecoration.thickness &&
+           a.letterSpacing == b.letterSpacing &&
+           a.wordSpacing == b.wordSpacing &&
+           a.transform.scaleX == b.transform.scaleX &&
+           a.transform.scaleY == b.transform.scaleY &&
+           a.transform.skewX == b.transform.skewX &&
+           a.transform.skewY == b.transform.skewY &&
+           a.transform.rotate == b.transform.rotate &&
+           a.direction == b.direction;
+}
+
 std::string JsonSerializer::blockTypeToString(BlockType type) {
     switch (type) {
         case BlockType::Paragraph: return "paragraph";
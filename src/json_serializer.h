@@ -17,8 +17,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <ostream>
 #include "wasm_container.h"
 #include "error_types.h"
+#include "parse_options.h"
 
 namespace wasm_litehtml_v2 {
 
@@ -198,6 +200,22 @@ struct LayoutDocument {
 
 // Note: ParseResult is defined in error_types.h
 
+class CompactStyleTable;
+
+/**
+ * @brief How characters are written, shared by all output modes (字符输出格式)
+ * 
+ * Compact dialect (紧凑格式): characters use short keys (c, x, y, w, h, b)
+ * and reference a deduplicated style entry by index ("s", omitted for 0).
+ * Style entries use short keys and omit default values; see
+ * JsonSerializer::serialize() for the full key list.
+ */
+struct CharFormat {
+    uint32_t fields = CharFieldAll;         // CharField bits to write (输出字段)
+    CompactStyleTable* styles = nullptr;    // Non-null selects the compact dialect (紧凑格式样式表)
+    int threads = 1;                        // Flat array worker threads, 0 = automatic (扁平数组工作线程数)
+};
+
 /**
  * @brief JSON Serializer class (JSON 序列化器)
  * 
@@ -217,48 +235,103 @@ public:
      * @param layouts Character layouts from WasmContainer
      * @param mode Output mode
      * @param viewport Viewport dimensions
+     * @param fields CharLayout fields to write (CharField bits, default all)
+     * @param compact Write the compact dialect (紧凑格式)
+     * @param threads Threads formatting the flat array, 0 = automatic (扁平数组线程数)
      * @return JSON string
+     * 
+     * Flat output of large documents is split into ranges of characters
+     * that are formatted on worker threads and joined in order; the text
+     * is identical to a single-threaded run. Threads are only used in
+     * native and pthreads builds, for the regular and projected formats.
+     * 
+     * In compact form the mode's usual output becomes `data` of a wrapper
+     * `{"styles":[...],"data":...}`. Characters are `{c,x,y,w,h,b,s}`
+     * (character, x, y, width, height, baseline, style index; s omitted
+     * when 0). Style entries hold f fontFamily, fs fontSize, fw fontWeight
+     * (400), st fontStyle ("normal"), c color ("#000000FF"), bg
+     * backgroundColor ("#00000000"), op opacity (1), td textDecoration,
+     * ls letterSpacing (0), ws wordSpacing (0), tf transform as
+     * [scaleX,scaleY,skewX,skewY,rotate] (identity), d direction ("ltr")
+     * and id fontId; values in parentheses are defaults and are omitted.
+     * td holds u/o/l (true only), c (defaults to the style color), st
+     * ("solid") and th (1); it is omitted when empty. Full-mode runs carry
+     * "s" instead of their font and color properties unless options.fields
+     * leaves some of those out.
      */
     static std::string serialize(
         const std::vector<CharLayout>& layouts,
         OutputMode mode,
-        const Viewport& viewport
+        const Viewport& viewport,
+        uint32_t fields = CharFieldAll,
+        bool compact = false,
+        int threads = 1
+    );
+    
+    /**
+     * @brief Write character layouts as JSON to a stream (按模式写入输出流)
+     * @param layouts Character layouts from WasmContainer
+     * @param mode Output mode
+     * @param viewport Viewport dimensions
+     * @param fields CharLayout fields to write (CharField bits)
+     * @param compact Write the compact dialect (紧凑格式)
+     * @param out Destination stream
+     * @param threads Threads formatting the flat array, 0 = automatic (扁平数组线程数)
+     * 
+     * Produces the same text as serialize() without holding it in memory,
+     * which lets callers flush the output in chunks while it is written.
+     * With more than one thread the flat array is buffered per thread.
+     */
+    static void write(
+        const std::vector<CharLayout>& layouts,
+        OutputMode mode,
+        const Viewport& viewport,
+        uint32_t fields,
+        bool compact,
+        std::ostream& out,
+        int threads = 1
     );
     
     /**
      * @brief Serialize to flat JSON array (v1 compatible, 扁平数组)
      * @param layouts Character layouts
+     * @param format Character output format
      * @return JSON string
      */
-    static std::string serializeFlat(const std::vector<CharLayout>& layouts);
+    static std::string serializeFlat(const std::vector<CharLayout>& layouts, const CharFormat& format = CharFormat());
     
     /**
      * @brief Serialize to byRow JSON (v1 isRow compatible, 按行分组)
      * @param layouts Character layouts
+     * @param format Character output format
      * @return JSON string
      */
-    static std::string serializeByRow(const std::vector<CharLayout>& layouts);
+    static std::string serializeByRow(const std::vector<CharLayout>& layouts, const CharFormat& format = CharFormat());
     
     /**
      * @brief Serialize to simple JSON (Lines → Characters, 简化结构)
      * @param layouts Character layouts
      * @param viewport Viewport dimensions
+     * @param format Character output format
      * @return JSON string
      */
     static std::string serializeSimple(
         const std::vector<CharLayout>& layouts,
-        const Viewport& viewport
+        const Viewport& viewport,
+        const CharFormat& format = CharFormat()
     );
     
     /**
      * @brief Serialize to full JSON (完整层级结构)
      * @param layouts Character layouts
      * @param viewport Viewport dimensions
+     * @param format Character output format
      * @return JSON string
      */
     static std::string serializeFull(
         const std::vector<CharLayout>& layouts,
-        const Viewport& viewport
+        const Viewport& viewport,
+        const CharFormat& format = CharFormat()
     );
     
     /**
@@ -280,6 +353,61 @@ public:
     static std::string escapeJsonString(const std::string& str);
 
 private:
+    /**
+     * @brief Dispatch to the writer of one output mode (按模式分派写入)
+     * @param layouts Character layouts
+     * @param mode Output mode
+     * @param viewport Viewport dimensions
+     * @param format Character output format
+     * @param out Output stream
+     */
+    static void writeMode(
+        const std::vector<CharLayout>& layouts,
+        OutputMode mode,
+        const Viewport& viewport,
+        const CharFormat& format,
+        std::ostream& out
+    );
+    
+    /**
+     * @brief Write flat JSON array (写入扁平数组)
+     */
+    static void writeFlat(const std::vector<CharLayout>& layouts, const CharFormat& format, std::ostream& oss);
+    
+    /**
+     * @brief Format the flat array elements in parallel (并行格式化扁平数组元素)
+     * @param layouts Character layouts
+     * @param format Character output format
+     * @return Comma-separated elements of consecutive ranges, in order;
+     *         empty when the array should be written on the calling thread
+     */
+    static std::vector<std::string> formatFlatParallel(const std::vector<CharLayout>& layouts, const CharFormat& format);
+    
+    /**
+     * @brief Write byRow JSON (写入按行分组)
+     */
+    static void writeByRow(const std::vector<CharLayout>& layouts, const CharFormat& format, std::ostream& oss);
+    
+    /**
+     * @brief Write simple JSON (写入简化结构)
+     */
+    static void writeSimple(
+        const std::vector<CharLayout>& layouts,
+        const Viewport& viewport,
+        const CharFormat& format,
+        std::ostream& oss
+    );
+    
+    /**
+     * @brief Write full JSON (写入完整层级结构)
+     */
+    static void writeFull(
+        const std::vector<CharLayout>& layouts,
+        const Viewport& viewport,
+        const CharFormat& format,
+        std::ostream& oss
+    );
+    
     /**
      * @brief Escape string for JSON (JSON 转义)
      * @param str Input string
@@ -290,65 +418,87 @@ private:
     /**
      * @brief Serialize a single CharLayout to JSON (序列化单个字符)
      * @param layout Character layout
+     * @param format Character output format
+     * @param oss Output stream
+     */
+    static void serializeCharLayout(const CharLayout& layout, const CharFormat& format, std::ostream& oss);
+    
+    /**
+     * @brief Serialize the selected fields of a CharLayout (按字段投影序列化字符)
+     * @param layout Character layout
+     * @param fields CharLayout fields to write (CharField bits, not CharFieldAll)
      * @param oss Output stream
      */
-    static void serializeCharLayout(const CharLayout& layout, std::ostringstream& oss);
+    static void serializeCharLayoutProjected(const CharLayout& layout, uint32_t fields, std::ostream& oss);
+    
+    /**
+     * @brief Serialize a CharLayout in the compact dialect (紧凑格式序列化字符)
+     * @param layout Character layout
+     * @param format Character output format (styles must be set)
+     * @param oss Output stream
+     */
+    static void serializeCharLayoutCompact(const CharLayout& layout, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Serialize TextDecoration to JSON (序列化装饰线)
      * @param decoration Text decoration
      * @param oss Output stream
      */
-    static void serializeTextDecoration(const TextDecoration& decoration, std::ostringstream& oss);
+    static void serializeTextDecoration(const TextDecoration& decoration, std::ostream& oss);
     
     /**
      * @brief Serialize Transform to JSON (序列化变换)
      * @param transform Transform
      * @param oss Output stream
      */
-    static void serializeTransform(const Transform& transform, std::ostringstream& oss);
+    static void serializeTransform(const Transform& transform, std::ostream& oss);
     
     /**
      * @brief Serialize BoxSpacing to JSON (序列化边距)
      * @param spacing Box spacing
      * @param oss Output stream
      */
-    static void serializeBoxSpacing(const BoxSpacing& spacing, std::ostringstream& oss);
+    static void serializeBoxSpacing(const BoxSpacing& spacing, std::ostream& oss);
     
     /**
      * @brief Serialize a Run to JSON (序列化 Run)
      * @param run Run
+     * @param format Character output format
      * @param oss Output stream
      */
-    static void serializeRun(const Run& run, std::ostringstream& oss);
+    static void serializeRun(const Run& run, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Serialize a Line to JSON (full mode, 完整模式)
      * @param line Line
+     * @param format Character output format
      * @param oss Output stream
      */
-    static void serializeLineFull(const Line& line, std::ostringstream& oss);
+    static void serializeLineFull(const Line& line, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Serialize a Line to JSON (simple mode, 简化模式)
      * @param line Line
+     * @param format Character output format
      * @param oss Output stream
      */
-    static void serializeLineSimple(const Line& line, std::ostringstream& oss);
+    static void serializeLineSimple(const Line& line, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Serialize a Block to JSON (序列化块)
      * @param block Block
+     * @param format Character output format
      * @param oss Output stream
      */
-    static void serializeBlock(const Block& block, std::ostringstream& oss);
+    static void serializeBlock(const Block& block, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Serialize a Page to JSON (序列化页面)
      * @param page Page
+     * @param format Character output format
      * @param oss Output stream
      */
-    static void serializePage(const Page& page, std::ostringstream& oss);
+    static void serializePage(const Page& page, const CharFormat& format, std::ostream& oss);
     
     /**
      * @brief Group characters into lines by Y coordinate (按 Y 分行)
@@ -372,6 +522,16 @@ private:
      */
     static bool isSameStyle(const CharLayout& a, const CharLayout& b);
     
+    /**
+     * @brief Check if two characters share every compact style field (检查紧凑样式是否一致)
+     * @param a First character
+     * @param b Second character
+     * @return true if isSameStyle() and the remaining style fields match
+     */
+    static bool isSameCompactStyle(const CharLayout& a, const CharLayout& b);
+    
+    friend class CompactStyleTable;
+    
     /**
      * @brief Convert BlockType enum to string (块类型转字符串)
      * @param type Block type
@@ -0,0 +1,95 @@
+/**
+ * @file layout_measure.cpp
+ * @brief Layout Measure implementation (布局测量实现)
+ */
+
+#include "layout_measure.h"
+#include <litehtml/render_item.h>
+#include <litehtml/render_inline_context.h>
+#include <cstring>
+#include <sstream>
+
+namespace wasm_litehtml_v2 {
+
+namespace {
+
+int countLines(const std::shared_ptr<litehtml::render_item>& item) {
+    int count = 0;
+    if (auto inlineContext = std::dynamic_pointer_cast<litehtml::render_item_inline_context>(item)) {
+        count += inlineContext->get_line_count();
+    }
+    for (const auto& child : item->children()) {
+        count += countLines(child);
+    }
+    return count;
+}
+
+std::shared_ptr<litehtml::render_item> findBody(const std::shared_ptr<litehtml::render_item>& root) {
+    for (const auto& child : root->children()) {
+        const char* tag = child->src_el()->get_tagName();
+        if (tag != nullptr && strcmp(tag, "body") == 0) {
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+LayoutMeasurement LayoutMeasure::measure(litehtml::document& doc) {
+    LayoutMeasurement result;
+    result.width = static_cast<float>(doc.width());
+    result.height = static_cast<float>(doc.height());
+    result.truncated = doc.layout_truncated();
+
+    auto root = doc.root_render();
+    if (!root) {
+        return result;
+    }
+    result.lineCount = countLines(root);
+
+    auto body = findBody(root);
+    if (!body) {
+        return result;
+    }
+    for (const auto& child : body->children()) {
+        const auto& el = child->src_el();
+        litehtml::element_position position = el->css().get_position();
+        if (child->skip() || el->is_inline() || el->is_float() ||
+            position == litehtml::element_position_absolute || position == litehtml::element_position_fixed) {
+            continue;
+        }
+        // get_placement() is the content box; widen it to the border box
+        litehtml::position pos = child->get_placement();
+        const auto& padding = child->get_paddings();
+        const auto& borders = child->get_borders();
+        BlockBox box;
+        box.x = static_cast<float>(pos.x - padding.left - borders.left);
+        box.y = static_cast<float>(pos.y - padding.top - borders.top);
+        box.width = static_cast<float>(pos.width + padding.width() + borders.width());
+        box.height = static_cast<float>(pos.height + padding.height() + borders.height());
+        result.blocks.push_back(box);
+    }
+    return result;
+}
+
+void LayoutMeasure::appendJson(const LayoutMeasurement& measurement, std::string& out) {
+    std::ostringstream oss;
+    oss << "{\"width\":" << measurement.width
+        << ",\"height\":" << measurement.height
+        << ",\"lineCount\":" << measurement.lineCount
+        << ",\"truncated\":" << (measurement.truncated ? "true" : "false")
+        << ",\"blocks\":[";
+    for (size_t i = 0; i < measurement.blocks.size(); ++i) {
+        const BlockBox& box = measurement.blocks[i];
+        if (i > 0) {
+            oss << ",";
+        }
+        oss << "{\"x\":" << box.x << ",\"y\":" << box.y
+            << ",\"width\":" << box.width << ",\"height\":" << box.height << "}";
+    }
+    oss << "]}";
+    out += oss.str();
+}
+
+} // namespace wasm_litehtml_v2
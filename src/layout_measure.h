@@ -0,0 +1,71 @@
+/**
+ * @file layout_measure.h
+ * @brief Layout Measure - document size without glyph output (布局测量)
+ *
+ * This module provides:
+ * - Measurement of a rendered document: size, line count and the boxes of
+ *   the top-level blocks inside <body>
+ * - Compact JSON encoding of the measurement
+ *
+ * Design principles:
+ * - Works on a document after render(); draw() is never needed, so no
+ *   CharLayout is created and nothing is serialized per glyph
+ * - Coordinates are document coordinates, like CharLayout x/y
+ */
+
+#ifndef WASM_V2_LAYOUT_MEASURE_H
+#define WASM_V2_LAYOUT_MEASURE_H
+
+#include <litehtml.h>
+#include <string>
+#include <vector>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Border box of a block (块的边框盒)
+ */
+struct BlockBox {
+    float x = 0;
+    float y = 0;
+    float width = 0;
+    float height = 0;
+};
+
+/**
+ * @brief Measurement of a rendered document (已渲染文档的测量结果)
+ */
+struct LayoutMeasurement {
+    float width = 0;                // Document width (文档宽度)
+    float height = 0;               // Document height (文档高度)
+    int lineCount = 0;              // Non-empty line boxes in the whole document (行数)
+    bool truncated = false;         // Layout stopped at the document layout limit (布局被截断)
+    std::vector<BlockBox> blocks;   // In-flow block children of <body> (body 的块级子元素)
+};
+
+/**
+ * @brief Layout Measure class (布局测量类)
+ */
+class LayoutMeasure {
+public:
+    /**
+     * @brief Measure a document after render() (测量已渲染的文档)
+     * @param doc Rendered document
+     * @return LayoutMeasurement Measurement
+     */
+    static LayoutMeasurement measure(litehtml::document& doc);
+
+    /**
+     * @brief Append a measurement as a JSON object (追加测量结果 JSON)
+     *
+     * Format: {"width":w,"height":h,"lineCount":n,"truncated":b,"blocks":[{"x","y","width","height"}]}
+     *
+     * @param measurement Measurement to encode
+     * @param out Output string
+     */
+    static void appendJson(const LayoutMeasurement& measurement, std::string& out);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_LAYOUT_MEASURE_H
@@ -31,9 +31,15 @@ MultiFontManager::MultiFontManager()
     : m_library(nullptr)
     , m_nextFontId(1)
     , m_defaultFontId(0)
+    , m_generation(0)
     , m_nextFontHandle(1)
     , m_memoryWarningIssued(false)
+    , m_concurrentMeasurements(0)
 {
+    // Construct the metrics cache first so it is destroyed after this manager;
+    // the destructor clears it (native builds run static destructors at exit)
+    FontMetricsCache::getInstance();
+
     // Initialize FreeType library (初始化 FreeType)
     FT_Error error = FT_Init_FreeType(&m_library);
     if (error) {
@@ -102,6 +108,7 @@ int MultiFontManager::loadFont(const uint8_t* data, size_t size, const std::stri
     int fontId = m_nextFontId++;
     entry.id = fontId;
     m_fonts[fontId] = std::move(entry);
+    m_generation++;
 
     // Set as default if this is the first font (首个字体设为默认)
     if (m_defaultFontId == 0) {
@@ -135,6 +142,7 @@ void MultiFontManager::unloadFont(int fontId) {
 
     // Remove from map (从表中移除)
     m_fonts.erase(it);
+    m_generation++;
 
     // Update default font if needed (更新默认字体)
     if (m_defaultFontId == fontId) {
@@ -159,8 +167,9 @@ void MultiFontManager::unloadFont(int fontId) {
 }
 
 void MultiFontManager::setDefaultFont(int fontId) {
-    if (m_fonts.find(fontId) != m_fonts.end()) {
+    if (m_fonts.find(fontId) != m_fonts.end() && m_defaultFontId != fontId) {
         m_defaultFontId = fontId;
+        m_generation++;
     }
 }
 
@@ -215,6 +224,7 @@ void MultiFontManager::clearAllFonts() {
     
     // Reset state
     m_defaultFontId = 0;
+    m_generation++;
     m_memoryWarningIssued = false;
 }
 
@@ -352,6 +362,8 @@ bool MultiFontManager::setFontSize(int fontId, int fontSize) {
 }
 
 bool MultiFontManager::getFontMetrics(int fontId, int fontSize, FontMetrics& metrics) {
+    auto lock = lockIfConcurrent();
+    
     // Default values
     metrics.ascent = fontSize;
     metrics.descent = fontSize / 4;
@@ -445,6 +457,8 @@ int MultiFontManager::getCharWidthWithFontFamily(const std::string& fontFamily,
 }
 
 int MultiFontManager::getCharWidthWithFallback(int fontId, uint32_t codepoint, int fontSize, int* outUsedFontId) {
+    auto lock = lockIfConcurrent();
+
     // Check cache first (先检查缓存)
     FontMetricsCache& cache = FontMetricsCache::getInstance();
     int cachedWidth = cache.getCharWidth(fontId, fontSize, codepoint);
@@ -624,6 +638,9 @@ int MultiFontManager::getTextWidth(int fontId, const char* text, int fontSize) {
         return 0;
     }
     
+    // Held for the whole word so concurrent layout locks once per text_width()
+    auto lock = lockIfConcurrent();
+    
     int totalWidth = 0;
     const char* p = text;
     
@@ -637,11 +654,29 @@ int MultiFontManager::getTextWidth(int fontId, const char* text, int fontSize) {
     return totalWidth;
 }
 
+void MultiFontManager::beginConcurrentMeasurement() {
+    m_concurrentMeasurements.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void MultiFontManager::endConcurrentMeasurement() {
+    m_concurrentMeasurements.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+std::unique_lock<std::recursive_mutex> MultiFontManager::lockIfConcurrent() {
+    std::unique_lock<std::recursive_mutex> lock(m_measureMutex, std::defer_lock);
+    if (m_concurrentMeasurements.load(std::memory_order_acquire) > 0) {
+        lock.lock();
+    }
+    return lock;
+}
+
 // ============================================================================
 // Font Handle Management
 // ============================================================================
 
 uint64_t MultiFontManager::createFontHandle(int fontId, int fontSize, bool bold, bool italic) {
+    auto lock = lockIfConcurrent();
+    
     if (!isFontLoaded(fontId)) {
         // Try default font
         if (m_defaultFontId != 0 && isFontLoaded(m_defaultFontId)) {
@@ -657,6 +692,7 @@ uint64_t MultiFontManager::createFontHandle(int fontId, int fontSize, bool bold,
 }
 
 void MultiFontManager::deleteFontHandle(uint64_t handle) {
+    auto lock = lockIfConcurrent();
     m_fontInstances.erase(handle);
 }
 
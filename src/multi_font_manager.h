@@ -20,6 +20,8 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 // FreeType headers
 #include <ft2build.h>
@@ -119,6 +121,16 @@ public:
      */
     int getDefaultFontId() const;
 
+    /**
+     * @brief Get the font-set generation (获取字体集代数)
+     * 
+     * Incremented whenever fonts are loaded, unloaded or the default font
+     * changes, so layout results can be tied to the font set they used.
+     * 
+     * @return uint64_t Current generation
+     */
+    uint64_t getGeneration() const { return m_generation; }
+
     /**
      * @brief Get list of loaded fonts as JSON (获取已加载字体列表 JSON)
      * @return std::string JSON array of font info
@@ -232,6 +244,23 @@ public:
      */
     int getTextWidth(int fontId, const char* text, int fontSize);
 
+    /**
+     * @brief Make font access thread-safe while documents are processed on several threads (多线程处理期间启用线程安全字体访问)
+     * 
+     * Measuring fills FontMetricsCache and sets FreeType face sizes, and font
+     * handles live in a shared map, so while at least one concurrent section
+     * is open getTextWidth(), getCharWidthWithFallback(), getFontMetrics(),
+     * createFontHandle() and deleteFontHandle() run under a lock. Serial
+     * calls skip the lock. Fonts must not be loaded or unloaded inside a
+     * section. Every call must be paired with endConcurrentMeasurement().
+     */
+    void beginConcurrentMeasurement();
+
+    /**
+     * @brief Close a section opened by beginConcurrentMeasurement() (结束并行测量区间)
+     */
+    void endConcurrentMeasurement();
+
     // ========================================================================
     // Font Handle Management (for litehtml integration)
     // ========================================================================
@@ -331,6 +360,7 @@ private:
     std::map<int, FontEntry> m_fonts;               // Loaded fonts by ID (已加载字体表)
     int m_nextFontId;                               // Next font ID to assign (下一个字体 ID)
     int m_defaultFontId;                            // Default font ID for fallback (默认回退字体 ID)
+    uint64_t m_generation;                          // Font-set generation (字体集代数)
     
     // Font handle management
     std::map<uint64_t, FontInstance> m_fontInstances; // Font handle -> instance (字体句柄映射)
@@ -338,6 +368,15 @@ private:
     
     // Memory warning flag (to avoid repeated warnings)
     mutable bool m_memoryWarningIssued;            // Warning flag to avoid repeats (内存警告标记)
+    
+    // Parallel layout and pipelined batches
+    std::recursive_mutex m_measureMutex;           // Guards font access in concurrent sections (字体访问锁)
+    std::atomic<int> m_concurrentMeasurements;     // Open concurrent sections (并行区间数)
+    
+    /**
+     * @brief Lock m_measureMutex if a concurrent section is open (并行区间内加锁)
+     */
+    std::unique_lock<std::recursive_mutex> lockIfConcurrent();
 };
 
 } // namespace wasm_litehtml_v2
@@ -0,0 +1,91 @@
+/**
+ * @file parallel_layout.cpp
+ * @brief Parallel layout of independent block formatting contexts (独立块格式化上下文并行布局)
+ */
+
+#include "parallel_layout.h"
+#include "multi_font_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// std::thread is only usable in WASM when built with -pthread
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define WASM_V2_LAYOUT_THREADS 1
+#endif
+
+namespace wasm_litehtml_v2 {
+
+#ifdef WASM_V2_LAYOUT_THREADS
+/**
+ * @brief Run task(0) .. task(count - 1) on up to threads threads (多线程执行布局任务)
+ *
+ * Threads claim the next task from a shared cursor until none are left; the
+ * calling thread takes part, so the tasks finish even if no thread starts.
+ * The first exception thrown by a task is rethrown after all threads joined.
+ */
+static void runTasks(size_t threads, int count, const std::function<void(int)>& task) {
+    threads = std::min(threads, static_cast<size_t>(count));
+    
+    std::atomic<int> next(0);
+    std::vector<std::exception_ptr> errors(threads);
+    auto work = [&](size_t worker) {
+        try {
+            for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                task(i);
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            next.store(count);
+        }
+    };
+    
+    // Text measurement is shared by all subtrees
+    MultiFontManager& manager = MultiFontManager::getInstance();
+    manager.beginConcurrentMeasurement();
+    
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try {
+        for (size_t worker = 1; worker < threads; ++worker) {
+            workers.emplace_back(work, worker);
+        }
+    } catch (const std::system_error&) {
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    manager.endConcurrentMeasurement();
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+#endif
+
+void ParallelLayout::install(litehtml::document& doc, int threads) {
+#ifdef WASM_V2_LAYOUT_THREADS
+    size_t count = static_cast<size_t>(threads);
+    if (threads <= 0) {
+        count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), kMaxLayoutThreads);
+    }
+    if (count < 2) {
+        doc.set_parallel_runner(nullptr);
+        return;
+    }
+    doc.set_parallel_runner([count](int tasks, const std::function<void(int)>& task) {
+        runTasks(count, tasks, task);
+    });
+#else
+    (void)threads;
+    doc.set_parallel_runner(nullptr);
+#endif
+}
+
+} // namespace wasm_litehtml_v2
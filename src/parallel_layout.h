@@ -0,0 +1,47 @@
+/**
+ * @file parallel_layout.h
+ * @brief Parallel layout of independent block formatting contexts (独立块格式化上下文并行布局)
+ *
+ * litehtml lays out the children of a block one after the other. Children
+ * that establish their own block formatting context (overflow other than
+ * visible, display: flex, inline-block, ...) and are not floated or
+ * positioned only depend on the available width, so a block with several of
+ * them renders them first through the document's parallel runner and then
+ * stacks them serially (margin collapsing, clearance, floats). The runner
+ * installed here executes those subtrees on a set of threads that claim
+ * subtrees one at a time, so long and short sections balance out.
+ *
+ * Only available when std::thread is (native builds and WASM built with
+ * -pthread); elsewhere install() leaves the document serial. The output is
+ * identical to serial layout.
+ */
+
+#ifndef WASM_V2_PARALLEL_LAYOUT_H
+#define WASM_V2_PARALLEL_LAYOUT_H
+
+#include <litehtml.h>
+#include <cstddef>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Parallel render support for litehtml documents (litehtml 文档并行布局)
+ */
+class ParallelLayout {
+public:
+    static constexpr size_t kMaxLayoutThreads = 8;
+
+    /**
+     * @brief Install or remove the parallel runner of a document (安装或移除并行布局执行器)
+     * @param doc Document to configure before render()
+     * @param threads Layout threads, 0 = automatic, 1 = serial layout
+     *
+     * Ignored by litehtml while a layout limit (maxLines / maxHeight) is set,
+     * since the limit is consumed in document order.
+     */
+    static void install(litehtml::document& doc, int threads);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_PARALLEL_LAYOUT_H
@@ -0,0 +1,170 @@
+/**
+ * @file parse_options.cpp
+ * @brief Parse options implementation (解析选项实现)
+ */
+
+#include "parse_options.h"
+#include "json_reader.h"
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Map a CharLayout field name to its CharField bit (字段名转位掩码)
+ * @return The bit, or 0 for an unknown name
+ */
+static uint32_t charFieldFromName(const std::string& name) {
+    static const struct { const char* name; uint32_t bit; } kFields[] = {
+        { "character", CharFieldCharacter },
+        { "x", CharFieldX },
+        { "y", CharFieldY },
+        { "width", CharFieldWidth },
+        { "height", CharFieldHeight },
+        { "fontFamily", CharFieldFontFamily },
+        { "fontSize", CharFieldFontSize },
+        { "fontWeight", CharFieldFontWeight },
+        { "fontStyle", CharFieldFontStyle },
+        { "color", CharFieldColor },
+        { "backgroundColor", CharFieldBackgroundColor },
+        { "opacity", CharFieldOpacity },
+        { "textDecoration", CharFieldTextDecoration },
+        { "letterSpacing", CharFieldLetterSpacing },
+        { "wordSpacing", CharFieldWordSpacing },
+        { "transform", CharFieldTransform },
+        { "baseline", CharFieldBaseline },
+        { "direction", CharFieldDirection },
+        { "fontId", CharFieldFontId },
+    };
+    for (const auto& field : kFields) {
+        if (name == field.name) {
+            return field.bit;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Read a non-empty array of field names into a CharField mask (读取字段投影)
+ * @return false on malformed input, unknown names or an empty list
+ */
+static bool readFieldMask(JsonReader& reader, uint32_t& mask) {
+    if (!reader.consume('[')) {
+        return false;
+    }
+    uint32_t parsed = 0;
+    if (!reader.consume(']')) {
+        do {
+            std::string name;
+            if (!reader.readString(name)) {
+                return false;
+            }
+            uint32_t bit = charFieldFromName(name);
+            if (bit == 0) {
+                return false;
+            }
+            parsed |= bit;
+        } while (reader.consume(','));
+        if (!reader.consume(']')) {
+            return false;
+        }
+    }
+    mask = parsed;
+    return parsed != 0;
+}
+
+bool ParseOptions::fromJson(const char* json, ParseOptions& options, std::string& error) {
+    options = ParseOptions();
+    if (json == nullptr || *json == '\0') {
+        return true;
+    }
+
+    ParseOptions parsed;
+    JsonReader reader(json);
+    if (!reader.consume('{')) {
+        error = "options must be a JSON object";
+        return false;
+    }
+
+    if (!reader.consume('}')) {
+        do {
+            std::string key;
+            if (!reader.readString(key) || !reader.consume(':')) {
+                error = "malformed options object";
+                return false;
+            }
+
+            bool ok;
+            if (key == "displayList") {
+                ok = reader.readBool(parsed.displayList);
+            } else if (key == "heightOnly") {
+                ok = reader.readBool(parsed.heightOnly);
+            } else if (key == "maxLines") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxLines = ok ? static_cast<int>(value) : 0;
+            } else if (key == "serializeThreads") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 64 && value == static_cast<int>(value);
+                parsed.serializeThreads = ok ? static_cast<int>(value) : 0;
+            } else if (key == "layoutThreads") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 64 && value == static_cast<int>(value);
+                parsed.layoutThreads = ok ? static_cast<int>(value) : 1;
+            } else if (key == "pipelineQueue") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 64 && value == static_cast<int>(value);
+                parsed.pipelineQueue = ok ? static_cast<int>(value) : 2;
+            } else if (key == "maxDepth") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxDepth = ok ? static_cast<int>(value) : 0;
+            } else if (key == "maxElements") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxElements = ok ? static_cast<int>(value) : 0;
+            } else if (key == "maxCssRules") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxCssRules = ok ? static_cast<int>(value) : 0;
+            } else if (key == "maxTableCells") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxTableCells = ok ? static_cast<int>(value) : 0;
+            } else if (key == "maxGlyphs") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0 && value <= 1e9 && value == static_cast<int>(value);
+                parsed.maxGlyphs = ok ? static_cast<int>(value) : 0;
+            } else if (key == "maxHeight") {
+                double value;
+                ok = reader.readNumber(value) && value >= 0;
+                parsed.maxHeight = ok ? static_cast<float>(value) : 0;
+            } else if (key == "ellipsis") {
+                ok = reader.readBool(parsed.ellipsis);
+            } else if (key == "compact") {
+                ok = reader.readBool(parsed.compact);
+            } else if (key == "fields") {
+                ok = readFieldMask(reader, parsed.fields);
+            } else {
+                ok = reader.skipValue();
+            }
+            if (!ok) {
+                error = "invalid value for option '" + key + "'";
+                return false;
+            }
+        } while (reader.consume(','));
+
+        if (!reader.consume('}')) {
+            error = "malformed options object";
+            return false;
+        }
+    }
+
+    if (!reader.atEnd()) {
+        error = "unexpected trailing characters after options object";
+        return false;
+    }
+
+    options = parsed;
+    return true;
+}
+
+} // namespace wasm_litehtml_v2
@@ -0,0 +1,81 @@
+/**
+ * @file parse_options.h
+ * @brief Parse options - decoding of the optionsJson argument (解析选项)
+ *
+ * The optionsJson argument of parseHTML() is a flat JSON object. Only the
+ * keys listed in ParseOptions are recognised; unknown keys are skipped so
+ * that newer JS wrappers keep working against older WASM builds.
+ */
+
+#ifndef WASM_V2_PARSE_OPTIONS_H
+#define WASM_V2_PARSE_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief CharLayout fields selectable with options.fields (可投影的字符字段位掩码)
+ *
+ * Bits are in serialization order; a projected object always lists its
+ * fields in this order regardless of the order requested.
+ */
+enum CharField : uint32_t {
+    CharFieldCharacter       = 1u << 0,
+    CharFieldX               = 1u << 1,
+    CharFieldY               = 1u << 2,
+    CharFieldWidth           = 1u << 3,
+    CharFieldHeight          = 1u << 4,
+    CharFieldFontFamily      = 1u << 5,
+    CharFieldFontSize        = 1u << 6,
+    CharFieldFontWeight      = 1u << 7,
+    CharFieldFontStyle       = 1u << 8,
+    CharFieldColor           = 1u << 9,
+    CharFieldBackgroundColor = 1u << 10,
+    CharFieldOpacity         = 1u << 11,
+    CharFieldTextDecoration  = 1u << 12,
+    CharFieldLetterSpacing   = 1u << 13,
+    CharFieldWordSpacing     = 1u << 14,
+    CharFieldTransform       = 1u << 15,
+    CharFieldBaseline        = 1u << 16,
+    CharFieldDirection       = 1u << 17,
+    CharFieldFontId          = 1u << 18,
+    CharFieldAll             = (1u << 19) - 1
+};
+
+/**
+ * @brief Options decoded from optionsJson (从 optionsJson 解码的选项)
+ */
+struct ParseOptions {
+    bool displayList = false;       // Record box decorations into a display list (记录绘制列表)
+    bool heightOnly = false;        // fitToBox: ignore horizontal overflow (仅按高度适配)
+    int maxLines = 0;               // Stop layout after this many lines, 0 = no limit (最大行数)
+    float maxHeight = 0;            // Stop layout at this document y, 0 = no limit (最大高度)
+    bool ellipsis = false;          // End a truncated layout with an ellipsis (截断时添加省略号)
+    uint32_t fields = CharFieldAll; // CharLayout fields to serialize, CharField bits (输出字段投影)
+    bool compact = false;           // Compact dialect: style table, short keys (紧凑输出格式)
+    int serializeThreads = 0;       // Flat output threads, 0 = automatic, 1 = off (扁平输出序列化线程数)
+    int layoutThreads = 1;          // Parallel layout threads, 0 = automatic, 1 = off (并行布局线程数)
+    int pipelineQueue = 2;          // Documents queued between parseHTMLBatch stages, 0 = no pipeline (批处理流水线队列长度)
+
+    // Complexity limits, 0 = no limit; exceeding one fails the parse (复杂度限制)
+    int maxDepth = 0;               // Element nesting depth (最大嵌套深度)
+    int maxElements = 0;            // Elements in the document (最大元素数)
+    int maxCssRules = 0;            // Selectors of the document's style sheets (最大 CSS 选择器数)
+    int maxTableCells = 0;          // Table grid cells, spanned cells included (最大表格单元数)
+    int maxGlyphs = 0;              // Characters drawn into the output (最大输出字符数)
+
+    /**
+     * @brief Decode options from a JSON object string (从 JSON 字符串解码选项)
+     * @param json JSON object text, may be NULL or empty
+     * @param options Output: decoded options (unknown keys are ignored)
+     * @param error Output: error description when decoding fails
+     * @return true on success; on failure options keeps the defaults
+     */
+    static bool fromJson(const char* json, ParseOptions& options, std::string& error);
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_PARSE_OPTIONS_H
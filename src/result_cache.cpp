@@ -0,0 +1,235 @@
+/**
+ * @file result_cache.cpp
+ * @brief Layout Result Cache implementation for HTML Layout Parser v2.0
+ */
+
+#include "result_cache.h"
+#include <cstring>
+#include <sstream>
+
+namespace wasm_litehtml_v2 {
+
+// ========== Hasher128 (MurmurHash3 x64_128) ==========
+
+namespace {
+
+inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+} // namespace
+
+void Hasher128::update(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const size_t nblocks = length / 16;
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    uint64_t h1 = m_hash.lo;
+    uint64_t h2 = m_hash.hi;
+
+    for (size_t i = 0; i < nblocks; i++) {
+        uint64_t k1 = load64(bytes + i * 16);
+        uint64_t k2 = load64(bytes + i * 16 + 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = bytes + nblocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    switch (length & 15) {
+        case 15: k2 ^= static_cast<uint64_t>(tail[14]) << 48; [[fallthrough]];
+        case 14: k2 ^= static_cast<uint64_t>(tail[13]) << 40; [[fallthrough]];
+        case 13: k2 ^= static_cast<uint64_t>(tail[12]) << 32; [[fallthrough]];
+        case 12: k2 ^= static_cast<uint64_t>(tail[11]) << 24; [[fallthrough]];
+        case 11: k2 ^= static_cast<uint64_t>(tail[10]) << 16; [[fallthrough]];
+        case 10: k2 ^= static_cast<uint64_t>(tail[9]) << 8; [[fallthrough]];
+        case 9:
+            k2 ^= static_cast<uint64_t>(tail[8]);
+            k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+            [[fallthrough]];
+        case 8: k1 ^= static_cast<uint64_t>(tail[7]) << 56; [[fallthrough]];
+        case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+        case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+        case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+        case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+        case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+        case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
+        case 1:
+            k1 ^= static_cast<uint64_t>(tail[0]);
+            k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+            break;
+        default:
+            break;
+    }
+
+    h1 ^= static_cast<uint64_t>(length);
+    h2 ^= static_cast<uint64_t>(length);
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    m_hash.lo = h1;
+    m_hash.hi = h2;
+}
+
+void Hasher128::update(const char* str) {
+    if (str == nullptr) {
+        update(static_cast<uint64_t>(0x6e756c6cULL));  // "null" marker
+        return;
+    }
+    update(str, strlen(str));
+}
+
+void Hasher128::update(uint64_t value) {
+    update(&value, sizeof(value));
+}
+
+// ========== ResultCache ==========
+
+ResultCache& ResultCache::getInstance() {
+    static ResultCache instance;
+    return instance;
+}
+
+ResultCache::ResultCache()
+    : m_budget(0)
+    , m_bytes(0)
+    , m_generation(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+{
+}
+
+void ResultCache::setBudget(size_t maxBytes) {
+    m_budget = maxBytes;
+    if (m_budget == 0) {
+        clear();
+    } else {
+        evictToFit(0);
+    }
+}
+
+const CachedResult* ResultCache::find(const Hash128& key, uint64_t generation) {
+    syncGeneration(generation);
+
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_misses++;
+        return nullptr;
+    }
+
+    // Move to front (most recently used, 移到队首)
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    m_hits++;
+    return &it->second->result;
+}
+
+void ResultCache::store(const Hash128& key, uint64_t generation, CachedResult&& result) {
+    if (m_budget == 0) {
+        return;
+    }
+    syncGeneration(generation);
+
+    size_t bytes = entrySize(result);
+    if (bytes > m_budget) {
+        return;
+    }
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_bytes -= it->second->bytes;
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+
+    evictToFit(bytes);
+
+    m_lru.push_front(Entry{key, std::move(result), bytes});
+    m_index[key] = m_lru.begin();
+    m_bytes += bytes;
+}
+
+void ResultCache::clear() {
+    m_lru.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+std::string ResultCache::getStatsJson() const {
+    std::ostringstream oss;
+    oss << "{";
+    oss << "\"enabled\":" << (isEnabled() ? "true" : "false") << ",";
+    oss << "\"hits\":" << m_hits << ",";
+    oss << "\"misses\":" << m_misses << ",";
+    oss << "\"evictions\":" << m_evictions << ",";
+    oss << "\"entries\":" << m_lru.size() << ",";
+    size_t total = m_hits + m_misses;
+    if (total > 0) {
+        oss << "\"hitRate\":" << static_cast<float>(m_hits) / static_cast<float>(total) << ",";
+    } else {
+        oss << "\"hitRate\":null,";
+    }
+    oss << "\"memoryUsage\":" << m_bytes << ",";
+    oss << "\"budget\":" << m_budget;
+    oss << "}";
+    return oss.str();
+}
+
+void ResultCache::resetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+size_t ResultCache::entrySize(const CachedResult& result) {
+    size_t bytes = sizeof(Entry) + result.data.size() + result.displayList.size();
+    for (const auto& warning : result.warnings) {
+        bytes += sizeof(ParseError) + warning.message.size() + warning.context.size();
+    }
+    return bytes;
+}
+
+void ResultCache::evictToFit(size_t incoming) {
+    while (!m_lru.empty() && m_bytes + incoming > m_budget) {
+        Entry& last = m_lru.back();
+        m_bytes -= last.bytes;
+        m_index.erase(last.key);
+        m_lru.pop_back();
+        m_evictions++;
+    }
+}
+
+void ResultCache::syncGeneration(uint64_t generation) {
+    // Results laid out with a different font set can never be returned again
+    if (generation != m_generation) {
+        clear();
+        m_generation = generation;
+    }
+}
+
+} // namespace wasm_litehtml_v2
@@ -0,0 +1,189 @@
+/**
+ * @file result_cache.h
+ * @brief Layout Result Cache for HTML Layout Parser v2.0
+ *
+ * This module provides:
+ * - An opt-in LRU cache of serialized parse results at the API boundary
+ * - Content-addressed keys: 128-bit hash of (html, css, viewport, mode,
+ *   options, font-set generation)
+ * - A byte budget with least-recently-used eviction
+ * - Automatic invalidation when the loaded font set changes
+ *
+ * Design principles:
+ * - Disabled by default (budget 0); enabled with setBudget()
+ * - A hit returns the stored output without parsing or layout
+ * - Entries larger than the budget are never stored
+ */
+
+#ifndef WASM_V2_RESULT_CACHE_H
+#define WASM_V2_RESULT_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include "error_types.h"
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief 128-bit hash value (128 位哈希值)
+ */
+struct Hash128 {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    bool operator==(const Hash128& other) const {
+        return lo == other.lo && hi == other.hi;
+    }
+};
+
+/**
+ * @brief Incremental 128-bit hasher (增量 128 位哈希器)
+ *
+ * MurmurHash3 x64_128 applied field by field, each field seeded with the
+ * running hash, so (html, css) boundaries cannot collide by concatenation.
+ */
+class Hasher128 {
+public:
+    /**
+     * @brief Mix a byte range into the hash (混入字节区间)
+     */
+    void update(const void* data, size_t length);
+
+    /**
+     * @brief Mix a C string into the hash; NULL hashes differently from "" (混入字符串)
+     */
+    void update(const char* str);
+
+    /**
+     * @brief Mix an integer into the hash (混入整数)
+     */
+    void update(uint64_t value);
+
+    /**
+     * @brief Get the current hash (获取当前哈希)
+     */
+    Hash128 digest() const { return m_hash; }
+
+private:
+    Hash128 m_hash;
+};
+
+/**
+ * @brief Cached parse output (缓存的解析结果)
+ */
+struct CachedResult {
+    std::string data;                       // Serialized JSON output (序列化输出)
+    std::vector<uint8_t> displayList;       // Display list bytes, if recorded (绘制列表)
+    std::vector<ParseError> warnings;       // Warnings of the original parse (原始警告)
+    int characterCount = 0;                 // Character count (字符数)
+};
+
+/**
+ * @brief Layout Result Cache class (布局结果缓存类)
+ *
+ * Usage:
+ * 1. Compute a key with Hasher128 over the parse inputs
+ * 2. find() before parsing; on a hit return the cached output
+ * 3. store() the output after a successful parse
+ */
+class ResultCache {
+public:
+    /**
+     * @brief Get singleton instance (获取单例实例)
+     * @return ResultCache& Reference to the singleton
+     */
+    static ResultCache& getInstance();
+
+    /**
+     * @brief Set the byte budget; 0 disables the cache and drops all entries (设置字节预算)
+     * @param maxBytes Maximum total size of cached entries in bytes
+     */
+    void setBudget(size_t maxBytes);
+
+    /**
+     * @brief Check whether the cache is enabled (是否启用)
+     */
+    bool isEnabled() const { return m_budget > 0; }
+
+    /**
+     * @brief Look up a result and mark it most recently used (查找结果)
+     *
+     * @param key Content hash of the parse inputs
+     * @param generation Current font-set generation; older entries are dropped
+     * @return const CachedResult* Cached result, nullptr on miss
+     */
+    const CachedResult* find(const Hash128& key, uint64_t generation);
+
+    /**
+     * @brief Store a result, evicting least recently used entries (存储结果)
+     *
+     * @param key Content hash of the parse inputs
+     * @param generation Font-set generation the result was produced with
+     * @param result Result to store (moved)
+     */
+    void store(const Hash128& key, uint64_t generation, CachedResult&& result);
+
+    /**
+     * @brief Drop all entries (清除所有条目)
+     */
+    void clear();
+
+    /**
+     * @brief Get cache statistics as a JSON object (获取统计 JSON)
+     * @return std::string JSON object
+     */
+    std::string getStatsJson() const;
+
+    /**
+     * @brief Reset hit/miss/eviction counters (重置统计)
+     */
+    void resetStats();
+
+    /**
+     * @brief Get total bytes held by cached entries (获取内存占用)
+     */
+    size_t getMemoryUsage() const { return m_bytes; }
+
+    // Disable copy and assignment
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+private:
+    ResultCache();
+    ~ResultCache() = default;
+
+    struct Entry {
+        Hash128 key;
+        CachedResult result;
+        size_t bytes;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Hash128& key) const {
+            return static_cast<size_t>(key.lo ^ (key.hi >> 1));
+        }
+    };
+
+    static size_t entrySize(const CachedResult& result);
+    void evictToFit(size_t incoming);
+    void syncGeneration(uint64_t generation);
+
+    std::list<Entry> m_lru;                 // Most recently used first (最近使用在前)
+    std::unordered_map<Hash128, std::list<Entry>::iterator, KeyHash> m_index;
+    size_t m_budget;                        // Byte budget, 0 = disabled (字节预算)
+    size_t m_bytes;                         // Bytes currently held (当前占用)
+    uint64_t m_generation;                  // Font-set generation of the entries (字体集代数)
+
+    // Statistics
+    size_t m_hits;
+    size_t m_misses;
+    size_t m_evictions;
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_RESULT_CACHE_H
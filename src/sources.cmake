@@ -0,0 +1,132 @@
+# ============================================================================
+# Source lists for the HTML Layout Parser core
+#
+# Included by src/CMakeLists.txt (WASM build) and node-addon/CMakeLists.txt
+# (Node addon). Defines LITEHTML_ROOT, GUMBO_DIR, LITEHTML_DIR and the
+# SOURCE_GUMBO, SOURCE_LITEHTML and SOURCE_WASM_V2 lists.
+# ============================================================================
+
+# litehtml root (allows override via -DLITEHTML_ROOT=... or env)
+if(NOT DEFINED LITEHTML_ROOT)
+    if(DEFINED ENV{LITEHTML_ROOT})
+        set(LITEHTML_ROOT "$ENV{LITEHTML_ROOT}")
+    else()
+        set(_third_party_root "${CMAKE_CURRENT_LIST_DIR}/../third_party/litehtml")
+        set(_lib_root "${CMAKE_CURRENT_LIST_DIR}/../lib/litehtml")
+        set(_local_root "${CMAKE_CURRENT_LIST_DIR}/..")
+        set(_legacy_root "${CMAKE_CURRENT_LIST_DIR}/../..")
+        if(EXISTS "${_third_party_root}/src/gumbo" AND EXISTS "${_third_party_root}/include")
+            set(LITEHTML_ROOT "${_third_party_root}")
+        elseif(EXISTS "${_lib_root}/src/gumbo" AND EXISTS "${_lib_root}/include")
+            set(LITEHTML_ROOT "${_lib_root}")
+        elseif(EXISTS "${_local_root}/src/gumbo" AND EXISTS "${_local_root}/include")
+            set(LITEHTML_ROOT "${_local_root}")
+        elseif(EXISTS "${_legacy_root}/src/gumbo" AND EXISTS "${_legacy_root}/include")
+            set(LITEHTML_ROOT "${_legacy_root}")
+        else()
+            set(LITEHTML_ROOT "${_third_party_root}")
+        endif()
+    endif()
+endif()
+
+# Gumbo source files
+set(GUMBO_DIR ${LITEHTML_ROOT}/src/gumbo)
+set(SOURCE_GUMBO
+    ${GUMBO_DIR}/attribute.c
+    ${GUMBO_DIR}/char_ref.c
+    ${GUMBO_DIR}/error.c
+    ${GUMBO_DIR}/parser.c
+    ${GUMBO_DIR}/string_buffer.c
+    ${GUMBO_DIR}/string_piece.c
+    ${GUMBO_DIR}/tag.c
+    ${GUMBO_DIR}/tokenizer.c
+    ${GUMBO_DIR}/utf8.c
+    ${GUMBO_DIR}/util.c
+    ${GUMBO_DIR}/vector.c
+)
+
+# litehtml source files
+set(LITEHTML_DIR ${LITEHTML_ROOT}/src)
+set(SOURCE_LITEHTML
+    ${LITEHTML_DIR}/codepoint.cpp
+    ${LITEHTML_DIR}/counter_state.cpp
+    ${LITEHTML_DIR}/css_length.cpp
+    ${LITEHTML_DIR}/css_selector.cpp
+    ${LITEHTML_DIR}/css_tokenizer.cpp
+    ${LITEHTML_DIR}/css_parser.cpp
+    ${LITEHTML_DIR}/document.cpp
+    ${LITEHTML_DIR}/document_container.cpp
+    ${LITEHTML_DIR}/el_anchor.cpp
+    ${LITEHTML_DIR}/el_base.cpp
+    ${LITEHTML_DIR}/el_before_after.cpp
+    ${LITEHTML_DIR}/el_body.cpp
+    ${LITEHTML_DIR}/el_break.cpp
+    ${LITEHTML_DIR}/el_cdata.cpp
+    ${LITEHTML_DIR}/el_comment.cpp
+    ${LITEHTML_DIR}/el_div.cpp
+    ${LITEHTML_DIR}/element.cpp
+    ${LITEHTML_DIR}/el_font.cpp
+    ${LITEHTML_DIR}/el_image.cpp
+    ${LITEHTML_DIR}/el_link.cpp
+    ${LITEHTML_DIR}/el_para.cpp
+    ${LITEHTML_DIR}/el_script.cpp
+    ${LITEHTML_DIR}/el_space.cpp
+    ${LITEHTML_DIR}/el_style.cpp
+    ${LITEHTML_DIR}/el_table.cpp
+    ${LITEHTML_DIR}/el_td.cpp
+    ${LITEHTML_DIR}/el_col.cpp
+    ${LITEHTML_DIR}/el_text.cpp
+    ${LITEHTML_DIR}/el_title.cpp
+    ${LITEHTML_DIR}/el_tr.cpp
+    ${LITEHTML_DIR}/encodings.cpp
+    ${LITEHTML_DIR}/html.cpp
+    ${LITEHTML_DIR}/html_tag.cpp
+    ${LITEHTML_DIR}/html_microsyntaxes.cpp
+    ${LITEHTML_DIR}/iterators.cpp
+    ${LITEHTML_DIR}/media_query.cpp
+    ${LITEHTML_DIR}/style.cpp
+    ${LITEHTML_DIR}/stylesheet.cpp
+    ${LITEHTML_DIR}/table.cpp
+    ${LITEHTML_DIR}/tstring_view.cpp
+    ${LITEHTML_DIR}/url.cpp
+    ${LITEHTML_DIR}/url_path.cpp
+    ${LITEHTML_DIR}/utf8_strings.cpp
+    ${LITEHTML_DIR}/web_color.cpp
+    ${LITEHTML_DIR}/num_cvt.cpp
+    ${LITEHTML_DIR}/strtod.cpp
+    ${LITEHTML_DIR}/string_id.cpp
+    ${LITEHTML_DIR}/css_properties.cpp
+    ${LITEHTML_DIR}/line_box.cpp
+    ${LITEHTML_DIR}/css_borders.cpp
+    ${LITEHTML_DIR}/render_item.cpp
+    ${LITEHTML_DIR}/render_block_context.cpp
+    ${LITEHTML_DIR}/render_block.cpp
+    ${LITEHTML_DIR}/render_inline_context.cpp
+    ${LITEHTML_DIR}/render_table.cpp
+    ${LITEHTML_DIR}/render_flex.cpp
+    ${LITEHTML_DIR}/render_image.cpp
+    ${LITEHTML_DIR}/formatting_context.cpp
+    ${LITEHTML_DIR}/flex_item.cpp
+    ${LITEHTML_DIR}/flex_line.cpp
+    ${LITEHTML_DIR}/background.cpp
+    ${LITEHTML_DIR}/gradient.cpp
+)
+
+# WASM v2 module source files
+set(SOURCE_WASM_V2
+    ${CMAKE_CURRENT_LIST_DIR}/html_layout_parser.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/multi_font_manager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/wasm_container.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/json_serializer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/debug_log.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/font_metrics_cache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/display_list.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/parse_options.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/result_cache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/template_session.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/document_snapshot.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/layout_measure.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/chunk_stream.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/parallel_layout.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/batch_pipeline.cpp
+)
@@ -0,0 +1,145 @@
+/**
+ * @file template_session.cpp
+ * @brief Template Session implementation (模板会话实现)
+ */
+
+#include "template_session.h"
+#include "json_reader.h"
+#include "json_serializer.h"
+#include "multi_font_manager.h"
+#include <litehtml/el_before_after.h>
+
+namespace wasm_litehtml_v2 {
+
+TemplateSession::TemplateSession(int viewportWidth, int viewportHeight)
+    : m_container(new WasmContainer(viewportWidth, viewportHeight))
+    , m_viewportWidth(viewportWidth)
+    , m_viewportHeight(viewportHeight)
+    , m_fontGeneration(0)
+{
+}
+
+bool TemplateSession::compile(const char* html, const char* css) {
+    std::string fullHtml;
+    if (css != nullptr && *css != '\0') {
+        fullHtml = "<style>";
+        fullHtml += css;
+        fullHtml += "</style>";
+    }
+    fullHtml += html;
+
+    m_fontGeneration = MultiFontManager::getInstance().getGeneration();
+    m_document = litehtml::document::createFromString(fullHtml.c_str(), m_container.get());
+    if (!m_document || !m_document->root()) {
+        return false;
+    }
+
+    collectSlots(m_document->root());
+    return true;
+}
+
+void TemplateSession::collectSlots(const litehtml::element::ptr& el) {
+    const char* name = el->get_attr("data-slot");
+    if (name != nullptr) {
+        Slot slot;
+        slot.element = el;
+        slot.name = name;
+        for (const auto& child : el->children()) {
+            // Generated content is not part of the slot text (伪元素不属于插槽文本)
+            if (!std::dynamic_pointer_cast<litehtml::el_before_after_base>(child)) {
+                child->get_text(slot.defaultText);
+            }
+        }
+        slot.currentText = slot.defaultText;
+        m_slots.push_back(std::move(slot));
+        // Nested slots would be replaced together with their parent
+        return;
+    }
+
+    for (const auto& child : el->children()) {
+        collectSlots(child);
+    }
+}
+
+void TemplateSession::setSlotValues(const std::vector<SlotValue>& values) {
+    bool changed = false;
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        Slot& slot = m_slots[i];
+        const std::string& text = (i < values.size() && !values[i].useDefault)
+            ? values[i].text : slot.defaultText;
+        if (text == slot.currentText) {
+            continue;
+        }
+        m_document->set_element_text(slot.element, text.c_str());
+        slot.currentText = text;
+        changed = true;
+    }
+
+    if (changed) {
+        m_document->rebuild_render_tree();
+    }
+}
+
+const std::vector<CharLayout>& TemplateSession::layout(bool displayList) {
+    m_container->clearCharLayouts();
+    m_container->setDisplayListEnabled(displayList);
+
+    m_document->render(m_viewportWidth);
+    litehtml::position clip(0, 0, m_viewportWidth, m_viewportHeight);
+    m_document->draw(0, 0, 0, &clip);
+
+    return m_container->getCharLayouts();
+}
+
+std::string TemplateSession::getSlotsJson() const {
+    std::string json = "[";
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "\"" + JsonSerializer::escapeJsonString(m_slots[i].name) + "\"";
+    }
+    json += "]";
+    return json;
+}
+
+bool TemplateSession::parseSlotValues(const char* json, std::vector<SlotValue>& values, std::string& error) {
+    values.clear();
+    if (json == nullptr || *json == '\0') {
+        return true;
+    }
+
+    JsonReader reader(json);
+    if (!reader.consume('[')) {
+        error = "slot values must be a JSON array";
+        return false;
+    }
+
+    if (!reader.consume(']')) {
+        do {
+            SlotValue value;
+            if (reader.readNull()) {
+                value.useDefault = true;
+            } else if (reader.readString(value.text)) {
+                value.useDefault = false;
+            } else {
+                error = "slot value " + std::to_string(values.size()) + " must be a string or null";
+                return false;
+            }
+            values.push_back(std::move(value));
+        } while (reader.consume(','));
+
+        if (!reader.consume(']')) {
+            error = "malformed slot values array";
+            return false;
+        }
+    }
+
+    if (!reader.atEnd()) {
+        error = "unexpected trailing characters after slot values";
+        return false;
+    }
+    return true;
+}
+
+} // namespace wasm_litehtml_v2
@@ -0,0 +1,147 @@
+/**
+ * @file template_session.h
+ * @brief Template Session - compiled documents with text slots (模板会话)
+ *
+ * This module provides:
+ * - Compile-once templates: HTML is parsed and styled a single time
+ * - Text slots marked with the data-slot attribute, in document order
+ * - Re-layout with new slot values: only slot text nodes are replaced and
+ *   re-measured, then the render tree is rebuilt and laid out again
+ *
+ * Design principles:
+ * - HTML parsing and style cascade are never repeated for a session
+ * - Slot content is plain text; markup inside a slot is replaced
+ * - Sessions are tied to the font set they were compiled with
+ */
+
+#ifndef WASM_V2_TEMPLATE_SESSION_H
+#define WASM_V2_TEMPLATE_SESSION_H
+
+#include <litehtml.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "wasm_container.h"
+
+namespace wasm_litehtml_v2 {
+
+/**
+ * @brief Value for one slot (插槽值)
+ */
+struct SlotValue {
+    bool useDefault = true;         // Keep the template text (使用模板文本)
+    std::string text;               // Replacement text (替换文本)
+};
+
+/**
+ * @brief Compiled template document (编译后的模板文档)
+ *
+ * Usage:
+ * 1. compile() the template HTML and CSS once
+ * 2. setSlotValues() with the values of one variant
+ * 3. layout() to render and collect character layouts
+ */
+class TemplateSession {
+public:
+    /**
+     * @brief Constructor (构造函数)
+     * @param viewportWidth Viewport width (pixels)
+     * @param viewportHeight Viewport height (pixels)
+     */
+    TemplateSession(int viewportWidth, int viewportHeight);
+
+    /**
+     * @brief Parse and style the template document (解析并计算模板样式)
+     * @param html Template HTML; slots are elements with a data-slot attribute
+     * @param css External CSS (optional, can be NULL)
+     * @return true on success
+     */
+    bool compile(const char* html, const char* css);
+
+    /**
+     * @brief Replace slot text (替换插槽文本)
+     *
+     * Slot i receives values[i]; slots without a value get their template text
+     * back. Unchanged slots are left untouched, and the render tree is only
+     * rebuilt when at least one slot changed.
+     *
+     * @param values Slot values in document order
+     */
+    void setSlotValues(const std::vector<SlotValue>& values);
+
+    /**
+     * @brief Lay out the document and collect character layouts (布局并收集字符)
+     * @param displayList true to record box decorations into the display list
+     * @return Character layouts, valid until the next layout() call
+     */
+    const std::vector<CharLayout>& layout(bool displayList);
+
+    /**
+     * @brief Get the container holding layouts and the display list (获取容器)
+     */
+    WasmContainer& getContainer() { return *m_container; }
+
+    /**
+     * @brief Get the template document, null before compile() (获取模板文档)
+     */
+    const litehtml::document::ptr& getDocument() const { return m_document; }
+
+    /**
+     * @brief Get the number of slots (获取插槽数量)
+     */
+    size_t getSlotCount() const { return m_slots.size(); }
+
+    /**
+     * @brief Get slot names as a JSON array in document order (获取插槽名称 JSON)
+     */
+    std::string getSlotsJson() const;
+
+    /**
+     * @brief Get the font-set generation the template was compiled with (获取字体集代数)
+     */
+    uint64_t getFontGeneration() const { return m_fontGeneration; }
+
+    /**
+     * @brief Get the viewport width (获取视口宽度)
+     */
+    int getViewportWidth() const { return m_viewportWidth; }
+
+    /**
+     * @brief Decode a JSON array of slot values (解码插槽值 JSON 数组)
+     *
+     * Entries are strings or null; null keeps the template text of that slot.
+     *
+     * @param json JSON array text, may be NULL or empty (all defaults)
+     * @param values Output: decoded values
+     * @param error Output: error description when decoding fails
+     * @return true on success
+     */
+    static bool parseSlotValues(const char* json, std::vector<SlotValue>& values, std::string& error);
+
+    // Disable copy and assignment
+    TemplateSession(const TemplateSession&) = delete;
+    TemplateSession& operator=(const TemplateSession&) = delete;
+
+private:
+    struct Slot {
+        litehtml::element::ptr element;     // Slot element (插槽元素)
+        std::string name;                   // data-slot value (插槽名称)
+        std::string defaultText;            // Template text (模板文本)
+        std::string currentText;            // Text currently in the tree (当前文本)
+    };
+
+    void collectSlots(const litehtml::element::ptr& el);
+
+    // Declared before m_document: the document releases fonts through the container
+    std::unique_ptr<WasmContainer> m_container;
+    litehtml::document::ptr m_document;
+    std::vector<Slot> m_slots;
+    int m_viewportWidth;
+    int m_viewportHeight;
+    uint64_t m_fontGeneration;
+};
+
+} // namespace wasm_litehtml_v2
+
+#endif // WASM_V2_TEMPLATE_SESSION_H
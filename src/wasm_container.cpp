@@ -173,6 +173,10 @@ void WasmContainer::draw_text(litehtml::uint_ptr /*hdc*/, const char* text,
     int baseY = static_cast<int>(pos.y);
     
     while (*p) {
+        if (m_maxGlyphs > 0 && m_charLayouts.size() >= m_maxGlyphs) {
+            m_glyphLimitReached = true;
+            return;
+        }
         std::string charStr;
         uint32_t codepoint = decodeUtf8Char(p, charStr);
         
@@ -268,10 +272,15 @@ const char* WasmContainer::get_default_font_name() const {
     return "sans-serif";
 }
 
-// ========== Drawing Methods (Empty Implementation) ==========
+// ========== Drawing Methods (绘制方法) ==========
 
 void WasmContainer::draw_list_marker(litehtml::uint_ptr /*hdc*/, 
-                                        const litehtml::list_marker& /*marker*/) {
+                                        const litehtml::list_marker& marker) {
+    // Text markers (decimal, roman, ...) arrive through draw_text;
+    // only bullets and list-style-image markers reach this method
+    if (m_recordDisplayList) {
+        m_displayList.listMarker(marker);
+    }
 }
 
 void WasmContainer::load_image(const char* /*src*/, const char* /*baseurl*/, 
@@ -285,35 +294,53 @@ void WasmContainer::get_image_size(const char* /*src*/, const char* /*baseurl*/,
 }
 
 void WasmContainer::draw_image(litehtml::uint_ptr /*hdc*/, 
-                                  const litehtml::background_layer& /*layer*/, 
-                                  const std::string& /*url*/, 
+                                  const litehtml::background_layer& layer, 
+                                  const std::string& url, 
                                   const std::string& /*base_url*/) {
+    if (m_recordDisplayList) {
+        m_displayList.image(layer, url);
+    }
 }
 
 void WasmContainer::draw_solid_fill(litehtml::uint_ptr /*hdc*/, 
-                                       const litehtml::background_layer& /*layer*/, 
-                                       const litehtml::web_color& /*color*/) {
+                                       const litehtml::background_layer& layer, 
+                                       const litehtml::web_color& color) {
+    if (m_recordDisplayList) {
+        m_displayList.fillRect(layer, color);
+    }
 }
 
 void WasmContainer::draw_linear_gradient(litehtml::uint_ptr /*hdc*/, 
-                                            const litehtml::background_layer& /*layer*/, 
-                                            const litehtml::background_layer::linear_gradient& /*gradient*/) {
+                                            const litehtml::background_layer& layer, 
+                                            const litehtml::background_layer::linear_gradient& gradient) {
+    if (m_recordDisplayList) {
+        m_displayList.linearGradient(layer, gradient);
+    }
 }
 
 void WasmContainer::draw_radial_gradient(litehtml::uint_ptr /*hdc*/, 
-                                            const litehtml::background_layer& /*layer*/, 
-                                            const litehtml::background_layer::radial_gradient& /*gradient*/) {
+                                            const litehtml::background_layer& layer, 
+                                            const litehtml::background_layer::radial_gradient& gradient) {
+    if (m_recordDisplayList) {
+        m_displayList.radialGradient(layer, gradient);
+    }
 }
 
 void WasmContainer::draw_conic_gradient(litehtml::uint_ptr /*hdc*/, 
-                                           const litehtml::background_layer& /*layer*/, 
-                                           const litehtml::background_layer::conic_gradient& /*gradient*/) {
+                                           const litehtml::background_layer& layer, 
+                                           const litehtml::background_layer::conic_gradient& gradient) {
+    if (m_recordDisplayList) {
+        m_displayList.conicGradient(layer, gradient);
+    }
 }
 
 void WasmContainer::draw_borders(litehtml::uint_ptr /*hdc*/, 
-                                    const litehtml::borders& /*borders*/, 
-                                    const litehtml::position& /*draw_pos*/, 
-                                    bool /*root*/) {
+                                    const litehtml::borders& borders, 
+                                    const litehtml::position& draw_pos, 
+                                    bool root) {
+    if (m_recordDisplayList) {
+        m_displayList.borders(borders, draw_pos, root);
+    }
 }
 
 // ========== Document Methods (Empty Implementation) ==========
@@ -348,11 +375,17 @@ void WasmContainer::import_css(litehtml::string& /*text*/,
                                   litehtml::string& /*baseurl*/) {
 }
 
-void WasmContainer::set_clip(const litehtml::position& /*pos*/, 
-                                const litehtml::border_radiuses& /*bdr_radius*/) {
+void WasmContainer::set_clip(const litehtml::position& pos, 
+                                const litehtml::border_radiuses& bdr_radius) {
+    if (m_recordDisplayList) {
+        m_displayList.pushClip(pos, bdr_radius);
+    }
 }
 
 void WasmContainer::del_clip() {
+    if (m_recordDisplayList) {
+        m_displayList.popClip();
+    }
 }
 
 void WasmContainer::get_viewport(litehtml::position& viewport) const {
@@ -380,12 +413,20 @@ void WasmContainer::get_media_features(litehtml::media_features& media) const {
     media.resolution = 96;
 }
 
+void WasmContainer::setViewportWidth(int viewportWidth) {
+    m_viewportWidth = viewportWidth;
+}
+
 void WasmContainer::get_language(litehtml::string& language, 
                                     litehtml::string& culture) const {
     language = "en";
     culture = "US";
 }
 
+void WasmContainer::get_complexity_limit(litehtml::complexity_limit& limit) const {
+    limit = m_complexityLimit;
+}
+
 // ========== Layout Result Access ==========
 
 const std::vector<CharLayout>& WasmContainer::getCharLayouts() const {
@@ -396,12 +437,30 @@ void WasmContainer::clearCharLayouts() {
     // ⚠️ MANDATORY: Clear and release vector memory
     m_charLayouts.clear();
     m_charLayouts.shrink_to_fit();
+    m_glyphLimitReached = false;
 }
 
 size_t WasmContainer::getCharCount() const {
     return m_charLayouts.size();
 }
 
+void WasmContainer::setDisplayListEnabled(bool enabled) {
+    m_recordDisplayList = enabled;
+}
+
+void WasmContainer::setComplexityLimit(const litehtml::complexity_limit& limit, int maxGlyphs) {
+    m_complexityLimit = limit;
+    m_maxGlyphs = maxGlyphs > 0 ? static_cast<size_t>(maxGlyphs) : 0;
+}
+
+bool WasmContainer::glyphLimitReached() const {
+    return m_glyphLimitReached;
+}
+
+DisplayList& WasmContainer::getDisplayList() {
+    return m_displayList;
+}
+
 // ========== Private Helper Methods ==========
 
 std::string WasmContainer::colorToHexRGBA(const litehtml::web_color& color) {
@@ -7,6 +7,7 @@
  * - Enhanced CharLayout with rich text attributes
  * - Font fallback chain support via font-family resolution
  * - Strict memory management with immediate cleanup
+ * - Optional display list capture of box decorations
  * 
  * @note Requirements: 1.1, 1.5, 9.1, 9.8
  */
@@ -19,6 +20,7 @@
 #include <string>
 #include <map>
 #include "multi_font_manager.h"
+#include "display_list.h"
 
 namespace wasm_litehtml_v2 {
 
@@ -165,7 +167,9 @@ public:
     litehtml::pixel_t get_default_font_size() const override;
     const char* get_default_font_name() const override;
 
-    // ========== Drawing Methods (Empty Implementation, 绘制空实现) ==========
+    // ========== Drawing Methods (绘制方法) ==========
+    // Recorded into the display list when enabled, ignored otherwise
+    // (启用时记录到绘制列表，否则忽略)
     
     void draw_list_marker(litehtml::uint_ptr hdc, const litehtml::list_marker& marker) override;
     void load_image(const char* src, const char* baseurl, bool redraw_on_ready) override;
@@ -204,6 +208,17 @@ public:
                                           const std::shared_ptr<litehtml::document>& doc) override;
     void get_media_features(litehtml::media_features& media) const override;
     void get_language(litehtml::string& language, litehtml::string& culture) const override;
+    void get_complexity_limit(litehtml::complexity_limit& limit) const override;
+
+    /**
+     * @brief Change the viewport width (修改视口宽度)
+     * 
+     * Affects get_viewport() and media features; call document::media_changed()
+     * afterwards so media-dependent styles are re-evaluated.
+     * 
+     * @param viewportWidth Viewport width (pixels)
+     */
+    void setViewportWidth(int viewportWidth);
 
     // ========== Layout Result Access (布局结果访问) ==========
     
@@ -226,11 +241,45 @@ public:
      */
     size_t getCharCount() const;
 
+    // ========== Complexity Limits (复杂度限制) ==========
+
+    /**
+     * @brief Limit the documents created with this container (设置复杂度限制)
+     * @param limit Tree construction limits, read by createFromString()
+     * @param maxGlyphs Characters draw_text() collects before it stops, 0 = no limit
+     */
+    void setComplexityLimit(const litehtml::complexity_limit& limit, int maxGlyphs);
+
+    /**
+     * @brief Check whether draw_text() dropped characters over maxGlyphs (输出字符数是否超限)
+     * @return true once the limit was hit; reset by clearCharLayouts()
+     */
+    bool glyphLimitReached() const;
+
+    // ========== Display List (绘制列表) ==========
+
+    /**
+     * @brief Enable recording of non-text paint calls (启用绘制列表记录)
+     * @param enabled true to record backgrounds, borders, markers and clips
+     */
+    void setDisplayListEnabled(bool enabled);
+
+    /**
+     * @brief Get the recorded display list (获取绘制列表)
+     * @return Display list in paint order (empty unless enabled)
+     */
+    DisplayList& getDisplayList();
+
 private:
     int m_viewportWidth;                                // Viewport width (视口宽度)
     int m_viewportHeight;                               // Viewport height (视口高度)
     std::vector<CharLayout> m_charLayouts;              // Collected character layouts (字符布局集合)
     std::map<litehtml::uint_ptr, FontInfoInternal> m_fonts; // Font handle map (字体句柄映射)
+    bool m_recordDisplayList = false;                   // Display list capture enabled (记录绘制列表)
+    DisplayList m_displayList;                          // Recorded paint calls (绘制列表)
+    litehtml::complexity_limit m_complexityLimit;       // Tree construction limits (树构建限制)
+    size_t m_maxGlyphs = 0;                             // Collected character limit, 0 = none (字符数上限)
+    bool m_glyphLimitReached = false;                   // draw_text() hit m_maxGlyphs (字符数已超限)
     
     // Cached default font name (缓存默认字体名)
     mutable std::string m_defaultFontName;
@@ -0,0 +1,86 @@
+/**
+ * Flex Layout Tests
+ *
+ * Tests flex container layout:
+ * - Wrapping items into flex lines
+ * - Reuse and invalidation of cached flex item sizes
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout } from './wasm-types';
+
+describe('Flex Layout', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('Flex Lines', () => {
+    it('should wrap flex items into lines', () => {
+      const html = `
+        <div style="display: flex; flex-wrap: wrap; width: 100px">
+          <div style="width: 60px">A</div>
+          <div style="width: 60px">B</div>
+          <div style="width: 30px">C</div>
+          <div style="flex-grow: 1">D</div>
+        </div>
+      `;
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const find = (ch: string) => result.find(c => c.character === ch)!;
+
+      expect(find('B').y).toBeGreaterThan(find('A').y);
+      expect(find('B').x).toBe(find('A').x);
+      expect(find('C').y).toBe(find('B').y);
+      expect(find('C').x - find('B').x).toBe(60);
+      expect(find('D').y).toBe(find('B').y);
+      expect(find('D').x - find('C').x).toBe(30);
+    });
+  });
+
+  describe('Flex Item Size Cache', () => {
+    it('should measure flex items again when the container width changes', () => {
+      // Percentage padding makes the item sizes depend on the container width
+      const css = '.row { display: flex; width: 50% } .row > div { padding: 0 10% }';
+      const html = '<div class="row"><div>AB</div><div>CD</div></div>';
+
+      const results = helper.parseHTMLMultiWidth<CharLayout[]>(html, [800, 400, 800], css);
+      for (const { viewportWidth, data } of results) {
+        expect(data).toEqual(helper.parseHTML<CharLayout[]>(html, viewportWidth, 'flat', css));
+      }
+    });
+
+    it('should measure flex items again after a restyle', () => {
+      // The container width stays the same at both viewports, so only the
+      // restyle tells the cached item sizes apart
+      const css = '.row { display: flex; width: 300px } @media (max-width: 400px) { .row > div { font-size: 32px } }';
+      const html = '<div class="row"><div>AB</div><div>CD</div></div>';
+      const gap = (chars: CharLayout[]) =>
+        chars.find(c => c.character === 'C')!.x - chars.find(c => c.character === 'A')!.x;
+
+      const results = helper.parseHTMLMultiWidth<CharLayout[]>(html, [800, 320, 800], css);
+      for (const { viewportWidth, data } of results) {
+        expect(data).toEqual(helper.parseHTML<CharLayout[]>(html, viewportWidth, 'flat', css));
+      }
+      expect(gap(results[1].data)).toBeGreaterThan(gap(results[0].data));
+      expect(gap(results[2].data)).toBe(gap(results[0].data));
+    });
+  });
+});
@@ -0,0 +1,102 @@
+/**
+ * Float Layout Tests
+ *
+ * Tests the placement of floats and of the line boxes around them:
+ * - Left and right floats with clear
+ * - Many stacked floats next to a tall one
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout } from './wasm-types';
+
+describe('Float Layout', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('Float Placement', () => {
+    it('should flow text around left and right floats', () => {
+      const html = `
+        <div style="width: 200px">
+          <div style="float: left; width: 50px; height: 40px">L</div>
+          <div style="float: right; width: 30px; height: 80px">R</div>
+          <div style="float: left; clear: left; width: 20px; height: 20px">M</div>
+          <p style="margin: 0">a b c d e f g h i j k l m n o p q r s t u v w x y z</p>
+        </div>
+      `;
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const find = (ch: string) => result.find(c => c.character === ch)!;
+
+      // First lines start after the 50px left float and stop before the right one
+      expect(find('a').x - find('L').x).toBe(50);
+      expect(find('h').x).toBeLessThan(find('R').x);
+      // The cleared float sits below the first one and narrows the following line
+      expect(find('M').y - find('L').y).toBe(40);
+      expect(find('q').x - find('M').x).toBe(20);
+      // Once all floats end the line spans the full container
+      expect(find('z').x).toBe(find('L').x);
+    });
+
+    it('should place lines around many floats like the linear float scan', () => {
+      // A tall float first, then 60 floats of both sides with clears, each
+      // followed by a paragraph of 25px inline blocks
+      const css = 'body { margin: 0 } .box { width: 400px; line-height: 20px } ' +
+        'i { display: inline-block; width: 25px; height: 20px; vertical-align: top; font-style: normal }';
+      let html = '<div class="box"><div style="float: left; width: 10px; height: 300px"></div>';
+      for (let i = 0; i < 60; i++) {
+        const side = i % 3 === 0 ? 'right' : 'left';
+        const clear = i % 9 === 8 ? 'both' : i % 5 === 4 ? side : 'none';
+        html += `<div style="float: ${side}; clear: ${clear}; width: ${20 + (i * 13) % 50}px; height: ${10 + (i * 37) % 60}px"></div>`;
+        html += `<p style="margin: 0">${'<i>x</i>'.repeat(3 + (i * 7) % 11)}</p>`;
+      }
+      html += '</div>';
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat', css);
+      const lines: number[][] = [];
+      for (const c of result) {
+        const line = lines.find(l => l[0] === c.y - result[0].y);
+        if (line) {
+          line[1] = Math.min(line[1], c.x);
+          line[2] = Math.max(line[2], c.x);
+        } else {
+          lines.push([c.y - result[0].y, c.x, c.x]);
+        }
+      }
+
+      // [top, left, right] of every line, computed before floats were indexed
+      expect(lines).toEqual([
+        [0, 10, 60], [20, 43, 268], [40, 89, 214], [60, 89, 314], [80, 10, 60], [100, 10, 210],
+        [120, 10, 110], [140, 10, 285], [160, 10, 185], [180, 10, 85], [200, 10, 260], [220, 10, 160],
+        [240, 10, 60], [260, 10, 235], [280, 10, 135], [300, 118, 368], [320, 118, 143], [340, 176, 276],
+        [360, 137, 212], [380, 137, 237], [400, 24, 299], [420, 80, 255], [440, 80, 155], [460, 80, 330],
+        [480, 41, 191], [500, 41, 91], [520, 222, 272], [540, 222, 272], [560, 0, 75], [580, 0, 125],
+        [600, 45, 320], [620, 45, 45], [640, 58, 258], [660, 0, 100], [680, 34, 309], [700, 34, 209],
+        [720, 47, 122], [740, 70, 295], [760, 47, 47], [780, 36, 186], [800, 36, 86], [820, 36, 261],
+        [840, 62, 187], [860, 62, 362], [880, 62, 262], [900, 62, 162], [920, 140, 315], [940, 76, 151],
+        [960, 116, 291], [980, 169, 244], [1000, 169, 294], [1020, 0, 100], [1040, 29, 179], [1060, 29, 79],
+        [1080, 29, 254], [1100, 68, 193], [1120, 99, 299], [1140, 99, 174], [1160, 99, 299], [1180, 99, 199],
+        [1200, 77, 327], [1220, 77, 77], [1240, 77, 252], [1260, 46, 121], [1280, 59, 309], [1300, 59, 209],
+        [1320, 94, 144], [1340, 142, 367], [1360, 142, 267], [1380, 166, 366], [1400, 166, 241], [1420, 166, 366]
+      ]);
+    });
+  });
+});
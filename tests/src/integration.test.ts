@@ -14,8 +14,8 @@ import { describe, it, expect, beforeAll, afterAll } from 'vitest';
 import { join, dirname } from 'path';
 import { fileURLToPath } from 'url';
 import { readFileSync, existsSync } from 'fs';
-import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
-import type { HtmlLayoutParserModule, CharLayout, LayoutDocument, SimpleOutput, Row } from './wasm-types';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath, getWasmModulePath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout, LayoutDocument, SimpleOutput, Row, PerformanceMetrics } from './wasm-types';
 
 const __dirname = dirname(fileURLToPath(import.meta.url));
 
@@ -128,6 +128,183 @@ describe('Integration Tests', () => {
         expect(char.baseline).toBeLessThanOrEqual(char.y + char.height);
       }
     });
+
+    it('should record box decorations into a display list in paint order', () => {
+      const html = `
+        <div style="background: #ff0000; border: 2px solid #00ff00; width: 100px; height: 40px; overflow: hidden">Box</div>
+        <ul><li>Item</li></ul>
+      `;
+
+      helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      expect(helper.getDisplayList()).toBeNull();
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat', undefined, { displayList: true });
+      expect(result.map(c => c.character).join('')).toContain('Box');
+
+      const bytes = helper.getDisplayList()!;
+      const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+      expect(view.getUint32(0, true)).toBe(0x4c444c48); // 'HLDL'
+      expect(view.getUint32(12, true)).toBe(bytes.byteLength);
+
+      const ops: number[] = [];
+      let offset = view.getUint16(6, true);
+      for (let i = 0; i < view.getUint32(8, true); i++) {
+        ops.push(bytes[offset]);
+        offset += view.getUint32(offset + 4, true);
+      }
+      expect(offset).toBe(bytes.byteLength);
+
+      // Background before borders, balanced clips for overflow: hidden, and the disc bullet
+      expect(ops.slice(0, 2)).toEqual([1, 2]);
+      expect(ops).toContain(8);
+      expect(ops.filter(op => op === 8).length).toBe(ops.filter(op => op === 9).length);
+      expect(ops).toContain(7);
+
+      // Fill color is stored as r, g, b, a after the 8-byte record header and 16-float layer
+      const fillColor = Array.from(bytes.subarray(16 + 8 + 64, 16 + 8 + 68));
+      expect(fillColor).toEqual([255, 0, 0, 255]);
+    });
+
+    it('should re-layout a compiled template with new slot values like a full parse', () => {
+      const css = '.label { width: 160px; padding: 4px } .label p:before { content: "> " }';
+      const fill = (name: string, price: string) =>
+        `<div class="label"><b data-slot="name">${name}</b><p data-slot="price">${price}</p></div>`;
+
+      const handle = helper.compileTemplate(fill('Name', '$0'), 400, css);
+      expect(handle).toBeGreaterThan(0);
+      expect(helper.getTemplateSlots(handle)).toEqual(['name', 'price']);
+
+      try {
+        for (const [name, price] of [['Widget with a name long enough to wrap', '$12.50'], ['Gadget', '$1,000']]) {
+          const fromTemplate = helper.layoutTemplate<CharLayout[]>(handle, [name, price]);
+          const fromParse = helper.parseHTML<CharLayout[]>(fill(name, price), 400, 'flat', css);
+          expect(fromTemplate).toEqual(fromParse);
+        }
+
+        // null keeps the template text
+        const defaults = helper.layoutTemplate<CharLayout[]>(handle, [null, 'X']);
+        expect(defaults.map(c => c.character).join('')).toBe('Name> X');
+
+        // Templates are bound to the font set they were compiled with
+        const extraId = helper.loadFont(loadFontFile(getTestFontPath()), 'TemplateFont');
+        helper.unloadFont(extraId);
+        expect(helper.layoutTemplate<CharLayout[]>(handle, ['A', 'B'])).toEqual([]);
+        expect(helper.getLastParseResult().errors[0].codeNum).toBe(2008);
+      } finally {
+        helper.destroyTemplate(handle);
+      }
+
+      expect(helper.layoutTemplate<CharLayout[]>(handle, ['A'])).toEqual([]);
+      expect(helper.getLastParseResult().errors[0].code).toBe('INVALID_TEMPLATE');
+    });
+
+    it('should lay out several widths from one parse like separate parses', () => {
+      const css = `
+        .col { float: left; width: 50% }
+        .wide-only { display: none }
+        @media (min-width: 600px) { .wide-only { display: block } }
+        @media (max-width: 400px) { .col { float: none; width: auto } }
+      `;
+      const html = '<div class="col">Left column text</div><div class="col">Right</div><p class="wide-only">Extra</p>';
+      const widths = [320, 500, 800, 1200];
+
+      const results = helper.parseHTMLMultiWidth<CharLayout[]>(html, widths, css);
+      expect(results.map(r => r.viewportWidth)).toEqual(widths);
+      for (const { viewportWidth, data } of results) {
+        expect(data).toEqual(helper.parseHTML<CharLayout[]>(html, viewportWidth, 'flat', css));
+      }
+
+      helper.parseHTMLMultiWidth<CharLayout[]>(html, widths, css);
+      const metrics = helper.getMetrics() as PerformanceMetrics | null;
+      expect(metrics?.widthCount).toBe(widths.length);
+      // 320 -> 500 and 500 -> 800 cross a breakpoint, 800 -> 1200 does not
+      expect(metrics?.mediaRestyles).toBe(2);
+    });
+
+    it('should measure document height and lines without glyph output', () => {
+      const css = 'body { margin: 0 } .item { padding: 8px; border-bottom: 1px solid #ccc } h3 { margin: 0 }';
+      const item = (lines: number) => `<div class="item"><h3>Title</h3><p>${'Some wrapping body text. '.repeat(lines)}</p></div>`;
+
+      const measured = helper.measureHTML(item(4), 240, css);
+      expect(measured.width).toBe(240);
+      expect(measured.lineCount).toBeGreaterThan(2);
+      expect(measured.blocks).toHaveLength(1);
+      expect(measured.blocks[0].height).toBe(measured.height);
+
+      // The last glyph of a full parse lies inside the measured height
+      const chars = helper.parseHTML<CharLayout[]>(item(4), 240, 'flat', css);
+      const bottom = Math.max(...chars.map(c => c.y + c.height));
+      expect(bottom).toBeLessThanOrEqual(measured.height);
+
+      const batch = helper.measureHTMLBatch([item(1), '', item(8)], 240, css);
+      expect(batch).toHaveLength(3);
+      expect(batch[1]).toBeNull();
+      expect(batch[2].height).toBeGreaterThan(batch[0].height);
+      expect(batch[2]).toEqual(helper.measureHTML(item(8), 240, css));
+
+      helper.measureHTMLBatch([item(1), item(2)], 240, css);
+      const metrics = helper.getMetrics() as PerformanceMetrics | null;
+      expect(metrics?.itemCount).toBe(2);
+      expect(metrics?.characterCount).toBe(0);
+    });
+
+    it('should pick the largest font size that fits a box', () => {
+      const css = 'body { margin: 4px } h2 { font-size: 1.5em; margin: 0 } p { margin: 0.2em 0 }';
+      const html = '<h2>Sale today</h2><p>Fresh organic apples from the valley, <b>two for one</b></p>';
+
+      const fit = helper.fitToBox<CharLayout[]>(html, 200, 120, 8, 72, css);
+      expect(fit.fits).toBe(true);
+      expect(fit.height).toBeLessThanOrEqual(120);
+      expect(fit.scale).toBeCloseTo(fit.fontSize / 16);
+      expect((helper.getMetrics() as PerformanceMetrics | null)?.fitProbes).toBe(fit.probes);
+
+      // The scale multiplies every font-size, like a larger root font size
+      const rootCss = `${css} html { font-size: ${fit.fontSize}px }`;
+      expect(fit.data).toEqual(helper.parseHTML<CharLayout[]>(html, 200, 'flat', rootCss));
+
+      // One pixel larger overflows
+      const larger = helper.fitToBox<CharLayout[]>(html, 200, 120, fit.fontSize + 1, fit.fontSize + 1, css);
+      expect(larger.fits).toBe(false);
+
+      // A long word limits the width unless only the height is checked
+      const word = '<div>Supercalifragilisticexpialidocious</div>';
+      const narrow = helper.fitToBox<CharLayout[]>(word, 150, 400, 8, 72);
+      expect(narrow.width).toBeLessThanOrEqual(150);
+      expect(helper.fitToBox<CharLayout[]>(word, 150, 400, 8, 72, undefined, { heightOnly: true }).fontSize)
+        .toBeGreaterThan(narrow.fontSize);
+    });
+
+    it('should stop layout at maxLines and line-clamp with an ellipsis', () => {
+      const css = 'body { margin: 0; line-height: 20px } p { margin: 0 0 10px }';
+      const html = `<p>${'Preview text wraps over several lines. '.repeat(6)}</p><p>Second paragraph</p>`;
+      const text = (chars: CharLayout[]) => chars.map(c => c.character).join('');
+      const full = helper.parseHTML<CharLayout[]>(html, 200, 'flat', css);
+      const firstLineY = full[0].y;
+
+      const preview = helper.parseHTML<CharLayout[]>(html, 200, 'flat', css, { maxLines: 1 });
+      expect(preview.every(c => c.y === firstLineY)).toBe(true);
+      expect(text(full).startsWith(text(preview))).toBe(true);
+      expect((helper.getMetrics() as PerformanceMetrics | null)?.truncated).toBe(true);
+
+      const clipped = helper.parseHTML<CharLayout[]>(html, 200, 'flat', css, { maxLines: 2, ellipsis: true });
+      expect(new Set(clipped.map(c => c.y)).size).toBe(2);
+      expect(clipped[clipped.length - 1].character).toBe('\u2026');
+      expect(text(clipped)).not.toContain('Second');
+
+      // A limit that is never reached leaves the layout unchanged
+      expect(helper.parseHTML<CharLayout[]>(html, 200, 'flat', css, { maxLines: 100 })).toEqual(full);
+      expect((helper.getMetrics() as PerformanceMetrics | null)?.truncated).toBe(false);
+
+      // CSS clamps one block; the following blocks are still laid out
+      const clampCss = `${css} p:first-child { -webkit-line-clamp: 2; text-overflow: ellipsis }`;
+      const clamped = text(helper.parseHTML<CharLayout[]>(html, 200, 'flat', clampCss));
+      expect(clamped).toContain('\u2026');
+      expect(clamped.endsWith('Second paragraph')).toBe(true);
+
+      const measured = helper.measureHTML(html, 200, css, { maxHeight: 45 });
+      expect(measured.truncated).toBe(true);
+      expect(measured.lineCount).toBe(2);
+    });
   });
 
   describe('Node.js Environment Integration (Req 5.3, 5.5)', () => {
@@ -190,6 +367,79 @@ describe('Integration Tests', () => {
       
       parser.destroy();
     });
+
+    it('should pass parse arguments through a reused staging buffer', async () => {
+      const { HtmlLayoutParser } = await import('../../packages/html-layout-parser/src/index');
+      const wasmPath = getWasmModulePath();
+
+      const parser = new HtmlLayoutParser();
+      await parser.init(wasmPath);
+      parser.setDefaultFont(parser.loadFont(new Uint8Array(readFileSync(getTestFontPath())), 'TestFont'));
+      const staging = parser as unknown as { stagingPtr: number; stagingSize: number };
+
+      // Short ASCII, multi-byte text with CSS, and a document larger than the initial buffer
+      const cases: Array<[string, string | undefined]> = [
+        ['<div>Staged</div>', undefined],
+        ['<p class="t">中文排版 staged</p>', '.t { color: #336699; font-size: 20px }'],
+        ['<p>' + 'Grow the staging buffer. '.repeat(4000) + '</p>', undefined]
+      ];
+      const sizes: number[] = [];
+      for (const [html, css] of cases) {
+        const result = parser.parse(html, { viewportWidth: 800, css });
+        expect(result).toEqual(helper.parseHTML<CharLayout[]>(html, 800, 'flat', css));
+        sizes.push(staging.stagingSize);
+      }
+      expect(sizes[0]).toBe(64 * 1024);
+      expect(sizes[2]).toBeGreaterThan(100 * 1024);
+
+      // Grow-only: a small parse keeps the same region
+      const ptr = staging.stagingPtr;
+      parser.parse(cases[0][0], { viewportWidth: 800 });
+      expect(staging.stagingPtr).toBe(ptr);
+
+      parser.destroy();
+    });
+
+    it('should lay out a snapshot from another parser like the parsed document', async () => {
+      const { HtmlLayoutParser } = await import('../../packages/html-layout-parser/src/index');
+      const wasmPath = getWasmModulePath();
+      const fontData = new Uint8Array(readFileSync(getTestFontPath()));
+
+      // Two instances stand in for the producing and the consuming process
+      const producer = new HtmlLayoutParser();
+      const consumer = new HtmlLayoutParser();
+      for (const parser of [producer, consumer]) {
+        await parser.init(wasmPath);
+        parser.setDefaultFont(parser.loadFont(fontData, 'TestFont'));
+      }
+
+      const css = '.card { padding: 8px; border: 1px solid #ccc } .card li::before { content: "- " } ' +
+        '@media (max-width: 500px) { .card { color: red } }';
+      const html = '<div class="card"><h2>Snapshot</h2><!-- dropped --><ul><li>One <b>bold</b></li>' +
+        '<li>中文排版</li></ul><img width="20" height="10"></div>';
+      const snapshot = producer.createSnapshot(html, { viewportWidth: 400, css });
+      expect(snapshot).not.toBeNull();
+
+      for (const mode of ['flat', 'full'] as const) {
+        const parsed = producer.parse(html, { viewportWidth: 400, css, mode, displayList: true });
+        const parsedDisplayList = producer.getDisplayListBuffer();
+        expect(consumer.parseSnapshot(snapshot!, { mode, displayList: true })).toEqual(parsed);
+        expect(consumer.getDisplayListBuffer()).toEqual(parsedDisplayList);
+      }
+
+      // Relayout at another width keeps the styles of the snapshot viewport
+      const narrow = consumer.parseSnapshot(snapshot!, { viewportWidth: 200 });
+      expect(narrow.length).toBe(producer.parse(html, { viewportWidth: 400, css }).length);
+      expect(narrow.every(c => c.color === '#FF0000FF')).toBe(true);
+
+      const corrupt = snapshot!.slice();
+      corrupt[corrupt.length - 1] ^= 0xff;
+      expect(consumer.parseSnapshot(corrupt)).toEqual([]);
+      expect(consumer.getLastParseResult().errors?.[0].code).toBe('INVALID_SNAPSHOT');
+
+      producer.destroy();
+      consumer.destroy();
+    });
   });
 
   describe('Real Webpage Parsing', () => {
@@ -6,7 +6,7 @@
 
 import { describe, it, expect, beforeAll, afterAll } from 'vitest';
 import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
-import type { HtmlLayoutParserModule, CharLayout, LayoutDocument, SimpleOutput, Row } from './wasm-types';
+import type { HtmlLayoutParserModule, CharLayout, LayoutDocument, SimpleOutput, Row, PerformanceMetrics } from './wasm-types';
 
 describe('JSON Output Modes', () => {
   let module: HtmlLayoutParserModule;
@@ -314,4 +314,97 @@ describe('JSON Output Modes', () => {
       expect(char.fontId).toBeDefined();
     });
   });
+
+  describe('Field Projection (options.fields)', () => {
+    const html = '<div><b>Bold</b> and <u>underlined</u> text</div>';
+    const fields = ['character', 'x', 'y', 'width', 'fontId'] as const;
+    const modes = ['flat', 'byRow', 'simple', 'full'] as const;
+
+    // Characters of any output mode in document order
+    const charactersOf = (result: any, mode: typeof modes[number]): Partial<CharLayout>[] => {
+      switch (mode) {
+        case 'flat':
+          return result;
+        case 'byRow':
+          return (result as Row[]).flatMap(row => row.children);
+        case 'simple':
+          return (result as SimpleOutput).lines.flatMap(line => line.characters ?? []);
+        case 'full':
+          return (result as LayoutDocument).pages.flatMap(page =>
+            page.blocks.flatMap(block => block.lines.flatMap(line => (line.runs ?? []).flatMap(run => run.characters))));
+      }
+    };
+
+    it('should serialize only the listed fields in every mode', () => {
+      for (const mode of modes) {
+        const full = charactersOf(helper.parseHTML<unknown>(html, 300, mode), mode);
+        const projected = charactersOf(helper.parseHTML<unknown>(html, 300, mode, undefined, { fields }), mode);
+
+        expect(projected.length).toBe(full.length);
+        projected.forEach((char, i) => {
+          expect(Object.keys(char)).toEqual(fields);
+          expect(char).toEqual(Object.fromEntries(fields.map(field => [field, full[i][field]])));
+        });
+      }
+    });
+
+    it('should keep serialization order regardless of the listed order', () => {
+      const byRow = helper.parseHTML<Row[]>(html, 300, 'byRow', undefined, { fields: ['y', 'character'] });
+      expect(Object.keys(byRow[0].children[0])).toEqual(['character', 'y']);
+    });
+
+    it('should ignore unknown field names with a warning', () => {
+      const full = helper.parseHTML<CharLayout[]>(html, 300, 'flat');
+      expect(helper.parseHTML<CharLayout[]>(html, 300, 'flat', undefined, { fields: ['glyph'] })).toEqual(full);
+      expect(helper.getLastParseResult().warnings?.length).toBeGreaterThan(0);
+    });
+  });
+
+  describe('Compact Dialect (options.compact)', () => {
+    it('should expand the compact dialect back to the regular output in every mode', async () => {
+      const { expandCompactLayout } = await import('../../packages/html-layout-parser/src/index');
+      const html = '<div><b>Bold</b> <u style="text-decoration-color: red">underlined</u> ' +
+        '<i>italic</i> <span style="color: #336699; background: #eee">colored</span> text</div>';
+
+      for (const mode of ['flat', 'byRow', 'simple', 'full'] as const) {
+        const regular = helper.parseHTML<unknown>(html, 300, mode);
+        const compact = helper.parseHTML<any>(html, 300, mode, undefined, { compact: true });
+        expect(expandCompactLayout(compact)).toEqual(regular);
+
+        const fields = ['character', 'x', 'color'] as const;
+        const projected = helper.parseHTML<unknown>(html, 300, mode, undefined, { fields });
+        const compactProjected = helper.parseHTML<any>(html, 300, mode, undefined, { fields, compact: true });
+        expect(expandCompactLayout(compactProjected, fields)).toEqual(projected);
+      }
+
+      // Styles are shared; default values and the first style index are omitted
+      const compact = helper.parseHTML<any>(html, 300, 'flat', undefined, { compact: true });
+      expect(compact.styles.length).toBeLessThan(6);
+      expect(compact.data[0]).toEqual(expect.objectContaining({ c: 'B' }));
+      expect(compact.styles[compact.data[0].s ?? 0].fw).toBe(700);
+      expect(compact.styles[compact.data[0].s ?? 0]).not.toHaveProperty('op');
+    });
+  });
+
+  describe('Chunked Output (parseHTMLStream)', () => {
+    it('should stream the same output in chunks', () => {
+      const html = '<div>' + '<p>Streamed <b>output</b> 中文字符 text.</p>'.repeat(40) + '</div>';
+
+      for (const mode of ['flat', 'full'] as const) {
+        const regular = helper.parseHTML<unknown>(html, 300, mode);
+        const chunks = helper.parseHTMLStream(html, 300, mode, 256);
+        expect(chunks).not.toBeNull();
+        expect(chunks!.length).toBeGreaterThan(1);
+        expect(chunks!.every(chunk => new TextEncoder().encode(chunk).length <= 256)).toBe(true);
+        expect(JSON.parse(chunks!.join(''))).toEqual(regular);
+
+        const metrics = helper.getMetrics() as PerformanceMetrics | null;
+        expect(metrics?.chunkCount).toBe(chunks!.length);
+        expect(metrics?.outputSize).toBe(new TextEncoder().encode(chunks!.join('')).length);
+      }
+
+      // Nothing is delivered for invalid input
+      expect(helper.parseHTMLStream('', 300)).toBeNull();
+    });
+  });
 });
@@ -0,0 +1,100 @@
+/**
+ * List and Counter Tests
+ *
+ * Tests list item numbering and CSS counters:
+ * - Ordered list markers and their numbering styles
+ * - Renumbering when the render tree is rebuilt
+ * - Nested counters, counter-reset and counter-increment
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout } from './wasm-types';
+
+describe('Lists and Counters', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('List Markers and Counters', () => {
+    it('should number ordered list markers', () => {
+      const html = `
+        <ol start="4" style="list-style-type: upper-roman"><li>a</li><li>b</li><li>c</li></ol>
+        <ol><li>x</li><li>y</li></ol>
+      `;
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const lineText = (y: number) => result
+        .filter(c => Math.abs(c.y - y) < 2)
+        .map(c => c.character)
+        .join('');
+      const find = (ch: string) => result.find(c => c.character === ch)!;
+
+      expect(lineText(find('a').y)).toBe('IV.a');
+      expect(lineText(find('b').y)).toBe('V.b');
+      expect(lineText(find('c').y)).toBe('VI.c');
+      expect(lineText(find('x').y)).toBe('1.x');
+      expect(lineText(find('y').y)).toBe('2.y');
+    });
+
+    it('should renumber list items when a breakpoint hides one', () => {
+      const css = '@media (max-width: 400px) { .a { display: none } }';
+      const html = '<ol><li class="a">x</li><li>y</li><li>z</li></ol>';
+
+      const results = helper.parseHTMLMultiWidth<CharLayout[]>(html, [800, 320], css);
+      const text = results.map(r => r.data.map(c => c.character).join(''));
+      expect(text).toEqual(['1.2.3.xyz', '1.2.yz']);
+      expect(results[1].data).toEqual(helper.parseHTML<CharLayout[]>(html, 320, 'flat', css));
+    });
+
+    it('should evaluate nested CSS counters in document order', () => {
+      const css = `
+        ol { counter-reset: item; list-style: none }
+        li { counter-increment: item }
+        li::before { content: counters(item, ".") " " }
+        h1 { counter-increment: chapter }
+        h1::before { content: counter(chapter) ". " }
+        h2 { counter-reset: step 5; counter-increment: step 2 }
+        h2::before { content: counter(step) ". " }
+      `;
+      const html = `
+        <ol><li>a<ol><li>b</li><li>c<ol><li>d</li></ol></li></ol></li><li>e</li></ol>
+        <h1>x</h1><h1>y</h1><h2>z</h2><h2>w</h2>
+      `;
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat', css);
+      const lineText = (ch: string) => {
+        const y = result.find(c => c.character === ch)!.y;
+        return result.filter(c => c.y === y).map(c => c.character).join('');
+      };
+
+      expect(lineText('a')).toBe('1 a');
+      expect(lineText('b')).toBe('1.1 b');
+      expect(lineText('c')).toBe('1.2 c');
+      expect(lineText('d')).toBe('1.2.1 d');
+      expect(lineText('e')).toBe('2 e');
+      expect(lineText('x')).toBe('1. x');
+      expect(lineText('y')).toBe('2. y');
+      // counter-reset applies before counter-increment of the same counter on one element
+      expect(lineText('z')).toBe('7. z');
+      expect(lineText('w')).toBe('7. w');
+    });
+  });
+});
@@ -13,7 +13,7 @@
 
 import { describe, it, expect, beforeAll, afterAll, beforeEach, afterEach } from 'vitest';
 import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
-import type { HtmlLayoutParserModule, CharLayout, FontInfo } from './wasm-types';
+import type { HtmlLayoutParserModule, CharLayout, FontInfo, PerformanceMetrics } from './wasm-types';
 
 describe('Multi-Font Management Tests', () => {
   let module: HtmlLayoutParserModule;
@@ -425,6 +425,36 @@ describe('Multi-Font Management Tests', () => {
     });
   });
 
+  describe('Result Cache Invalidation', () => {
+    it('should drop cached layouts when a font is loaded or unloaded', () => {
+      const fontData = loadFontFile(getTestFontPath());
+      helper.setDefaultFont(helper.loadFont(fontData, 'TestFont'));
+      helper.clearCache();
+      helper.setResultCacheBudget(8 * 1024 * 1024);
+      const html = '<div>Cached layout</div>';
+      const cacheHit = () => (helper.getMetrics() as PerformanceMetrics).cacheHit;
+
+      try {
+        const before = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        expect(cacheHit()).toBe(true);
+
+        const extraId = helper.loadFont(fontData, 'ExtraFont');
+        helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        expect(cacheHit()).toBe(false);
+        helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        expect(cacheHit()).toBe(true);
+
+        helper.unloadFont(extraId);
+        expect(helper.parseHTML<CharLayout[]>(html, 800, 'flat')).toEqual(before);
+        expect(cacheHit()).toBe(false);
+        expect(helper.getCacheStats()!.resultCache.entries).toBe(1);
+      } finally {
+        helper.setResultCacheBudget(0);
+      }
+    });
+  });
+
   describe('Error Handling', () => {
     it('should handle invalid font data gracefully', () => {
       const invalidData = new Uint8Array([0, 1, 2, 3, 4, 5]);
@@ -0,0 +1,244 @@
+/**
+ * Native Node Addon Tests
+ *
+ * Tests the N-API addon built from the parser core with ./build-node.sh:
+ * - Layout parity with the WASM build
+ * - Serialization of large outputs on worker threads
+ * - Layout of independent block formatting contexts in parallel
+ * - Pipelined batch parses
+ * - Complexity limits of parses, templates and snapshots
+ * - maxLines in templates and fitToBox
+ *
+ * Skipped when the addon has not been built.
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { join, dirname } from 'path';
+import { fileURLToPath } from 'url';
+import { existsSync } from 'fs';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout, PerformanceMetrics } from './wasm-types';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+
+// Built separately with ./build-node.sh; skipped when the addon is absent
+const addonPath = join(__dirname, '../../native-output/html_layout_parser.node');
+
+describe.skipIf(!existsSync(addonPath))('Native Node Addon', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('Layout Parity', () => {
+    it('should match the WASM layout for string and Buffer input', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+
+      const fontData = loadFontFile(getTestFontPath());
+      const id = addon.loadFont(fontData, 'TestFont');
+      expect(id).toBeGreaterThan(0);
+      addon.setDefaultFont(id);
+
+      const html = '<div style="font-size: 16px;">Native addon parity</div>';
+      const wasmResult = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const fromString = JSON.parse(addon.parseHTML(html, '', 800, 'flat', ''));
+      const fromBuffer = JSON.parse(addon.parseHTML(Buffer.from(html), '', 800, 'flat', ''));
+
+      expect(fromString).toEqual(wasmResult);
+      expect(fromBuffer).toEqual(fromString);
+
+      const fromAsync = JSON.parse(await addon.parseHTMLAsync(html, '', 800, 'flat', ''));
+      expect(fromAsync).toEqual(fromString);
+
+      const streamed: string[] = [];
+      expect(addon.parseHTMLStream(html, '', 800, 'flat', '', 64, (chunk: string) => { streamed.push(chunk); })).toBe(true);
+      expect(JSON.parse(streamed.join(''))).toEqual(fromString);
+
+      addon.destroy();
+    });
+  });
+
+  describe('Threaded Serialization', () => {
+    it('should serialize large flat outputs identically on any number of threads', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+
+      // Small lines keep about 34k glyphs inside the viewport: enough for eight ranges
+      const html = '<div style="font-size: 8px; line-height: 10px">' +
+        '<p style="margin: 0">Threaded <b>serializer</b> paragraph with 中文 text.</p>'.repeat(800) + '</div>';
+      const single = addon.parseHTML(html, '', 800, 'flat', '{"serializeThreads":1}');
+      expect(JSON.parse(single).length).toBeGreaterThan(8 * 4096);
+      for (const threads of [0, 2, 4, 8]) {
+        expect(addon.parseHTML(html, '', 800, 'flat', `{"serializeThreads":${threads}}`)).toBe(single);
+      }
+      const fields = '"fields":["character","x","y"]';
+      expect(addon.parseHTML(html, '', 800, 'flat', `{"serializeThreads":4,${fields}}`))
+        .toBe(addon.parseHTML(html, '', 800, 'flat', `{"serializeThreads":1,${fields}}`));
+
+      addon.destroy();
+    });
+  });
+
+  describe('Parallel Layout', () => {
+    it('should lay out independent sections identically on any number of threads', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+
+      // The float narrows the first section, which is then laid out serially
+      const css = 'section { overflow: hidden; margin: 6px 0; padding: 2px } .flex { display: flex } ' +
+        '.rel { position: relative; top: 3px } .float { float: left; width: 100px; height: 30px }';
+      const sections = Array.from({ length: 40 }, (_, i) => i % 5 === 4
+        ? `<section class="flex"><div>Flex ${i}</div><div>Second item</div></section>`
+        : `<section${i % 7 === 3 ? ' class="rel"' : ''}><h2>Section ${i}</h2>` +
+          '<p>Paragraph with <b>bold</b> and 中文 words that wrap across lines.</p>'.repeat(3) +
+          '<section><p>Nested section</p></section></section>');
+      const html = '<div class="float">float</div>' + sections.join('');
+      for (const mode of ['flat', 'full']) {
+        const serial = addon.parseHTML(html, css, 800, mode, '{"layoutThreads":1}');
+        for (const threads of [0, 2, 4, 8]) {
+          expect(addon.parseHTML(html, css, 800, mode, `{"layoutThreads":${threads}}`)).toBe(serial);
+        }
+      }
+
+      addon.destroy();
+    });
+  });
+
+  describe('Batch Pipeline', () => {
+    it('should pipeline batch parses with per-item results', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+
+      const css = 'p { margin: 2px 0 } .note { color: #c00 }';
+      const items = Array.from({ length: 12 }, (_, i) =>
+        `<h3>Card ${i}</h3>` + `<p>Card body with <span class="note">中文</span> text.</p>`.repeat(i + 1));
+      items.splice(4, 0, '');
+      for (const mode of ['flat', 'byRow']) {
+        const expected = items.map(html => html ? JSON.parse(addon.parseHTML(html, css, 320, mode, '')) : null);
+        for (const queue of [0, 1, 4]) {
+          const batch = JSON.parse(addon.parseHTMLBatch(items, css, 320, mode, `{"pipelineQueue":${queue}}`));
+          expect(batch).toEqual(expected);
+        }
+      }
+
+      JSON.parse(addon.parseHTMLBatch(items, css, 320, 'flat', ''));
+      const metrics = JSON.parse(addon.getMetrics()) as PerformanceMetrics;
+      expect(metrics.itemCount).toBe(items.length);
+      expect(metrics.itemsPerSecond).toBeGreaterThan(0);
+      for (const occupancy of Object.values(metrics.stageOccupancy!)) {
+        expect(occupancy).toBeGreaterThanOrEqual(0);
+        expect(occupancy).toBeLessThanOrEqual(1);
+      }
+
+      addon.destroy();
+    });
+  });
+
+  describe('Complexity Limits', () => {
+    it('should reject pathological documents over their complexity limits', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+
+      const cases: Array<[string, string, string, string]> = [
+        ['<div>'.repeat(100000) + 'deep', '', '{"maxDepth":512}', 'DOM_TOO_DEEP'],
+        ['<span>x</span>'.repeat(5000), '', '{"maxElements":1000}', 'TOO_MANY_ELEMENTS'],
+        ['<p>rules</p>', Array.from({ length: 600 }, (_, i) => `.c${i} { color: red }`).join(' '),
+          '{"maxCssRules":500}', 'TOO_MANY_CSS_RULES'],
+        ['<table>' + '<tr><td colspan="1000">x</td></tr>'.repeat(200) + '</table>', '',
+          '{"maxTableCells":100000}', 'TOO_MANY_TABLE_CELLS'],
+        ['<p>' + 'x'.repeat(200000) + '</p>', '', '{"maxGlyphs":10000}', 'TOO_MANY_GLYPHS'],
+      ];
+      for (const [html, css, options, code] of cases) {
+        const start = Date.now();
+        expect(JSON.parse(addon.parseHTML(html, css, 800, 'flat', options))).toEqual([]);
+        expect(Date.now() - start).toBeLessThan(2000);
+        expect(JSON.parse(addon.getLastParseResult()).errors[0].code).toBe(code);
+      }
+
+      // Limits the document stays within leave the output unchanged
+      const html = '<table><tr><td>A</td><td colspan="2">B</td></tr></table><p>Within <b>limits</b></p>';
+      const limits = '{"maxDepth":64,"maxElements":100,"maxCssRules":10,"maxTableCells":10,"maxGlyphs":100}';
+      expect(addon.parseHTML(html, 'b { color: red }', 800, 'flat', limits))
+        .toBe(addon.parseHTML(html, 'b { color: red }', 800, 'flat', ''));
+
+      addon.destroy();
+    });
+
+    it('should apply complexity limits to templates and snapshots', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+      const lastCode = () => JSON.parse(addon.getLastParseResult()).errors[0].code;
+
+      const deep = '<div>'.repeat(3000) + 'deep';
+      expect(addon.compileTemplate(deep, null, 800, '{"maxDepth":512}')).toBe(0);
+      expect(lastCode()).toBe('DOM_TOO_DEEP');
+      expect(addon.createSnapshot(deep, null, 800, '{"maxDepth":512}')).toBeNull();
+      expect(lastCode()).toBe('DOM_TOO_DEEP');
+
+      const huge = '<p>' + 'x'.repeat(10 * 1024 * 1024) + '</p>';
+      expect(addon.compileTemplate(huge, null, 800, null)).toBe(0);
+      expect(lastCode()).toBe('HTML_TOO_LARGE');
+      expect(addon.createSnapshot(huge, null, 800, null)).toBeNull();
+      expect(lastCode()).toBe('HTML_TOO_LARGE');
+
+      const handle = addon.compileTemplate('<p data-slot="text">Template text</p>', null, 800, '{"maxDepth":64}');
+      expect(handle).toBeGreaterThan(0);
+      expect(JSON.parse(addon.layoutTemplate(handle, '[null]', 'flat', '{"maxGlyphs":5}'))).toEqual([]);
+      expect(lastCode()).toBe('TOO_MANY_GLYPHS');
+      expect(JSON.parse(addon.layoutTemplate(handle, '[null]', 'flat', '{"maxGlyphs":100}')).length).toBe(13);
+      addon.destroyTemplate(handle);
+
+      addon.destroy();
+    });
+  });
+
+  describe('Layout Limits', () => {
+    it('should honor maxLines in templates and fitToBox', async () => {
+      const { createRequire } = await import('module');
+      const addon = createRequire(import.meta.url)(addonPath);
+      addon.setDefaultFont(addon.loadFont(loadFontFile(getTestFontPath()), 'TestFont'));
+      const html = '<p>' + 'Some wrapping words. '.repeat(50) + '</p>';
+
+      const handle = addon.compileTemplate(html, null, 300, null);
+      expect(JSON.parse(addon.layoutTemplate(handle, '[]', 'byRow', '{"maxLines":1}')).length).toBe(1);
+      expect(JSON.parse(addon.getMetrics()).truncated).toBe(true);
+      // The limit applies to one layout only
+      expect(JSON.parse(addon.layoutTemplate(handle, '[]', 'byRow', null)).length).toBeGreaterThan(1);
+      expect(JSON.parse(addon.getMetrics()).truncated).toBe(false);
+      addon.destroyTemplate(handle);
+
+      // Text cut by maxLines does not fit, so the smallest size is used and clamped
+      const clamped = JSON.parse(addon.fitToBox(html, null, 300, 2000, 8, 40, 'byRow', '{"maxLines":3}'));
+      expect(clamped.fits).toBe(false);
+      expect(clamped.fontSize).toBe(8);
+      expect(clamped.data.length).toBe(3);
+      const fitted = JSON.parse(addon.fitToBox('<p>short words here</p>', null, 300, 2000, 8, 40, 'byRow', '{"maxLines":1}'));
+      expect(fitted.fits).toBe(true);
+      expect(fitted.data.length).toBe(1);
+
+      addon.destroy();
+    });
+  });
+});
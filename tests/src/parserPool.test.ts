@@ -0,0 +1,118 @@
+/**
+ * Parser Pool Tests
+ *
+ * Tests HtmlLayoutParserPool with in-thread MessageChannel workers:
+ * - Spreading parses and font broadcasts over the workers
+ * - Dropping a crashed worker from the rotation
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { readFileSync } from 'fs';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath, getWasmModulePath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout } from './wasm-types';
+
+describe('Parser Pool', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('Worker Pool', () => {
+    it('should spread parses over a parser pool', async () => {
+      const { HtmlLayoutParser, HtmlLayoutParserPool, serveParserPool } =
+        await import('../../packages/html-layout-parser/src/index');
+      const { MessageChannel } = await import('worker_threads');
+      const wasmPath = getWasmModulePath();
+
+      // In-thread workers: each channel serves its own parser instance
+      const pool = new HtmlLayoutParserPool({
+        size: 2,
+        wasmPath,
+        createWorker: () => {
+          const { port1, port2 } = new MessageChannel();
+          serveParserPool(new HtmlLayoutParser(), port2);
+          return Object.assign(port1, { terminate: () => port1.close() });
+        }
+      });
+      await pool.init();
+      expect(pool.size).toBe(2);
+
+      const fontId = await pool.loadFont(new Uint8Array(readFileSync(getTestFontPath())), 'TestFont');
+      expect(fontId).toBeGreaterThan(0);
+      await pool.setDefaultFont(fontId);
+
+      const html = '<div style="background: #eee">Pooled parse</div>';
+      const expected = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const results = await Promise.all([0, 1, 2, 3].map(() => pool.parse(html, { viewportWidth: 800 })));
+      for (const result of results) {
+        expect(result).toEqual(expected);
+      }
+
+      const { output, displayList } = await pool.parseToBuffer(html, { viewportWidth: 800, displayList: true });
+      expect(JSON.parse(new TextDecoder().decode(output!))).toEqual(expected);
+      expect(displayList?.byteLength).toBeGreaterThan(0);
+
+      // init, loadFont, setDefaultFont plus two queued parses each
+      const metrics = pool.getWorkerMetrics();
+      expect(metrics.every(m => m.pending === 0 && m.completed >= 5)).toBe(true);
+      expect(metrics.every(m => m.utilization >= 0 && m.utilization <= 1)).toBe(true);
+
+      await pool.destroy();
+    });
+
+    it('should take a crashed worker out of the parser pool', async () => {
+      const { HtmlLayoutParser, HtmlLayoutParserPool, serveParserPool } =
+        await import('../../packages/html-layout-parser/src/index');
+      const { MessageChannel } = await import('worker_threads');
+      const wasmPath = getWasmModulePath();
+
+      const ports: import('worker_threads').MessagePort[] = [];
+      const pool = new HtmlLayoutParserPool({
+        size: 2,
+        wasmPath,
+        createWorker: () => {
+          const { port1, port2 } = new MessageChannel();
+          serveParserPool(new HtmlLayoutParser(), port2);
+          ports.push(port1);
+          return Object.assign(port1, { terminate: () => port1.close() });
+        }
+      });
+      await pool.init();
+      await pool.setDefaultFont(await pool.loadFont(new Uint8Array(readFileSync(getTestFontPath())), 'TestFont'));
+
+      // Worker 0 takes the first parse and crashes before answering
+      const html = '<div>Survivor</div>';
+      const lost = pool.parse(html, { viewportWidth: 800 });
+      ports[0].emit('error', new Error('out of memory'));
+      await expect(lost).rejects.toThrow('Pool worker 0: out of memory');
+      expect(pool.size).toBe(1);
+
+      // Later parses all go to the remaining worker
+      const expected = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const results = await Promise.all([0, 1, 2].map(() => pool.parseToBuffer(html, { viewportWidth: 800 })));
+      for (const { output, worker } of results) {
+        expect(worker).toBe(1);
+        expect(JSON.parse(new TextDecoder().decode(output!))).toEqual(expected);
+      }
+      expect(pool.getWorkerMetrics().map(m => m.index)).toEqual([1]);
+
+      await pool.destroy();
+    });
+  });
+});
@@ -191,4 +191,32 @@ describe('Performance Tests', () => {
       console.log(`    Parse: ${metrics.parseTime.toFixed(2)}ms, Layout: ${metrics.layoutTime.toFixed(2)}ms`);
     });
   });
+
+  describe('Result Cache', () => {
+    it('should serve repeated parses from the result cache', () => {
+      const html = '<div style="color: #336699">Cached layout</div>';
+      helper.clearCache();
+      helper.resetCacheStats();
+      helper.setResultCacheBudget(8 * 1024 * 1024);
+
+      try {
+        const first = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        const second = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+        expect(second).toEqual(first);
+        expect((helper.getMetrics() as PerformanceMetrics).cacheHit).toBe(true);
+
+        // A different viewport is a different key
+        helper.parseHTML<CharLayout[]>(html, 400, 'flat');
+        expect((helper.getMetrics() as PerformanceMetrics).cacheHit).toBe(false);
+
+        const stats = helper.getCacheStats()!.resultCache;
+        expect(stats.hits).toBe(1);
+        expect(stats.misses).toBe(2);
+        expect(stats.entries).toBe(2);
+      } finally {
+        helper.setResultCacheBudget(0);
+      }
+      expect(helper.getCacheStats()!.resultCache.enabled).toBe(false);
+    });
+  });
 });
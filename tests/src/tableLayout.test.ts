@@ -0,0 +1,100 @@
+/**
+ * Table Layout Tests
+ *
+ * Tests table layout on synthetic tables:
+ * - Cell spans in the automatic table layout
+ * - The fixed table layout and <col> widths
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { loadWasmModule, WasmHelper, loadFontFile, getTestFontPath } from './wasm-loader';
+import type { HtmlLayoutParserModule, CharLayout } from './wasm-types';
+
+describe('Table Layout', () => {
+  let module: HtmlLayoutParserModule;
+  let helper: WasmHelper;
+  let fontId: number;
+
+  beforeAll(async () => {
+    module = await loadWasmModule();
+    helper = new WasmHelper(module);
+
+    // Load test font
+    const fontData = loadFontFile(getTestFontPath());
+    fontId = helper.loadFont(fontData, 'TestFont');
+    expect(fontId).toBeGreaterThan(0);
+    helper.setDefaultFont(fontId);
+  });
+
+  afterAll(() => {
+    if (helper) {
+      helper.clearAllFonts();
+    }
+  });
+
+  describe('Automatic Layout', () => {
+    it('should lay out spanning table cells consistently across widths', () => {
+      const html = `
+        <table>
+          <tr><td rowspan="2">A</td><td colspan="2">BC</td></tr>
+          <tr><td>D</td><td>E</td></tr>
+          <tr><td>F</td><td>G</td><td>H</td></tr>
+        </table>
+      `;
+
+      const wide = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const narrow = helper.parseHTML<CharLayout[]>(html, 400, 'flat');
+
+      const find = (chars: CharLayout[], ch: string) => chars.find(c => c.character === ch)!;
+      for (const chars of [wide, narrow]) {
+        expect(chars.map(c => c.character).join('')).toBe('ABCDEFGH');
+        // D sits under B, E under C, and the row below starts left of both
+        expect(find(chars, 'D').x).toBe(find(chars, 'B').x);
+        expect(find(chars, 'E').x).toBeGreaterThan(find(chars, 'D').x);
+        expect(find(chars, 'F').x).toBe(find(chars, 'A').x);
+        expect(find(chars, 'F').y).toBeGreaterThan(find(chars, 'D').y);
+      }
+      // The auto-width table is as wide as its content at both widths
+      expect(find(narrow, 'H').x).toBe(find(wide, 'H').x);
+    });
+  });
+
+  describe('Fixed Layout', () => {
+    it('should take fixed table layout widths from <col> and the first row only', () => {
+      const html = `
+        <table style="table-layout: fixed; width: 400px; border-spacing: 0">
+          <col style="width: 100px">
+          <tr><td style="padding: 0">A</td><td style="width: 50px; padding: 0">B</td><td style="padding: 0">C</td></tr>
+          <tr><td style="width: 300px; padding: 0">D</td><td style="padding: 0">E</td><td style="padding: 0">F</td></tr>
+        </table>
+      `;
+
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat');
+      const find = (ch: string) => result.find(c => c.character === ch)!;
+
+      expect(find('B').x - find('A').x).toBe(100);
+      expect(find('C').x - find('B').x).toBe(50);
+      // the width of the second row cell doesn't affect the columns
+      expect(find('E').x).toBe(find('B').x);
+      expect(find('F').x).toBe(find('C').x);
+    });
+
+    it('should ignore <col span> beyond the columns of the table', () => {
+      const html = `
+        <table style="table-layout: fixed; width: 400px; border-spacing: 0">
+          <col span="2000000000" style="width: 100px">
+          <tr><td style="padding: 0">A</td><td style="padding: 0">B</td></tr>
+        </table>
+      `;
+
+      const start = performance.now();
+      const result = helper.parseHTML<CharLayout[]>(html, 800, 'flat', undefined, { maxTableCells: 1000 });
+      const find = (ch: string) => result.find(c => c.character === ch)!;
+
+      expect(performance.now() - start).toBeLessThan(1000);
+      expect(result.map(c => c.character).join('')).toBe('AB');
+      // both columns get the same <col> width
+      expect(find('B').x - find('A').x).toBe(200);
+    });
+  });
+});
@@ -10,10 +10,10 @@ import type { HtmlLayoutParserModule, CreateHtmlLayoutParserModule, CharLayout,
 const __dirname = dirname(fileURLToPath(import.meta.url));
 
 /**
- * Load the compiled WASM module
- * @returns Promise resolving to the WASM module instance
+ * Get the path to the compiled WASM module's JS glue
+ * Checks the build output directories in order, for tests that pass the path to `init()`
  */
-export async function loadWasmModule(): Promise<HtmlLayoutParserModule> {
+export function getWasmModulePath(): string {
   const wasmCandidates = [
     join(__dirname, '../../wasm-output/html_layout_parser.js'),
     join(__dirname, '../../build/html_layout_parser.js')
@@ -28,6 +28,16 @@ export async function loadWasmModule(): Promise<HtmlLayoutParserModule> {
     );
   }
 
+  return wasmJsPath;
+}
+
+/**
+ * Load the compiled WASM module
+ * @returns Promise resolving to the WASM module instance
+ */
+export async function loadWasmModule(): Promise<HtmlLayoutParserModule> {
+  const wasmJsPath = getWasmModulePath();
+
   // Dynamic import of the compiled WASM module
   const wasmModule = await import(wasmJsPath);
   const createModule: CreateHtmlLayoutParserModule = wasmModule.default || wasmModule.createModule;
@@ -148,18 +158,21 @@ export class WasmHelper {
    * @param viewportWidth Viewport width in pixels
    * @param mode Output mode: "full", "simple", "flat", or "byRow"
    * @param css Optional external CSS string
+   * @param options Optional native options, passed as optionsJson
    * @returns Parsed result based on mode
    */
   parseHTML<T = CharLayout[]>(
     html: string,
     viewportWidth: number,
     mode: 'full' | 'simple' | 'flat' | 'byRow' = 'flat',
-    css?: string
+    css?: string,
+    options?: Record<string, unknown>
   ): T {
     // Track all allocated pointers for cleanup
     let htmlPtr = 0;
     let modePtr = 0;
     let cssPtr = 0;
+    let optionsPtr = 0;
 
     try {
       // Allocate HTML string
@@ -188,8 +201,19 @@ export class WasmHelper {
         this.module.stringToUTF8(css, cssPtr, cssBytes);
       }
 
+      // Allocate options JSON if provided
+      if (options) {
+        const optionsJson = JSON.stringify(options);
+        const optionsBytes = this.module.lengthBytesUTF8(optionsJson) + 1;
+        optionsPtr = this.module._malloc(optionsBytes);
+        if (optionsPtr === 0) {
+          throw new Error('Failed to allocate memory for options string');
+        }
+        this.module.stringToUTF8(optionsJson, optionsPtr, optionsBytes);
+      }
+
       // Call WASM function
-      const resultPtr = this.module._parseHTML(htmlPtr, cssPtr, viewportWidth, modePtr, 0);
+      const resultPtr = this.module._parseHTML(htmlPtr, cssPtr, viewportWidth, modePtr, optionsPtr);
       
       if (resultPtr === 0) {
         return [] as unknown as T;
@@ -218,9 +242,244 @@ export class WasmHelper {
       if (cssPtr !== 0) {
         this.module._free(cssPtr);
       }
+      if (optionsPtr !== 0) {
+        this.module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Parse once and lay out at several viewport widths
+   * @returns One { viewportWidth, data } entry per width
+   */
+  parseHTMLMultiWidth<T = CharLayout[]>(
+    html: string,
+    widths: number[],
+    css?: string,
+    mode: 'full' | 'simple' | 'flat' | 'byRow' = 'flat'
+  ): Array<{ viewportWidth: number; data: T }> {
+    const htmlPtr = this.allocString(html);
+    const cssPtr = css ? this.allocString(css) : 0;
+    const modePtr = this.allocString(mode);
+    const widthsPtr = this.module._malloc(widths.length * 4);
+    try {
+      new Int32Array(this.module.HEAPU8.buffer, widthsPtr, widths.length).set(widths);
+      const resultPtr = this.module._parseHTMLMultiWidth(htmlPtr, cssPtr, widthsPtr, widths.length, modePtr, 0);
+      if (resultPtr === 0) {
+        return [];
+      }
+      const result = this.module.UTF8ToString(resultPtr);
+      this.module._freeString(resultPtr);
+      return JSON.parse(result);
+    } finally {
+      this.module._free(htmlPtr);
+      this.module._free(modePtr);
+      this.module._free(widthsPtr);
+      if (cssPtr !== 0) {
+        this.module._free(cssPtr);
+      }
     }
   }
 
+  /**
+   * Parse HTML with streamed output
+   * @returns The decoded chunks, or null when the stream failed
+   */
+  parseHTMLStream(
+    html: string,
+    viewportWidth: number,
+    mode: 'full' | 'simple' | 'flat' | 'byRow' = 'flat',
+    chunkSize = 0,
+    options?: Record<string, unknown>
+  ): string[] | null {
+    const chunks: string[] = [];
+    const decoder = new TextDecoder();
+    this.module.onParseChunk = (ptr, size) => {
+      chunks.push(decoder.decode(this.module.HEAPU8.subarray(ptr, ptr + size)));
+    };
+    const htmlPtr = this.allocString(html);
+    const modePtr = this.allocString(mode);
+    const optionsPtr = options ? this.allocString(JSON.stringify(options)) : 0;
+    try {
+      const delivered = this.module._parseHTMLStream(htmlPtr, 0, viewportWidth, modePtr, optionsPtr, chunkSize);
+      return delivered === 1 ? chunks : null;
+    } finally {
+      this.module.onParseChunk = undefined;
+      this.module._free(htmlPtr);
+      this.module._free(modePtr);
+      if (optionsPtr !== 0) {
+        this.module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Measure HTML without glyph output
+   */
+  measureHTML(html: string, viewportWidth: number, css?: string, options?: Record<string, unknown>): any {
+    const htmlPtr = this.allocString(html);
+    const cssPtr = css ? this.allocString(css) : 0;
+    const optionsPtr = options ? this.allocString(JSON.stringify(options)) : 0;
+    try {
+      const resultPtr = this.module._measureHTML(htmlPtr, cssPtr, viewportWidth, optionsPtr);
+      const result = this.module.UTF8ToString(resultPtr);
+      this.module._freeString(resultPtr);
+      return JSON.parse(result);
+    } finally {
+      this.module._free(htmlPtr);
+      if (cssPtr !== 0) {
+        this.module._free(cssPtr);
+      }
+      if (optionsPtr !== 0) {
+        this.module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Measure a batch of HTML documents at one width
+   */
+  measureHTMLBatch(items: string[], viewportWidth: number, css?: string): any[] {
+    const itemPtrs = items.map(item => this.allocString(item));
+    const ptrsPtr = this.module._malloc(Math.max(items.length, 1) * 4);
+    const cssPtr = css ? this.allocString(css) : 0;
+    try {
+      new Int32Array(this.module.HEAPU8.buffer, ptrsPtr, items.length).set(itemPtrs);
+      const resultPtr = this.module._measureHTMLBatch(ptrsPtr, items.length, cssPtr, viewportWidth, 0);
+      const result = this.module.UTF8ToString(resultPtr);
+      this.module._freeString(resultPtr);
+      return JSON.parse(result);
+    } finally {
+      itemPtrs.forEach(ptr => this.module._free(ptr));
+      this.module._free(ptrsPtr);
+      if (cssPtr !== 0) {
+        this.module._free(cssPtr);
+      }
+    }
+  }
+
+  /**
+   * Find the largest base font size at which HTML fits in a box
+   * @returns Fit result ({} on failure)
+   */
+  fitToBox<T = CharLayout[]>(
+    html: string,
+    width: number,
+    height: number,
+    minSize: number,
+    maxSize: number,
+    css?: string,
+    options?: { heightOnly?: boolean }
+  ): { fontSize: number; scale: number; fits: boolean; probes: number; width: number; height: number; data: T } {
+    const htmlPtr = this.allocString(html);
+    const cssPtr = css ? this.allocString(css) : 0;
+    const modePtr = this.allocString('flat');
+    const optionsPtr = options ? this.allocString(JSON.stringify(options)) : 0;
+    try {
+      const resultPtr = this.module._fitToBox(htmlPtr, cssPtr, width, height, minSize, maxSize, modePtr, optionsPtr);
+      const result = this.module.UTF8ToString(resultPtr);
+      this.module._freeString(resultPtr);
+      return JSON.parse(result);
+    } finally {
+      this.module._free(htmlPtr);
+      this.module._free(modePtr);
+      if (cssPtr !== 0) {
+        this.module._free(cssPtr);
+      }
+      if (optionsPtr !== 0) {
+        this.module._free(optionsPtr);
+      }
+    }
+  }
+
+  /**
+   * Compile a template with data-slot text slots
+   * @returns Template handle, 0 on failure
+   */
+  compileTemplate(html: string, viewportWidth: number, css?: string): number {
+    const htmlPtr = this.allocString(html);
+    const cssPtr = css ? this.allocString(css) : 0;
+    try {
+      return this.module._compileTemplate(htmlPtr, cssPtr, viewportWidth, 0);
+    } finally {
+      this.module._free(htmlPtr);
+      if (cssPtr !== 0) {
+        this.module._free(cssPtr);
+      }
+    }
+  }
+
+  /**
+   * Lay out a compiled template with slot values in document order
+   */
+  layoutTemplate<T = CharLayout[]>(
+    handle: number,
+    values: Array<string | null>,
+    mode: 'full' | 'simple' | 'flat' | 'byRow' = 'flat'
+  ): T {
+    const valuesPtr = this.allocString(JSON.stringify(values));
+    const modePtr = this.allocString(mode);
+    try {
+      const resultPtr = this.module._layoutTemplate(handle, valuesPtr, modePtr, 0);
+      const result = this.module.UTF8ToString(resultPtr);
+      this.module._freeString(resultPtr);
+      return JSON.parse(result) as T;
+    } finally {
+      this.module._free(valuesPtr);
+      this.module._free(modePtr);
+    }
+  }
+
+  /**
+   * Get template slot names in document order
+   */
+  getTemplateSlots(handle: number): string[] {
+    const resultPtr = this.module._getTemplateSlots(handle);
+    const result = this.module.UTF8ToString(resultPtr);
+    this.module._freeString(resultPtr);
+    return JSON.parse(result);
+  }
+
+  /**
+   * Destroy a compiled template
+   */
+  destroyTemplate(handle: number): void {
+    this.module._destroyTemplate(handle);
+  }
+
+  /**
+   * Get the last parse result with diagnostics
+   */
+  getLastParseResult(): any {
+    const resultPtr = this.module._getLastParseResult();
+    const result = this.module.UTF8ToString(resultPtr);
+    this.module._freeString(resultPtr);
+    return JSON.parse(result);
+  }
+
+  private allocString(value: string): number {
+    const bytes = this.module.lengthBytesUTF8(value) + 1;
+    const ptr = this.module._malloc(bytes);
+    if (ptr === 0) {
+      throw new Error('Failed to allocate memory for string');
+    }
+    this.module.stringToUTF8(value, ptr, bytes);
+    return ptr;
+  }
+
+  /**
+   * Get the binary display list recorded by the last parse
+   * @returns Copy of the display list bytes, or null if none was recorded
+   */
+  getDisplayList(): Uint8Array | null {
+    const size = this.module._getDisplayListSize();
+    const ptr = this.module._getDisplayList();
+    if (ptr === 0 || size <= 0) {
+      return null;
+    }
+    return this.module.HEAPU8.slice(ptr, ptr + size);
+  }
+
   /**
    * Get parser version
    * @returns Version string
@@ -326,7 +585,7 @@ export class WasmHelper {
    * Get cache statistics
    * @returns Cache statistics object
    */
-  getCacheStats(): { hits: number; misses: number; entries: number; hitRate: number | null; memoryUsage: number } | null {
+  getCacheStats(): { hits: number; misses: number; entries: number; hitRate: number | null; memoryUsage: number; resultCache?: any } | null {
     if (typeof this.module._getCacheStats !== 'function') {
       return null;
     }
@@ -364,6 +623,13 @@ export class WasmHelper {
     }
   }
 
+  /**
+   * Set the layout result cache byte budget (0 disables the cache)
+   */
+  setResultCacheBudget(maxBytes: number): void {
+    this.module._setResultCacheBudget(maxBytes);
+  }
+
   /**
    * Get detailed metrics including cache statistics
    * @returns Detailed metrics object
@@ -17,6 +17,14 @@ export enum ErrorCode {
   InvalidMode = 1004,
   InvalidOptions = 1005,
   HtmlTooLarge = 1006,
+  InvalidTemplate = 1007,
+  InvalidSlotValues = 1008,
+  InvalidSnapshot = 1009,
+  DomTooDeep = 1010,
+  TooManyElements = 1011,
+  TooManyCssRules = 1012,
+  TooManyTableCells = 1013,
+  TooManyGlyphs = 1014,
   FontNotLoaded = 2001,
   FontLoadFailed = 2002,
   FontDataInvalid = 2003,
@@ -24,6 +32,7 @@ export enum ErrorCode {
   FontIdNotFound = 2005,
   NoDefaultFont = 2006,
   FontMemoryExceeded = 2007,
+  FontSetChanged = 2008,
   ParseFailed = 3001,
   DocumentCreationFailed = 3002,
   RenderFailed = 3003,
@@ -166,6 +175,22 @@ export interface PerformanceMetrics {
   characterCount: number;    // Number of characters processed
   inputSize: number;         // Input HTML size (bytes)
   charsPerSecond: number;    // Processing speed (chars/sec)
+  cacheHit?: boolean;        // Served from the layout result cache
+  widthCount?: number;       // Widths laid out from one parse
+  mediaRestyles?: number;    // Style recalcs from media breakpoints
+  sharedTimeSaved?: number;  // Parse time not repeated across widths (ms)
+  fitProbes?: number;        // Layout-only probes run by fitToBox
+  itemCount?: number;        // Documents processed by measureHTMLBatch / parseHTMLBatch
+  itemsPerSecond?: number;   // Documents per second of the last batch call
+  stageOccupancy?: {         // Busy fraction of each parseHTMLBatch stage
+    parse: number;
+    layout: number;
+    serialize: number;
+  };
+  truncated?: boolean;       // Layout stopped at maxLines / maxHeight
+  outputSize?: number;       // Serialized output size (bytes)
+  chunkCount?: number;       // Chunks delivered by parseHTMLStream
+  peakMemory?: number;       // Peak heap growth during the parse (bytes)
   memory: {
     totalFontMemory: number;
     fontCount: number;
@@ -321,6 +346,17 @@ export interface HtmlLayoutParserModule {
     optionsPtr: number
   ): number;
   
+  // HTML parsing with explicit byte lengths (no strlen over html / css)
+  _parseHTMLSized(
+    htmlPtr: number,
+    htmlLen: number,
+    cssPtr: number,
+    cssLen: number,
+    viewportWidth: number,
+    modePtr: number,
+    optionsPtr: number
+  ): number;
+  
   // HTML parsing with diagnostics API
   _parseHTMLWithDiagnostics(
     htmlPtr: number,
@@ -330,8 +366,31 @@ export interface HtmlLayoutParserModule {
     optionsPtr: number
   ): number;
   
+  // Streamed parse: chunks are passed to onParseChunk(ptr, size)
+  _parseHTMLStream(htmlPtr: number, cssPtr: number, viewportWidth: number, modePtr: number, optionsPtr: number, chunkSize: number): number;
+  onParseChunk?: (ptr: number, size: number) => boolean | void;
+  
   // Get last parse result
   _getLastParseResult(): number;
+  _measureHTML(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _measureHTMLBatch(htmlPtrsPtr: number, itemCount: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _parseHTMLBatch(htmlPtrsPtr: number, itemCount: number, cssPtr: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  _fitToBox(htmlPtr: number, cssPtr: number, boxWidth: number, boxHeight: number, minSize: number, maxSize: number, modePtr: number, optionsPtr: number): number;
+  _parseHTMLMultiWidth(htmlPtr: number, cssPtr: number, widthsPtr: number, widthCount: number, modePtr: number, optionsPtr: number): number;
+  _compileTemplate(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _layoutTemplate(handle: number, valuesPtr: number, modePtr: number, optionsPtr: number): number;
+  _getTemplateSlots(handle: number): number;
+  _destroyTemplate(handle: number): void;
+  
+  // Snapshot API
+  _createSnapshot(htmlPtr: number, cssPtr: number, viewportWidth: number, optionsPtr: number): number;
+  _getSnapshot(): number;
+  _getSnapshotSize(): number;
+  _parseSnapshot(snapshotPtr: number, snapshotSize: number, viewportWidth: number, modePtr: number, optionsPtr: number): number;
+  
+  // Display list API
+  _getDisplayList(): number;
+  _getDisplayListSize(): number;
   
   // Memory management API
   _freeString(ptr: number): void;
@@ -355,6 +414,7 @@ export interface HtmlLayoutParserModule {
   _getCacheStats(): number;
   _resetCacheStats(): void;
   _clearCache(): void;
+  _setResultCacheBudget(maxBytes: number): void;
 }
 
 /**
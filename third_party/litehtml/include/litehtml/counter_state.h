@@ -0,0 +1,62 @@
+#ifndef LH_COUNTER_STATE_H
+#define LH_COUNTER_STATE_H
+
+#include <map>
+#include <vector>
+#include "types.h"
+#include "string_id.h"
+
+namespace litehtml
+{
+	class element;
+	class style;
+
+	/**
+	 * CSS counters evaluated incrementally during the document-order traversal
+	 * done by compute_styles().
+	 *
+	 * Each counter name has a stack of instances. An instance created by an
+	 * element is in scope for the element, its descendants and its following
+	 * siblings, so it is popped when the element's parent is left. counter()
+	 * reads the top of the stack and counters() the instances whose owner is
+	 * still open (self and ancestors); neither walks the element tree.
+	 *
+	 * A restyle that starts below the root only rebuilds the state (by replaying
+	 * the document up to the requesting element) when a counter value is actually
+	 * requested.
+	 */
+	class counter_state
+	{
+		struct instance
+		{
+			int				value;
+			int				depth;		// depth of the owner element
+			const element*	owner;
+			bool			open;		// the owner's subtree is still being traversed
+		};
+
+		std::map<string_id, std::vector<instance>>	m_counters;
+		std::vector<string_id>						m_log;		// counter names in creation order
+		int											m_depth = 0;
+		int											m_nesting = 0;
+		bool										m_synced = false;
+
+	public:
+		void	enter(const element* el, const style& st);
+		void	leave(const element* el);
+
+		string	get_counter_value(const element* el, string_id name);
+		string	get_counters_value(const element* el, string_id name, const string& delims);
+
+	private:
+		void	apply(const element* el, const style& st);
+		void	close_scope(const element* el);
+		void	sync(const element* el);
+		bool	replay(const std::shared_ptr<element>& el, const element* target);
+		void	reset();
+		void	reset_counter(const element* el, string_id name, int value);
+		void	increment_counter(const element* el, string_id name, int value);
+	};
+}
+
+#endif  // LH_COUNTER_STATE_H
@@ -7,6 +7,7 @@
 #include "borders.h"
 #include "css_offsets.h"
 #include "background.h"
+#include "font_description.h"
 
 namespace litehtml
 {
@@ -61,6 +62,7 @@ namespace litehtml
 		background				m_bg;
 		uint_ptr				m_font;
 		css_length				m_font_size;
+		css_length				m_unscaled_font_size;	// font size before the document font scale; inherited by children
 		string					m_font_family;
 		css_length				m_font_weight;
 		font_style				m_font_style;
@@ -91,9 +93,13 @@ namespace litehtml
 		flex_align_content		m_flex_align_content;
 
 		caption_side			m_caption_side;
+		table_layout			m_table_layout;
 
 		int 					m_order;
 
+		int						m_max_lines;		// max-lines / -webkit-line-clamp, 0 = none
+		text_overflow			m_text_overflow;
+
 	private:
 		void compute_font(const html_tag* el, const std::shared_ptr<document>& doc);
 		void compute_background(const html_tag* el, const std::shared_ptr<document>& doc);
@@ -101,6 +107,75 @@ namespace litehtml
 		web_color get_color_property(const html_tag* el, string_id name, bool inherited, web_color default_value, uint_ptr member_offset) const;
 		void snap_border_width(css_length& width, const std::shared_ptr<document>& doc);
 
+		template<class Self, class Visitor>
+		static void visit_fields(Self& self, Visitor& v)
+		{
+			v(self.m_el_position);
+			v(self.m_text_align);
+			v(self.m_overflow);
+			v(self.m_white_space);
+			v(self.m_display);
+			v(self.m_visibility);
+			v(self.m_appearance);
+			v(self.m_box_sizing);
+			v(self.m_z_index);
+			v(self.m_vertical_align);
+			v(self.m_float);
+			v(self.m_clear);
+			v(self.m_css_margins);
+			v(self.m_css_padding);
+			v(self.m_css_borders);
+			v(self.m_css_width);
+			v(self.m_css_height);
+			v(self.m_css_min_width);
+			v(self.m_css_min_height);
+			v(self.m_css_max_width);
+			v(self.m_css_max_height);
+			v(self.m_css_offsets);
+			v(self.m_css_text_indent);
+			v(self.m_css_line_height);
+			v(self.m_line_height.css_value);
+			v(self.m_line_height.computed_value);
+			v(self.m_list_style_type);
+			v(self.m_list_style_position);
+			v(self.m_list_style_image);
+			v(self.m_list_style_image_baseurl);
+			v(self.m_bg);
+			v(self.m_font_size);
+			v(self.m_unscaled_font_size);
+			v(self.m_font_family);
+			v(self.m_font_weight);
+			v(self.m_font_style);
+			v(self.m_text_decoration_line);
+			v(self.m_text_decoration_style);
+			v(self.m_text_decoration_thickness);
+			v(self.m_text_decoration_color);
+			v(self.m_text_emphasis_style);
+			v(self.m_text_emphasis_color);
+			v(self.m_text_emphasis_position);
+			v(self.m_text_transform);
+			v(self.m_color);
+			v(self.m_cursor);
+			v(self.m_content);
+			v(self.m_border_collapse);
+			v(self.m_css_border_spacing_x);
+			v(self.m_css_border_spacing_y);
+			v(self.m_flex_grow);
+			v(self.m_flex_shrink);
+			v(self.m_flex_basis);
+			v(self.m_flex_direction);
+			v(self.m_flex_wrap);
+			v(self.m_flex_justify_content);
+			v(self.m_flex_align_items);
+			v(self.m_flex_align_self);
+			v(self.m_flex_align_content);
+			v(self.m_caption_side);
+			v(self.m_table_layout);
+			v(self.m_order);
+			v(self.m_max_lines);
+			v(self.m_text_overflow);
+		}
+
 	public:
 		css_properties() :
 				m_el_position(element_position_static),
@@ -132,6 +207,7 @@ namespace litehtml
 				m_bg(),
 				m_font(0),
 				m_font_size(0),
+				m_unscaled_font_size(0),
 				m_font_metrics(),
 				m_text_transform(text_transform_none),
 				m_border_collapse(border_collapse_separate),
@@ -145,12 +221,24 @@ namespace litehtml
 				m_flex_align_items(flex_align_items_stretch),
 				m_flex_align_self(flex_align_items_auto),
 				m_flex_align_content(flex_align_content_stretch),
-				m_order(0)
+				m_caption_side(caption_side_top),
+				m_table_layout(table_layout_auto),
+				m_order(0),
+				m_max_lines(0),
+				m_text_overflow(text_overflow_clip)
 		{}
 
 		void compute(const html_tag* el, const std::shared_ptr<document>& doc);
 		std::vector<std::tuple<string, string>> dump_get_attrs();
 
+		// Font requested by the computed style; compute() resolves m_font from it
+		font_description get_font_description() const;
+
+		// Calls v(member) for every computed value except the font handle and the font metrics,
+		// which belong to the document that created them (see set_font)
+		template<class Visitor> void visit_fields(Visitor& v)		{ visit_fields(*this, v); }
+		template<class Visitor> void visit_fields(Visitor& v) const	{ visit_fields(*this, v); }
+
 		element_position get_position() const;
 		void set_position(element_position mElPosition);
 
@@ -271,6 +359,9 @@ namespace litehtml
 		caption_side get_caption_side() const;
 		void set_caption_side(caption_side side);
 
+		table_layout get_table_layout() const;
+		void set_table_layout(table_layout layout);
+
 		float get_flex_grow() const;
 		float get_flex_shrink() const;
 		const css_length& get_flex_basis() const;
@@ -284,6 +375,9 @@ namespace litehtml
 		int get_order() const;
 		void set_order(int order);
 
+		int get_max_lines() const;
+		text_overflow get_text_overflow() const;
+
 		int get_text_decoration_line() const;
 		text_decoration_style get_text_decoration_style() const;
 		const css_length& get_text_decoration_thickness() const;
@@ -703,6 +797,15 @@ namespace litehtml
 		m_caption_side = side;
 	}
 
+	inline table_layout css_properties::get_table_layout() const
+	{
+		return m_table_layout;
+	}
+	inline void css_properties::set_table_layout(table_layout layout)
+	{
+		m_table_layout = layout;
+	}
+
 	inline int css_properties::get_order() const
 	{
 		return m_order;
@@ -713,6 +816,16 @@ namespace litehtml
 		m_order = order;
 	}
 
+	inline int css_properties::get_max_lines() const
+	{
+		return m_max_lines;
+	}
+
+	inline text_overflow css_properties::get_text_overflow() const
+	{
+		return m_text_overflow;
+	}
+
 	inline int css_properties::get_text_decoration_line() const
 	{
 		return m_text_decoration_line;
@@ -6,7 +6,11 @@
 #include "master_css.h"
 #include "encodings.h"
 #include "font_description.h"
+#include "counter_state.h"
 #include <vector>
+#include <tuple>
+#include <unordered_map>
+#include <functional>
 
 typedef struct GumboInternalOutput GumboOutput;
 
@@ -44,6 +48,17 @@ namespace litehtml
 	class html_tag;
 	class render_item;
 
+	// Limits render() to the start of the document, for previews
+	struct layout_limit
+	{
+		int		max_lines	= 0;		// non-empty line boxes to lay out, 0 = no limit
+		pixel_t	max_height	= 0;		// document y where layout stops, 0 = no limit
+		bool	ellipsis	= false;	// end the last line with an ellipsis even without text-overflow: ellipsis
+	};
+
+	// Runs task(0) .. task(count - 1), possibly on several threads, and returns when all of them are done
+	typedef std::function<void(int count, const std::function<void(int)>& task)> parallel_runner;
+
 	class document : public std::enable_shared_from_this<document>
 	{
 	public:
@@ -54,6 +69,8 @@ namespace litehtml
 		std::shared_ptr<render_item>		m_root_render;
 		document_container*					m_container;
 		fonts_map							m_fonts;
+		std::map<std::tuple<list_style_type, int, uint_ptr>, list_marker_text>	m_list_markers;
+		std::unordered_map<const element*, int>	m_list_indexes;	// list item numbers of the current render tree
 		css_text::vector					m_css;
 		litehtml::css						m_styles;
 		litehtml::web_color					m_def_color;
@@ -70,6 +87,20 @@ namespace litehtml
 		string								m_culture;
 		string								m_text;
 		document_mode						m_mode = no_quirks_mode;
+		int									m_styles_generation = 0;
+		float								m_font_scale = 1;
+		counter_state						m_counters;
+		layout_limit						m_layout_limit;
+		int									m_render_pass = 0;
+		int									m_lines_left = 0;
+		bool								m_layout_truncated = false;
+		bool								m_styles_frozen = false;	// set_styled_root(): no cascade to recompute
+		std::weak_ptr<render_item>			m_last_lines_owner;
+		parallel_runner						m_parallel_runner;
+		complexity_limit					m_complexity_limit;
+		complexity_error					m_complexity_error = complexity_ok;
+		int									m_element_count = 0;
+		size_t								m_table_cells = 0;
 	public:
 		document(document_container* objContainer);
 		virtual ~document();
@@ -77,6 +108,10 @@ namespace litehtml
 		document_container*				container()	{ return m_container; }
 		document_mode					mode() const { return m_mode; }
 		uint_ptr						get_font(const font_description& descr, font_metrics* fm);
+		const list_marker_text&			get_list_marker_text(list_style_type type, int index, uint_ptr font);
+		// Number of the list item in its list. Computed for the whole list at once and dropped with the render tree,
+		// because the items shown depend on the computed styles.
+		int								get_list_index(const element* el);
 		pixel_t							render(pixel_t max_width, render_type rt = render_all);
 		void							draw(uint_ptr hdc, pixel_t x, pixel_t y, const position* clip);
 		web_color						get_def_color()	{ return m_def_color; }
@@ -101,11 +136,47 @@ namespace litehtml
 		void							add_media_list(media_query_list_list::ptr list);
 		bool							media_changed();
 		bool							lang_changed();
+		// Multiplies every computed font-size. Returns true if styles were recomputed; call rebuild_render_tree() before render().
+		bool							set_font_scale(float scale);
+		float							font_scale() const { return m_font_scale; }
+		// Stops layout once the limit is reached; content after the cut is skipped and not drawn
+		void							set_layout_limit(const layout_limit& limit) { m_layout_limit = limit; }
+		const layout_limit&				get_layout_limit() const { return m_layout_limit; }
+		bool							has_layout_limit() const { return m_layout_limit.max_lines > 0 || m_layout_limit.max_height > 0; }
+		// True if the last render() cut content because of the layout limit
+		bool							layout_truncated() const { return m_layout_truncated; }
+		// Layout limit bookkeeping for render items, valid during render()
+		int								render_pass() const { return m_render_pass; }
+		int								lines_left() const { return m_lines_left; }
+		void							use_lines(int count, const std::shared_ptr<render_item>& owner);
+		bool							layout_limit_reached(pixel_t document_y) const;
+		void							set_layout_truncated() { m_layout_truncated = true; }
+		std::shared_ptr<render_item>	last_lines_owner() const { return m_last_lines_owner.lock(); }
+		// Lets render() lay out independent block formatting contexts concurrently; ignored while a layout limit is set.
+		// The container's text_width() must be thread-safe while the runner executes tasks.
+		void							set_parallel_runner(parallel_runner runner) { m_parallel_runner = std::move(runner); }
+		const parallel_runner&			get_parallel_runner() const { return m_parallel_runner; }
+		// Set by createFromString() when the container's complexity_limit was exceeded; the document is then left empty
+		complexity_error				complexity_exceeded() const { return m_complexity_error; }
+		// Counts table grid slots while the render tree is built; false once max_table_cells is exceeded
+		bool							use_table_cells(size_t count);
 		bool							match_lang(const string& lang);
 		void							add_tabular(const std::shared_ptr<render_item>& el);
 		std::shared_ptr<const element>	get_over_element() const { return m_over_element; }
+		// Changes every time the computed styles are updated. Layout caches are valid for one generation only.
+		int								styles_generation() const { return m_styles_generation; }
+		void							styles_changed() { m_styles_generation++; }
+		counter_state&					counters() { return m_counters; }
 
 		void							append_children_from_string(element& parent, const char* str, bool replace_existing);
+		// Replaces the content of parent (except ::before/::after) with text nodes. Call rebuild_render_tree() before render().
+		void							set_element_text(const std::shared_ptr<element>& parent, const char* text);
+		// Recreates the render tree from the element tree without re-parsing or re-applying styles.
+		void							rebuild_render_tree();
+		// Installs an element tree whose computed styles are already set (e.g. restored from a snapshot)
+		// and builds its render tree. Such documents have no style sheets to re-apply, so set_font_scale() is ignored.
+		void							set_styled_root(const std::shared_ptr<element>& root);
+		void							set_mode(document_mode mode) { m_mode = mode; }
 		void							dump(dumper& cout);
 
 		// see doc/document_createFromString.txt
@@ -119,7 +190,7 @@ namespace litehtml
 		uint_ptr	add_font(const font_description& descr, font_metrics* fm);
 
 		GumboOutput* parse_html(estring str);
-		void create_node(void* gnode, elements_list& elements, bool parseTextNode, bool process_root);
+		void create_node(void* gnode, elements_list& elements, bool parseTextNode, bool process_root, int depth = 0);
 		bool update_media_lists(const media_features& features);
 		void fix_tables_layout();
 		void fix_table_children(const std::shared_ptr<render_item>& el_ptr, style_display disp, const char* disp_str);
@@ -69,6 +69,8 @@ namespace litehtml
 		virtual void				get_media_features(litehtml::media_features& media) const = 0;
 		virtual void				get_language(litehtml::string& language, litehtml::string& culture) const = 0;
 		virtual litehtml::string	resolve_color(const litehtml::string& /*color*/) const { return litehtml::string(); }
+		// Read by createFromString() before the element tree is built
+		virtual void				get_complexity_limit(litehtml::complexity_limit& /*limit*/) const {}
 		virtual void				split_text(const char* text, const std::function<void(const char*)>& on_word, const std::function<void(const char*)>& on_space);
 
 	protected:
@@ -7,10 +7,13 @@ namespace litehtml
 {
 	class el_before_after_base : public html_tag
 	{
+		string	m_content;
 	public:
 		el_before_after_base(const std::shared_ptr<document>& doc, bool before);
 
 		void add_style(const style& style) override;
+	protected:
+		void	generate_content() override;
 	private:
 		void	add_text(const string& txt);
 		void	add_function(const string& fnc, const string& params);
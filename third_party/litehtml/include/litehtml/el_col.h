@@ -0,0 +1,17 @@
+#ifndef LH_EL_COL_H
+#define LH_EL_COL_H
+
+#include "html_tag.h"
+
+namespace litehtml
+{
+	class el_col : public html_tag
+	{
+	public:
+		explicit el_col(const std::shared_ptr<litehtml::document>& doc);
+
+		void parse_attributes() override;
+	};
+}
+
+#endif  // LH_EL_COL_H
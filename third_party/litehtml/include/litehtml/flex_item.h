@@ -47,6 +47,14 @@ namespace litehtml
 
 		flex_align_items align;
 
+		// Intrinsic sizes are measured once and reused by the next layouts while the containing block
+		// size and the document styles are the same.
+		int cache_generation;
+		pixel_t cache_width;
+		pixel_t cache_height;
+		def_value<pixel_t> cached_min_content_size;
+		def_value<pixel_t> cached_content_base_size;
+
 		explicit flex_item(std::shared_ptr<render_item> &_el) :
 				el(_el),
 				base_size(0),
@@ -64,7 +72,12 @@ namespace litehtml
 				auto_margin_main_end(0),
 				auto_margin_cross_start(false),
 				auto_margin_cross_end(false),
-				align(flex_align_items_auto)
+				align(flex_align_items_auto),
+				cache_generation(-1),
+				cache_width(0),
+				cache_height(0),
+				cached_min_content_size(0),
+				cached_content_base_size(0)
 		{}
 
 		virtual ~flex_item() = default;
@@ -91,6 +104,7 @@ namespace litehtml
 		pixel_t get_first_baseline(baseline::_baseline_type type) const;
 
 	protected:
+		void validate_cache(const litehtml::containing_block_context &self_size);
 		virtual void direction_specific_init(const litehtml::containing_block_context &self_size,
 											 litehtml::formatting_context *fmt_ctx) = 0;
 		virtual void align_stretch(flex_line &ln, const containing_block_context &self_size,
@@ -1,16 +1,108 @@
 #ifndef LITEHTML_FLOATS_HOLDER_H
 #define LITEHTML_FLOATS_HOLDER_H
 
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
 #include "types.h"
 
 namespace litehtml
 {
+	/**
+	 * Floats of one side stored contiguously and sorted by top, with a segment
+	 * tree of their bottoms over the same order. A query at y binary-searches
+	 * the floats starting at or above y, then descends the tree only into
+	 * ranges whose highest bottom still reaches y. A query costs
+	 * O((k + 1) log n) for k reported floats, however tall the earlier floats
+	 * are. Appending a float updates one tree path; inserting, removing or
+	 * moving floats refreshes the tree from the first changed float.
+	 */
+	class floats_index
+	{
+	private:
+		std::vector<floated_box>	m_boxes;		// sorted by pos.top()
+		std::vector<pixel_t>		m_tree;			// max bottom per node; leaf of m_boxes[i] is m_leaves + i
+		size_t						m_leaves = 0;	// leaf count, a power of two >= m_boxes.size()
+		pixel_t						m_clear_left_top = std::numeric_limits<pixel_t>::lowest();	// max top of floats clearing left floats
+		pixel_t						m_clear_right_top = std::numeric_limits<pixel_t>::lowest();	// max top of floats clearing right floats
+
+		void update_tree(size_t from, size_t old_size);
+		void update_clear_tops();
+		size_t upper_bound_top(pixel_t y) const
+		{
+			return std::upper_bound(m_boxes.begin(), m_boxes.end(), y,
+									[](pixel_t val, const floated_box& fb) { return val < fb.pos.top(); }) - m_boxes.begin();
+		}
+		size_t lower_bound_top(pixel_t y) const
+		{
+			return std::lower_bound(m_boxes.begin(), m_boxes.end(), y,
+									[](const floated_box& fb, pixel_t val) { return fb.pos.top() < val; }) - m_boxes.begin();
+		}
+
+		/// Calls func for every float before end with bottom > y (bottom >= y if inclusive)
+		template<class Func>
+		void for_each_below(size_t node, size_t node_first, size_t node_size, size_t end, pixel_t y, bool inclusive, Func& func) const
+		{
+			if(node_first >= end || (inclusive ? m_tree[node] < y : m_tree[node] <= y))
+			{
+				return;
+			}
+			if(node_size == 1)
+			{
+				func(m_boxes[node_first]);
+				return;
+			}
+			node_size /= 2;
+			for_each_below(node * 2, node_first, node_size, end, y, inclusive, func);
+			for_each_below(node * 2 + 1, node_first + node_size, node_size, end, y, inclusive, func);
+		}
+
+	public:
+		using const_iterator = std::vector<floated_box>::const_iterator;
+
+		bool empty() const						{ return m_boxes.empty(); }
+		const_iterator begin() const			{ return m_boxes.begin(); }
+		const_iterator end() const				{ return m_boxes.end(); }
+		pixel_t max_bottom() const				{ return m_tree[1]; }
+		// Highest top of the floats with clear: left (float_left) or clear: right (float_right), clear: both included
+		pixel_t max_clearing_top(element_float side) const	{ return side == float_left ? m_clear_left_top : m_clear_right_top; }
+
+		void add(floated_box&& fb);
+		bool remove_context(int context);
+		bool shift_descendants(pixel_t dy, const std::shared_ptr<render_item>& parent);
+
+		/// Calls func for every float with top <= y < bottom
+		template<class Func>
+		void for_each_at(pixel_t y, Func func) const
+		{
+			if(!m_boxes.empty())
+			{
+				for_each_below(1, 0, m_leaves, upper_bound_top(y), y, false, func);
+			}
+		}
+
+		/// Calls func for every float with top >= y or bottom >= y
+		template<class Func>
+		void for_each_reaching(pixel_t y, Func func) const
+		{
+			if(m_boxes.empty())
+			{
+				return;
+			}
+			size_t first = lower_bound_top(y);
+			for(size_t i = first; i < m_boxes.size(); i++)
+			{
+				func(m_boxes[i]);
+			}
+			for_each_below(1, 0, m_leaves, first, y, true, func);
+		}
+	};
+
 	class formatting_context
 	{
 	private:
-		std::list<floated_box> m_floats_left;
-		std::list<floated_box> m_floats_right;
+		floats_index m_floats_left;
+		floats_index m_floats_right;
 		pixel_pixel_cache m_cache_line_left;
 		pixel_pixel_cache m_cache_line_right;
 		pixel_t m_current_top;
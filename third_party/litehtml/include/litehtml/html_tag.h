@@ -18,6 +18,7 @@ namespace litehtml
 		friend class el_table;
 		friend class table_grid;
 		friend class line_box;
+		friend class counter_state;
 	public:
 		typedef shared_ptr<html_tag>	ptr;
 	protected:
@@ -46,6 +47,7 @@ namespace litehtml
 		void				set_data(const char* data) override;
 		const vector<string_id>& classes() const { return m_classes; }
 		const string_vector& str_classes() const { return m_str_classes; }
+		const string_map&	attrs() const { return m_attrs; }
 
 		void				set_attr(const char* name, const char* val) override;
 		const char*			get_attr(const char* name, const char* def = nullptr) const override;
@@ -104,9 +106,11 @@ namespace litehtml
 
 		string				dump_get_name() override;
 
+		static string		get_list_marker_text(list_style_type type, int index);
+
 	protected:
 		void				draw_list_marker( uint_ptr hdc, const position &pos, const std::shared_ptr<render_item> &ri );
-		string				get_list_marker_text(int index);
+		virtual void		generate_content() {}
 		element::ptr		get_element_before(const style& style, bool create);
 		element::ptr		get_element_after(const style& style, bool create);
 
@@ -115,9 +119,6 @@ namespace litehtml
 		void map_to_dimension_property(string_id prop_name, string attr_value);
 		void map_to_dimension_property_ignoring_zero(string_id prop_name, string attr_value);
 
-	private:
-		void				handle_counter_properties();
-
 	};
 
 	/************************************************************************/
@@ -14,6 +14,9 @@ namespace litehtml
 	{
 	protected:
 		pixel_t _render_content(pixel_t x, pixel_t y, bool second_pass, const containing_block_context &self_size, formatting_context* fmt_ctx) override;
+		// Renders the independent block formatting contexts among the children with the document's parallel runner.
+		// Returns the rendered children in document order with their render() results.
+		std::vector<std::pair<render_item*, pixel_t>> prerender_independent(const containing_block_context &self_size);
 
 	public:
 		explicit render_item_block_context(std::shared_ptr<element>  src_el) : render_item_block(std::move(src_el))
@@ -9,14 +9,17 @@ namespace litehtml
 {
 	class render_item_flex : public render_item_block
 	{
-		std::list<flex_line> m_lines;
+		std::vector<flex_line> m_lines;
+		std::vector<std::shared_ptr<flex_item>> m_items;	// flex items are kept between layouts to reuse the measured sizes
+		bool m_items_row_direction;
 
-		std::list<flex_line> get_lines(const containing_block_context &self_size, formatting_context *fmt_ctx, bool is_row_direction,
+		std::vector<flex_line> get_lines(const containing_block_context &self_size, formatting_context *fmt_ctx, bool is_row_direction,
 									   pixel_t container_main_size, bool single_line);
 		pixel_t _render_content(pixel_t x, pixel_t y, bool second_pass, const containing_block_context &self_size, formatting_context* fmt_ctx) override;
 
 	public:
-		explicit render_item_flex(std::shared_ptr<element>  src_el) : render_item_block(std::move(src_el))
+		explicit render_item_flex(std::shared_ptr<element>  src_el) : render_item_block(std::move(src_el)),
+			m_items_row_direction(true)
 		{}
 
 		std::shared_ptr<render_item> clone() override
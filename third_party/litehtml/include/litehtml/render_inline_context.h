@@ -31,6 +31,16 @@ namespace litehtml
 		std::vector<std::unique_ptr<litehtml::line_box> > m_line_boxes;
 		pixel_t m_max_line_width;
 
+		// Line clamping: max-lines / -webkit-line-clamp and the document layout limit
+		int m_max_lines = -1;				// lines allowed by the current render, -1 = no limit
+		pixel_t m_max_bottom = -1;			// content y where lines stop, -1 = no limit
+		bool m_limit_from_document = false;	// the document limit is stricter than max-lines
+		bool m_clamped = false;				// content was cut by the last render
+		int m_limit_pass = -1;				// document render pass of the lines taken below
+		int m_limit_lines = 0;				// lines taken from the document limit by the last render
+		bool m_ellipsis = false;
+		position m_ellipsis_pos;
+
 		pixel_t _render_content(pixel_t x, pixel_t y, bool second_pass, const containing_block_context &self_size, formatting_context* fmt_ctx) override;
 		void fix_line_width(element_float flt,
 							const containing_block_context &self_size, formatting_context* fmt_ctx) override;
@@ -39,6 +49,7 @@ namespace litehtml
 		void place_inline(std::unique_ptr<line_box_item> item, const containing_block_context &self_size, formatting_context* fmt_ctx);
 		pixel_t new_box(const std::unique_ptr<line_box_item>& el, line_context& line_ctx, const containing_block_context &self_size, formatting_context* fmt_ctx);
 		void apply_vertical_align() override;
+		bool line_limit_reached();
 	public:
 		explicit render_item_inline_context(std::shared_ptr<element>  src_el) : render_item_block(std::move(src_el)), m_max_line_width(0)
 		{}
@@ -50,6 +61,13 @@ namespace litehtml
 
 		pixel_t get_first_baseline() override;
 		pixel_t get_last_baseline() override;
+
+		// Number of non-empty line boxes created by the last render
+		int get_line_count() const;
+		// Ends the last line with an ellipsis, hiding the text it would cover
+		void place_ellipsis();
+
+		void draw_children(uint_ptr hdc, pixel_t x, pixel_t y, const position* clip, draw_flag flag, int zindex) override;
 	};
 }
 
@@ -12,7 +12,10 @@ namespace litehtml
 		std::unique_ptr<table_grid>	m_grid;
 		pixel_t						m_border_spacing_x;
 		pixel_t						m_border_spacing_y;
+		bool						m_fixed_layout;
+		int							m_styles_generation;	// styles generation of the cached cells widths
 
+		void measure_cells(const containing_block_context& self_size, pixel_t table_width_spacing, formatting_context* fmt_ctx);
 		pixel_t _render(pixel_t x, pixel_t y, const containing_block_context &containing_block_size, formatting_context* fmt_ctx, bool second_pass) override;
 
 	public:
@@ -305,8 +305,13 @@ STRING_ID(
 	_flex_basis_,
 
 	_caption_side_,
+	_table_layout_,
 	_order_,
 
+	_text_overflow_,
+	_max_lines_,
+	__webkit_line_clamp_,
+
 	_counter_reset_,
 	_counter_increment_,
 
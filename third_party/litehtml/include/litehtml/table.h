@@ -151,6 +151,12 @@ namespace litehtml
 		pixel_t			width;
 		pixel_t			height;
 		margins			borders;
+		// Intrinsic widths are cached between layouts: the render item tree (and the grid) is
+		// rebuilt whenever the content changes, and the table drops the cache when the styles change.
+		pixel_t			min_content_width;	// cached minimum content width, -1 if not measured
+		pixel_t			max_content_width;	// cached maximum content width, -1 if not measured
+		pixel_t			max_content_base;	// available width max_content_width was measured with
+		pixel_t			rendered_width;		// width of the last render in the current layout pass, -1 if none
 
 		table_cell()
 		{
@@ -163,6 +169,10 @@ namespace litehtml
 			colspan			= 1;
 			rowspan			= 1;
 			el				= nullptr;
+			min_content_width	= -1;
+			max_content_width	= -1;
+			max_content_base	= 0;
+			rendered_width		= -1;
 		}
 
 		table_cell(const table_cell& val)
@@ -177,6 +187,10 @@ namespace litehtml
 			max_width		= val.max_width;
 			max_height		= val.max_height;
 			borders			= val.borders;
+			min_content_width	= val.min_content_width;
+			max_content_width	= val.max_content_width;
+			max_content_base	= val.max_content_base;
+			rendered_width		= val.rendered_width;
 		}
 
 		table_cell(table_cell&& val) noexcept
@@ -191,6 +205,10 @@ namespace litehtml
 			max_width = val.max_width;
 			max_height = val.max_height;
 			borders = val.borders;
+			min_content_width = val.min_content_width;
+			max_content_width = val.max_content_width;
+			max_content_base = val.max_content_base;
+			rendered_width = val.rendered_width;
 		}
 	};
 
@@ -205,6 +223,9 @@ namespace litehtml
 		table_column::vector	m_columns;
 		table_row::vector		m_rows;
 		std::vector<std::shared_ptr<render_item>> m_captions;
+		std::vector<int>		m_rowspan_end;		// last row covered by a rowspan started in the column
+		std::vector<css_length>	m_col_widths;		// widths of the <col> elements
+		int						m_max_row_size;		// slots in the longest row added so far
 		pixel_t					m_top_captions_height;
 		pixel_t					m_bottom_captions_height;
 	public:
@@ -212,6 +233,7 @@ namespace litehtml
 		table_grid() :
 			m_rows_count(0),
 			m_cols_count(0),
+			m_max_row_size(0),
 			m_top_captions_height(0),
 			m_bottom_captions_height(0)
 		{
@@ -219,9 +241,13 @@ namespace litehtml
 
 		void			clear();
 		void			begin_row(const std::shared_ptr<render_item>& row);
-		void			add_cell(const std::shared_ptr<render_item>& el);
+		// Returns the grid slots appended to the current row, including the ones skipped for rowspans
+		int				add_cell(const std::shared_ptr<render_item>& el);
 		bool			is_rowspanned(int r, int c);
-		void			finish();
+		void			add_column(const css_length& width, int span);
+		// Slots of the grid finish() builds: row count x longest row
+		size_t			finished_size() const;
+		void			finish(table_layout layout = table_layout_auto);
 		table_cell*		cell(int t_col, int t_row);
 		table_column&	column(int c)	{ return m_columns[c];	}
 		table_row&		row(int r)		{ return m_rows[r];		}
@@ -240,6 +266,7 @@ namespace litehtml
 		void			distribute_width(pixel_t width, int start, int end);
 		void			distribute_width(pixel_t width, int start, int end, table_column_accessor* acc);
 		pixel_t			calc_table_width(pixel_t block_width, bool is_auto, pixel_t& min_table_width, pixel_t& max_table_width);
+		pixel_t			calc_fixed_table_width(pixel_t block_width);
 		void			calc_horizontal_positions(const margins& table_borders, border_collapse bc, pixel_t bdr_space_x);
 		void			calc_vertical_positions(const margins& table_borders, border_collapse bc, pixel_t bdr_space_y);
 		void			calc_rows_height(pixel_t blockHeight, pixel_t borderSpacingY);
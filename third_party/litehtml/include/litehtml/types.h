@@ -297,6 +297,14 @@ namespace litehtml
 
 	using fonts_map = std::map<string, font_item>;
 
+	// Text and widths of a numbered list marker, cached per (list-style-type, index, font)
+	struct list_marker_text
+	{
+		string		text;
+		pixel_t		text_width;
+		pixel_t		space_width;
+	};
+
 	enum draw_flag
 	{
 		draw_root,
@@ -682,6 +690,14 @@ namespace litehtml
 		overflow_no_content
 	};
 
+#define text_overflow_strings		"clip;ellipsis"
+
+	enum text_overflow
+	{
+		text_overflow_clip,
+		text_overflow_ellipsis
+	};
+
 #define background_size_strings		"auto;cover;contain"
 
 	enum background_size
@@ -980,6 +996,25 @@ namespace litehtml
 		render_fixed_only,
 	};
 
+	// Caps the work createFromString() does for pathological input, 0 = no limit
+	struct complexity_limit
+	{
+		int		max_depth		= 0;	// element nesting depth
+		int		max_elements	= 0;	// elements created from the HTML
+		int		max_css_rules	= 0;	// selectors of the document's style sheets ("a, b" counts twice)
+		int		max_table_cells	= 0;	// table grid slots of all tables (a cell spanning n columns takes n)
+	};
+
+	// First complexity_limit value a document exceeded
+	enum complexity_error
+	{
+		complexity_ok,
+		complexity_depth,
+		complexity_elements,
+		complexity_css_rules,
+		complexity_table_cells,
+	};
+
 	const char* const split_delims_spaces = " \t\r\n\f\v";
 
 	// List of the Void Elements (can't have any contents)
@@ -1078,6 +1113,14 @@ namespace litehtml
 		caption_side_top,
 		caption_side_bottom
 	};
+
+#define table_layout_strings		"auto;fixed"
+
+	enum table_layout
+	{
+		table_layout_auto,
+		table_layout_fixed
+	};
 }
 
 #endif  // LH_TYPES_H
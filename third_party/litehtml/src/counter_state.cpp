@@ -0,0 +1,207 @@
+#include "html.h"
+#include "counter_state.h"
+#include "html_tag.h"
+#include "document.h"
+
+namespace litehtml
+{
+
+static void parse_counter_tokens(const string_vector& tokens, const int default_value, const std::function<void(string_id, int)>& handler)
+{
+	int pos = 0;
+	while (pos < (int) tokens.size())
+	{
+		const string& name = tokens[pos];
+		int value = default_value;
+		if (pos < (int) tokens.size() - 1 && litehtml::is_number(tokens[pos + 1], false))
+		{
+			value = atoi(tokens[pos + 1].c_str());
+			pos += 2;
+		}
+		else
+		{
+			pos += 1;
+		}
+		handler(_id(name), value);
+	}
+}
+
+void counter_state::enter(const element* el, const style& st)
+{
+	if(m_nesting++ == 0)
+	{
+		reset();
+		// A pass starting at the root sees every counter in document order
+		m_synced = el->parent() == nullptr;
+	}
+	if(m_synced)
+	{
+		m_depth++;
+		apply(el, st);
+	}
+}
+
+void counter_state::leave(const element* el)
+{
+	if(m_synced)
+	{
+		close_scope(el);
+		m_depth--;
+	}
+	if(--m_nesting == 0)
+	{
+		reset();
+	}
+}
+
+string counter_state::get_counter_value(const element* el, string_id name)
+{
+	sync(el);
+	auto iter = m_counters.find(name);
+	if(iter != m_counters.end() && !iter->second.empty())
+	{
+		return std::to_string(iter->second.back().value);
+	}
+	return "0";
+}
+
+string counter_state::get_counters_value(const element* el, string_id name, const string& delims)
+{
+	sync(el);
+	string_vector values;
+	for(const auto& inst : m_counters[name])
+	{
+		if(inst.open)
+		{
+			values.push_back(std::to_string(inst.value));
+		}
+	}
+	if(values.empty())
+	{
+		// if no counter is found, instance one with value '0'
+		reset_counter(el, name, 0);
+		return "0";
+	}
+	string result;
+	join_string(result, values, delims);
+	return result;
+}
+
+void counter_state::apply(const element* el, const style& st)
+{
+	const auto& reset_property = st.get_property(_counter_reset_);
+	if(reset_property.is<string_vector>())
+	{
+		parse_counter_tokens(reset_property.get<string_vector>(), 0,
+							 [&](string_id name, int value) { reset_counter(el, name, value); });
+	}
+
+	const auto& inc_property = st.get_property(_counter_increment_);
+	if(inc_property.is<string_vector>())
+	{
+		parse_counter_tokens(inc_property.get<string_vector>(), 1,
+							 [&](string_id name, int value) { increment_counter(el, name, value); });
+	}
+}
+
+void counter_state::close_scope(const element* el)
+{
+	// Instances created by the children go out of scope together with their parent
+	while(!m_log.empty())
+	{
+		auto& stack = m_counters[m_log.back()];
+		if(stack.back().depth <= m_depth)
+		{
+			break;
+		}
+		stack.pop_back();
+		m_log.pop_back();
+	}
+	// Own instances stay visible to the following siblings, but are no longer ancestors
+	for(auto iter = m_log.rbegin(); iter != m_log.rend(); ++iter)
+	{
+		auto& inst = m_counters[*iter].back();
+		if(inst.owner != el)
+		{
+			break;
+		}
+		inst.open = false;
+	}
+}
+
+void counter_state::sync(const element* el)
+{
+	if(m_synced)
+	{
+		return;
+	}
+	m_synced = true;
+	m_depth = 0;
+	if(auto root = el->get_document()->root())
+	{
+		replay(root, el);
+	}
+}
+
+bool counter_state::replay(const element::ptr& el, const element* target)
+{
+	auto tag = dynamic_cast<const html_tag*>(el.get());
+	if(!tag)
+	{
+		return false;
+	}
+	m_depth++;
+	apply(el.get(), tag->m_style);
+	if(el.get() == target)
+	{
+		return true;
+	}
+	for(const auto& child : el->children())
+	{
+		if(replay(child, target))
+		{
+			return true;
+		}
+	}
+	close_scope(el.get());
+	m_depth--;
+	return false;
+}
+
+void counter_state::reset()
+{
+	m_counters.clear();
+	m_log.clear();
+	m_depth = 0;
+	m_synced = false;
+}
+
+void counter_state::reset_counter(const element* el, string_id name, int value)
+{
+	auto& stack = m_counters[name];
+	if(!stack.empty() && stack.back().owner == el)
+	{
+		stack.back().value = value;
+	}
+	else
+	{
+		stack.push_back({value, m_depth, el, true});
+		m_log.push_back(name);
+	}
+}
+
+void counter_state::increment_counter(const element* el, string_id name, int value)
+{
+	auto& stack = m_counters[name];
+	if(stack.empty())
+	{
+		// if counter is not found, initialize one on this element
+		reset_counter(el, name, value);
+	}
+	else
+	{
+		stack.back().value += value;
+	}
+}
+
+} // namespace litehtml
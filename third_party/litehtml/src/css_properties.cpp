@@ -26,6 +26,7 @@ void litehtml::css_properties::compute(const html_tag* el, const document::ptr&
 	m_text_transform = (text_transform)		el->get_property<int>( _text_transform_,	true,	text_transform_none,		 offset(m_text_transform));
 	m_white_space	 = (white_space)		el->get_property<int>( _white_space_,		true,	white_space_normal,		 offset(m_white_space));
 	m_caption_side	 = (caption_side)		el->get_property<int>( _caption_side_,	true,	caption_side_top,		 offset(m_caption_side));
+	m_table_layout	 = (table_layout)		el->get_property<int>( _table_layout_,	false,	table_layout_auto,		 offset(m_table_layout));
 
 	// https://www.w3.org/TR/CSS22/visuren.html#dis-pos-flo
 	if (m_display == display_none)
@@ -252,6 +253,9 @@ void litehtml::css_properties::compute(const html_tag* el, const document::ptr&
 
 	m_order = el->get_property<int>(_order_, false, 0, offset(m_order));
 
+	m_max_lines		= el->get_property<int>(_max_lines_, false, 0, offset(m_max_lines));
+	m_text_overflow	= (text_overflow) el->get_property<int>(_text_overflow_, false, text_overflow_clip, offset(m_text_overflow));
+
 	compute_background(el, doc);
 	compute_flex(el, doc);
 }
@@ -279,14 +283,17 @@ static const litehtml::pixel_t font_size_table[8][7] =
 void litehtml::css_properties::compute_font(const html_tag* el, const document::ptr& doc)
 {
 	// initialize font size
-	css_length sz = el->get_property<css_length>(_font_size_, true, css_length::predef_value(font_size_medium), offset(m_font_size));
+	// Font sizes are resolved and inherited unscaled; the document font scale is applied to the
+	// result, so it is not compounded through inheritance
+	css_length sz = el->get_property<css_length>(_font_size_, true, css_length::predef_value(font_size_medium), offset(m_unscaled_font_size));
 
+	pixel_t font_scale = doc->font_scale();
 	pixel_t parent_sz = 0;
 	pixel_t doc_font_size = doc->container()->get_default_font_size();
 	element::ptr el_parent = el->parent();
 	if (el_parent)
 	{
-		parent_sz = el_parent->css().get_font_size();
+		parent_sz = (pixel_t) el_parent->css().m_unscaled_font_size.val();
 	} else
 	{
 		parent_sz = doc_font_size;
@@ -355,9 +362,15 @@ void litehtml::css_properties::compute_font(const html_tag* el, const document::
 			font_metrics fm;
 			fm.x_height = fm.font_size = parent_sz;
 			font_size = doc->to_pixels(sz, fm, 0);
+			if(sz.units() == css_units_rem)
+			{
+				font_size /= font_scale;
+			}
 		}
 	}
 
+	m_unscaled_font_size = (float)font_size;
+	font_size *= font_scale;
 	m_font_size = (float)font_size;
 
 	// initialize font
@@ -433,9 +446,14 @@ void litehtml::css_properties::compute_font(const html_tag* el, const document::
 		}
 	}
 
+	m_font = doc->get_font(get_font_description(), &m_font_metrics);
+}
+
+litehtml::font_description litehtml::css_properties::get_font_description() const
+{
 	font_description descr;
 	descr.family 				= m_font_family;
-	descr.size					= std::round(font_size);
+	descr.size					= std::round(m_font_size.val());
 	descr.style					= m_font_style;
 	descr.weight				= (int) m_font_weight.val();
 	descr.decoration_line		= m_text_decoration_line;
@@ -445,8 +463,7 @@ void litehtml::css_properties::compute_font(const html_tag* el, const document::
 	descr.emphasis_style		= m_text_emphasis_style;
 	descr.emphasis_color		= m_text_emphasis_color;
 	descr.emphasis_position		= m_text_emphasis_position;
-
-	m_font = doc->get_font(descr, &m_font_metrics);
+	return descr;
 }
 
 void litehtml::css_properties::compute_background(const html_tag* el, const document::ptr& doc)
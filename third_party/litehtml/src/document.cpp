@@ -9,6 +9,7 @@
 #include "el_image.h"
 #include "el_table.h"
 #include "el_td.h"
+#include "el_col.h"
 #include "el_link.h"
 #include "el_title.h"
 #include "el_style.h"
@@ -21,6 +22,7 @@
 #include "el_div.h"
 #include "el_font.h"
 #include "el_tr.h"
+#include "el_before_after.h"
 #include "gumbo.h"
 #include "render_item.h"
 #include "render_table.h"
@@ -56,6 +58,7 @@ document::ptr document::createFromString(
 {
 	// Create litehtml::document
 	document::ptr doc = make_shared<document>(container);
+	container->get_complexity_limit(doc->m_complexity_limit);
 
 	// Parse document into GumboOutput
 	GumboOutput* output = doc->parse_html(str);
@@ -68,6 +71,11 @@ document::ptr document::createFromString(
 	case GUMBO_DOCTYPE_LIMITED_QUIRKS: doc->m_mode = limited_quirks_mode; break;
 	}
 
+	if (output->status == GUMBO_STATUS_TREE_TOO_DEEP)
+	{
+		doc->m_complexity_error = complexity_depth;
+	}
+
 	// Create litehtml::elements.
 	elements_list root_elements;
 	doc->create_node(output->root, root_elements, true, true);
@@ -79,6 +87,16 @@ document::ptr document::createFromString(
 	// Destroy GumboOutput
 	gumbo_destroy_output(&kGumboDefaultOptions, output);
 
+	// Nothing else runs on a document over its complexity limit
+	auto exceeded = [&doc]()
+	{
+		if (doc->m_complexity_error == complexity_ok) return false;
+		doc->m_root_render = nullptr;
+		doc->m_root = nullptr;
+		return true;
+	};
+	if (exceeded()) return doc;
+
 	if (master_styles != "")
 	{
 		doc->m_master_css.parse_css_stylesheet(master_styles, "", doc);
@@ -115,6 +133,13 @@ document::ptr document::createFromString(
 			}
 			doc->m_styles.parse_css_stylesheet(css.text, css.baseurl, doc, media);
 		}
+		// Selector matching costs elements x selectors, so stop before it
+		int max_css_rules = doc->m_complexity_limit.max_css_rules;
+		if (max_css_rules > 0 && doc->m_styles.selectors().size() > (size_t) max_css_rules)
+		{
+			doc->m_complexity_error = complexity_css_rules;
+		}
+		if (exceeded()) return doc;
 		// Sort css selectors using CSS rules.
 		doc->m_styles.sort_selectors();
 
@@ -144,6 +169,7 @@ document::ptr document::createFromString(
 		{
 			doc->m_root_render = doc->m_root_render->init();
 		}
+		exceeded();
 	}
 
 	return doc;
@@ -214,6 +240,15 @@ encoding get_meta_encoding(GumboNode* root)
 }
 
 // substitute for gumbo_parse that handles encodings
+// Parse errors are never read. Gumbo copies the stack of open elements into every
+// error, which takes memory quadratic in the nesting depth of broken markup.
+static GumboOptions gumbo_options()
+{
+	GumboOptions options = kGumboDefaultOptions;
+	options.max_errors = 0;
+	return options;
+}
+
 GumboOutput* document::parse_html(estring str)
 {
 	// https://html.spec.whatwg.org/multipage/parsing.html#the-input-byte-stream
@@ -229,7 +264,11 @@ GumboOutput* document::parse_html(estring str)
 	// Instead, we parse entire file and then handle <meta> tags.
 
 	// Using gumbo_parse_with_options to pass string length (m_text may contain NUL chars).
-	GumboOutput* output = gumbo_parse_with_options(&kGumboDefaultOptions, m_text.data(), m_text.size());
+	GumboOptions options = gumbo_options();
+	// Gumbo's scope checks walk the open element stack for each tag, so stop deep nesting while parsing
+	if (m_complexity_limit.max_depth > 0)
+		options.max_tree_depth = m_complexity_limit.max_depth;
+	GumboOutput* output = gumbo_parse_with_options(&options, m_text.data(), m_text.size());
 
 	if (str.confidence == confidence::certain)
 		return output;
@@ -252,15 +291,17 @@ GumboOutput* document::parse_html(estring str)
 				m_text = str;
 			else
 				decode(str, new_encoding, m_text);
-			output = gumbo_parse_with_options(&kGumboDefaultOptions, m_text.data(), m_text.size());
+			output = gumbo_parse_with_options(&options, m_text.data(), m_text.size());
 		}
 	}
 
 	return output;
 }
 
-void document::create_node(void* gnode, elements_list& elements, bool parseTextNode, bool process_root)
+void document::create_node(void* gnode, elements_list& elements, bool parseTextNode, bool process_root, int depth)
 {
+	if (m_complexity_error != complexity_ok) return;
+
 	auto* node = (GumboNode*)gnode;
 	switch (node->type)
 	{
@@ -299,11 +340,21 @@ void document::create_node(void* gnode, elements_list& elements, bool parseTextN
 			}
 			if (ret)
 			{
+				if (m_complexity_limit.max_elements > 0 && ++m_element_count > m_complexity_limit.max_elements)
+				{
+					m_complexity_error = complexity_elements;
+					return;
+				}
+				if (m_complexity_limit.max_depth > 0 && depth >= m_complexity_limit.max_depth)
+				{
+					m_complexity_error = complexity_depth;
+					return;
+				}
 				elements_list child;
 				for (unsigned int i = 0; i < node->v.element.children.length; i++)
 				{
 					child.clear();
-					create_node(static_cast<GumboNode*> (node->v.element.children.data[i]), child, parseTextNode, true);
+					create_node(static_cast<GumboNode*> (node->v.element.children.data[i]), child, parseTextNode, true, depth + 1);
 					std::for_each(child.begin(), child.end(),
 						[&ret](element::ptr& el)
 						{
@@ -317,7 +368,7 @@ void document::create_node(void* gnode, elements_list& elements, bool parseTextN
 		{
 			for (unsigned int i = 0; i < node->v.element.children.length; i++)
 			{
-				create_node(static_cast<GumboNode*> (node->v.element.children.data[i]), elements, parseTextNode, true);
+				create_node(static_cast<GumboNode*> (node->v.element.children.data[i]), elements, parseTextNode, true, depth);
 			}
 		}
 	}
@@ -394,6 +445,10 @@ element::ptr document::create_element(const char* tag_name, const string_map& at
 		{
 			newTag = std::make_shared<el_td>(this_doc);
 		}
+		else if (!strcmp(tag_name, "col") || !strcmp(tag_name, "colgroup"))
+		{
+			newTag = std::make_shared<el_col>(this_doc);
+		}
 		else if (!strcmp(tag_name, "link"))
 		{
 			newTag = std::make_shared<el_link>(this_doc);
@@ -495,6 +550,58 @@ uint_ptr document::get_font( const font_description& descr, font_metrics* fm )
 	return add_font(descr, fm);
 }
 
+const list_marker_text& document::get_list_marker_text(list_style_type type, int index, uint_ptr font)
+{
+	auto key = std::make_tuple(type, index, font);
+	auto iter = m_list_markers.find(key);
+	if(iter != m_list_markers.end())
+	{
+		return iter->second;
+	}
+
+	list_marker_text marker = {html_tag::get_list_marker_text(type, index), 0, 0};
+	if(font)
+	{
+		if(!marker.text.empty())
+		{
+			marker.text += ".";
+			marker.text_width = m_container->text_width(marker.text.c_str(), font);
+		}
+		marker.space_width = m_container->text_width(" ", font);
+	}
+	return m_list_markers.emplace(key, std::move(marker)).first->second;
+}
+
+int document::get_list_index(const element* el)
+{
+	auto iter = m_list_indexes.find(el);
+	if(iter != m_list_indexes.end())
+	{
+		return iter->second;
+	}
+
+	// The first item asked for numbers its whole list, so long lists are not rescanned for every item
+	auto p = el->parent();
+	if(!p)
+	{
+		return 0;
+	}
+	int val = atoi(p->get_attr("start", "1"));
+	int ret = 0;
+	for(const auto& child : p->children())
+	{
+		if(child->css().get_display() == display_list_item)
+		{
+			if(child.get() == el)
+			{
+				ret = val;
+			}
+			m_list_indexes[child.get()] = val++;
+		}
+	}
+	return ret;
+}
+
 pixel_t document::render( pixel_t max_width, render_type rt )
 {
 	pixel_t ret = 0;
@@ -514,6 +621,11 @@ pixel_t document::render( pixel_t max_width, render_type rt )
 			m_root_render->render_positioned(rt);
 		} else
 		{
+			m_render_pass++;
+			m_lines_left = m_layout_limit.max_lines;
+			m_layout_truncated = false;
+			m_last_lines_owner.reset();
+
 			ret = m_root_render->render(0, 0, cb_context, nullptr);
 			if(m_root_render->fetch_positioned())
 			{
@@ -528,6 +640,34 @@ pixel_t document::render( pixel_t max_width, render_type rt )
 	return ret;
 }
 
+void document::use_lines(int count, const std::shared_ptr<render_item>& owner)
+{
+	m_lines_left -= count;
+	if(count > 0)
+	{
+		m_last_lines_owner = owner;
+	}
+}
+
+bool document::use_table_cells(size_t count)
+{
+	m_table_cells += count;
+	if(m_complexity_limit.max_table_cells > 0 && m_table_cells > (size_t) m_complexity_limit.max_table_cells)
+	{
+		m_complexity_error = complexity_table_cells;
+	}
+	return m_complexity_error == complexity_ok;
+}
+
+bool document::layout_limit_reached(pixel_t document_y) const
+{
+	if(m_layout_limit.max_lines > 0 && m_lines_left <= 0)
+	{
+		return true;
+	}
+	return m_layout_limit.max_height > 0 && document_y >= m_layout_limit.max_height;
+}
+
 void document::draw( uint_ptr hdc, pixel_t x, pixel_t y, const position* clip )
 {
 	if(m_root && m_root_render)
@@ -840,11 +980,28 @@ bool document::media_changed()
 	{
 		m_root->refresh_styles();
 		m_root->compute_styles();
+		styles_changed();
 		return true;
 	}
 	return false;
 }
 
+bool document::set_font_scale(float scale)
+{
+	if (scale <= 0 || scale == m_font_scale || m_styles_frozen)
+	{
+		return false;
+	}
+	m_font_scale = scale;
+	if (m_root)
+	{
+		m_root->refresh_styles();
+		m_root->compute_styles();
+		styles_changed();
+	}
+	return true;
+}
+
 bool document::lang_changed()
 {
 	if (!m_media_lists.empty())
@@ -861,6 +1018,7 @@ bool document::lang_changed()
 		}
 		m_root->refresh_styles();
 		m_root->compute_styles();
+		styles_changed();
 		return true;
 	}
 	return false;
@@ -970,7 +1128,8 @@ void document::fix_table_children(const std::shared_ptr<render_item>& el_ptr, st
 		{
 			if (!(*cur_iter)->src_el()->is_table_skip() || ((*cur_iter)->src_el()->is_table_skip() && !tmp.empty()))
 			{
-				if (disp != display_table_row_group || (*cur_iter)->src_el()->css().get_display() != display_table_caption)
+				if (disp != display_table_row_group || !is_one_of((*cur_iter)->src_el()->css().get_display(),
+					display_table_caption, display_table_column, display_table_column_group))
 				{
 					if (tmp.empty())
 					{
@@ -1086,7 +1245,7 @@ void document::append_children_from_string(element& parent, const char* str, boo
 		return;
 	}
 
-	GumboOptions opts = kGumboDefaultOptions;
+	GumboOptions opts = gumbo_options();
 	// This is require to prevent creating html, head, body tags around the fragment
 	// Although Gumbo always creates html tag anyway. We have to ignore it in create_node.
 	opts.fragment_context = GUMBO_TAG_BODY;
@@ -1102,6 +1261,8 @@ void document::append_children_from_string(element& parent, const char* str, boo
 	gumbo_destroy_output(&kGumboDefaultOptions, output);
 
 	auto parent_render = parent.get_render_item();
+	// The new children may be list items
+	m_list_indexes.clear();
 
 	if (replace_existing)
 	{
@@ -1147,6 +1308,81 @@ void document::append_children_from_string(element& parent, const char* str, boo
 	fix_tables_layout();
 }
 
+void document::set_element_text(const element::ptr& parent, const char* text)
+{
+	element::ptr before;
+	element::ptr after;
+	elements_list old_children = parent->children();
+	for (const auto& child : old_children)
+	{
+		if (std::dynamic_pointer_cast<el_before>(child))
+		{
+			before = child;
+		} else if (std::dynamic_pointer_cast<el_after>(child))
+		{
+			after = child;
+		}
+		parent->removeChild(child);
+	}
+
+	if (before)
+	{
+		parent->appendChild(before);
+	}
+	auto append_text = [&parent](const element::ptr& el)
+		{
+			parent->appendChild(el);
+			el->compute_styles();
+		};
+	m_container->split_text(text ? text : "",
+		[this, &append_text](const char* word) { append_text(std::make_shared<el_text>(word, shared_from_this())); },
+		[this, &append_text](const char* space) { append_text(std::make_shared<el_space>(space, shared_from_this())); });
+	if (after)
+	{
+		parent->appendChild(after);
+	}
+
+	// Text sizes changed: cached layout results are no longer valid
+	styles_changed();
+}
+
+void document::rebuild_render_tree()
+{
+	if (!m_root)
+	{
+		return;
+	}
+
+	m_root->clear_renders();
+	m_tabular_elements.clear();
+	m_fixed_boxes.clear();
+	m_list_indexes.clear();
+	m_table_cells = 0;
+
+	m_root_render = m_root->create_render_item(nullptr);
+	fix_tables_layout();
+	if (m_root_render)
+	{
+		m_root_render = m_root_render->init();
+	}
+	styles_changed();
+}
+
+void document::set_styled_root(const element::ptr& root)
+{
+	m_root = root;
+	m_root_render = nullptr;
+	m_styles_frozen = true;
+	if (!m_root)
+	{
+		return;
+	}
+
+	// Viewport units that were not resolved while styling are resolved against the media at render time
+	m_container->get_media_features(m_media);
+	rebuild_render_tree();
+}
+
 void document::dump(dumper& cout)
 {
 	if(m_root_render)
@@ -14,61 +14,73 @@ void litehtml::el_before_after_base::add_style(const style& style)
 {
 	html_tag::add_style(style);
 
-	auto children = m_children;
-	m_children.clear();
-
 	const auto& content_property = style.get_property(_content_);
 	if(content_property.is<string>() && !content_property.get<string>().empty())
 	{
 		const string& str = content_property.get<string>();
-		int idx = value_index(str, content_property_string);
-		if(idx < 0)
+		if(value_index(str, content_property_string) < 0)
+		{
+			m_content = str;
+		}
+	}
+}
+
+// Called from compute_styles() so that counter() and counters() see the
+// counter state of this point in the document
+void litehtml::el_before_after_base::generate_content()
+{
+	if(m_content.empty())
+	{
+		return;
+	}
+
+	auto children = m_children;
+	m_children.clear();
+
+	const string& str = m_content;
+	string fnc;
+	string::size_type i = 0;
+	while(i < str.length() && i != string::npos)
+	{
+		if(str.at(i) == '"' || str.at(i) == '\'')
 		{
-			string fnc;
-			string::size_type i = 0;
-			while(i < str.length() && i != string::npos)
+			auto chr = str.at(i);
+			fnc.clear();
+			i++;
+			string::size_type pos = str.find(chr, i);
+			string txt;
+			if(pos == string::npos)
 			{
-				if(str.at(i) == '"' || str.at(i) == '\'')
-				{
-					auto chr = str.at(i);
-					fnc.clear();
-					i++;
-					string::size_type pos = str.find(chr, i);
-					string txt;
-					if(pos == string::npos)
-					{
-						txt = str.substr(i);
-						i = string::npos;
-					} else
-					{
-						txt = str.substr(i, pos - i);
-						i = pos + 1;
-					}
-					add_text(txt);
-				} else if(str.at(i) == '(')
-				{
-					i++;
-					litehtml::trim(fnc);
-					litehtml::lcase(fnc);
-					string::size_type pos = str.find(')', i);
-					string params;
-					if(pos == string::npos)
-					{
-						params = str.substr(i);
-						i = string::npos;
-					} else
-					{
-						params = str.substr(i, pos - i);
-						i = pos + 1;
-					}
-					add_function(fnc, params);
-					fnc.clear();
-				} else
-				{
-					fnc += str.at(i);
-					i++;
-				}
+				txt = str.substr(i);
+				i = string::npos;
+			} else
+			{
+				txt = str.substr(i, pos - i);
+				i = pos + 1;
 			}
+			add_text(txt);
+		} else if(str.at(i) == '(')
+		{
+			i++;
+			litehtml::trim(fnc);
+			litehtml::lcase(fnc);
+			string::size_type pos = str.find(')', i);
+			string params;
+			if(pos == string::npos)
+			{
+				params = str.substr(i);
+				i = string::npos;
+			} else
+			{
+				params = str.substr(i, pos - i);
+				i = pos + 1;
+			}
+			add_function(fnc, params);
+			fnc.clear();
+		} else
+		{
+			fnc += str.at(i);
+			i++;
 		}
 	}
 
@@ -162,7 +174,7 @@ void litehtml::el_before_after_base::add_function( const string& fnc, const stri
 		break;
 	// counter
 	case 1:
-		add_text(get_counter_value(params));
+		add_text(get_document()->counters().get_counter_value(this, _id(params)));
 		break;
 	// counters
 	case 2:
@@ -170,7 +182,12 @@ void litehtml::el_before_after_base::add_function( const string& fnc, const stri
 			string_vector tokens;
 			split_string(params, tokens, ",");
 			for (auto& str : tokens) trim(str);
-			add_text(get_counters_value(tokens));
+			if (tokens.size() >= 2)
+			{
+				string delims = tokens[1];
+				trim(delims, "\"'");
+				add_text(get_document()->counters().get_counters_value(this, _id(tokens[0]), delims));
+			}
 		}
 		break;
 	// url
@@ -2,10 +2,20 @@
 #include "flex_item.h"
 #include "flex_line.h"
 #include "types.h"
+#include "document.h"
 
 void litehtml::flex_item::init(const litehtml::containing_block_context &self_size,
 							   litehtml::formatting_context *fmt_ctx, flex_align_items align_items)
 {
+	// The item can be laid out several times, reset the state of the previous layout
+	max_size.reset(0);
+	auto_margin_main_start.reset(0);
+	auto_margin_main_end.reset(0);
+	auto_margin_cross_start = false;
+	auto_margin_cross_end = false;
+	clamp_state = flex_clamp_state_unclamped;
+	validate_cache(self_size);
+
 	grow = (int) std::nearbyint(el->css().get_flex_grow() * 1000.0);
 	// Negative numbers are invalid.
 	// https://www.w3.org/TR/css-flexbox-1/#valdef-flex-grow-number
@@ -43,6 +53,19 @@ void litehtml::flex_item::init(const litehtml::containing_block_context &self_si
 	frozen = false;
 }
 
+void litehtml::flex_item::validate_cache(const litehtml::containing_block_context &self_size)
+{
+	int generation = el->src_el()->get_document()->styles_generation();
+	if(generation != cache_generation || self_size.render_width != cache_width || self_size.height != cache_height)
+	{
+		cache_generation = generation;
+		cache_width = self_size.render_width;
+		cache_height = self_size.height;
+		cached_min_content_size.reset(0);
+		cached_content_base_size.reset(0);
+	}
+}
+
 void litehtml::flex_item::place(flex_line &ln, pixel_t main_pos,
 								const containing_block_context &self_size,
 								formatting_context *fmt_ctx)
@@ -137,13 +160,16 @@ void litehtml::flex_item_row_direction::direction_specific_init(const litehtml::
 	{
 		auto_margin_cross_end = true;
 	}
-	def_value<pixel_t> content_size(0);
+	def_value<pixel_t>& content_size = cached_min_content_size;
 	if (el->css().get_min_width().is_predefined())
 	{
-		min_size = el->render(0, 0,
-							  self_size.new_width(el->content_offset_width(),
-												  containing_block_context::size_mode_content), fmt_ctx);
-		content_size = min_size;
+		if(content_size.is_default())
+		{
+			content_size = el->render(0, 0,
+									  self_size.new_width(el->content_offset_width(),
+														  containing_block_context::size_mode_content), fmt_ctx);
+		}
+		min_size = content_size;
 	} else
 	{
 		min_size = el->css().get_min_width().calc_percent(self_size.render_width) +
@@ -183,10 +209,14 @@ void litehtml::flex_item_row_direction::direction_specific_init(const litehtml::
 				break;
 			case flex_basis_fit_content:
 			case flex_basis_content:
-				base_size = el->render(0, 0, self_size.new_width(self_size.render_width + el->content_offset_width(),
-																 containing_block_context::size_mode_content |
-																 containing_block_context::size_mode_exact_width),
-									   fmt_ctx);
+				if(cached_content_base_size.is_default())
+				{
+					cached_content_base_size = el->render(0, 0, self_size.new_width(self_size.render_width + el->content_offset_width(),
+																					containing_block_context::size_mode_content |
+																					containing_block_context::size_mode_exact_width),
+														  fmt_ctx);
+				}
+				base_size = cached_content_base_size;
 				break;
 			case flex_basis_min_content:
 				if(content_size.is_default())
@@ -199,8 +229,12 @@ void litehtml::flex_item_row_direction::direction_specific_init(const litehtml::
 				base_size = content_size;
 				break;
 			case flex_basis_max_content:
-				el->render(0, 0, self_size, fmt_ctx);
-				base_size = el->width();
+				if(cached_content_base_size.is_default())
+				{
+					el->render(0, 0, self_size, fmt_ctx);
+					cached_content_base_size = el->width();
+				}
+				base_size = cached_content_base_size;
 				break;
 			default:
 				base_size = 0;
@@ -268,7 +302,9 @@ void litehtml::flex_item_row_direction::align_stretch(flex_line &ln, const conta
 													  formatting_context *fmt_ctx)
 {
 	set_cross_position(ln.cross_start);
-	if (el->css().get_height().is_predefined())
+	// The item is already rendered with its used main size by flex_line::init, so it must be rendered again
+	// only if the line is taller than the item
+	if (el->css().get_height().is_predefined() && el->height() != ln.cross_size)
 	{
 		el->render(el->left(), el->top(), self_size.new_width_height(
 				el->pos().width + el->box_sizing_width(),
@@ -326,8 +362,12 @@ void litehtml::flex_item_column_direction::direction_specific_init(const litehtm
 	}
 	if (el->css().get_min_height().is_predefined())
 	{
-		el->render(0, 0, self_size.new_width(self_size.render_width, containing_block_context::size_mode_content), fmt_ctx);
-		min_size = el->height();
+		if(cached_min_content_size.is_default())
+		{
+			el->render(0, 0, self_size.new_width(self_size.render_width, containing_block_context::size_mode_content), fmt_ctx);
+			cached_min_content_size = el->height();
+		}
+		min_size = cached_min_content_size;
 	} else
 	{
 		min_size = el->css().get_min_height().calc_percent(self_size.height) +
@@ -366,8 +406,12 @@ void litehtml::flex_item_column_direction::direction_specific_init(const litehtm
 				break;
 			case flex_basis_max_content:
 			case flex_basis_fit_content:
-				el->render(0, 0, self_size, fmt_ctx);
-				base_size = el->height();
+				if(cached_content_base_size.is_default())
+				{
+					el->render(0, 0, self_size, fmt_ctx);
+					cached_content_base_size = el->height();
+				}
+				base_size = cached_content_base_size;
 				break;
 			case flex_basis_min_content:
 				base_size = min_size;
@@ -2,6 +2,107 @@
 #include "types.h"
 #include "formatting_context.h"
 
+// Refreshes the leaves of the floats [from, max(old_size, size)) and their ancestors
+void litehtml::floats_index::update_tree(size_t from, size_t old_size)
+{
+	size_t leaves = 1;
+	while(leaves < m_boxes.size())
+	{
+		leaves *= 2;
+	}
+	size_t to = std::max(old_size, m_boxes.size());
+	if(leaves != m_leaves)
+	{
+		m_leaves = leaves;
+		m_tree.assign(leaves * 2, std::numeric_limits<pixel_t>::lowest());
+		from = 0;
+		to = m_boxes.size();
+	}
+	if(from >= to)
+	{
+		return;
+	}
+	for(size_t i = from; i < to; i++)
+	{
+		m_tree[m_leaves + i] = i < m_boxes.size() ? m_boxes[i].pos.bottom() : std::numeric_limits<pixel_t>::lowest();
+	}
+	for(size_t lo = (m_leaves + from) / 2, hi = (m_leaves + to - 1) / 2; lo > 0; lo /= 2, hi /= 2)
+	{
+		for(size_t node = lo; node <= hi; node++)
+		{
+			m_tree[node] = std::max(m_tree[node * 2], m_tree[node * 2 + 1]);
+		}
+	}
+}
+
+void litehtml::floats_index::update_clear_tops()
+{
+	m_clear_left_top	= std::numeric_limits<pixel_t>::lowest();
+	m_clear_right_top	= std::numeric_limits<pixel_t>::lowest();
+	for(const auto& fb : m_boxes)
+	{
+		if(fb.clear_floats == clear_left || fb.clear_floats == clear_both)
+		{
+			m_clear_left_top = std::max(m_clear_left_top, fb.pos.top());
+		}
+		if(fb.clear_floats == clear_right || fb.clear_floats == clear_both)
+		{
+			m_clear_right_top = std::max(m_clear_right_top, fb.pos.top());
+		}
+	}
+}
+
+void litehtml::floats_index::add(floated_box&& fb)
+{
+	if(fb.clear_floats == clear_left || fb.clear_floats == clear_both)
+	{
+		m_clear_left_top = std::max(m_clear_left_top, fb.pos.top());
+	}
+	if(fb.clear_floats == clear_right || fb.clear_floats == clear_both)
+	{
+		m_clear_right_top = std::max(m_clear_right_top, fb.pos.top());
+	}
+	// Floats are usually placed top to bottom, so this is almost always an append
+	size_t idx = upper_bound_top(fb.pos.top());
+	m_boxes.insert(m_boxes.begin() + (std::ptrdiff_t) idx, std::move(fb));
+	update_tree(idx, m_boxes.size() - 1);
+}
+
+bool litehtml::floats_index::remove_context(int context)
+{
+	auto first = std::find_if(m_boxes.begin(), m_boxes.end(), [context](const floated_box& fb) { return fb.context >= context; });
+	if(first == m_boxes.end())
+	{
+		return false;
+	}
+	size_t idx = first - m_boxes.begin();
+	size_t old_size = m_boxes.size();
+	m_boxes.erase(std::remove_if(first, m_boxes.end(), [context](const floated_box& fb) { return fb.context >= context; }), m_boxes.end());
+	update_tree(idx, old_size);
+	update_clear_tops();
+	return true;
+}
+
+bool litehtml::floats_index::shift_descendants(pixel_t dy, const std::shared_ptr<render_item>& parent)
+{
+	bool shifted = false;
+	for(auto& fb : m_boxes)
+	{
+		if(fb.el->src_el()->is_ancestor(parent->src_el()))
+		{
+			shifted		= true;
+			fb.pos.y	+= dy;
+		}
+	}
+	if(shifted)
+	{
+		std::stable_sort(m_boxes.begin(), m_boxes.end(), [](const floated_box& a, const floated_box& b) { return a.pos.top() < b.pos.top(); });
+		update_tree(0, m_boxes.size());
+		update_clear_tops();
+	}
+	return shifted;
+}
+
 void litehtml::formatting_context::add_float(const std::shared_ptr<render_item> &el, pixel_t min_width, int context)
 {
 	floated_box fb;
@@ -17,49 +118,11 @@ void litehtml::formatting_context::add_float(const std::shared_ptr<render_item>
 
 	if(fb.float_side == float_left)
 	{
-		if(m_floats_left.empty())
-		{
-			m_floats_left.push_back(fb);
-		} else
-		{
-			bool inserted = false;
-			for(auto i = m_floats_left.begin(); i != m_floats_left.end(); i++)
-			{
-				if(fb.pos.right() > i->pos.right())
-				{
-					m_floats_left.insert(i, std::move(fb));
-					inserted = true;
-					break;
-				}
-			}
-			if(!inserted)
-			{
-				m_floats_left.push_back(std::move(fb));
-			}
-		}
+		m_floats_left.add(std::move(fb));
 		m_cache_line_left.invalidate();
 	} else if(fb.float_side == float_right)
 	{
-		if(m_floats_right.empty())
-		{
-			m_floats_right.push_back(std::move(fb));
-		} else
-		{
-			bool inserted = false;
-			for(auto i = m_floats_right.begin(); i != m_floats_right.end(); i++)
-			{
-				if(fb.pos.left() < i->pos.left())
-				{
-					m_floats_right.insert(i, std::move(fb));
-					inserted = true;
-					break;
-				}
-			}
-			if(!inserted)
-			{
-				m_floats_right.push_back(fb);
-			}
-		}
+		m_floats_right.add(std::move(fb));
 		m_cache_line_right.invalidate();
 	}
 }
@@ -68,70 +131,19 @@ litehtml::pixel_t litehtml::formatting_context::get_floats_height(element_float
 {
 	pixel_t h = m_current_top;
 
-	for(const auto& fb : m_floats_left)
+	for(const auto* floats : {&m_floats_left, &m_floats_right})
 	{
-		bool process = false;
-		switch(el_float)
+		if(floats->empty())
 		{
-			case float_none:
-				process = true;
-				break;
-			case float_left:
-				if (fb.clear_floats == clear_left || fb.clear_floats == clear_both)
-				{
-					process = true;
-				}
-				break;
-			case float_right:
-				if (fb.clear_floats == clear_right || fb.clear_floats == clear_both)
-				{
-					process = true;
-				}
-				break;
+			continue;
 		}
-		if(process)
-		{
-			if(el_float == float_none)
-			{
-				h = std::max(h, fb.pos.bottom());
-			} else
-			{
-				h = std::max(h, fb.pos.top());
-			}
-		}
-	}
-
-
-	for(const auto& fb : m_floats_right)
-	{
-		bool process = false;
-		switch(el_float)
+		if(el_float == float_none)
 		{
-			case float_none:
-				process = true;
-				break;
-			case float_left:
-				if (fb.clear_floats == clear_left || fb.clear_floats == clear_both)
-				{
-					process = true;
-				}
-				break;
-			case float_right:
-				if (fb.clear_floats == clear_right || fb.clear_floats == clear_both)
-				{
-					process = true;
-				}
-				break;
-		}
-		if(process)
+			h = std::max(h, floats->max_bottom());
+		} else
 		{
-			if(el_float == float_none)
-			{
-				h = std::max(h, fb.pos.bottom());
-			} else
-			{
-				h = std::max(h, fb.pos.top());
-			}
+			// A float may not be placed above an earlier float that clears floats of its side
+			h = std::max(h, floats->max_clearing_top(el_float));
 		}
 	}
 
@@ -143,10 +155,7 @@ litehtml::pixel_t litehtml::formatting_context::get_left_floats_height() const
 	pixel_t h = 0;
 	if(!m_floats_left.empty())
 	{
-		for (const auto& fb : m_floats_left)
-		{
-			h = std::max(h, fb.pos.bottom());
-		}
+		h = std::max(h, m_floats_left.max_bottom());
 	}
 	return h - m_current_top;
 }
@@ -156,10 +165,7 @@ litehtml::pixel_t litehtml::formatting_context::get_right_floats_height() const
 	pixel_t h = 0;
 	if(!m_floats_right.empty())
 	{
-		for(const auto& fb : m_floats_right)
-		{
-			h = std::max(h, fb.pos.bottom());
-		}
+		h = std::max(h, m_floats_right.max_bottom());
 	}
 	return h - m_current_top;
 }
@@ -178,17 +184,10 @@ litehtml::pixel_t litehtml::formatting_context::get_line_left(pixel_t y )
 	}
 
 	pixel_t w = 0;
-	for(const auto& fb : m_floats_left)
-	{
-		if (y >= fb.pos.top() && y < fb.pos.bottom())
+	m_floats_left.for_each_at(y, [&w](const floated_box& fb)
 		{
 			w = std::max(w, fb.pos.right());
-			if (w < fb.pos.right())
-			{
-				break;
-			}
-		}
-	}
+		});
 	m_cache_line_left.set_value(y, w);
 	w -= m_current_left;
 	if(w < 0) return 0;
@@ -214,18 +213,11 @@ litehtml::pixel_t litehtml::formatting_context::get_line_right(pixel_t y, pixel_
 
 	pixel_t w = def_right;
 	m_cache_line_right.is_default = true;
-	for(const auto& fb : m_floats_right)
-	{
-		if(y >= fb.pos.top() && y < fb.pos.bottom())
+	m_floats_right.for_each_at(y, [this, &w](const floated_box& fb)
 		{
 			w = std::min(w, fb.pos.left());
 			m_cache_line_right.is_default = false;
-			if(w > fb.pos.left())
-			{
-				break;
-			}
-		}
-	}
+		});
 	m_cache_line_right.set_value(y, w);
 	w -= m_current_left;
 	if(w < 0) return 0;
@@ -235,30 +227,13 @@ litehtml::pixel_t litehtml::formatting_context::get_line_right(pixel_t y, pixel_
 
 void litehtml::formatting_context::clear_floats(int context)
 {
-	auto iter = m_floats_left.begin();
-	while(iter != m_floats_left.end())
+	if(m_floats_left.remove_context(context))
 	{
-		if(iter->context >= context)
-		{
-			iter = m_floats_left.erase(iter);
-			m_cache_line_left.invalidate();
-		} else
-		{
-			iter++;
-		}
+		m_cache_line_left.invalidate();
 	}
-
-	iter = m_floats_right.begin();
-	while(iter != m_floats_right.end())
+	if(m_floats_right.remove_context(context))
 	{
-		if(iter->context >= context)
-		{
-			iter = m_floats_right.erase(iter);
-			m_cache_line_right.invalidate();
-		} else
-		{
-			iter++;
-		}
+		m_cache_line_right.invalidate();
 	}
 }
 
@@ -315,45 +290,24 @@ litehtml::pixel_t litehtml::formatting_context::find_next_line_top(pixel_t top,
 	pixel_t new_top = top;
 	pixel_vector points;
 
-	for(const auto& fb : m_floats_left)
-	{
-		if(fb.pos.top() >= top)
+	auto add_points = [&points, top](const floated_box& fb)
 		{
-			if(find(points.begin(), points.end(), fb.pos.top()) == points.end())
+			if(fb.pos.top() >= top)
 			{
 				points.push_back(fb.pos.top());
 			}
-		}
-		if (fb.pos.bottom() >= top)
-		{
-			if (find(points.begin(), points.end(), fb.pos.bottom()) == points.end())
+			if(fb.pos.bottom() >= top)
 			{
 				points.push_back(fb.pos.bottom());
 			}
-		}
-	}
-
-	for (const auto& fb : m_floats_right)
-	{
-		if (fb.pos.top() >= top)
-		{
-			if (find(points.begin(), points.end(), fb.pos.top()) == points.end())
-			{
-				points.push_back(fb.pos.top());
-			}
-		}
-		if (fb.pos.bottom() >= top)
-		{
-			if (find(points.begin(), points.end(), fb.pos.bottom()) == points.end())
-			{
-				points.push_back(fb.pos.bottom());
-			}
-		}
-	}
+		};
+	m_floats_left.for_each_reaching(top, add_points);
+	m_floats_right.for_each_reaching(top, add_points);
 
 	if(!points.empty())
 	{
 		sort(points.begin(), points.end(), std::less<pixel_t>( ));
+		points.erase(std::unique(points.begin(), points.end()), points.end());
 		new_top = points.back();
 
 		for(auto pt : points)
@@ -374,29 +328,11 @@ litehtml::pixel_t litehtml::formatting_context::find_next_line_top(pixel_t top,
 
 void litehtml::formatting_context::update_floats(pixel_t dy, const std::shared_ptr<render_item> &parent)
 {
-	bool reset_cache = false;
-	for(auto fb = m_floats_left.rbegin(); fb != m_floats_left.rend(); fb++)
-	{
-		if(fb->el->src_el()->is_ancestor(parent->src_el()))
-		{
-			reset_cache	= true;
-			fb->pos.y	+= dy;
-		}
-	}
-	if(reset_cache)
+	if(m_floats_left.shift_descendants(dy, parent))
 	{
 		m_cache_line_left.invalidate();
 	}
-	reset_cache = false;
-	for(auto fb = m_floats_right.rbegin(); fb != m_floats_right.rend(); fb++)
-	{
-		if(fb->el->src_el()->is_ancestor(parent->src_el()))
-		{
-			reset_cache	= true;
-			fb->pos.y	+= dy;
-		}
-	}
-	if(reset_cache)
+	if(m_floats_right.shift_descendants(dy, parent))
 	{
 		m_cache_line_right.invalidate();
 	}
@@ -414,13 +350,13 @@ litehtml::pixel_t litehtml::formatting_context::find_min_left(pixel_t y, int con
 {
 	y += m_current_top;
 	pixel_t min_left = m_current_left;
-	for(const auto& fb : m_floats_left)
-	{
-		if (y >= fb.pos.top() && y < fb.pos.bottom() && fb.context == context_idx)
+	m_floats_left.for_each_at(y, [&min_left, context_idx](const floated_box& fb)
 		{
-			min_left += fb.min_width;
-		}
-	}
+			if(fb.context == context_idx)
+			{
+				min_left += fb.min_width;
+			}
+		});
 	if(min_left < m_current_left) return 0;
 	return min_left - m_current_left;
 }
@@ -429,13 +365,13 @@ litehtml::pixel_t litehtml::formatting_context::find_min_right(pixel_t y, pixel_
 {
 	y += m_current_top;
 	pixel_t min_right = right + m_current_left;
-	for(const auto& fb : m_floats_right)
-	{
-		if (y >= fb.pos.top() && y < fb.pos.bottom() && fb.context == context_idx)
+	m_floats_right.for_each_at(y, [&min_right, context_idx](const floated_box& fb)
 		{
-			min_right -= fb.min_width;
-		}
-	}
+			if(fb.context == context_idx)
+			{
+				min_right -= fb.min_width;
+			}
+		});
 	if(min_right < m_current_left) return 0;
 	return min_right - m_current_left;
 }
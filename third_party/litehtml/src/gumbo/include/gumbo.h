@@ -597,6 +597,14 @@ typedef struct GumboInternalOptions {
    */
   int max_errors;
 
+  /**
+   * The maximum number of open elements.  Deeper nesting stops the parse and
+   * sets the output status to GUMBO_STATUS_TREE_TOO_DEEP; the partial tree is
+   * still returned.  Set to -1 to disable the limit.
+   * Default: -1
+   */
+  int max_tree_depth;
+
   /**
    * The fragment context for parsing:
    * https://html.spec.whatwg.org/multipage/syntax.html#parsing-html-fragments
@@ -624,6 +632,14 @@ typedef struct GumboInternalOptions {
 /** Default options struct; use this with gumbo_parse_with_options. */
 extern const GumboOptions kGumboDefaultOptions;
 
+/** Why the parse ended. */
+typedef enum {
+  /** The whole input was parsed. */
+  GUMBO_STATUS_OK,
+  /** The parse stopped when nesting exceeded GumboOptions.max_tree_depth. */
+  GUMBO_STATUS_TREE_TOO_DEEP,
+} GumboOutputStatus;
+
 /** The output struct containing the results of the parse. */
 typedef struct GumboInternalOutput {
   /**
@@ -646,6 +662,9 @@ typedef struct GumboInternalOutput {
    * reported so we can work out something appropriate for your use-case.
    */
   GumboVector /* GumboError */ errors;
+
+  /** Whether the whole input was parsed. */
+  GumboOutputStatus status;
 } GumboOutput;
 
 /**
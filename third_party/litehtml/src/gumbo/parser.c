@@ -60,7 +60,7 @@ static void* malloc_wrapper(void* unused, size_t size) { return malloc(size); }
 static void free_wrapper(void* unused, void* ptr) { free(ptr); }
 
 const GumboOptions kGumboDefaultOptions = {&malloc_wrapper, &free_wrapper, NULL,
-    8, false, -1, GUMBO_TAG_LAST, GUMBO_NAMESPACE_HTML};
+    8, false, -1, -1, GUMBO_TAG_LAST, GUMBO_NAMESPACE_HTML};
 
 static const GumboStringPiece kDoctypeHtml = GUMBO_STRING("html");
 static const GumboStringPiece kPublicIdHtml4_0 =
@@ -468,6 +468,7 @@ static void output_init(GumboParser* parser) {
   GumboOutput* output = gumbo_parser_allocate(parser, sizeof(GumboOutput));
   output->root = NULL;
   output->document = new_document_node(parser);
+  output->status = GUMBO_STATUS_OK;
   parser->_output = output;
   gumbo_init_errors(parser);
 }
@@ -4069,6 +4070,13 @@ GumboOutput* gumbo_parse_with_options(
     ++loop_count;
     assert(loop_count < 1000000000);
 
+    // Stop between tokens, once a reprocessed token has been consumed.
+    if (options->max_tree_depth >= 0 && !state->_reprocess_current_token &&
+        state->_open_elements.length > (unsigned int) options->max_tree_depth) {
+      parser._output->status = GUMBO_STATUS_TREE_TOO_DEEP;
+      break;
+    }
+
   } while ((token.type != GUMBO_TOKEN_EOF || state->_reprocess_current_token) &&
            !(options->stop_on_first_error && has_error));
 
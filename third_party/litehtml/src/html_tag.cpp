@@ -351,6 +351,12 @@ void litehtml::html_tag::compute_styles(bool recursive)
 
 	m_style.subst_vars(this);
 
+	// Counters are updated in the same document-order pass, so generated
+	// content sees the counter values of its position in the document
+	counter_state& counters = doc->counters();
+	counters.enter(this, m_style);
+	generate_content();
+
 	m_css.compute(this, doc);
 
 	if (recursive)
@@ -360,6 +366,7 @@ void litehtml::html_tag::compute_styles(bool recursive)
 			el->compute_styles();
 		}
 	}
+	counters.leave(this);
 }
 
 bool litehtml::html_tag::is_white_space() const
@@ -1092,7 +1099,7 @@ void litehtml::html_tag::draw_list_marker( uint_ptr hdc, const position& pos, co
 		lm.pos.y = li_baseline - css().get_font_metrics().ascent;
 		lm.pos.height = css().get_font_metrics().height;
 
-		lm.index = atoi(get_attr("list_index", "0"));
+		lm.index = get_document()->get_list_index(this);
 	}
 	else
 	{
@@ -1116,13 +1123,19 @@ void litehtml::html_tag::draw_list_marker( uint_ptr hdc, const position& pos, co
 		lm.pos.height	= img_size.height;
 	}
 
+	const list_marker_text* marker_text = nullptr;
+	if (m_css.get_list_style_type() >= list_style_type_armenian)
+	{
+		marker_text = &get_document()->get_list_marker_text(lm.marker_type, lm.index, lm.font);
+	}
+
 	if (m_css.get_list_style_position() == list_style_position_outside)
 	{
-		if (m_css.get_list_style_type() >= list_style_type_armenian)
+		if (marker_text)
 		{
 			if(lm.font)
 			{
-				auto tw_space = get_document()->container()->text_width(" ", lm.font);
+				auto tw_space = marker_text->space_width;
 				lm.pos.x = pos.x - tw_space * 2;
 				lm.pos.width = tw_space;
 			} else
@@ -1136,10 +1149,9 @@ void litehtml::html_tag::draw_list_marker( uint_ptr hdc, const position& pos, co
 		}
 	}
 
-	if (m_css.get_list_style_type() >= list_style_type_armenian)
+	if (marker_text)
 	{
-		auto marker_text = get_list_marker_text(lm.index);
-		if (marker_text.empty())
+		if (marker_text->text.empty())
 		{
 			get_document()->container()->draw_list_marker(hdc, lm);
 		}
@@ -1147,13 +1159,12 @@ void litehtml::html_tag::draw_list_marker( uint_ptr hdc, const position& pos, co
 		{
 			if(lm.font)
 			{
-				marker_text += ".";
-				auto tw = get_document()->container()->text_width(marker_text.c_str(), lm.font);
+				auto tw = marker_text->text_width;
 				auto text_pos = lm.pos;
 				text_pos.move_to(text_pos.right() - tw, text_pos.y);
 				text_pos.width = tw;
 				text_pos.round();
-				get_document()->container()->draw_text(hdc, marker_text.c_str(), lm.font, lm.color, text_pos);
+				get_document()->container()->draw_text(hdc, marker_text->text.c_str(), lm.font, lm.color, text_pos);
 			}
 		}
 	}
@@ -1163,9 +1174,9 @@ void litehtml::html_tag::draw_list_marker( uint_ptr hdc, const position& pos, co
 	}
 }
 
-litehtml::string litehtml::html_tag::get_list_marker_text(int index)
+litehtml::string litehtml::html_tag::get_list_marker_text(list_style_type type, int index)
 {
-	switch (m_css.get_list_style_type())
+	switch (type)
 	{
 	case litehtml::list_style_type_decimal:
 		return std::to_string(index);
@@ -1398,32 +1409,9 @@ litehtml::element::ptr litehtml::html_tag::get_element_after(const style& style,
 }
 
 
-void litehtml::html_tag::handle_counter_properties()
-{
-	const auto& reset_property = m_style.get_property(_counter_reset_);
-	if (reset_property.is<string_vector>()) {
-		auto reset_function = [&](const string_id&name_id, const int value) {
-			reset_counter(name_id, value);
-		};
-		parse_counter_tokens(reset_property.get<string_vector>(), 0, reset_function);
-		return;
-	}
-
-	const auto& inc_property = m_style.get_property(_counter_increment_);
-	if (inc_property.is<string_vector>()) {
-		auto inc_function = [&](const string_id&name_id, const int value) {
-			increment_counter(name_id, value);
-		};
-		parse_counter_tokens(inc_property.get<string_vector>(), 1, inc_function);
-		return;
-	}
-}
-
-
 void litehtml::html_tag::add_style(const style& style)
 {
 	m_style.combine(style);
-	handle_counter_properties();
 }
 
 void litehtml::html_tag::refresh_styles()
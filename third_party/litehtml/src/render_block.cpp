@@ -56,23 +56,10 @@ std::shared_ptr<litehtml::render_item> litehtml::render_item_block::init()
 {
     std::shared_ptr<render_item> ret;
 
-    // Initialize indexes for list items
+    // Number the list items while the render tree is built
     if(src_el()->css().get_display() == display_list_item && src_el()->css().get_list_style_type() >= list_style_type_armenian)
     {
-        if (auto p = src_el()->parent())
-        {
-            int val = atoi(p->get_attr("start", "1"));
-			for(const auto &child : p->children())
-            {
-                if (child == src_el())
-                {
-                    src_el()->set_attr("list_index", std::to_string(val).c_str());
-                    break;
-                }
-                else if (child->css().get_display() == display_list_item)
-                    val++;
-            }
-        }
+        src_el()->get_document()->get_list_index(src_el().get());
     }
     // Split inline blocks with box blocks inside
     auto iter = m_children.begin();
@@ -1,7 +1,14 @@
 #include "render_block_context.h"
+#include "render_inline_context.h"
 #include "document.h"
 #include "types.h"
 
+namespace
+{
+	// Set while a thread renders a subtree for render_item_block_context::prerender_independent()
+	thread_local bool t_in_parallel_render = false;
+}
+
 litehtml::pixel_t litehtml::render_item_block_context::_render_content(pixel_t /*x*/, pixel_t /*y*/, bool second_pass, const containing_block_context &self_size, formatting_context* fmt_ctx)
 {
     element_position el_position;
@@ -11,8 +18,34 @@ litehtml::pixel_t litehtml::render_item_block_context::_render_content(pixel_t /
     pixel_t last_margin = 0;
 	std::shared_ptr<render_item> last_margin_el;
     bool is_first = true;
+
+	document::ptr doc = src_el()->get_document();
+	bool limited = doc->has_layout_limit();
+	pixel_t content_top = limited ? get_placement().y : 0;
+	bool cut = false;
+
+	auto prerendered = prerender_independent(self_size);
+	auto next_prerendered = prerendered.begin();
+
     for (const auto& el : m_children)
     {
+		// Children after the document layout limit are skipped without being rendered
+		if (limited)
+		{
+			if (!cut && doc->layout_limit_reached(content_top + child_top))
+			{
+				cut = true;
+				doc->set_layout_truncated();
+				auto last_lines = std::dynamic_pointer_cast<render_item_inline_context>(doc->last_lines_owner());
+				if (last_lines && (doc->get_layout_limit().ellipsis || last_lines->css().get_text_overflow() == text_overflow_ellipsis))
+				{
+					last_lines->place_ellipsis();
+				}
+			}
+			el->skip(cut);
+			if (cut) continue;
+		}
+
         // we don't need to process absolute and fixed positioned element on the second pass
         if (second_pass)
         {
@@ -92,7 +125,23 @@ litehtml::pixel_t litehtml::render_item_block_context::_render_content(pixel_t /
 					}
 				}
 
-                pixel_t rw = el->render(child_x, child_top, self_size.new_width(child_width), fmt_ctx);
+				const std::pair<render_item*, pixel_t>* prerendered_el = nullptr;
+				if(next_prerendered != prerendered.end() && next_prerendered->first == el.get())
+				{
+					prerendered_el = &*next_prerendered++;
+				}
+
+				pixel_t rw;
+				if(prerendered_el && child_x == 0 && child_width == self_size.render_width)
+				{
+					// Laid out by prerender_independent(), only the position depends on the previous siblings
+					rw = prerendered_el->second;
+					el->pos().x = child_x + el->content_offset_left();
+					el->pos().y = child_top + el->content_offset_top();
+				} else
+				{
+					rw = el->render(child_x, child_top, self_size.new_width(child_width), fmt_ctx);
+				}
 				// Render table with "width: auto" into returned width
 				if(el->src_el()->css().get_display() == display_table && rw < child_width && el->src_el()->css().get_width().is_predefined())
 				{
@@ -172,6 +221,50 @@ litehtml::pixel_t litehtml::render_item_block_context::_render_content(pixel_t /
     return ret_width;
 }
 
+std::vector<std::pair<litehtml::render_item*, litehtml::pixel_t>> litehtml::render_item_block_context::prerender_independent(const containing_block_context &self_size)
+{
+	std::vector<std::pair<render_item*, pixel_t>> ret;
+
+	document::ptr doc = src_el()->get_document();
+	const parallel_runner& runner = doc->get_parallel_runner();
+	// Nested contexts are rendered by the thread that owns the subtree
+	if(!runner || t_in_parallel_render || doc->has_layout_limit())
+	{
+		return ret;
+	}
+
+	// In-flow children with their own formatting context don't see this context's floats,
+	// so their layout depends on the available width only
+	for (const auto& el : m_children)
+	{
+		const css_properties& el_css = el->src_el()->css();
+		if(el_css.get_display() == display_none ||
+		   el_css.get_display() == display_table ||
+		   el_css.get_float() != float_none ||
+		   (el_css.get_position() != element_position_static && el_css.get_position() != element_position_relative) ||
+		   el->src_el()->is_replaced() ||
+		   !el->src_el()->is_block_formatting_context())
+		{
+			continue;
+		}
+		ret.emplace_back(el.get(), 0);
+	}
+	if(ret.size() < 2)
+	{
+		ret.clear();
+		return ret;
+	}
+
+	containing_block_context child_size = self_size.new_width(self_size.render_width);
+	runner((int) ret.size(), [&ret, &child_size](int i)
+	{
+		t_in_parallel_render = true;
+		ret[i].second = ret[i].first->render(0, 0, child_size, nullptr);
+		t_in_parallel_render = false;
+	});
+	return ret;
+}
+
 litehtml::pixel_t litehtml::render_item_block_context::get_first_baseline()
 {
 	if(m_children.empty())
@@ -78,7 +78,7 @@ litehtml::pixel_t litehtml::render_item_flex::_render_content(pixel_t x, pixel_t
 		sum_main_size = std::max(sum_main_size, ln.main_size);
 		if(reverse)
 		{
-			ln.items.reverse();
+			std::reverse(ln.items.begin(), ln.items.end());
 		}
 	}
 
@@ -153,7 +153,7 @@ litehtml::pixel_t litehtml::render_item_flex::_render_content(pixel_t x, pixel_t
 	/// Reverse lines for flex-wrap: wrap-reverse
 	if(css().get_flex_wrap() == flex_wrap_wrap_reverse)
 	{
-		m_lines.reverse();
+		std::reverse(m_lines.begin(), m_lines.end());
 	}
 
 	/////////////////////////////////////////////////////////////////
@@ -230,7 +230,7 @@ litehtml::pixel_t litehtml::render_item_flex::_render_content(pixel_t x, pixel_t
 	return ret_width;
 }
 
-std::list<litehtml::flex_line> litehtml::render_item_flex::get_lines(const litehtml::containing_block_context &self_size,
+std::vector<litehtml::flex_line> litehtml::render_item_flex::get_lines(const litehtml::containing_block_context &self_size,
 																	 litehtml::formatting_context *fmt_ctx,
 																	 bool is_row_direction, pixel_t container_main_size,
 																	 bool single_line)
@@ -246,23 +246,34 @@ std::list<litehtml::flex_line> litehtml::render_item_flex::get_lines(const liteh
 		reverse_main = css().get_flex_direction() == flex_direction_column_reverse;
 	}
 
-	std::list<flex_line> lines;
+	std::vector<flex_line> lines;
 	flex_line line(reverse_main, reverse_cross);
-	std::list<std::shared_ptr<flex_item>> items;
 	int src_order = 0;
 	bool sort_required = false;
 	def_value<int> prev_order(0);
 
-	for( auto& el : m_children)
+	// Create the flex items on the first layout. The flex direction can be changed with the styles only.
+	if(m_items.size() != m_children.size() || m_items_row_direction != is_row_direction)
 	{
-		std::shared_ptr<flex_item> item = nullptr;
-		if(is_row_direction)
-		{
-			item = std::make_shared<flex_item_row_direction>(el);
-		} else
+		m_items_row_direction = is_row_direction;
+		m_items.clear();
+		m_items.reserve(m_children.size());
+		for( auto& el : m_children)
 		{
-			item = std::make_shared<flex_item_column_direction>(el);
+			if(is_row_direction)
+			{
+				m_items.push_back(std::make_shared<flex_item_row_direction>(el));
+			} else
+			{
+				m_items.push_back(std::make_shared<flex_item_column_direction>(el));
+			}
 		}
+	}
+
+	std::vector<std::shared_ptr<flex_item>> items;
+	items.reserve(m_items.size());
+	for( auto& item : m_items)
+	{
 		item->init(self_size, fmt_ctx, css().get_flex_align_items());
 		item->src_order = src_order++;
 
@@ -279,7 +290,7 @@ std::list<litehtml::flex_line> litehtml::render_item_flex::get_lines(const liteh
 
 	if(sort_required)
 	{
-		items.sort([](const std::shared_ptr<flex_item>& item1, const std::shared_ptr<flex_item>& item2)
+		std::stable_sort(items.begin(), items.end(), [](const std::shared_ptr<flex_item>& item1, const std::shared_ptr<flex_item>& item2)
 					   {
 					   		if(item1->order < item2->order) return true;
 					   		if(item1->order == item2->order)
@@ -295,7 +306,7 @@ std::list<litehtml::flex_line> litehtml::render_item_flex::get_lines(const liteh
 	{
 		if(!line.items.empty() && !single_line && line.main_size + item->main_size > container_main_size)
 		{
-			lines.emplace_back(line);
+			lines.push_back(std::move(line));
 			line = flex_line(reverse_main, reverse_cross);
 		}
 		line.base_size += item->base_size;
@@ -307,7 +318,7 @@ std::list<litehtml::flex_line> litehtml::render_item_flex::get_lines(const liteh
 	// Add the last line to the lines list
 	if(!line.items.empty())
 	{
-		lines.emplace_back(line);
+		lines.push_back(std::move(line));
 	}
 	return lines;
 }
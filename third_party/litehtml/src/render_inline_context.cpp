@@ -1,12 +1,43 @@
 #include "render_inline_context.h"
 #include "document.h"
+#include "document_container.h"
 #include "iterators.h"
 #include "types.h"
 
+static const char* ellipsis_text = "\xE2\x80\xA6";	// U+2026 HORIZONTAL ELLIPSIS
+
 litehtml::pixel_t litehtml::render_item_inline_context::_render_content(pixel_t /*x*/, pixel_t /*y*/, bool /*second_pass*/, const containing_block_context &self_size, formatting_context* fmt_ctx)
 {
     m_line_boxes.clear();
 	m_max_line_width = 0;
+	m_clamped = false;
+	m_ellipsis = false;
+
+	m_max_lines = src_el()->css().get_max_lines() > 0 ? src_el()->css().get_max_lines() : -1;
+	m_max_bottom = -1;
+	m_limit_from_document = false;
+	document::ptr doc = src_el()->get_document();
+	if(doc->has_layout_limit())
+	{
+		// This context can be rendered several times in one pass; give back the lines of the previous render
+		if(m_limit_pass == doc->render_pass())
+		{
+			doc->use_lines(-m_limit_lines, nullptr);
+		}
+		m_limit_pass = doc->render_pass();
+		m_limit_lines = 0;
+
+		const layout_limit& limit = doc->get_layout_limit();
+		if(limit.max_lines > 0 && (m_max_lines < 0 || doc->lines_left() < m_max_lines))
+		{
+			m_max_lines = std::max(doc->lines_left(), 0);
+			m_limit_from_document = true;
+		}
+		if(limit.max_height > 0)
+		{
+			m_max_bottom = limit.max_height - get_placement().y;
+		}
+	}
 
     white_space ws = src_el()->css().get_white_space();
     bool skip_spaces = false;
@@ -70,6 +101,24 @@ litehtml::pixel_t litehtml::render_item_inline_context::_render_content(pixel_t
 
     finish_last_box(true, self_size);
 
+	if(m_clamped)
+	{
+		if(m_limit_from_document)
+		{
+			doc->set_layout_truncated();
+		}
+		if(src_el()->css().get_text_overflow() == text_overflow_ellipsis ||
+		   (m_limit_from_document && doc->get_layout_limit().ellipsis))
+		{
+			place_ellipsis();
+		}
+	}
+	if(m_limit_pass == doc->render_pass())
+	{
+		m_limit_lines = get_line_count();
+		doc->use_lines(m_limit_lines, shared_from_this());
+	}
+
     if (!m_line_boxes.empty())
     {
         if (collapse_top_margin())
@@ -244,6 +293,13 @@ void litehtml::render_item_inline_context::place_inline(std::unique_ptr<line_box
 {
     if(item->get_el()->src_el()->css().get_display() == display_none) return;
 
+	// Everything after the clamped line is skipped without being measured
+	if(m_clamped)
+	{
+		item->get_el()->skip(true);
+		return;
+	}
+
     if(item->get_el()->src_el()->is_float())
     {
         pixel_t line_top = 0;
@@ -297,6 +353,12 @@ void litehtml::render_item_inline_context::place_inline(std::unique_ptr<line_box
     }
     if(add_box)
     {
+		if(line_limit_reached())
+		{
+			m_clamped = true;
+			item->get_el()->skip(true);
+			return;
+		}
         new_box(item, line_ctx, self_size, fmt_ctx);
     } else if(!m_line_boxes.empty())
     {
@@ -407,3 +469,94 @@ litehtml::pixel_t litehtml::render_item_inline_context::get_last_baseline()
 	}
 	return bl;
 }
+
+int litehtml::render_item_inline_context::get_line_count() const
+{
+	int count = 0;
+	for(const auto& line : m_line_boxes)
+	{
+		if(!line->is_empty())
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+bool litehtml::render_item_inline_context::line_limit_reached()
+{
+	if(m_max_lines >= 0 && get_line_count() >= m_max_lines)
+	{
+		return true;
+	}
+	if(m_max_bottom >= 0)
+	{
+		pixel_t line_top = m_line_boxes.empty() ? 0 : m_line_boxes.back()->bottom();
+		if(line_top + css().line_height().computed_value > m_max_bottom)
+		{
+			// Only the document limit has a height
+			m_limit_from_document = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+void litehtml::render_item_inline_context::place_ellipsis()
+{
+	m_ellipsis = false;
+	if(m_line_boxes.empty())
+	{
+		return;
+	}
+	uint_ptr font = css().get_font();
+	if(!font)
+	{
+		return;
+	}
+	const auto& line = m_line_boxes.back();
+	document::ptr doc = src_el()->get_document();
+	pixel_t ellipsis_width = doc->container()->text_width(ellipsis_text, font);
+
+	// Hide the words the ellipsis would cover and the spaces before it
+	pixel_t x = line->left();
+	for(auto iter = line->items().rbegin(); iter != line->items().rend(); iter++)
+	{
+		const auto& item = *iter;
+		if(item->get_type() != line_box_item::type_text_part || item->get_el()->skip())
+		{
+			continue;
+		}
+		if(item->right() > line->line_right() - ellipsis_width || item->get_el()->src_el()->is_white_space())
+		{
+			item->get_el()->skip(true);
+			continue;
+		}
+		x = item->right();
+		break;
+	}
+
+	m_ellipsis = true;
+	m_ellipsis_pos.x = x;
+	// Same vertical placement as a text box of the block font on this line
+	const font_metrics& fm = css().get_font_metrics();
+	m_ellipsis_pos.y = line->bottom() - line->baseline() - (fm.height - fm.base_line());
+	m_ellipsis_pos.width = ellipsis_width;
+	m_ellipsis_pos.height = fm.height;
+}
+
+void litehtml::render_item_inline_context::draw_children(uint_ptr hdc, pixel_t x, pixel_t y, const position* clip, draw_flag flag, int zindex)
+{
+	render_item_block::draw_children(hdc, x, y, clip, flag, zindex);
+
+	if(m_ellipsis && flag == draw_inlines)
+	{
+		position pos = m_ellipsis_pos;
+		pos.x += m_pos.x + x - get_scroll_left();
+		pos.y += m_pos.y + y - get_scroll_top();
+		if(pos.does_intersect(clip))
+		{
+			src_el()->get_document()->container()->draw_text(hdc, ellipsis_text, css().get_font(), css().get_color(), pos);
+		}
+	}
+}
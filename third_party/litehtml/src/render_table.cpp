@@ -6,44 +6,42 @@
 litehtml::render_item_table::render_item_table(std::shared_ptr<element> _src_el) :
         render_item(std::move(_src_el)),
         m_border_spacing_x(0),
-        m_border_spacing_y(0)
+        m_border_spacing_y(0),
+        m_fixed_layout(false),
+        m_styles_generation(-1)
 {
 }
 
-litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, const containing_block_context &containing_block_size, formatting_context* fmt_ctx, bool /*second_pass*/)
+void litehtml::render_item_table::measure_cells(const containing_block_context& self_size, pixel_t table_width_spacing, formatting_context* fmt_ctx)
 {
-    if (!m_grid) return 0;
+    // Calculate the minimum content width (MCW) of each cell: the formatted content may span any number of lines but may not overflow the cell box.
+    // If the specified 'width' (W) of the cell is greater than MCW, W is the minimum cell width. A value of 'auto' means that MCW is the minimum
+    // cell width.
+    //
+    // Also, calculate the "maximum" cell width of each cell: formatting the content without breaking lines other than where explicit line breaks occur.
+    //
+    // The measured widths are cached in the cells and reused by the next layouts of the table with the same available
+    // width. The minimum content width is measured only when the column widths depend on it (see below).
 
-	containing_block_context self_size = calculate_containing_block_context(containing_block_size);
+    pixel_t avail_width = self_size.render_width - table_width_spacing;
+    bool min_widths_pending = false;
 
-    // Calculate table spacing
-    pixel_t table_width_spacing = 0;
-    if (src_el()->css().get_border_collapse() == border_collapse_separate)
+    int styles_generation = src_el()->get_document()->styles_generation();
+    if (m_styles_generation != styles_generation)
     {
-        table_width_spacing = m_border_spacing_x * (m_grid->cols_count() + 1);
-    }
-    else
-    {
-        table_width_spacing = 0;
-
-        if (m_grid->cols_count())
-        {
-            table_width_spacing -= std::min(border_left(), m_grid->column(0).border_left);
-            table_width_spacing -= std::min(border_right(), m_grid->column(m_grid->cols_count() - 1).border_right);
-        }
-
-        for (int col = 1; col < m_grid->cols_count(); col++)
+        // Styles were changed, so the cached widths are invalid
+        for (int row = 0; row < m_grid->rows_count(); row++)
         {
-            table_width_spacing -= std::min(m_grid->column(col).border_left, m_grid->column(col - 1).border_right);
+            for (int col = 0; col < m_grid->cols_count(); col++)
+            {
+                table_cell* cell = m_grid->cell(col, row);
+                cell->min_content_width = -1;
+                cell->max_content_width = -1;
+            }
         }
+        m_styles_generation = styles_generation;
     }
-
-
-    // Calculate the minimum content width (MCW) of each cell: the formatted content may span any number of lines but may not overflow the cell box.
-    // If the specified 'width' (W) of the cell is greater than MCW, W is the minimum cell width. A value of 'auto' means that MCW is the minimum
-    // cell width.
-    //
-    // Also, calculate the "maximum" cell width of each cell: formatting the content without breaking lines other than where explicit line breaks occur.
+    std::vector<std::pair<int, int>> spanning_cells;
 
     if (m_grid->cols_count() == 1 && self_size.width.type != containing_block_context::cbc_value_type_auto)
     {
@@ -52,9 +50,13 @@ litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, con
             table_cell* cell = m_grid->cell(0, row);
             if (cell && cell->el)
             {
-                cell->min_width = cell->max_width = cell->el->render(0, 0, self_size.new_width(self_size.render_width - table_width_spacing), fmt_ctx);
+                cell->min_width = cell->max_width = cell->el->render(0, 0, self_size.new_width(avail_width), fmt_ctx);
                 cell->el->pos().width = cell->min_width - cell->el->content_offset_left() -
 						cell->el->content_offset_right();
+                cell->rendered_width = avail_width;
+            } else if (cell)
+            {
+                cell->rendered_width = -1;
             }
         }
     }
@@ -65,8 +67,13 @@ litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, con
             for (int col = 0; col < m_grid->cols_count(); col++)
             {
                 table_cell* cell = m_grid->cell(col, row);
-                if (cell && cell->el)
+                cell->rendered_width = -1;
+                if (cell->el)
                 {
+                    if (cell->colspan > 1)
+                    {
+                        spanning_cells.emplace_back(col, row);
+                    }
                     if (!m_grid->column(col).css_width.is_predefined() && m_grid->column(col).css_width.units() != css_units_percentage)
                     {
                         pixel_t css_w = m_grid->column(col).css_width.calc_percent(self_size.width);
@@ -74,86 +81,204 @@ litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, con
                         cell->min_width = cell->max_width = std::max(css_w, el_w);
                         cell->el->pos().width = cell->min_width - cell->el->content_offset_left() -
 								cell->el->content_offset_right();
+                        cell->rendered_width = css_w;
                     }
                     else
                     {
-                        // calculate minimum content width
-                        cell->min_width = cell->el->render(0, 0, self_size.new_width(cell->el->content_offset_width()), fmt_ctx);
                         // calculate maximum content width
-                        cell->max_width = cell->el->render(0, 0, self_size.new_width(self_size.render_width - table_width_spacing), fmt_ctx);
+                        if (cell->max_content_width < 0 || cell->max_content_base != avail_width)
+                        {
+                            cell->max_content_width = cell->el->render(0, 0, self_size.new_width(avail_width), fmt_ctx);
+                            cell->max_content_base = avail_width;
+                            cell->rendered_width = avail_width;
+                        }
+                        cell->max_width = cell->max_content_width;
+                        // minimum content width is calculated below if required
+                        if (cell->min_content_width >= 0)
+                        {
+                            cell->min_width = cell->min_content_width;
+                        } else
+                        {
+                            cell->min_width = cell->max_width;
+                            min_widths_pending = true;
+                        }
                     }
                 }
             }
         }
     }
 
-    // For each column, determine a maximum and minimum column width from the cells that span only that column.
-    // The minimum is that required by the cell with the largest minimum cell width (or the column 'width', whichever is larger).
-    // The maximum is that required by the cell with the largest maximum cell width (or the column 'width', whichever is larger).
+    // Spanning cells are processed column by column
+    std::stable_sort(spanning_cells.begin(), spanning_cells.end(),
+        [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
 
+    bool has_fixed_columns = false;
+    bool has_percent_columns = false;
     for (int col = 0; col < m_grid->cols_count(); col++)
     {
-        m_grid->column(col).max_width = 0;
-        m_grid->column(col).min_width = 0;
-        for (int row = 0; row < m_grid->rows_count(); row++)
+        const css_length& css_w = m_grid->column(col).css_width;
+        if (!css_w.is_predefined())
         {
-            if (m_grid->cell(col, row)->colspan <= 1)
+            if (css_w.units() == css_units_percentage)
             {
-                m_grid->column(col).max_width = std::max(m_grid->column(col).max_width, m_grid->cell(col, row)->max_width);
-                m_grid->column(col).min_width = std::max(m_grid->column(col).min_width, m_grid->cell(col, row)->min_width);
+                has_percent_columns = true;
+            } else
+            {
+                has_fixed_columns = true;
             }
         }
     }
 
-    // For each cell that spans more than one column, increase the minimum widths of the columns it spans so that together,
-    // they are at least as wide as the cell. Do the same for the maximum widths.
-    // If possible, widen all spanned columns by approximately the same amount.
-
-    for (int col = 0; col < m_grid->cols_count(); col++)
+    while (true)
     {
+        // For each column, determine a maximum and minimum column width from the cells that span only that column.
+        // The minimum is that required by the cell with the largest minimum cell width (or the column 'width', whichever is larger).
+        // The maximum is that required by the cell with the largest maximum cell width (or the column 'width', whichever is larger).
+
+        for (int col = 0; col < m_grid->cols_count(); col++)
+        {
+            m_grid->column(col).max_width = 0;
+            m_grid->column(col).min_width = 0;
+        }
         for (int row = 0; row < m_grid->rows_count(); row++)
         {
-            if (m_grid->cell(col, row)->colspan > 1)
+            for (int col = 0; col < m_grid->cols_count(); col++)
             {
-                pixel_t max_total_width = m_grid->column(col).max_width;
-                pixel_t min_total_width = m_grid->column(col).min_width;
-                for (int col2 = col + 1; col2 < col + m_grid->cell(col, row)->colspan; col2++)
-                {
-                    max_total_width += m_grid->column(col2).max_width;
-                    min_total_width += m_grid->column(col2).min_width;
-                }
-                if (min_total_width < m_grid->cell(col, row)->min_width)
+                table_cell* cell = m_grid->cell(col, row);
+                if (cell->colspan <= 1)
                 {
-                    m_grid->distribute_min_width(m_grid->cell(col, row)->min_width - min_total_width, col, col + m_grid->cell(col, row)->colspan - 1);
+                    m_grid->column(col).max_width = std::max(m_grid->column(col).max_width, cell->max_width);
+                    m_grid->column(col).min_width = std::max(m_grid->column(col).min_width, cell->min_width);
                 }
-                if (max_total_width < m_grid->cell(col, row)->max_width)
+            }
+        }
+
+        // For each cell that spans more than one column, increase the minimum widths of the columns it spans so that together,
+        // they are at least as wide as the cell. Do the same for the maximum widths.
+        // If possible, widen all spanned columns by approximately the same amount.
+
+        for (const auto& span : spanning_cells)
+        {
+            int col = span.first;
+            table_cell* cell = m_grid->cell(col, span.second);
+            pixel_t max_total_width = m_grid->column(col).max_width;
+            pixel_t min_total_width = m_grid->column(col).min_width;
+            for (int col2 = col + 1; col2 < col + cell->colspan; col2++)
+            {
+                max_total_width += m_grid->column(col2).max_width;
+                min_total_width += m_grid->column(col2).min_width;
+            }
+            if (min_total_width < cell->min_width)
+            {
+                m_grid->distribute_min_width(cell->min_width - min_total_width, col, col + cell->colspan - 1);
+            }
+            if (max_total_width < cell->max_width)
+            {
+                m_grid->distribute_max_width(cell->max_width - max_total_width, col, col + cell->colspan - 1);
+            }
+        }
+
+        if (!min_widths_pending)
+        {
+            break;
+        }
+
+        // An auto-width table gives every column its maximum width when all of them fit, so the minimum
+        // widths are not required. Percentage columns and fixed columns widened by spanning cells depend on them.
+        if (self_size.width.type == containing_block_context::cbc_value_type_auto &&
+            !has_percent_columns && (!has_fixed_columns || spanning_cells.empty()))
+        {
+            pixel_t max_columns_width = 0;
+            for (int col = 0; col < m_grid->cols_count(); col++)
+            {
+                max_columns_width += m_grid->column(col).max_width;
+            }
+            if (max_columns_width <= avail_width)
+            {
+                break;
+            }
+        }
+
+        // calculate minimum content width
+        for (int row = 0; row < m_grid->rows_count(); row++)
+        {
+            for (int col = 0; col < m_grid->cols_count(); col++)
+            {
+                table_cell* cell = m_grid->cell(col, row);
+                if (cell->el && cell->min_content_width < 0 &&
+                    (m_grid->column(col).css_width.is_predefined() || m_grid->column(col).css_width.units() == css_units_percentage))
                 {
-                    m_grid->distribute_max_width(m_grid->cell(col, row)->max_width - max_total_width, col, col + m_grid->cell(col, row)->colspan - 1);
+                    pixel_t min_render_width = cell->el->content_offset_width();
+                    cell->min_content_width = cell->el->render(0, 0, self_size.new_width(min_render_width), fmt_ctx);
+                    cell->min_width = cell->min_content_width;
+                    cell->rendered_width = min_render_width;
                 }
             }
         }
+        min_widths_pending = false;
     }
+}
 
-    // If the 'table' or 'inline-table' element's 'width' property has a computed value (W) other than 'auto', the used width is the
-    // greater of W, CAPMIN, and the minimum width required by all the columns plus cell spacing or borders (MIN).
-    // If the used width is greater than MIN, the extra width should be distributed over the columns.
-    //
-    // If the 'table' or 'inline-table' element has 'width: auto', the used width is the greater of the table's containing block width,
-    // CAPMIN, and MIN. However, if either CAPMIN or the maximum width required by the columns plus cell spacing or borders (MAX) is
-    // less than that of the containing block, use max(MAX, CAPMIN).
+litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, const containing_block_context &containing_block_size, formatting_context* fmt_ctx, bool /*second_pass*/)
+{
+    if (!m_grid) return 0;
+
+	containing_block_context self_size = calculate_containing_block_context(containing_block_size);
+
+    // Calculate table spacing
+    pixel_t table_width_spacing = 0;
+    if (src_el()->css().get_border_collapse() == border_collapse_separate)
+    {
+        table_width_spacing = m_border_spacing_x * (m_grid->cols_count() + 1);
+    }
+    else
+    {
+        table_width_spacing = 0;
+
+        if (m_grid->cols_count())
+        {
+            table_width_spacing -= std::min(border_left(), m_grid->column(0).border_left);
+            table_width_spacing -= std::min(border_right(), m_grid->column(m_grid->cols_count() - 1).border_right);
+        }
+
+        for (int col = 1; col < m_grid->cols_count(); col++)
+        {
+            table_width_spacing -= std::min(m_grid->column(col).border_left, m_grid->column(col - 1).border_right);
+        }
+    }
 
 
     pixel_t table_width = 0;
     pixel_t min_table_width = 0;
     pixel_t max_table_width = 0;
 
-    if (self_size.width.type == containing_block_context::cbc_value_type_absolute)
+    if (m_fixed_layout)
     {
-        table_width = m_grid->calc_table_width(self_size.render_width - table_width_spacing, false, min_table_width, max_table_width);
+        // https://www.w3.org/TR/CSS22/tables.html#fixed-table-layout
+        // The column widths don't depend on the cells content, so each cell is rendered only once with its final width.
+        table_width = m_grid->calc_fixed_table_width(self_size.render_width - table_width_spacing);
+        min_table_width = max_table_width = table_width;
     }
     else
     {
-        table_width = m_grid->calc_table_width(self_size.render_width - table_width_spacing, self_size.width.type == containing_block_context::cbc_value_type_auto, min_table_width, max_table_width);
+        measure_cells(self_size, table_width_spacing, fmt_ctx);
+
+        // If the 'table' or 'inline-table' element's 'width' property has a computed value (W) other than 'auto', the used width is the
+        // greater of W, CAPMIN, and the minimum width required by all the columns plus cell spacing or borders (MIN).
+        // If the used width is greater than MIN, the extra width should be distributed over the columns.
+        //
+        // If the 'table' or 'inline-table' element has 'width: auto', the used width is the greater of the table's containing block width,
+        // CAPMIN, and MIN. However, if either CAPMIN or the maximum width required by the columns plus cell spacing or borders (MAX) is
+        // less than that of the containing block, use max(MAX, CAPMIN).
+
+        if (self_size.width.type == containing_block_context::cbc_value_type_absolute)
+        {
+            table_width = m_grid->calc_table_width(self_size.render_width - table_width_spacing, false, min_table_width, max_table_width);
+        }
+        else
+        {
+            table_width = m_grid->calc_table_width(self_size.render_width - table_width_spacing, self_size.width.type == containing_block_context::cbc_value_type_auto, min_table_width, max_table_width);
+        }
     }
 
     min_table_width += table_width_spacing;
@@ -179,17 +304,18 @@ litehtml::pixel_t litehtml::render_item_table::_render(pixel_t x, pixel_t y, con
                 }
                 pixel_t cell_width = m_grid->column(span_col).right - m_grid->column(col).left;
 
-                //if (cell->el->pos().width != cell_width - cell->el->content_offset_left() -
-				//									 cell->el->content_offset_right())
+                if (cell->rendered_width != cell_width)
                 {
                     cell->el->render(m_grid->column(col).left, 0, self_size.new_width(cell_width), fmt_ctx, true);
-                    cell->el->pos().width = cell_width - cell->el->content_offset_left() -
-							cell->el->content_offset_right();
                 }
-                /*else
+                else
                 {
+                    // The cell was rendered with this width while measuring, so only move it into the column
                     cell->el->pos().x = m_grid->column(col).left + cell->el->content_offset_left();
-                }*/
+                    cell->el->pos().y = cell->el->content_offset_top();
+                }
+                cell->el->pos().width = cell_width - cell->el->content_offset_left() -
+						cell->el->content_offset_right();
 
                 if (cell->rowspan <= 1)
                 {
@@ -380,6 +506,8 @@ std::shared_ptr<litehtml::render_item> litehtml::render_item_table::init()
 {
     // Initialize Grid
     m_grid = std::make_unique<table_grid>();
+    document::ptr doc = src_el()->get_document();
+    size_t cell_slots = 0;
 
     go_inside_table 		table_selector;
     table_rows_selector		row_selector;
@@ -395,29 +523,67 @@ std::shared_ptr<litehtml::render_item> litehtml::render_item_table::init()
             elements_iterator cell_iter(true, &table_selector, &cell_selector);
             cell_iter.process(el, [&](std::shared_ptr<render_item>& el, iterator_item_type item_type)
                 {
-					if(item_type != iterator_item_type_end_parent)
+					if(item_type != iterator_item_type_end_parent && doc->complexity_exceeded() == complexity_ok)
 					{
 						el = el->init();
-						m_grid->add_cell(el);
+						int slots = m_grid->add_cell(el);
+						cell_slots += slots;
+						doc->use_table_cells(slots);
 					}
                 });
         });
 
+    auto add_column = [this](const std::shared_ptr<render_item>& el)
+        {
+            // Clamped like in browsers (HTML: 1 <= span <= 1000)
+            int span = atoi(el->src_el()->get_attr("span", "1"));
+            m_grid->add_column(el->src_el()->css().get_width(), std::min(std::max(span, 1), 1000));
+        };
+
     for (auto& el : m_children)
     {
-        if (el->src_el()->css().get_display() == display_table_caption)
+        switch (el->src_el()->css().get_display())
         {
+        case display_table_caption:
             el = el->init();
             m_grid->captions().push_back(el);
+            break;
+        case display_table_column:
+            add_column(el);
+            break;
+        case display_table_column_group:
+            {
+                bool has_columns = false;
+                for (const auto& col : el->children())
+                {
+                    if (col->src_el()->css().get_display() == display_table_column)
+                    {
+                        add_column(col);
+                        has_columns = true;
+                    }
+                }
+                if (!has_columns)
+                {
+                    add_column(el);
+                }
+            }
+            break;
+        default:
+            break;
         }
     }
 
-    m_grid->finish();
+    // The fixed table layout is used only if the table width is specified
+    m_fixed_layout = src_el()->css().get_table_layout() == table_layout_fixed && !src_el()->css().get_width().is_predefined();
+    // finish() pads rows shorter than the longest one with empty slots
+    if(doc->use_table_cells(m_grid->finished_size() - cell_slots))
+    {
+        m_grid->finish(m_fixed_layout ? table_layout_fixed : table_layout_auto);
+    }
 
 	if(src_el()->css().get_border_collapse() == border_collapse_separate)
 	{
 		auto fm = css().get_font_metrics();
-		document::ptr doc = src_el()->get_document();
 		m_border_spacing_x = doc->to_pixels(src_el()->css().get_border_spacing_x(), fm, 0);
 		m_border_spacing_y = doc->to_pixels(src_el()->css().get_border_spacing_y(), fm, 0);
 	} else
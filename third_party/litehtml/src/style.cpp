@@ -66,6 +66,8 @@ std::map<string_id, string> style::m_valid_values =
 	{ _align_self_, flex_align_items_strings },
 
 	{ _caption_side_, caption_side_strings },
+	{ _table_layout_, table_layout_strings },
+	{ _text_overflow_, text_overflow_strings },
 
 	{ _text_decoration_style_, style_text_decoration_style_strings },
 	{ _text_emphasis_position_, style_text_emphasis_position_strings },
@@ -231,6 +233,8 @@ void style::add_property(string_id name, const css_token_vector& value, const st
 	case _align_content_:
 
 	case _caption_side_:
+	case _table_layout_:
+	case _text_overflow_:
 
 		if (int index = value_index(ident, m_valid_values[name]); index >= 0)
 			add_parsed_property(name, property_value(index, important));
@@ -498,6 +502,16 @@ void style::add_property(string_id name, const css_token_vector& value, const st
 			add_parsed_property(name, property_value((int)val.n.number, important));
 		break;
 
+	//  =============================  LINE CLAMP  =============================
+
+	case _max_lines_:
+	case __webkit_line_clamp_: // none | <integer [1,inf]>
+		if (ident == "none")
+			add_parsed_property(_max_lines_, property_value(0, important));
+		else if (val.type == NUMBER && val.n.number_type == css_number_integer && val.n.number >= 1)
+			add_parsed_property(_max_lines_, property_value((int)val.n.number, important));
+		break;
+
 	//  =============================  COUNTER, CONTENT  =============================
 
 	case _counter_increment_:
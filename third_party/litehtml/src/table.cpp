@@ -4,25 +4,40 @@
 #include "render_item.h"
 #include "types.h"
 
-void litehtml::table_grid::add_cell(const std::shared_ptr<render_item>& el)
+int litehtml::table_grid::add_cell(const std::shared_ptr<render_item>& el)
 {
 	table_cell cell;
 	cell.el = el;
-	cell.colspan	= atoi(el->src_el()->get_attr("colspan", "1"));
-	cell.rowspan	= atoi(el->src_el()->get_attr("rowspan", "1"));
+	// Spans are clamped like in browsers (HTML: colspan <= 1000, rowspan <= 65534)
+	cell.colspan	= std::min(atoi(el->src_el()->get_attr("colspan", "1")), 1000);
+	cell.rowspan	= std::min(atoi(el->src_el()->get_attr("rowspan", "1")), 65534);
 	cell.borders	= el->get_borders();
 
-	while( is_rowspanned( (int) m_cells.size() - 1, (int) m_cells.back().size() ) )
+	int row = (int) m_cells.size() - 1;
+	size_t slots = m_cells.back().size();
+	while( is_rowspanned( row, (int) m_cells.back().size() ) )
 	{
 		m_cells.back().emplace_back();
 	}
 
+	if(cell.rowspan > 1)
+	{
+		int col = (int) m_cells.back().size();
+		if(col >= (int) m_rowspan_end.size())
+		{
+			m_rowspan_end.resize(col + 1, -1);
+		}
+		m_rowspan_end[col] = std::max(m_rowspan_end[col], row + cell.rowspan - 1);
+	}
+
 	m_cells.back().push_back(cell);
 	for(int i = 1; i < cell.colspan; i++)
 	{
 		table_cell empty_cell;
 		m_cells.back().push_back(empty_cell);
 	}
+	m_max_row_size = std::max(m_max_row_size, (int) m_cells.back().size());
+	return (int) (m_cells.back().size() - slots);
 }
 
 
@@ -35,25 +50,38 @@ void litehtml::table_grid::begin_row(const std::shared_ptr<render_item>& row)
 }
 
 
+// Checks whether the cell (r, c) of the row being built is covered by a rowspan from the rows above.
+// m_rowspan_end keeps the last covered row per column, so there is no need to scan the previous rows.
 bool litehtml::table_grid::is_rowspanned( int r, int c )
 {
-	for(int row = r - 1; row >= 0; row--)
+	if(c < (int) m_rowspan_end.size())
 	{
-		if(c < (int) m_cells[row].size())
-		{
-			if(m_cells[row][c].rowspan > 1)
-			{
-				if(m_cells[row][c].rowspan >= r - row + 1)
-				{
-					return true;
-				}
-			}
-		}
+		return m_rowspan_end[c] >= r;
 	}
 	return false;
 }
 
-void litehtml::table_grid::finish()
+// Columns are added after the cells. Column elements beyond the columns created by the cells are never used,
+// so they are not stored: <col span> must not be able to grow the grid past the cells.
+void litehtml::table_grid::add_column(const css_length& width, int span)
+{
+	for(int i = 0; i < span && (int) m_col_widths.size() < m_max_row_size; i++)
+	{
+		m_col_widths.push_back(width);
+	}
+}
+
+size_t litehtml::table_grid::finished_size() const
+{
+	size_t cols = 0;
+	for(const auto& row : m_cells)
+	{
+		cols = std::max(cols, row.size());
+	}
+	return m_cells.size() * cols;
+}
+
+void litehtml::table_grid::finish(table_layout layout)
 {
 	m_rows_count	= (int) m_cells.size();
 	m_cols_count	= 0;
@@ -76,6 +104,42 @@ void litehtml::table_grid::finish()
 		m_columns.emplace_back(0, 0);
 	}
 
+	// https://www.w3.org/TR/CSS22/tables.html#fixed-table-layout
+	// In the fixed table layout the column widths are taken from the column elements and from the cells in the first
+	// row only. Column elements beyond the columns created by the cells are ignored.
+	if(layout == table_layout_fixed)
+	{
+		for(int col = 0; col < m_cols_count && col < (int) m_col_widths.size(); col++)
+		{
+			if(!m_col_widths[col].is_predefined())
+			{
+				m_columns[col].css_width = m_col_widths[col];
+			}
+		}
+		if(m_rows_count)
+		{
+			for(int col = 0; col < m_cols_count; col++)
+			{
+				table_cell* first_cell = cell(col, 0);
+				if(!first_cell->el) continue;
+
+				css_length width = first_cell->el->src_el()->css().get_width();
+				if(width.is_predefined()) continue;
+
+				// a spanning cell's width is divided over the columns it spans
+				int span = std::max(1, std::min(first_cell->colspan, m_cols_count - col));
+				width.set_value(width.val() / (float) span, width.units());
+				for(int i = col; i < col + span; i++)
+				{
+					if(m_columns[i].css_width.is_predefined())
+					{
+						m_columns[i].css_width = width;
+					}
+				}
+			}
+		}
+	}
+
 	for(int col = 0; col < m_cols_count; col++)
 	{
 		for(int row = 0; row < m_rows_count; row++)
@@ -116,7 +180,7 @@ void litehtml::table_grid::finish()
 				}
 			}
 
-			if(cell(col, row)->el && cell(col, row)->colspan <= 1)
+			if(layout == table_layout_auto && cell(col, row)->el && cell(col, row)->colspan <= 1)
 			{
 				if (!cell(col, row)->el->src_el()->css().get_width().is_predefined() && m_columns[col].css_width.is_predefined())
 				{
@@ -408,6 +472,57 @@ litehtml::pixel_t litehtml::table_grid::calc_table_width(pixel_t block_width, bo
 	return cur_width;
 }
 
+// Fixed table layout: the column widths don't depend on the cells content.
+// Columns with the specified width get it, the rest of the table width is divided equally over the other columns.
+// If all columns have widths, the remaining space is distributed over all columns proportionally.
+litehtml::pixel_t litehtml::table_grid::calc_fixed_table_width(pixel_t block_width)
+{
+	pixel_t fixed_width = 0;
+	int auto_columns = 0;
+	for(int col = 0; col < m_cols_count; col++)
+	{
+		if(!m_columns[col].css_width.is_predefined())
+		{
+			m_columns[col].width = std::max((pixel_t) 0, m_columns[col].css_width.calc_percent(block_width));
+			fixed_width += m_columns[col].width;
+		} else
+		{
+			m_columns[col].width = 0;
+			auto_columns++;
+		}
+	}
+
+	pixel_t rest = block_width - fixed_width;
+	if(rest > 0)
+	{
+		if(auto_columns)
+		{
+			pixel_t auto_width = rest / (pixel_t) auto_columns;
+			for(int col = 0; col < m_cols_count; col++)
+			{
+				if(m_columns[col].css_width.is_predefined())
+				{
+					m_columns[col].width = auto_width;
+				}
+			}
+		} else if(fixed_width > 0)
+		{
+			for(int col = 0; col < m_cols_count; col++)
+			{
+				m_columns[col].width += rest * m_columns[col].width / fixed_width;
+			}
+		}
+	}
+
+	pixel_t table_width = 0;
+	for(int col = 0; col < m_cols_count; col++)
+	{
+		m_columns[col].min_width = m_columns[col].max_width = m_columns[col].width;
+		table_width += m_columns[col].width;
+	}
+	return table_width;
+}
+
 void litehtml::table_grid::clear()
 {
 	m_rows_count	= 0;
@@ -415,6 +530,9 @@ void litehtml::table_grid::clear()
 	m_cells.clear();
 	m_columns.clear();
 	m_rows.clear();
+	m_rowspan_end.clear();
+	m_col_widths.clear();
+	m_max_row_size	= 0;
 }
 
 void litehtml::table_grid::calc_horizontal_positions( const margins& table_borders, border_collapse bc, pixel_t bdr_space_x)